@@ -0,0 +1,147 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file Benchmark.hh
+
+    A small framework for timing mesh operations. Benchmarks are registered
+    with OM_BENCHMARK and run for several mesh sizes by benchmarks.cc.
+*/
+
+#ifndef INCLUDE_BENCHMARK_HH
+#define INCLUDE_BENCHMARK_HH
+
+#include <string>
+#include <vector>
+//
+#include <OpenMesh/Tools/Utils/Timer.hh>
+
+
+/** State of one benchmark run.
+
+    Only the time between start() and stop() is measured, so setup work
+    like the generation of input meshes is excluded. The benchmark reports
+    the number of processed items (e.g. faces) and optionally bytes, from
+    which the throughput is computed.
+*/
+class BenchmarkState
+{
+public:
+
+  explicit BenchmarkState(size_t _size)
+  : size_(_size), seconds_(0.0), items_(0), bytes_(0) { }
+
+  /// Requested problem size (number of faces of the input mesh)
+  size_t size() const { return size_; }
+
+  /// Start (or continue) the measurement
+  void start() { timer_.start(); }
+
+  /// Stop the measurement
+  void stop()  { timer_.stop(); seconds_ += timer_.seconds(); }
+
+  /// Measured time in seconds
+  double seconds() const { return seconds_; }
+
+  /// Number of processed items
+  void   set_items(size_t _n) { items_ = _n; }
+  size_t items() const        { return items_; }
+
+  /// Number of processed bytes (IO benchmarks)
+  void   set_bytes(size_t _n) { bytes_ = _n; }
+  size_t bytes() const        { return bytes_; }
+
+private:
+
+  size_t                 size_;
+  OpenMesh::Utils::Timer timer_;
+  double                 seconds_;
+  size_t                 items_;
+  size_t                 bytes_;
+};
+
+
+typedef void (*BenchmarkFunction)(BenchmarkState&);
+
+
+/// A registered benchmark
+struct BenchmarkInfo
+{
+  std::string       name;
+  BenchmarkFunction function;
+};
+
+
+/// All registered benchmarks
+std::vector<BenchmarkInfo>& registered_benchmarks();
+
+
+/// Registers a benchmark during static initialization
+struct BenchmarkRegistrar
+{
+  BenchmarkRegistrar(const char* _group, const char* _name, BenchmarkFunction _function);
+};
+
+
+/** Define a benchmark named group/name.
+
+    \code
+    OM_BENCHMARK(Normals, update_normals)
+    {
+      Mesh mesh;
+      generate_torus(mesh, state.size());
+      state.start();
+      mesh.update_normals();
+      state.stop();
+      state.set_items(mesh.n_faces());
+    }
+    \endcode
+*/
+#define OM_BENCHMARK(group, name) \
+  static void benchmark_##group##_##name(BenchmarkState& state); \
+  static BenchmarkRegistrar registrar_##group##_##name(#group, #name, &benchmark_##group##_##name); \
+  static void benchmark_##group##_##name(BenchmarkState& state)
+
+
+/// Keeps the compiler from optimizing away the results of a benchmark
+void do_not_optimize(double _value);
+
+
+#endif // INCLUDE_BENCHMARK_HH
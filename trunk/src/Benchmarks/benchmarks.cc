@@ -0,0 +1,303 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+//
+#include <OpenMesh/Core/System/config.h>
+#include <OpenMesh/Tools/Utils/getopt.h>
+//
+#include "Benchmark.hh"
+
+
+// ----------------------------------------------------------------------------
+
+std::vector<BenchmarkInfo>& registered_benchmarks()
+{
+  static std::vector<BenchmarkInfo> benchmarks;
+  return benchmarks;
+}
+
+
+BenchmarkRegistrar::BenchmarkRegistrar(const char* _group, const char* _name,
+                                       BenchmarkFunction _function)
+{
+  BenchmarkInfo info;
+  info.name     = std::string(_group) + "/" + _name;
+  info.function = _function;
+  registered_benchmarks().push_back(info);
+}
+
+
+static volatile double benchmark_sink = 0.0;
+
+void do_not_optimize(double _value)
+{
+  benchmark_sink = benchmark_sink + _value;
+}
+
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+/// Statistics over the repetitions of one benchmark with one size
+struct Result
+{
+  std::string name;
+  size_t      size;
+  size_t      items;
+  size_t      bytes;
+  double      min, median, mean;
+  std::vector<double> seconds;
+};
+
+
+bool by_name(const BenchmarkInfo& _a, const BenchmarkInfo& _b)
+{
+  return _a.name < _b.name;
+}
+
+
+Result run(const BenchmarkInfo& _benchmark, size_t _size, size_t _repetitions)
+{
+  Result result;
+  result.name  = _benchmark.name;
+  result.size  = _size;
+  result.items = 0;
+  result.bytes = 0;
+
+  for (size_t i = 0; i < _repetitions; ++i)
+  {
+    BenchmarkState state(_size);
+    _benchmark.function(state);
+    result.seconds.push_back(state.seconds());
+    result.items = state.items();
+    result.bytes = state.bytes();
+  }
+
+  std::vector<double> sorted(result.seconds);
+  std::sort(sorted.begin(), sorted.end());
+
+  result.min    = sorted.front();
+  result.median = sorted[sorted.size() / 2];
+  result.mean   = 0.0;
+  for (size_t i = 0; i < sorted.size(); ++i)
+    result.mean += sorted[i];
+  result.mean /= double(sorted.size());
+
+  return result;
+}
+
+
+double per_second(double _amount, double _seconds)
+{
+  return _seconds > 0.0 ? _amount / _seconds : 0.0;
+}
+
+
+void write_json(std::ostream& _os, const std::vector<Result>& _results,
+                size_t _repetitions)
+{
+  char date[32];
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+  _os << "{\n";
+  _os << "  \"version\": \"0x" << std::hex << OM_VERSION << std::dec << "\",\n";
+  _os << "  \"date\": \"" << date << "\",\n";
+#ifdef NDEBUG
+  _os << "  \"build\": \"release\",\n";
+#else
+  _os << "  \"build\": \"debug\",\n";
+#endif
+#ifdef USE_OPENMP
+  _os << "  \"openmp\": true,\n";
+#else
+  _os << "  \"openmp\": false,\n";
+#endif
+  _os << "  \"repetitions\": " << _repetitions << ",\n";
+  _os << "  \"results\": [";
+
+  _os << std::setprecision(9);
+  for (size_t i = 0; i < _results.size(); ++i)
+  {
+    const Result& r = _results[i];
+    _os << (i ? ",\n" : "\n")
+        << "    {\"name\": \"" << r.name << "\""
+        << ", \"size\": " << r.size
+        << ", \"items\": " << r.items
+        << ", \"bytes\": " << r.bytes
+        << ", \"min\": " << r.min
+        << ", \"median\": " << r.median
+        << ", \"mean\": " << r.mean
+        << ", \"items_per_second\": " << per_second(double(r.items), r.median)
+        << ", \"bytes_per_second\": " << per_second(double(r.bytes), r.median)
+        << ", \"seconds\": [";
+    for (size_t j = 0; j < r.seconds.size(); ++j)
+      _os << (j ? ", " : "") << r.seconds[j];
+    _os << "]}";
+  }
+  _os << "\n  ]\n}\n";
+}
+
+
+void usage_and_exit(int xcode)
+{
+  std::cerr << "Usage: OpenMesh_benchmarks [Options]\n\n"
+            << "  Runs all benchmarks for all sizes and writes the results\n"
+            << "  as JSON.\n" << std::endl;
+  std::cerr << "Options\n\n"
+            << "  -f <text>   Only run benchmarks whose name contains <text>.\n"
+            << "  -l          List the benchmarks.\n"
+            << "  -o <file>   Write the JSON results to <file> (default: stdout).\n"
+            << "  -r <n>      Repetitions of each benchmark (default: 3).\n"
+            << "  -s <sizes>  Comma separated numbers of faces of the input\n"
+            << "              meshes (default: 1000,10000,100000).\n"
+            << std::endl;
+  exit(xcode);
+}
+
+} // namespace
+
+
+// ----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+  std::string         filter, ofname;
+  std::vector<size_t> sizes;
+  size_t              repetitions = 3;
+  bool                list = false;
+  int                 c;
+
+  while ( (c=getopt(argc, argv, "f:hlo:r:s:")) != -1 )
+  {
+    switch (c)
+    {
+      case 'f': filter = optarg; break;
+      case 'l': list = true; break;
+      case 'o': ofname = optarg; break;
+      case 'r': repetitions = size_t(atol(optarg)); break;
+      case 's':
+      {
+        std::istringstream str(optarg);
+        std::string token;
+        while (std::getline(str, token, ','))
+          if (atol(token.c_str()) > 0)
+            sizes.push_back(size_t(atol(token.c_str())));
+        break;
+      }
+      case 'h': usage_and_exit(0); break;
+      default:  usage_and_exit(1);
+    }
+  }
+
+  if (sizes.empty())
+  {
+    sizes.push_back(1000);
+    sizes.push_back(10000);
+    sizes.push_back(100000);
+  }
+  if (repetitions == 0)
+    usage_and_exit(1);
+
+  std::vector<BenchmarkInfo> benchmarks = registered_benchmarks();
+  std::sort(benchmarks.begin(), benchmarks.end(), by_name);
+
+  if (list)
+  {
+    for (size_t i = 0; i < benchmarks.size(); ++i)
+      std::cout << benchmarks[i].name << std::endl;
+    return 0;
+  }
+
+  // ---------------------------------------- run
+  std::vector<Result> results;
+
+  for (size_t i = 0; i < benchmarks.size(); ++i)
+  {
+    if (benchmarks[i].name.find(filter) == std::string::npos)
+      continue;
+
+    for (size_t j = 0; j < sizes.size(); ++j)
+    {
+      Result r = run(benchmarks[i], sizes[j], repetitions);
+      results.push_back(r);
+
+      std::cerr << std::left << std::setw(40) << r.name << std::right
+                << std::setw(9) << r.size
+                << std::fixed << std::setprecision(6)
+                << std::setw(12) << r.median << " s"
+                << std::setprecision(0)
+                << std::setw(14) << per_second(double(r.items), r.median)
+                << " items/s";
+      if (r.bytes)
+        std::cerr << std::setprecision(2) << std::setw(10)
+                  << per_second(r.bytes / (1024.0 * 1024.0), r.median)
+                  << " MB/s";
+      std::cerr << std::endl;
+    }
+  }
+
+  // ---------------------------------------- report
+  if (ofname.empty())
+    write_json(std::cout, results, repetitions);
+  else
+  {
+    std::ofstream ofs(ofname.c_str());
+    if (!ofs)
+    {
+      std::cerr << "Cannot write " << ofname << std::endl;
+      return 1;
+    }
+    write_json(ofs, results, repetitions);
+  }
+
+  return 0;
+}
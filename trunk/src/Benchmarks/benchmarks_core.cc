@@ -0,0 +1,383 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+#include "Benchmark.hh"
+#include "generate_torus.hh"
+
+#include <OpenMesh/Core/Geometry/QuadricT.hh>
+
+
+// ------------------------------------------------------------- circulators --
+
+OM_BENCHMARK(Circulators, vertex_vertex)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  double sum = 0.0;
+  state.start();
+  for (Mesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    for (Mesh::VertexVertexIter vv_it = mesh.vv_iter(*v_it); vv_it.is_valid(); ++vv_it)
+      sum += mesh.point(*vv_it)[0];
+  state.stop();
+
+  do_not_optimize(sum);
+  state.set_items(mesh.n_halfedges());
+}
+
+
+OM_BENCHMARK(Circulators, vertex_outgoing_halfedge)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  double sum = 0.0;
+  state.start();
+  for (Mesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    for (Mesh::VertexOHalfedgeIter voh_it = mesh.voh_iter(*v_it); voh_it.is_valid(); ++voh_it)
+      sum += voh_it->idx();
+  state.stop();
+
+  do_not_optimize(sum);
+  state.set_items(mesh.n_halfedges());
+}
+
+
+OM_BENCHMARK(Circulators, vertex_face)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  double sum = 0.0;
+  state.start();
+  for (Mesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    for (Mesh::VertexFaceIter vf_it = mesh.vf_iter(*v_it); vf_it.is_valid(); ++vf_it)
+      sum += vf_it->idx();
+  state.stop();
+
+  do_not_optimize(sum);
+  state.set_items(mesh.n_halfedges());
+}
+
+
+OM_BENCHMARK(Circulators, face_vertex)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  double sum = 0.0;
+  state.start();
+  for (Mesh::FaceIter f_it = mesh.faces_begin(); f_it != mesh.faces_end(); ++f_it)
+    for (Mesh::FaceVertexIter fv_it = mesh.fv_iter(*f_it); fv_it.is_valid(); ++fv_it)
+      sum += mesh.point(*fv_it)[0];
+  state.stop();
+
+  do_not_optimize(sum);
+  state.set_items(3 * mesh.n_faces());
+}
+
+
+OM_BENCHMARK(Circulators, face_face)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  double sum = 0.0;
+  state.start();
+  for (Mesh::FaceIter f_it = mesh.faces_begin(); f_it != mesh.faces_end(); ++f_it)
+    for (Mesh::FaceFaceIter ff_it = mesh.ff_iter(*f_it); ff_it.is_valid(); ++ff_it)
+      sum += ff_it->idx();
+  state.stop();
+
+  do_not_optimize(sum);
+  state.set_items(3 * mesh.n_faces());
+}
+
+
+// ------------------------------------------------------------ construction --
+
+OM_BENCHMARK(Construction, add_face)
+{
+  Mesh mesh;
+
+  state.start();
+  generate_torus(mesh, state.size());
+  state.stop();
+
+  state.set_items(mesh.n_faces());
+}
+
+
+OM_BENCHMARK(Construction, add_face_poly)
+{
+  PolyMesh mesh;
+
+  state.start();
+  generate_torus(mesh, state.size(), true);
+  state.stop();
+
+  state.set_items(mesh.n_faces());
+}
+
+
+// ---------------------------------------------------------------- quadrics --
+
+namespace {
+
+// one plane quadric per face, to be evaluated at the face's vertices
+void face_quadrics(const Mesh& _mesh, std::vector<OpenMesh::Geometry::Quadricd>& _quadrics,
+                   std::vector<Mesh::Point>& _points)
+{
+  for (Mesh::ConstFaceIter f_it = _mesh.faces_begin(); f_it != _mesh.faces_end(); ++f_it)
+  {
+    Mesh::ConstFaceVertexIter fv_it = _mesh.cfv_iter(*f_it);
+    Mesh::Point p0 = _mesh.point(*fv_it); ++fv_it;
+    Mesh::Point p1 = _mesh.point(*fv_it); ++fv_it;
+    Mesh::Point p2 = _mesh.point(*fv_it);
+    Mesh::Point n  = (p1 - p0) % (p2 - p0);
+
+    OpenMesh::Geometry::Quadricd q(n[0], n[1], n[2], -(n | p0));
+    _quadrics.push_back(q); _points.push_back(p0);
+    _quadrics.push_back(q); _points.push_back(p1);
+    _quadrics.push_back(q); _points.push_back(p2);
+  }
+}
+
+template <class Batch>
+void benchmark_quadric_batch(BenchmarkState& _state)
+{
+  Mesh mesh;
+  generate_torus(mesh, _state.size());
+
+  std::vector<OpenMesh::Geometry::Quadricd> quadrics;
+  std::vector<Mesh::Point>                  points;
+  face_quadrics(mesh, quadrics, points);
+
+  Batch batch;
+  batch.reserve(quadrics.size());
+  std::vector<typename Batch::value_type> errors(quadrics.size());
+
+  for (size_t k = 0; k < quadrics.size(); ++k)
+    batch.push_back(quadrics[k], points[k]);
+
+  _state.start();
+  batch.evaluate(&errors[0]);
+  _state.stop();
+
+  do_not_optimize(double(errors[errors.size() / 2]));
+  _state.set_items(quadrics.size());
+}
+
+} // namespace
+
+
+OM_BENCHMARK(Quadrics, evaluate)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  std::vector<OpenMesh::Geometry::Quadricd> quadrics;
+  std::vector<Mesh::Point>                  points;
+  face_quadrics(mesh, quadrics, points);
+
+  std::vector<double> errors(quadrics.size());
+
+  state.start();
+  for (size_t k = 0; k < quadrics.size(); ++k)
+    errors[k] = quadrics[k](points[k]);
+  state.stop();
+
+  do_not_optimize(errors[errors.size() / 2]);
+  state.set_items(quadrics.size());
+}
+
+
+OM_BENCHMARK(Quadrics, evaluate_batch_double)
+{
+  benchmark_quadric_batch<OpenMesh::Geometry::QuadricBatchd>(state);
+}
+
+
+OM_BENCHMARK(Quadrics, evaluate_batch_float)
+{
+  benchmark_quadric_batch<OpenMesh::Geometry::QuadricBatchf>(state);
+}
+
+
+// ----------------------------------------------------------------- normals --
+
+OM_BENCHMARK(Normals, update_normals)
+{
+  Mesh mesh;
+  mesh.request_face_normals();
+  mesh.request_vertex_normals();
+  generate_torus(mesh, state.size());
+
+  state.start();
+  mesh.update_normals();
+  state.stop();
+
+  state.set_items(mesh.n_faces());
+}
+
+
+OM_BENCHMARK(Normals, update_face_normals)
+{
+  Mesh mesh;
+  mesh.request_face_normals();
+  generate_torus(mesh, state.size());
+
+  state.start();
+  mesh.update_face_normals();
+  state.stop();
+
+  state.set_items(mesh.n_faces());
+}
+
+
+// -------------------------------------------------------------- topology --
+
+OM_BENCHMARK(Topology, garbage_collection)
+{
+  Mesh mesh;
+  mesh.request_vertex_status();
+  mesh.request_edge_status();
+  mesh.request_face_status();
+  generate_torus(mesh, state.size());
+
+  size_t n_faces = mesh.n_faces();
+
+  // delete every third face
+  for (size_t i = 0; i < n_faces; i += 3)
+    mesh.delete_face(mesh.face_handle(int(i)), true);
+
+  state.start();
+  mesh.garbage_collection();
+  state.stop();
+
+  state.set_items(n_faces);
+}
+
+
+OM_BENCHMARK(Topology, collapse)
+{
+  Mesh mesh;
+  mesh.request_vertex_status();
+  mesh.request_edge_status();
+  mesh.request_face_status();
+  generate_torus(mesh, state.size());
+
+  // collapse every legal edge of a fixed subset (every seventh edge)
+  size_t n_collapses = 0;
+  state.start();
+  for (size_t i = 0; i < mesh.n_edges(); i += 7)
+  {
+    Mesh::HalfedgeHandle heh = mesh.halfedge_handle(mesh.edge_handle(int(i)), 0);
+    if (!mesh.status(mesh.edge_handle(heh)).deleted() && mesh.is_collapse_ok(heh))
+    {
+      mesh.collapse(heh);
+      ++n_collapses;
+    }
+  }
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Topology, is_collapse_ok)
+{
+  Mesh mesh;
+  mesh.request_vertex_status();
+  mesh.request_edge_status();
+  mesh.request_face_status();
+  generate_torus(mesh, state.size());
+
+  double sum = 0.0;
+  state.start();
+  for (Mesh::HalfedgeIter h_it = mesh.halfedges_begin(); h_it != mesh.halfedges_end(); ++h_it)
+    sum += mesh.is_collapse_ok(*h_it) ? 1.0 : 0.0;
+  state.stop();
+
+  do_not_optimize(sum);
+  state.set_items(mesh.n_halfedges());
+}
+
+
+// -------------------------------------------------------------- properties --
+
+OM_BENCHMARK(Properties, custom_vertex_property)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  OpenMesh::VPropHandleT<double> prop;
+  mesh.add_property(prop);
+
+  double sum = 0.0;
+  state.start();
+  for (Mesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    mesh.property(prop, *v_it) = mesh.point(*v_it)[2];
+  for (Mesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    sum += mesh.property(prop, *v_it);
+  state.stop();
+
+  do_not_optimize(sum);
+  state.set_items(2 * mesh.n_vertices());
+}
+
+
+OM_BENCHMARK(Properties, add_remove_property)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  state.start();
+  for (int i = 0; i < 10; ++i)
+  {
+    OpenMesh::HPropHandleT<OpenMesh::Vec3d> prop;
+    mesh.add_property(prop);
+    mesh.remove_property(prop);
+  }
+  state.stop();
+
+  state.set_items(10 * mesh.n_halfedges());
+}
@@ -0,0 +1,143 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+//
+#include <OpenMesh/Core/IO/MeshIO.hh>
+//
+#include "Benchmark.hh"
+#include "generate_torus.hh"
+
+
+namespace {
+
+std::string io_filename(const std::string& _ext)
+{
+  return "OpenMesh_benchmark_io." + _ext;
+}
+
+
+size_t file_size(const std::string& _filename)
+{
+  std::ifstream ifs(_filename.c_str(), std::ios::in | std::ios::binary);
+  ifs.seekg(0, std::ios::end);
+  return ifs ? size_t(ifs.tellg()) : 0;
+}
+
+
+void benchmark_write(BenchmarkState& _state, const std::string& _ext,
+                     OpenMesh::IO::Options _opt)
+{
+  Mesh mesh;
+  generate_torus(mesh, _state.size());
+
+  std::string filename = io_filename(_ext);
+
+  _state.start();
+  bool ok = OpenMesh::IO::write_mesh(mesh, filename, _opt);
+  _state.stop();
+
+  _state.set_items(ok ? mesh.n_faces() : 0);
+  _state.set_bytes(file_size(filename));
+  std::remove(filename.c_str());
+}
+
+
+void benchmark_read(BenchmarkState& _state, const std::string& _ext,
+                    OpenMesh::IO::Options _opt)
+{
+  std::string filename = io_filename(_ext);
+  {
+    Mesh mesh;
+    generate_torus(mesh, _state.size());
+    OpenMesh::IO::write_mesh(mesh, filename, _opt);
+  }
+
+  Mesh                  mesh;
+  OpenMesh::IO::Options ropt;
+
+  _state.start();
+  bool ok = OpenMesh::IO::read_mesh(mesh, filename, ropt);
+  _state.stop();
+
+  _state.set_items(ok ? mesh.n_faces() : 0);
+  _state.set_bytes(file_size(filename));
+  std::remove(filename.c_str());
+}
+
+const OpenMesh::IO::Options Ascii;
+const OpenMesh::IO::Options Binary(OpenMesh::IO::Options::Binary);
+
+} // namespace
+
+
+// --------------------------------------------------------------------- OFF --
+
+OM_BENCHMARK(IO, write_off)        { benchmark_write(state, "off", Ascii);  }
+OM_BENCHMARK(IO, write_off_binary) { benchmark_write(state, "off", Binary); }
+OM_BENCHMARK(IO, read_off)         { benchmark_read (state, "off", Ascii);  }
+OM_BENCHMARK(IO, read_off_binary)  { benchmark_read (state, "off", Binary); }
+
+// --------------------------------------------------------------------- OBJ --
+
+OM_BENCHMARK(IO, write_obj)        { benchmark_write(state, "obj", Ascii);  }
+OM_BENCHMARK(IO, read_obj)         { benchmark_read (state, "obj", Ascii);  }
+
+// --------------------------------------------------------------------- PLY --
+
+OM_BENCHMARK(IO, write_ply)        { benchmark_write(state, "ply", Ascii);  }
+OM_BENCHMARK(IO, write_ply_binary) { benchmark_write(state, "ply", Binary); }
+OM_BENCHMARK(IO, read_ply)         { benchmark_read (state, "ply", Ascii);  }
+OM_BENCHMARK(IO, read_ply_binary)  { benchmark_read (state, "ply", Binary); }
+
+// --------------------------------------------------------------------- STL --
+
+OM_BENCHMARK(IO, write_stl)        { benchmark_write(state, "stl", Ascii);  }
+OM_BENCHMARK(IO, write_stl_binary) { benchmark_write(state, "stl", Binary); }
+OM_BENCHMARK(IO, read_stl)         { benchmark_read (state, "stl", Ascii);  }
+OM_BENCHMARK(IO, read_stl_binary)  { benchmark_read (state, "stl", Binary); }
+
+// ---------------------------------------------------------------------- OM --
+
+OM_BENCHMARK(IO, write_om)         { benchmark_write(state, "om",  Binary); }
+OM_BENCHMARK(IO, read_om)          { benchmark_read (state, "om",  Binary); }
@@ -0,0 +1,444 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+#include <cstdio>
+#include <string>
+//
+#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
+#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
+#include <OpenMesh/Tools/Decimater/ModAttribQuadricT.hh>
+#include <OpenMesh/Tools/Decimater/ModHausdorffT.hh>
+#include <OpenMesh/Tools/Decimater/ModNormalDeviationT.hh>
+#include <OpenMesh/Tools/Decimater/ModProgMeshT.hh>
+#include <OpenMesh/Tools/Decimater/PartitionDecimaterT.hh>
+#include <OpenMesh/Tools/Decimater/ProgMesh.hh>
+#include <OpenMesh/Tools/Decimater/VertexClusteringT.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/LoopT.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/Sqrt3T.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/ModifiedButterFlyT.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/Sqrt3InterpolatingSubdividerLabsikGreinerT.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/CatmullClarkT.hh>
+//
+#include "Benchmark.hh"
+#include "generate_torus.hh"
+
+
+// --------------------------------------------------------------- decimater --
+
+OM_BENCHMARK(Decimater, quadric)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>           Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT<Mesh>::Handle  HModQuadric;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // decimate to 10% of the vertices, including the setup of the quadrics
+  state.start();
+  size_t n_collapses;
+  {
+    Decimater   decimater(mesh);
+    HModQuadric hModQuadric;
+    decimater.add(hModQuadric);
+    decimater.module(hModQuadric).unset_max_err();
+    decimater.initialize();
+    n_collapses = decimater.decimate_to(mesh.n_vertices() / 10);
+  }
+  mesh.garbage_collection();
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Decimater, quadric_optimal)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>           Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT<Mesh>::Handle  HModQuadric;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // same as Decimater/quadric, but with optimal vertex placement
+  state.start();
+  size_t n_collapses;
+  {
+    Decimater   decimater(mesh);
+    HModQuadric hModQuadric;
+    decimater.add(hModQuadric);
+    decimater.module(hModQuadric).unset_max_err();
+    decimater.module(hModQuadric).set_optimal_placement(true);
+    decimater.initialize();
+    n_collapses = decimater.decimate_to(mesh.n_vertices() / 10);
+  }
+  mesh.garbage_collection();
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Decimater, attrib_quadric)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>                 Decimater;
+  typedef OpenMesh::Decimater::ModAttribQuadricT<Mesh>::Handle  HModAttribQuadric;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // planar texture coordinates and normals, 8-dimensional quadrics
+  mesh.request_vertex_texcoords2D();
+  mesh.request_vertex_normals();
+  mesh.request_face_normals();
+  mesh.update_normals();
+  for (Mesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    mesh.set_texcoord2D(*v_it, Mesh::TexCoord2D(mesh.point(*v_it)[0], mesh.point(*v_it)[1]));
+
+  // same as Decimater/quadric, but with attribute quadrics
+  state.start();
+  size_t n_collapses;
+  {
+    Decimater         decimater(mesh);
+    HModAttribQuadric hModAttribQuadric;
+    decimater.add(hModAttribQuadric);
+    decimater.module(hModAttribQuadric).unset_max_err();
+    decimater.initialize();
+    n_collapses = decimater.decimate_to(mesh.n_vertices() / 10);
+  }
+  mesh.garbage_collection();
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Decimater, lod_chain)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>           Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT<Mesh>::Handle  HModQuadric;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // snapshots at 1/2, 1/4, 1/8, 1/16 and 1/32 of the faces in one run
+  std::vector<size_t> n_faces;
+  for (size_t i = 1; i <= 5; ++i)
+    n_faces.push_back(mesh.n_faces() >> i);
+
+  state.start();
+  size_t n_collapses;
+  {
+    std::vector<Decimater::LevelOfDetail> lods;
+    Decimater   decimater(mesh);
+    HModQuadric hModQuadric;
+    decimater.add(hModQuadric);
+    decimater.module(hModQuadric).unset_max_err();
+    decimater.initialize();
+    n_collapses = decimater.decimate_to_lods(n_faces, lods);
+  }
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Decimater, lod_chain_repeated)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>           Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT<Mesh>::Handle  HModQuadric;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // same levels as Decimater/lod_chain, each decimated from a copy
+  state.start();
+  size_t n_collapses = 0;
+  for (size_t i = 1; i <= 5; ++i)
+  {
+    Mesh        copy(mesh);
+    Decimater   decimater(copy);
+    HModQuadric hModQuadric;
+    decimater.add(hModQuadric);
+    decimater.module(hModQuadric).unset_max_err();
+    decimater.initialize();
+    n_collapses = decimater.decimate_to_faces(0, mesh.n_faces() >> i);
+    copy.garbage_collection();
+  }
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+namespace {
+
+class QuadricSetup : public OpenMesh::Decimater::PartitionDecimaterT<Mesh>::Setup
+{
+public:
+  void add_modules(OpenMesh::Decimater::DecimaterT<Mesh>& _decimater)
+  {
+    OpenMesh::Decimater::ModQuadricT<Mesh>::Handle hModQuadric;
+    _decimater.add(hModQuadric);
+    _decimater.module(hModQuadric).unset_max_err();
+  }
+};
+
+}
+
+
+OM_BENCHMARK(Decimater, partitioned)
+{
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // same target as Decimater/quadric, in 8 chunks
+  state.start();
+  size_t n_collapses;
+  {
+    OpenMesh::Decimater::PartitionDecimaterT<Mesh> decimater(mesh);
+    QuadricSetup setup;
+    decimater.set_n_chunks(8);
+    n_collapses = decimater.decimate_to_faces(mesh.n_faces() / 10, setup);
+  }
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Decimater, hausdorff)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>             Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT<Mesh>::Handle    HModQuadric;
+  typedef OpenMesh::Decimater::ModHausdorffT<Mesh>::Handle  HModHausdorff;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // decimate to 2% of the vertices, so that many removed points end up in
+  // the point list of each remaining face
+  state.start();
+  size_t n_collapses;
+  {
+    Decimater     decimater(mesh);
+    HModQuadric   hModQuadric;
+    HModHausdorff hModHausdorff;
+    decimater.add(hModQuadric);
+    decimater.add(hModHausdorff);
+    decimater.module(hModQuadric).unset_max_err();
+    decimater.module(hModHausdorff).set_tolerance(0.1f);
+    decimater.initialize();
+    n_collapses = decimater.decimate_to(mesh.n_vertices() / 50);
+  }
+  mesh.garbage_collection();
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Decimater, normal_deviation)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>                   Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT<Mesh>::Handle          HModQuadric;
+  typedef OpenMesh::Decimater::ModNormalDeviationT<Mesh>::Handle  HModNormalDeviation;
+
+  Mesh mesh;
+  mesh.request_face_normals();
+  generate_torus(mesh, state.size());
+  mesh.update_face_normals();
+
+  // decimate to 10% of the vertices, the normal cones only limit the
+  // collapses late in the decimation
+  state.start();
+  size_t n_collapses;
+  {
+    Decimater           decimater(mesh);
+    HModQuadric         hModQuadric;
+    HModNormalDeviation hModNormalDeviation;
+    decimater.add(hModQuadric);
+    decimater.add(hModNormalDeviation);
+    decimater.module(hModQuadric).unset_max_err();
+    decimater.module(hModNormalDeviation).set_normal_deviation(60.0f);
+    decimater.initialize();
+    n_collapses = decimater.decimate_to(mesh.n_vertices() / 10);
+  }
+  mesh.garbage_collection();
+  state.stop();
+
+  state.set_items(n_collapses);
+}
+
+
+OM_BENCHMARK(Decimater, vertex_clustering_mean)
+{
+  typedef OpenMesh::Decimater::VertexClusteringT<Mesh> VertexClustering;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  // a far level of detail, items are the faces of the input
+  state.start();
+  {
+    Mesh             out;
+    VertexClustering clustering(mesh);
+    clustering.set_grid_size(32);
+    clustering.set_representative(VertexClustering::Mean);
+    clustering.simplify(out);
+  }
+  state.stop();
+
+  state.set_items(mesh.n_faces());
+}
+
+
+OM_BENCHMARK(Decimater, vertex_clustering_quadric)
+{
+  typedef OpenMesh::Decimater::VertexClusteringT<Mesh> VertexClustering;
+
+  Mesh mesh;
+  generate_torus(mesh, state.size());
+
+  state.start();
+  {
+    Mesh             out;
+    VertexClustering clustering(mesh);
+    clustering.set_grid_size(32);
+    clustering.set_representative(VertexClustering::Quadric);
+    clustering.simplify(out);
+  }
+  state.stop();
+
+  state.set_items(mesh.n_faces());
+}
+
+
+// -------------------------------------------------------- progressive mesh --
+
+OM_BENCHMARK(ProgMesh, switch_lod)
+{
+  typedef OpenMesh::Decimater::DecimaterT<Mesh>            Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT<Mesh>::Handle   HModQuadric;
+  typedef OpenMesh::Decimater::ModProgMeshT<Mesh>::Handle  HModProgMesh;
+
+  const std::string filename = "OpenMesh_benchmark_progmesh.pm";
+  {
+    Mesh mesh;
+    generate_torus(mesh, state.size());
+
+    Decimater    decimater(mesh);
+    HModQuadric  hModQuadric;
+    HModProgMesh hModProgMesh;
+    decimater.add(hModQuadric);
+    decimater.add(hModProgMesh);
+    decimater.initialize();
+    decimater.decimate(0);
+    decimater.module(hModProgMesh).write(filename);
+  }
+
+  OpenMesh::Decimater::ProgMesh pm;
+  bool ok = pm.read(filename);
+  std::remove(filename.c_str());
+
+  // switch between the base mesh and the full mesh 10 times
+  state.start();
+  for (int i = 0; ok && i < 10; ++i)
+  {
+    pm.set_lod(pm.n_details());
+    pm.set_lod(0);
+  }
+  state.stop();
+
+  state.set_items(ok ? 20 * size_t(pm.n_details()) : 0);
+}
+
+
+// ------------------------------------------------------------- subdividers --
+
+namespace {
+
+/// One step of a uniform subdivision of a mesh with state.size() faces
+template <class Subdivider>
+void benchmark_subdivider(BenchmarkState& _state, bool _quads = false)
+{
+  typename Subdivider::mesh_t mesh;
+  generate_torus(mesh, _state.size(), _quads);
+
+  Subdivider subdivider;
+
+  _state.start();
+  subdivider(mesh, 1);
+  _state.stop();
+
+  _state.set_items(mesh.n_faces());
+}
+
+} // namespace
+
+
+OM_BENCHMARK(Subdivider, loop)
+{
+  benchmark_subdivider< OpenMesh::Subdivider::Uniform::LoopT<Mesh> >(state);
+}
+
+
+OM_BENCHMARK(Subdivider, sqrt3)
+{
+  benchmark_subdivider< OpenMesh::Subdivider::Uniform::Sqrt3T<Mesh> >(state);
+}
+
+
+OM_BENCHMARK(Subdivider, modified_butterfly)
+{
+  benchmark_subdivider< OpenMesh::Subdivider::Uniform::ModifiedButterflyT<Mesh> >(state);
+}
+
+
+OM_BENCHMARK(Subdivider, interpolating_sqrt3)
+{
+  benchmark_subdivider< OpenMesh::Subdivider::Uniform::InterpolatingSqrt3LGT<Mesh> >(state);
+}
+
+
+OM_BENCHMARK(Subdivider, catmull_clark)
+{
+  benchmark_subdivider< OpenMesh::Subdivider::Uniform::CatmullClarkT<PolyMesh> >(state, true);
+}
@@ -0,0 +1,140 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file generate_torus.hh
+
+    Deterministic procedural input meshes for the benchmarks.
+*/
+
+#ifndef INCLUDE_GENERATE_TORUS_HH
+#define INCLUDE_GENERATE_TORUS_HH
+
+#include <cmath>
+#include <vector>
+//
+#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+#include <OpenMesh/Core/Mesh/PolyMesh_ArrayKernelT.hh>
+
+
+typedef OpenMesh::TriMesh_ArrayKernelT<>  Mesh;
+typedef OpenMesh::PolyMesh_ArrayKernelT<> PolyMesh;
+
+
+/** Generate a closed torus with about _n_faces faces.
+
+    The torus is a grid of quads (twice as many around the main axis as
+    around the tube), which are split into two triangles each unless
+    _quads is set. The vertices are displaced by a small pseudo-random
+    offset from a fixed seed, so the result is identical in every run but
+    has no symmetric ties that would make decimation unrealistically
+    regular.
+*/
+template <class MeshT>
+void generate_torus(MeshT& _mesh, size_t _n_faces, bool _quads = false)
+{
+  typedef typename MeshT::Point        Point;
+  typedef typename MeshT::Scalar       Scalar;
+  typedef typename MeshT::VertexHandle VertexHandle;
+
+  const double pi = 3.14159265358979323846;
+
+  // n_u = 2 n_v quads, two triangles per quad
+  size_t n_v = size_t(std::sqrt(double(_n_faces) / (_quads ? 2.0 : 4.0)) + 0.5);
+  if (n_v < 3)
+    n_v = 3;
+  size_t n_u = 2 * n_v;
+
+  _mesh.clear();
+  _mesh.reserve(n_u * n_v, 2 * n_u * n_v + (_quads ? 0 : n_u * n_v),
+                (_quads ? 1 : 2) * n_u * n_v);
+
+  unsigned int seed = 12345u;
+
+  std::vector<VertexHandle> vhandles(n_u * n_v);
+  for (size_t i = 0; i < n_u; ++i)
+  {
+    double u = 2.0 * pi * double(i) / double(n_u);
+    for (size_t j = 0; j < n_v; ++j)
+    {
+      double v = 2.0 * pi * double(j) / double(n_v);
+
+      // linear congruential generator, noise in [-0.01, 0.01]
+      seed = seed * 1103515245u + 12345u;
+      double noise = 0.02 * (double((seed >> 16) & 0x7fff) / 32767.0 - 0.5);
+
+      double r = 0.25 + noise;
+      vhandles[i * n_v + j] = _mesh.add_vertex(Point(
+          Scalar((1.0 + r * std::cos(v)) * std::cos(u)),
+          Scalar((1.0 + r * std::cos(v)) * std::sin(u)),
+          Scalar(r * std::sin(v))));
+    }
+  }
+
+  std::vector<VertexHandle> face;
+  for (size_t i = 0; i < n_u; ++i)
+  {
+    size_t i1 = (i + 1) % n_u;
+    for (size_t j = 0; j < n_v; ++j)
+    {
+      size_t j1 = (j + 1) % n_v;
+      VertexHandle v00 = vhandles[i  * n_v + j ];
+      VertexHandle v10 = vhandles[i1 * n_v + j ];
+      VertexHandle v11 = vhandles[i1 * n_v + j1];
+      VertexHandle v01 = vhandles[i  * n_v + j1];
+
+      face.clear();
+      if (_quads)
+      {
+        face.push_back(v00); face.push_back(v10);
+        face.push_back(v11); face.push_back(v01);
+        _mesh.add_face(face);
+      }
+      else
+      {
+        _mesh.add_face(v00, v10, v11);
+        _mesh.add_face(v00, v11, v01);
+      }
+    }
+  }
+}
+
+
+#endif // INCLUDE_GENERATE_TORUS_HH
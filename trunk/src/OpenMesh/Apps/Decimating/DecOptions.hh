@@ -0,0 +1,249 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+#ifndef DECOPTIONS_HH
+#define DECOPTIONS_HH
+
+#include <sstream>
+#include <string>
+//
+#include <OpenMesh/Tools/Decimater/ModAspectRatioT.hh>
+#include <OpenMesh/Tools/Decimater/ModEdgeLengthT.hh>
+#include <OpenMesh/Tools/Decimater/ModHausdorffT.hh>
+#include <OpenMesh/Tools/Decimater/ModNormalDeviationT.hh>
+#include <OpenMesh/Tools/Decimater/ModNormalFlippingT.hh>
+#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
+#include <OpenMesh/Tools/Decimater/ModProgMeshT.hh>
+#include <OpenMesh/Tools/Decimater/ModIndependentSetsT.hh>
+#include <OpenMesh/Tools/Decimater/ModRoundnessT.hh>
+//
+#include "CmdOption.hh"
+
+
+//--------------------------------------------------- decimater arguments  ----
+
+struct DecOptions
+{
+  DecOptions()
+  : n_collapses(0)
+  { }
+
+  CmdOption<bool>        decorate_name;
+  CmdOption<float>       n_collapses;
+  CmdOption<int>         n_chunks;
+
+  CmdOption<float>       AR;   // Aspect ratio
+  CmdOption<float>       EL;   // Edge length
+  CmdOption<float>       HD;   // Hausdorff distance
+  CmdOption<bool>        IS;   // Independent Sets
+  CmdOption<float>       ND;   // Normal deviation
+  CmdOption<float>       NF;   // Normal flipping
+  CmdOption<std::string> PM;   // Progressive Mesh
+  CmdOption<float>       Q;    // Quadrics
+  CmdOption<float>       QO;   // Quadrics with optimal placement
+  CmdOption<float>       R;    // Roundness
+
+  template <typename T>
+  bool init( CmdOption<T>& _o, const std::string& _val )
+  {
+    if ( _val.empty() )
+      _o.enable();
+    else
+    {
+      std::istringstream istr( _val );
+
+      T v;
+
+      if ( (istr >> v).fail() )
+        return false;
+
+      _o = v;
+    }
+    return true;
+  }
+
+
+  bool parse_argument( const std::string& arg )
+  {
+    std::string::size_type pos = arg.find(':');
+
+    std::string name;
+    std::string value;
+
+    if (pos == std::string::npos)
+      name = arg;
+    else
+    {
+      name  = arg.substr(0, pos);
+      value = arg.substr(pos+1, arg.size());
+    }
+    strip(name);
+    strip(value);
+
+    if (name == "AR") return init(AR, value);
+    if (name == "EL") return init(EL, value);
+    if (name == "HD") return init(HD, value);
+    if (name == "IS") return init(IS, value);
+    if (name == "ND") return init(ND, value);
+    if (name == "NF") return init(NF, value);
+    if (name == "PM") return init(PM, value);
+    if (name == "Q")  return init(Q,  value);
+    if (name == "QO") return init(QO, value);
+    if (name == "R")  return init(R,  value);
+    return false;
+  }
+
+  std::string& strip(std::string & line)
+  {
+    std::string::size_type pos = 0;
+
+    pos = line.find_last_not_of(" \t");
+
+    if ( pos!=0 && pos!=std::string::npos )
+    {
+      ++pos;
+      line.erase( pos, line.length()-pos );
+    }
+
+    pos = line.find_first_not_of(" \t");
+    if ( pos!=0 && pos!=std::string::npos )
+    {
+      line.erase(0,pos);
+    }
+
+    return line;
+  }
+
+};
+
+
+//------------------------------------------------------ decimater modules ----
+
+/// Handles of all modules that can be selected with DecOptions
+template <typename Mesh>
+struct DecModules
+{
+  typename OpenMesh::Decimater::ModAspectRatioT<Mesh>::Handle     AR;
+  typename OpenMesh::Decimater::ModEdgeLengthT<Mesh>::Handle      EL;
+  typename OpenMesh::Decimater::ModHausdorffT<Mesh>::Handle       HD;
+  typename OpenMesh::Decimater::ModIndependentSetsT<Mesh>::Handle IS;
+  typename OpenMesh::Decimater::ModNormalDeviationT<Mesh>::Handle ND;
+  typename OpenMesh::Decimater::ModNormalFlippingT<Mesh>::Handle  NF;
+  typename OpenMesh::Decimater::ModProgMeshT<Mesh>::Handle        PM;
+  typename OpenMesh::Decimater::ModQuadricT<Mesh>::Handle         Q;
+  typename OpenMesh::Decimater::ModRoundnessT<Mesh>::Handle       R;
+
+  /// Register and parameterize the modules enabled in _opt
+  template <typename DecimaterType>
+  void add(DecimaterType& _decimater, const DecOptions& _opt)
+  {
+    if (_opt.AR.is_enabled())
+    {
+      _decimater.add(AR);
+      if (_opt.AR.has_value())
+        _decimater.module( AR ).set_aspect_ratio( _opt.AR ) ;
+    }
+
+    if (_opt.EL.is_enabled())
+    {
+      _decimater.add(EL);
+      if (_opt.EL.has_value())
+        _decimater.module( EL ).set_edge_length( _opt.EL ) ;
+      _decimater.module(EL).set_binary(false);
+    }
+
+    if (_opt.HD.is_enabled())
+    {
+      _decimater.add(HD);
+      if (_opt.HD.has_value())
+        _decimater.module( HD ).set_tolerance( _opt.HD ) ;
+    }
+
+    if ( _opt.IS.is_enabled() )
+      _decimater.add(IS);
+
+    if (_opt.ND.is_enabled())
+    {
+      _decimater.add(ND);
+      if (_opt.ND.has_value())
+        _decimater.module( ND ).set_normal_deviation( _opt.ND );
+      _decimater.module( ND ).set_binary(false);
+    }
+
+    if (_opt.NF.is_enabled())
+    {
+      _decimater.add(NF);
+      if (_opt.NF.has_value())
+        _decimater.module( NF ).set_max_normal_deviation( _opt.NF );
+    }
+
+    if ( _opt.PM.is_enabled() )
+      _decimater.add(PM);
+
+    if (_opt.Q.is_enabled())
+    {
+      _decimater.add(Q);
+      if (_opt.Q.has_value())
+        _decimater.module( Q ).set_max_err( _opt.Q );
+      _decimater.module(Q).set_binary(false);
+    }
+    else if (_opt.QO.is_enabled()) // the applications reject Q with QO
+    {
+      _decimater.add(Q);
+      if (_opt.QO.has_value())
+        _decimater.module( Q ).set_max_err( _opt.QO );
+      _decimater.module(Q).set_binary(false);
+      _decimater.module(Q).set_optimal_placement(true);
+    }
+
+    if ( _opt.R.is_enabled() )
+    {
+      _decimater.add( R );
+      if ( _opt.R.has_value() )
+        _decimater.module( R ).set_min_angle( _opt.R,
+            !Q.is_valid() ||
+            !_decimater.module(Q).is_binary());
+    }
+  }
+};
+
+
+#endif // DECOPTIONS_HH
@@ -0,0 +1,19 @@
+################################################################################
+#
+################################################################################
+
+include( $$TOPDIR/qmake/all.include )
+
+INCLUDEPATH += ../../..
+
+Application()
+glew()
+glut()
+openmesh()
+
+DIRECTORIES = .. 
+
+# Input
+SOURCES += ../batchdecimater.cc
+
+################################################################################
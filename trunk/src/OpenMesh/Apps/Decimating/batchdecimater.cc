@@ -0,0 +1,953 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+//--------------------
+#ifdef USE_OPENMP
+#  include <omp.h>
+#  if defined(_WIN32)
+#    include <windows.h>
+#  else
+#    include <pthread.h>
+#  endif
+#endif
+//--------------------
+#include <OpenMesh/Core/IO/MeshIO.hh>
+#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+//--------------------
+#include <OpenMesh/Tools/Utils/getopt.h>
+#include <OpenMesh/Tools/Utils/Timer.hh>
+#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
+#include <OpenMesh/Tools/Decimater/Observer.hh>
+
+//------------------------------------------------------------------- mesh ----
+
+typedef OpenMesh::TriMesh_ArrayKernelT<>          Mesh;
+typedef OpenMesh::Decimater::DecimaterT<Mesh>     Decimater;
+
+
+//--------------------------------------------------------------- forwards ----
+
+void usage_and_exit(int xcode);
+
+
+//--------------------------------------------------- decimater arguments  ----
+
+#include "DecOptions.hh"
+
+
+//------------------------------------------------------------------- jobs ----
+
+/// One entry of the job manifest
+struct Job
+{
+  Job()
+  : id(0), n_collapses(0.0f), decorate_name(false), timeout(0.0),
+    input_size(0), ok(false), timed_out(false), collapses(0),
+    n_vertices(0), n_faces(0), memory(0), seconds(0.0)
+  { }
+
+  size_t                   id;
+  std::string              input;
+  std::string              output;
+  std::vector<std::string> modules;
+  float                    n_collapses;
+  bool                     decorate_name;
+  double                   timeout;
+
+  // results
+  size_t                   input_size;
+  bool                     ok;
+  bool                     timed_out;
+  std::string              error;
+  size_t                   collapses;
+  size_t                   n_vertices;
+  size_t                   n_faces;
+  size_t                   memory;
+  double                   seconds;
+};
+
+
+bool larger_input(const Job& _a, const Job& _b)
+{
+  return _a.input_size > _b.input_size;
+}
+
+
+std::string extension(const std::string& _filename)
+{
+  std::string::size_type pos = _filename.rfind('.');
+  if (pos == std::string::npos)
+    return std::string();
+  std::string ext = _filename.substr(pos+1);
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext;
+}
+
+
+size_t file_size(const std::string& _filename)
+{
+  std::ifstream ifs(_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!ifs)
+    return 0;
+  ifs.seekg(0, std::ios::end);
+  return static_cast<size_t>(ifs.tellg());
+}
+
+
+/** Parse a job manifest.
+
+    Each line describes one job:
+
+      <input> <output> [-n <N>] [-M <module>]... [-D] [-t <seconds>]
+
+    The options have the same meaning as on the command line. Jobs without
+    -M or -n use the defaults given in _defaults. Empty lines and lines
+    starting with '#' are ignored.
+*/
+bool parse_manifest(std::istream& _is, const Job& _defaults,
+                    std::vector<Job>& _jobs)
+{
+  std::string line;
+  size_t      line_no = 0;
+
+  while (std::getline(_is, line))
+  {
+    ++line_no;
+
+    std::istringstream tokens(line);
+    std::string        token;
+    Job                job = _defaults;
+
+    if (!(tokens >> job.input) || job.input[0] == '#')
+      continue;
+
+    bool ok = bool(tokens >> job.output);
+    bool has_modules = false;
+
+    while (ok && tokens >> token)
+    {
+      if (token == "-n")
+        ok = bool(tokens >> job.n_collapses);
+      else if (token == "-t")
+        ok = bool(tokens >> job.timeout);
+      else if (token == "-D")
+        job.decorate_name = true;
+      else if (token == "-M" && (tokens >> token))
+      {
+        if (!has_modules)
+          job.modules.clear();
+        has_modules = true;
+        job.modules.push_back(token);
+      }
+      else
+        ok = false;
+    }
+
+    if (!ok)
+    {
+      std::cerr << "manifest line " << line_no << ": cannot parse '"
+                << line << "'" << std::endl;
+      return false;
+    }
+
+    job.id = _jobs.size();
+    _jobs.push_back(job);
+  }
+
+  return true;
+}
+
+
+//------------------------------------------------------------- reporting ----
+
+std::string json_string(const std::string& _s)
+{
+  std::string out = "\"";
+  for (size_t i = 0; i < _s.size(); ++i)
+  {
+    switch (_s[i])
+    {
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n";  break;
+      case '\t': out += "\\t";  break;
+      default:   out += _s[i];
+    }
+  }
+  return out + "\"";
+}
+
+
+/// Print one line of machine readable progress (JSON) to stdout.
+void emit(const std::ostringstream& _line)
+{
+#ifdef USE_OPENMP
+#pragma omp critical (batchdecimater_emit)
+#endif
+  std::cout << "{" << _line.str() << "}" << std::endl;
+}
+
+
+/** Reports the progress of a decimation.
+
+    Each notification emits the number of collapses so far. If the job has
+    a time limit the decimation is aborted as soon as it is exceeded.
+*/
+class ProgressObserver : public OpenMesh::Decimater::Observer
+{
+public:
+
+  ProgressObserver(size_t _interval, const Job& _job, size_t _n_vertices)
+  : OpenMesh::Decimater::Observer(_interval),
+    job_(_job), n_vertices_(_n_vertices), aborted_(false)
+  {
+    timer_.start();
+  }
+
+  virtual void notify(size_t _step)
+  {
+    std::ostringstream line;
+    line << "\"event\":\"progress\",\"job\":" << job_.id
+         << ",\"collapses\":" << _step
+         << ",\"vertices\":" << n_vertices_ - _step;
+    emit(line);
+  }
+
+  virtual bool abort() const
+  {
+    if (job_.timeout <= 0.0)
+      return false;
+
+    timer_.stop();
+    double seconds = timer_.seconds();
+    timer_.cont();
+    if (seconds > job_.timeout)
+      aborted_ = true;
+    return aborted_;
+  }
+
+  /// True if the decimation was stopped by the time limit
+  bool aborted() const { return aborted_; }
+
+private:
+
+  const Job&                     job_;
+  size_t                         n_vertices_;
+  mutable OpenMesh::Utils::Timer timer_;
+  mutable bool                   aborted_;
+};
+
+
+//---------------------------------------------------------------- locking ----
+
+/// One lock per reader and writer format, since the IO modules keep
+/// per-file state. Without OpenMP all operations are no-ops.
+class FormatLocks
+{
+public:
+
+  FormatLocks(const std::vector<Job>& _jobs)
+  {
+#ifdef USE_OPENMP
+    for (size_t i = 0; i < _jobs.size(); ++i)
+    {
+      init("r." + extension(_jobs[i].input));
+      init("w." + extension(_jobs[i].output));
+    }
+#else
+    (void)_jobs;
+#endif
+  }
+
+  ~FormatLocks()
+  {
+#ifdef USE_OPENMP
+    for (LockMap::iterator it = locks_.begin(); it != locks_.end(); ++it)
+    {
+      omp_destroy_lock(it->second);
+      delete it->second;
+    }
+#endif
+  }
+
+  void set(const std::string& _key)
+  {
+#ifdef USE_OPENMP
+    omp_set_lock(locks_.find(_key)->second);
+#else
+    (void)_key;
+#endif
+  }
+
+  void unset(const std::string& _key)
+  {
+#ifdef USE_OPENMP
+    omp_unset_lock(locks_.find(_key)->second);
+#else
+    (void)_key;
+#endif
+  }
+
+private:
+
+#ifdef USE_OPENMP
+  typedef std::map<std::string, omp_lock_t*> LockMap;
+
+  void init(const std::string& _key)
+  {
+    if (locks_.find(_key) == locks_.end())
+    {
+      omp_lock_t* lock = new omp_lock_t;
+      omp_init_lock(lock);
+      locks_[_key] = lock;
+    }
+  }
+
+  LockMap locks_;
+#endif
+};
+
+
+//---------------------------------------------------------- memory budget ----
+
+/** Bounds the memory of all meshes that are held by the workers.
+
+    A reservation is granted if it fits into the budget or if nothing else
+    is reserved, so a single job that is larger than the budget still runs
+    (alone). A budget of 0 is unlimited. Workers that keep warm allocations
+    give them back while others are waiting. Waiting workers sleep on a
+    condition variable that is signalled whenever memory is released.
+*/
+class MemoryBudget
+{
+public:
+
+  MemoryBudget(size_t _budget) : budget_(_budget), reserved_(0), waiting_(0)
+  {
+#if defined(USE_OPENMP) && defined(_WIN32)
+    InitializeCriticalSection(&mutex_);
+    InitializeConditionVariable(&released_);
+#elif defined(USE_OPENMP)
+    pthread_mutex_init(&mutex_, NULL);
+    pthread_cond_init(&released_, NULL);
+#endif
+  }
+
+  ~MemoryBudget()
+  {
+#if defined(USE_OPENMP) && defined(_WIN32)
+    DeleteCriticalSection(&mutex_);
+#elif defined(USE_OPENMP)
+    pthread_cond_destroy(&released_);
+    pthread_mutex_destroy(&mutex_);
+#endif
+  }
+
+  /// Reserve if possible. Only waiting workers are served while there are any.
+  bool try_reserve(size_t _bytes)
+  {
+    lock();
+    bool ok = waiting_ == 0 && fits(_bytes);
+    if (ok)
+      reserved_ += _bytes;
+    unlock();
+    return ok;
+  }
+
+  /// Block until the reservation is granted.
+  void reserve(size_t _bytes)
+  {
+    lock();
+    ++waiting_;
+    while (!fits(_bytes))
+      wait();
+    reserved_ += _bytes;
+    --waiting_;
+    unlock();
+  }
+
+  /// Are workers waiting for memory?
+  bool has_waiters()
+  {
+    lock();
+    bool waiters = waiting_ > 0;
+    unlock();
+    return waiters;
+  }
+
+  /// Reserve without checking the budget (the memory is already in use)
+  void grow(size_t _bytes)
+  {
+    lock();
+    reserved_ += _bytes;
+    unlock();
+  }
+
+  void release(size_t _bytes)
+  {
+    lock();
+    reserved_ -= _bytes;
+    notify_all();
+    unlock();
+  }
+
+  size_t budget() const { return budget_; }
+
+private:
+
+  bool fits(size_t _bytes) const
+  {
+    return budget_ == 0 || reserved_ == 0 || reserved_ + _bytes <= budget_;
+  }
+
+  // Without OpenMP there is a single worker, which has released all of its
+  // memory before it waits, so its reservation always fits.
+#if defined(USE_OPENMP) && defined(_WIN32)
+  void lock()       { EnterCriticalSection(&mutex_); }
+  void unlock()     { LeaveCriticalSection(&mutex_); }
+  void wait()       { SleepConditionVariableCS(&released_, &mutex_, INFINITE); }
+  void notify_all() { WakeAllConditionVariable(&released_); }
+  CRITICAL_SECTION   mutex_;
+  CONDITION_VARIABLE released_;
+#elif defined(USE_OPENMP)
+  void lock()       { pthread_mutex_lock(&mutex_); }
+  void unlock()     { pthread_mutex_unlock(&mutex_); }
+  void wait()       { pthread_cond_wait(&released_, &mutex_); }
+  void notify_all() { pthread_cond_broadcast(&released_); }
+  pthread_mutex_t mutex_;
+  pthread_cond_t  released_;
+#else
+  void lock()       { }
+  void unlock()     { }
+  void wait()       { }
+  void notify_all() { }
+#endif
+
+  size_t budget_;
+  size_t reserved_;
+  size_t waiting_;
+};
+
+
+/// Memory of the mesh items and all properties in bytes
+size_t mesh_memory(const Mesh& _mesh)
+{
+  // kernel items: a halfedge handle per vertex and face, two halfedges
+  // (face, vertex, next and prev handles) per edge
+  size_t bytes = 4 * _mesh.n_vertices() + 32 * _mesh.n_edges()
+               + 4 * _mesh.n_faces();
+
+  Mesh::const_prop_iterator it;
+  for (it = _mesh.vprops_begin(); it != _mesh.vprops_end(); ++it)
+    if (*it) bytes += (*it)->size_of();
+  for (it = _mesh.hprops_begin(); it != _mesh.hprops_end(); ++it)
+    if (*it) bytes += (*it)->size_of();
+  for (it = _mesh.eprops_begin(); it != _mesh.eprops_end(); ++it)
+    if (*it) bytes += (*it)->size_of();
+  for (it = _mesh.fprops_begin(); it != _mesh.fprops_end(); ++it)
+    if (*it) bytes += (*it)->size_of();
+
+  return bytes;
+}
+
+
+//----------------------------------------------------------------- worker ----
+
+/** Decimates jobs on one thread.
+
+    The mesh and, for jobs with the same modules, the decimater are reused
+    between jobs, so their allocations stay warm. The memory they hold is
+    reserved in the budget until the worker has to make room for a larger
+    job.
+*/
+class Worker
+{
+public:
+
+  Worker(MemoryBudget& _budget, FormatLocks& _locks, size_t _interval)
+  : budget_(_budget), locks_(_locks), interval_(_interval),
+    decimater_(NULL), modules_(NULL), reserved_(0)
+  {
+    mesh_.request_face_normals();
+  }
+
+  ~Worker()
+  {
+    trim();
+  }
+
+  void run(Job& _job, double _ratio)
+  {
+    OpenMesh::Utils::Timer timer;
+    timer.start();
+
+    std::ostringstream line;
+    line << "\"event\":\"start\",\"job\":" << _job.id
+         << ",\"input\":" << json_string(_job.input);
+    emit(line);
+
+    if (decimate(_job, _ratio))
+      _job.ok = true;
+
+    timer.stop();
+    _job.seconds = timer.seconds();
+
+    line.str("");
+    if (_job.ok)
+    {
+      line << "\"event\":\"done\",\"job\":" << _job.id
+           << ",\"output\":" << json_string(_job.output)
+           << ",\"collapses\":" << _job.collapses
+           << ",\"vertices\":" << _job.n_vertices
+           << ",\"faces\":" << _job.n_faces
+           << ",\"memory\":" << _job.memory
+           << ",\"seconds\":" << _job.seconds;
+    }
+    else if (_job.timed_out)
+    {
+      line << "\"event\":\"timeout\",\"job\":" << _job.id
+           << ",\"collapses\":" << _job.collapses
+           << ",\"seconds\":" << _job.seconds;
+    }
+    else
+    {
+      line << "\"event\":\"error\",\"job\":" << _job.id
+           << ",\"message\":" << json_string(_job.error);
+    }
+    emit(line);
+
+    if (budget_.has_waiters())
+      trim();
+  }
+
+private:
+
+  bool decimate(Job& _job, double _ratio)
+  {
+    DecOptions opt;
+    opt.n_collapses = _job.n_collapses;
+    if (_job.decorate_name)
+      opt.decorate_name = true;
+
+    std::vector<std::string> modules(_job.modules);
+    std::sort(modules.begin(), modules.end());
+
+    std::string config;
+    for (size_t i = 0; i < modules.size(); ++i)
+    {
+      if (!opt.parse_argument(modules[i]))
+      {
+        _job.error = "unknown module " + modules[i];
+        return false;
+      }
+      config += modules[i] + " ";
+    }
+
+    if ( (-1.0f < opt.n_collapses) && (opt.n_collapses < 0.0f) )
+    {
+      _job.error = "invalid target";
+      return false;
+    }
+
+    if ( opt.Q.is_enabled() && opt.QO.is_enabled() )
+    {
+      _job.error = "modules Q and QO cannot be used together";
+      return false;
+    }
+
+    // ---- wait for enough memory
+    reserve(size_t(double(_job.input_size) * _ratio));
+
+    // ---- read (into the warm mesh)
+    OpenMesh::IO::Options ropt;
+    std::string key = "r." + extension(_job.input);
+    bool rc;
+
+    mesh_.resize(0, 0, 0);
+    locks_.set(key);
+    rc = OpenMesh::IO::read_mesh(mesh_, _job.input, ropt, false);
+    locks_.unset(key);
+    if (!rc)
+    {
+      _job.error = "read failed";
+      return false;
+    }
+
+    if ( !ropt.check( OpenMesh::IO::Options::FaceNormal ) )
+      mesh_.update_face_normals();
+
+    // ---- set up the decimater unless the previous job used the same
+    //      modules (the progressive mesh module collects data per mesh)
+    if (!decimater_ || config != config_ || opt.PM.is_enabled())
+    {
+      delete decimater_;
+      delete modules_;
+      decimater_ = new Decimater(mesh_);
+      modules_   = new DecModules<Mesh>;
+      modules_->add(*decimater_, opt);
+      config_    = config;
+    }
+    else
+      decimater_->reset();
+
+    if (!decimater_->initialize())
+    {
+      _job.error = "initializing failed (none or more than one priority module, "
+                   "or QO with other modules)";
+      delete decimater_; decimater_ = NULL;
+      delete modules_;   modules_   = NULL;
+      return false;
+    }
+
+    // the memory used now is the peak of this job
+    _job.memory = mesh_memory(mesh_);
+    if (_job.memory > reserved_)
+    {
+      budget_.grow(_job.memory - reserved_);
+      reserved_ = _job.memory;
+    }
+
+    // ---- decimate
+    ProgressObserver observer(interval_, _job, mesh_.n_vertices());
+    decimater_->set_observer(&observer);
+
+    if (opt.n_collapses < 0.0)
+      _job.collapses = decimater_->decimate_to( size_t(-opt.n_collapses) );
+    else if (opt.n_collapses >= 1.0 || opt.n_collapses == 0.0)
+      _job.collapses = decimater_->decimate( size_t(opt.n_collapses) );
+    else if (opt.n_collapses > 0.0f)
+      _job.collapses = decimater_->decimate_to(size_t(mesh_.n_vertices()*opt.n_collapses));
+
+    decimater_->set_observer(NULL);
+
+    // a partially decimated mesh is not written
+    if (observer.aborted())
+    {
+      _job.timed_out = true;
+      _job.error     = "time limit exceeded";
+      return false;
+    }
+
+    if ( opt.PM.has_value() )
+      decimater_->module(modules_->PM).write( opt.PM );
+
+    mesh_.garbage_collection();
+
+    _job.n_vertices = mesh_.n_vertices();
+    _job.n_faces    = mesh_.n_faces();
+
+    // ---- write
+    std::string ofname(_job.output);
+
+    if ( _job.decorate_name )
+    {
+      std::string::size_type pos = ofname.rfind('.');
+      std::stringstream s; s << "-" << mesh_.n_vertices();
+      ofname.insert(pos == std::string::npos ? ofname.size() : pos, s.str());
+    }
+    _job.output = ofname;
+
+    key = "w." + extension(_job.output);
+    locks_.set(key);
+    rc = OpenMesh::IO::write_mesh(mesh_, ofname);
+    locks_.unset(key);
+    if (!rc)
+    {
+      _job.error = "write failed";
+      return false;
+    }
+
+    return true;
+  }
+
+  /// Make sure that at least _bytes are reserved for this worker.
+  void reserve(size_t _bytes)
+  {
+    if (_bytes <= reserved_)
+      return;
+
+    if (budget_.try_reserve(_bytes - reserved_))
+    {
+      reserved_ = _bytes;
+      return;
+    }
+
+    // give back the warm memory and wait for other jobs to finish
+    trim();
+    budget_.reserve(_bytes);
+    reserved_ = _bytes;
+  }
+
+public:
+
+  /// Free the warm allocations and their reservation.
+  void trim()
+  {
+    delete decimater_; decimater_ = NULL;
+    delete modules_;   modules_   = NULL;
+    mesh_.clear();
+    budget_.release(reserved_);
+    reserved_ = 0;
+  }
+
+private:
+
+  MemoryBudget&     budget_;
+  FormatLocks&      locks_;
+  size_t            interval_;
+
+  Mesh              mesh_;
+  Decimater*        decimater_;
+  DecModules<Mesh>* modules_;
+  std::string       config_;
+  size_t            reserved_;
+};
+
+
+//------------------------------------------------------------------ main -----
+
+int main(int argc, char* argv[])
+{
+  Job    defaults;
+  size_t budget_mb = 0;
+  size_t interval  = 1000;
+  int    n_threads = 0;
+
+  //---------------------------------------- parse command line
+  {
+    int c;
+
+    while ( (c=getopt( argc, argv, "Dhj:m:M:n:p:t:")) != -1 )
+    {
+      switch (c)
+      {
+        case 'D': defaults.decorate_name = true;                   break;
+        case 'h': usage_and_exit(0);
+        case 'j': n_threads            = atoi(optarg);             break;
+        case 'm': budget_mb            = size_t(atol(optarg));     break;
+        case 'M': defaults.modules.push_back(optarg);              break;
+        case 'n': defaults.n_collapses = float(atof(optarg));      break;
+        case 'p': interval             = size_t(atol(optarg));     break;
+        case 't': defaults.timeout     = atof(optarg);             break;
+        case '?':
+        default:
+          usage_and_exit(1);
+      }
+    }
+  }
+
+  if (optind >= argc || interval == 0)
+    usage_and_exit(1);
+
+  if (defaults.modules.empty())
+    defaults.modules.push_back("Q");
+
+  //---------------------------------------- read the manifest
+  std::vector<Job> jobs;
+  {
+    std::string manifest(argv[optind]);
+    bool        rc;
+
+    if (manifest == "-")
+      rc = parse_manifest(std::cin, defaults, jobs);
+    else
+    {
+      std::ifstream ifs(manifest.c_str());
+      if (!ifs)
+      {
+        std::cerr << "Cannot open manifest " << manifest << std::endl;
+        return 1;
+      }
+      rc = parse_manifest(ifs, defaults, jobs);
+    }
+
+    if (!rc)
+      return 1;
+  }
+
+  for (size_t i = 0; i < jobs.size(); ++i)
+    jobs[i].input_size = file_size(jobs[i].input);
+
+  // large jobs first, so no thread is left with a large job at the end
+  std::stable_sort(jobs.begin(), jobs.end(), larger_input);
+
+  //---------------------------------------- decimate
+  OpenMesh::IO::IOManager();
+
+  MemoryBudget budget(budget_mb * 1024 * 1024);
+  FormatLocks  locks(jobs);
+
+  // memory per byte of input, learned per format from finished jobs
+  std::map<std::string, double> ratios;
+  const double default_ratio = 10.0;
+
+#ifdef USE_OPENMP
+  if (n_threads <= 0)
+    n_threads = omp_get_max_threads();
+#else
+  n_threads = 1;
+#endif
+
+  OpenMesh::Utils::Timer timer;
+  timer.start();
+
+  long n_jobs = long(jobs.size());
+
+#ifdef USE_OPENMP
+#pragma omp parallel num_threads(n_threads)
+#endif
+  {
+    Worker worker(budget, locks, interval);
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(dynamic) nowait
+#endif
+    for (long i = 0; i < n_jobs; ++i)
+    {
+      Job&        job = jobs[i];
+      std::string ext = extension(job.input);
+      double      ratio;
+
+#ifdef USE_OPENMP
+#pragma omp critical (batchdecimater_ratio)
+#endif
+      {
+        std::map<std::string, double>::iterator it = ratios.find(ext);
+        ratio = it == ratios.end() ? default_ratio : it->second;
+      }
+
+      worker.run(job, ratio);
+
+      if (job.ok && job.input_size > 0)
+      {
+#ifdef USE_OPENMP
+#pragma omp critical (batchdecimater_ratio)
+#endif
+        {
+          double measured = double(job.memory) / double(job.input_size);
+          std::map<std::string, double>::iterator it = ratios.find(ext);
+          if (it == ratios.end() || it->second < measured)
+            ratios[ext] = measured;
+        }
+      }
+    }
+
+    // no more jobs for this thread, let the others use its memory
+    worker.trim();
+  }
+
+  timer.stop();
+
+  //---------------------------------------- summary
+  size_t n_failed = 0, collapses = 0;
+  for (size_t i = 0; i < jobs.size(); ++i)
+  {
+    if (!jobs[i].ok)
+      ++n_failed;
+    collapses += jobs[i].collapses;
+  }
+
+  std::ostringstream line;
+  line << "\"event\":\"summary\",\"jobs\":" << jobs.size()
+       << ",\"failed\":" << n_failed
+       << ",\"collapses\":" << collapses
+       << ",\"threads\":" << n_threads
+       << ",\"seconds\":" << timer.seconds();
+  emit(line);
+
+  return n_failed ? 1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+void usage_and_exit(int xcode)
+{
+  std::cerr << "Usage: batchdecimater [Options] <manifest>\n"
+            << "  Decimate all jobs of the manifest (- reads from stdin)"
+            << " in parallel.\n" << std::endl;
+  std::cerr << "Each line of the manifest describes a job:\n\n"
+            << "  <input> <output> [-n <N>] [-M <module>]... [-D] [-t <s>]\n\n"
+            << "The per job options override the defaults given on the\n"
+            << "command line. See commandlineDecimater -h for the modules.\n"
+            << std::endl;
+  std::cerr << "Options\n" << std::endl;
+  std::cerr << " -M \"{Module-Name}[:Value]}\"\n"
+            << "    Default modules (Q if not given)\n" << std::endl;
+  std::cerr << " -n <N>\n"
+            << "    N >= 1: do N halfedge collapses.\n"
+            << "    N <=-1: decimate down to |N| vertices.\n"
+            << " 0 < N < 1: decimate down to N%.\n" << std::endl;
+  std::cerr << " -D\n"
+            << "    Append the number of vertices to the output names.\n"
+            << std::endl;
+  std::cerr << " -t <s>\n"
+            << "    Abort decimations that take longer than s seconds, their\n"
+            << "    output is not written and a timeout event is reported.\n"
+            << std::endl;
+  std::cerr << " -j <threads>\n"
+            << "    Number of jobs decimated in parallel"
+            << " (default: number of processors).\n" << std::endl;
+  std::cerr << " -m <MB>\n"
+            << "    Memory budget for all meshes in memory (default: none).\n"
+            << std::endl;
+  std::cerr << " -p <N>\n"
+            << "    Report progress every N collapses (default: 1000).\n"
+            << std::endl;
+  std::cerr << "Progress is written to stdout as one JSON object per line.\n"
+            << std::endl;
+
+  exit( xcode );
+}
+
+
+//                             end of file
+//=============================================================================
@@ -64,15 +64,7 @@
 #include <OpenMesh/Tools/Utils/getopt.h>
 #include <OpenMesh/Tools/Utils/Timer.hh>
 #include <OpenMesh/Tools/Decimater/DecimaterT.hh>
-#include <OpenMesh/Tools/Decimater/ModAspectRatioT.hh>
-#include <OpenMesh/Tools/Decimater/ModEdgeLengthT.hh>
-#include <OpenMesh/Tools/Decimater/ModHausdorffT.hh>
-#include <OpenMesh/Tools/Decimater/ModNormalDeviationT.hh>
-#include <OpenMesh/Tools/Decimater/ModNormalFlippingT.hh>
-#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
-#include <OpenMesh/Tools/Decimater/ModProgMeshT.hh>
-#include <OpenMesh/Tools/Decimater/ModIndependentSetsT.hh>
-#include <OpenMesh/Tools/Decimater/ModRoundnessT.hh>
+#include <OpenMesh/Tools/Decimater/PartitionDecimaterT.hh>
 
 //----------------------------------------------------------------- traits ----
 
@@ -109,99 +101,86 @@ void usage_and_exit(int xcode);
 
 //--------------------------------------------------- decimater arguments  ----
 
-#include "CmdOption.hh"
+#include "DecOptions.hh"
 
 
-struct DecOptions
+//------------------------------------------------ partitioned decimation  ----
+//
+template <typename Mesh>
+class DecSetup : public OpenMesh::Decimater::PartitionDecimaterT<Mesh>::Setup
 {
-  DecOptions()
-  : n_collapses(0)
-  { }
-
-  CmdOption<bool>        decorate_name;
-  CmdOption<float>       n_collapses;
-
-  CmdOption<float>       AR;   // Aspect ratio
-  CmdOption<float>       EL;   // Edge length
-  CmdOption<float>       HD;   // Hausdorff distance
-  CmdOption<bool>        IS;   // Independent Sets
-  CmdOption<float>       ND;   // Normal deviation
-  CmdOption<float>       NF;   // Normal flipping
-  CmdOption<std::string> PM;   // Progressive Mesh
-  CmdOption<float>       Q;    // Quadrics
-  CmdOption<float>       R;    // Roundness
-
-  template <typename T>
-  bool init( CmdOption<T>& _o, const std::string& _val )
+public:
+
+  DecSetup(const DecOptions& _opt) : opt_(_opt) { }
+
+  void add_modules(OpenMesh::Decimater::DecimaterT<Mesh>& _decimater)
   {
-    if ( _val.empty() )
-      _o.enable();
-    else
-    {
-      std::istringstream istr( _val );
+    // the handles only need to live as long as the decimater knows them
+    DecModules<Mesh> modules;
+    modules.add(_decimater, opt_);
+  }
 
-      T v;
+private:
 
-      if ( (istr >> v).fail() )
-        return false;
+  const DecOptions& opt_;
+};
 
-      _o = v;
-    }
-    return true;
-  }
 
+template <typename Mesh>
+bool
+decimate_partitioned(Mesh& _mesh, DecOptions& _opt)
+{
+   OpenMesh::Utils::Timer timer;
 
-  bool parse_argument( const std::string& arg )
-  {
-    std::string::size_type pos = arg.find(':');
+   if ( _opt.PM.is_enabled() )
+   {
+     std::cerr << "  ModProgMesh cannot be used with option -c!" << std::endl;
+     return false;
+   }
 
-    std::string name;
-    std::string value;
+   if ( !_mesh.has_face_normals() )
+     _mesh.request_face_normals();
+   _mesh.update_face_normals();
 
-    if (pos == std::string::npos)
-      name = arg;
-    else
-    {
-      name  = arg.substr(0, pos);
-      value = arg.substr(pos+1, arg.size());
-    }
-    strip(name);
-    strip(value);
-
-    if (name == "AR") return init(AR, value);
-    if (name == "EL") return init(EL, value);
-    if (name == "HD") return init(HD, value);
-    if (name == "IS") return init(IS, value);
-    if (name == "ND") return init(ND, value);
-    if (name == "NF") return init(NF, value);
-    if (name == "PM") return init(PM, value);
-    if (name == "Q")  return init(Q,  value);
-    if (name == "R")  return init(R,  value);
-    return false;
-  }
+   // the target is given in vertices, the chunks are decimated to faces
+   float nv_before = float(_mesh.n_vertices());
+   float nv_target = 0.0f;
+   if (_opt.n_collapses < 0.0)
+     nv_target = -_opt.n_collapses;
+   else if (_opt.n_collapses > 0.0f)
+     nv_target = nv_before * _opt.n_collapses;
 
-  std::string& strip(std::string & line)
-  {
-    std::string::size_type pos = 0;
+   OpenMesh::Decimater::PartitionDecimaterT<Mesh> decimater( _mesh );
+   decimater.set_n_chunks( _opt.n_chunks );
 
-    pos = line.find_last_not_of(" \t");
+   DecSetup<Mesh> setup( _opt );
 
-    if ( pos!=0 && pos!=std::string::npos )
-    {
-      ++pos;
-      line.erase( pos, line.length()-pos );
-    }
+   if (gverbose)
+   {
+     std::clog << "decimating in " << decimater.n_chunks() << " chunks" << std::endl;
+     std::clog << "  # vertices: " << _mesh.n_vertices() << std::endl;
+   }
 
-    pos = line.find_first_not_of(" \t");
-    if ( pos!=0 && pos!=std::string::npos )
-    {
-      line.erase(0,pos);
-    }
+   timer.start();
+   size_t rc = decimater.decimate_to_faces( size_t(_mesh.n_faces() * nv_target / nv_before), setup );
+   timer.stop();
 
-    return line;
-  }
+   if (gverbose)
+   {
+     std::clog << "  # seam vertices: " << decimater.n_seam_vertices() << std::endl;
+     if (decimater.n_stitch_failures() > 0)
+       std::clog << "  # faces not stitched: " << decimater.n_stitch_failures() << std::endl;
+     std::clog << "  # executed collapses: " << rc << ", "
+         << decimater.n_seam_collapses() << " at the seams\n";
+     std::clog << "  # vertices: " << _mesh.n_vertices() << ", "
+         << ( 100.0*_mesh.n_vertices()/nv_before ) << "%\n";
+     std::clog << "  Elapsed time: " << timer.as_string() << std::endl;
+     std::clog << "  collapses/s : " << rc/timer.seconds() << std::endl;
+   }
+
+   return true;
+}
 
-};
 
 //----------------------------------------------------- decimater wrapper  ----
 //
@@ -232,6 +211,13 @@ decimate(const std::string &_ifname,
      }
    }
 
+   // ---------------------------------------- decimate in chunks
+   if ( _opt.n_chunks.is_valid() && _opt.n_chunks > 1 )
+   {
+     if ( !decimate_partitioned(mesh, _opt) )
+       return false;
+   }
+   else
    // ---------------------------------------- do some decimation
    {
      // ---- 0 - For module NormalFlipping one needs face normals
@@ -255,85 +241,8 @@ decimate(const std::string &_ifname,
 
 
 
-     typename OpenMesh::Decimater::ModAspectRatioT<Mesh>::Handle modAR;
-
-     if (_opt.AR.is_enabled())
-     {
-       decimater.add(modAR);
-       if (_opt.AR.has_value())
-         decimater.module( modAR ).set_aspect_ratio( _opt.AR ) ;
-     }
-
-     typename OpenMesh::Decimater::ModEdgeLengthT<Mesh>::Handle modEL;
-
-     if (_opt.EL.is_enabled())
-     {
-       decimater.add(modEL);
-       if (_opt.EL.has_value())
-         decimater.module( modEL ).set_edge_length( _opt.EL ) ;
-       decimater.module(modEL).set_binary(false);
-     }
-
-     typename OpenMesh::Decimater::ModHausdorffT <Mesh>::Handle modHD;
-
-     if (_opt.HD.is_enabled())
-     {
-       decimater.add(modHD);
-       if (_opt.HD.has_value())
-         decimater.module( modHD ).set_tolerance( _opt.HD ) ;
-
-     }
-
-     typename OpenMesh::Decimater::ModIndependentSetsT<Mesh>::Handle modIS;
-
-     if ( _opt.IS.is_enabled() )
-       decimater.add(modIS);
-
-     typename OpenMesh::Decimater::ModNormalDeviationT<Mesh>::Handle modND;
-
-     if (_opt.ND.is_enabled())
-     {
-       decimater.add(modND);
-       if (_opt.ND.has_value())
-         decimater.module( modND ).set_normal_deviation( _opt.ND );
-       decimater.module( modND ).set_binary(false);
-     }
-
-     typename OpenMesh::Decimater::ModNormalFlippingT<Mesh>::Handle modNF;
-
-     if (_opt.NF.is_enabled())
-     {
-       decimater.add(modNF);
-       if (_opt.NF.has_value())
-         decimater.module( modNF ).set_max_normal_deviation( _opt.NF );
-     }
-
-
-     typename OpenMesh::Decimater::ModProgMeshT<Mesh>::Handle       modPM;
-
-     if ( _opt.PM.is_enabled() )
-       decimater.add(modPM);
-
-     typename OpenMesh::Decimater::ModQuadricT<Mesh>::Handle        modQ;
-
-     if (_opt.Q.is_enabled())
-     {
-       decimater.add(modQ);
-       if (_opt.Q.has_value())
-         decimater.module( modQ ).set_max_err( _opt.Q );
-       decimater.module(modQ).set_binary(false);
-     }
-
-     typename OpenMesh::Decimater::ModRoundnessT<Mesh>::Handle      modR;
-
-     if ( _opt.R.is_enabled() )
-     {
-       decimater.add( modR );
-       if ( _opt.R.has_value() )
-         decimater.module( modR ).set_min_angle( _opt.R,
-             !modQ.is_valid() ||
-             !decimater.module(modQ).is_binary());
-     }
+     DecModules<Mesh> modules;
+     modules.add(decimater, _opt);
 
      // ---- 3 - initialize decimater
 
@@ -348,7 +257,8 @@ decimate(const std::string &_ifname,
        if (!rc)
        {
          std::cerr << "  initializing failed!" << std::endl;
-         std::cerr << "  maybe no priority module or more than one were defined!" << std::endl;
+         std::cerr << "  maybe no priority module or more than one were defined,"
+                   << " or QO was combined with other modules!" << std::endl;
          return false;
        }
      }
@@ -381,7 +291,7 @@ decimate(const std::string &_ifname,
      // ---- 5 - write progmesh file for progviewer (before garbage collection!)
 
      if ( _opt.PM.has_value() )
-       decimater.module(modPM).write( _opt.PM );
+       decimater.module(modules.PM).write( _opt.PM );
 
      // ---- 6 - throw away all tagged edges
 
@@ -451,10 +361,11 @@ int main(int argc, char* argv[])
   {
     int c;
 
-    while ( (c=getopt( argc, argv, "dDhi:M:n:o:v")) != -1 )
+    while ( (c=getopt( argc, argv, "c:dDhi:M:n:o:v")) != -1 )
     {
       switch (c)
       {
+        case 'c': opt.n_chunks      = atoi(optarg); break;
         case 'D': opt.decorate_name = true;   break;
         case 'd': gdebug            = true;   break;
         case 'h': usage_and_exit(0);
@@ -480,6 +391,18 @@ int main(int argc, char* argv[])
     usage_and_exit(2);
   }
 
+  if ( opt.n_chunks.is_valid() && opt.n_chunks > 1 && opt.n_collapses >= 1.0f )
+  {
+    std::cerr << "Error: Option -n: a number of collapses cannot be used with -c!" << std::endl;
+    usage_and_exit(2);
+  }
+
+  if ( opt.Q.is_enabled() && opt.QO.is_enabled() )
+  {
+    std::cerr << "Error: Option -M: Q and QO cannot be used together!" << std::endl;
+    usage_and_exit(2);
+  }
+
   //----------------------------------------
 
   if (gverbose)
@@ -544,6 +467,12 @@ void usage_and_exit(int xcode)
             << "    N >= 1: do N halfedge collapses.\n"
             << "    N <=-1: decimate down to |N| vertices.\n"
             << " 0 < N < 1: decimate down to N%.\n" << std::endl;
+  std::cerr << " -c <N>\n"
+            << "    Split the mesh into N chunks that are decimated in parallel.\n"
+            << "    The seams between the chunks are decimated afterwards.\n"
+            << "    The chunks are decimated to a number of faces, so a target\n"
+            << "    of -n in vertices is only met approximately. -n N >= 1 is\n"
+            << "    not supported.\n" << std::endl;
   std::cerr << std::endl;
   std::cerr << "Modules:\n\n";
   std::cerr << "  AR[:ratio]      - ModAspectRatio\n";
@@ -554,6 +483,8 @@ void usage_and_exit(int xcode)
   std::cerr << "  NF[:angle]      - ModNormalFlipping\n";
   std::cerr << "  PM[:file name]  - ModProgMesh\n";
   std::cerr << "  Q[:error]       - ModQuadric*\n";
+  std::cerr << "  QO[:error]      - ModQuadric* with optimal vertex placement,\n"
+            << "                    cannot be combined with other modules\n";
   std::cerr << "  R[:angle]       - ModRoundness\n";
   std::cerr << "    0 < angle < 60\n";
   std::cerr << "  *: priority module. Decimater needs one of them (not more).\n";
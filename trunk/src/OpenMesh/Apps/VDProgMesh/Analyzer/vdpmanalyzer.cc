@@ -49,6 +49,7 @@
 #include <limits>
 #include <exception>
 #include <cmath>
+#include <cstdlib>
 // -------------------- OpenMesh
 #include <OpenMesh/Core/IO/MeshIO.hh>
 #include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
@@ -60,6 +61,8 @@
 #include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
 #include <OpenMesh/Tools/VDPM/VHierarchy.hh>
 #include <OpenMesh/Tools/VDPM/VFront.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyPager.hh>
+#include <OpenMesh/Tools/VDPM/VSplitCoder.hh>
 
 // ----------------------------------------------------------------------------
 
@@ -77,6 +80,8 @@ using VDPM::VHierarchy;
 using VDPM::VHierarchyNode;
 using VDPM::VHierarchyNodeIndex;
 using VDPM::VHierarchyNodeHandle;
+using VDPM::VHierarchyPager;
+using VDPM::VSplitEncoder;
 using VDPM::VHierarchyNodeHandleContainer;
 using VDPM::ViewingParameters;
 
@@ -212,7 +217,10 @@ void usage_and_exit(int xcode)
 {
   using namespace std;
 
-  cout << "Usage: vdpmanalyzer [-h] [-o output.spm] input.pm\n";
+  cout << "Usage: vdpmanalyzer [-h] [-o output.spm] [-p records] [-z] input.pm\n";
+  cout << "  -p records  additionally write a paged hierarchy (.pspm) with\n"
+       << "              the given number of vertex splits per block\n"
+       << "  -z          additionally write a compressed hierarchy (.cspm)\n";
 
   exit(xcode);
 }
@@ -262,13 +270,17 @@ int main(int argc, char **argv)
   int           c;
   std::string   ifname;
   std::string   ofname;
+  unsigned int  records_per_block = 0;
+  bool          compress = false;
 
-  while ( (c=getopt(argc, argv, "o:"))!=-1 )
+  while ( (c=getopt(argc, argv, "o:p:z"))!=-1 )
   {
     switch(c)
     {
       case 'v': verbose = true; break;
       case 'o': ofname = optarg;  break;
+      case 'p': records_per_block = (unsigned int) atoi(optarg); break;
+      case 'z': compress = true; break;
       case 'h': usage_and_exit(0);
       default:  usage_and_exit(1);
     }
@@ -294,6 +306,28 @@ int main(int argc, char **argv)
     open_prog_mesh(ifname);
     vdpm_analysis();
     save_vd_prog_mesh(spmfname);
+
+    if (records_per_block > 0)
+    {
+      std::string pagedfname = spmfname;
+      replace_extension(pagedfname, "pspm");
+      if (!VHierarchyPager::convert(spmfname, pagedfname, records_per_block))
+      {
+        std::cerr << "Error: could not write " << pagedfname << std::endl;
+        return 1;
+      }
+    }
+
+    if (compress)
+    {
+      std::string codedfname = spmfname;
+      replace_extension(codedfname, "cspm");
+      if (!VSplitEncoder::compress(spmfname, codedfname))
+      {
+        std::cerr << "Error: could not write " << codedfname << std::endl;
+        return 1;
+      }
+    }
   }
   catch( std::bad_alloc& )
   {
@@ -0,0 +1,264 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+// -------------------------------------------------------------- includes ----
+
+#include <OpenMesh/Core/System/config.h>
+// -------------------- STL
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+// -------------------- OpenMesh
+#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+#include <OpenMesh/Tools/Utils/getopt.h>
+#include <OpenMesh/Tools/VDPM/MeshTraits.hh>
+#include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchy.hh>
+#include <OpenMesh/Tools/VDPM/VFront.hh>
+#include <OpenMesh/Tools/VDPM/AdaptiveRefinerT.hh>
+
+
+// ----------------------------------------------------------------------------
+
+using namespace OpenMesh;
+
+typedef TriMesh_ArrayKernelT<VDPM::MeshTraits>  VDPMMesh;
+
+struct Camera
+{
+  Vec3f eye, center, up;
+};
+
+
+// ----------------------------------------------------------------------------
+
+void usage_and_exit(int xcode)
+{
+  using namespace std;
+
+  cout << "Usage: vdpmbenchmark [-h] [-v] [-b budget] [-t tolerance] [-n frames]\n"
+       << "                     [-c camera_path] input.spm|input.pspm\n"
+       << "\n"
+       << "Replays a camera path on a view-dependent progressive mesh and\n"
+       << "reports the cost of the adaptive refinement per frame. Paged files\n"
+       << "(.pspm) are refined out of core.\n"
+       << "\n"
+       << "  -b budget       time budget per frame in milliseconds (default: none)\n"
+       << "  -t tolerance    screen-space error tolerance^2 (default: 0.001)\n"
+       << "  -n frames       number of frames of the default orbit (default: 360)\n"
+       << "  -c camera_path  file with one camera per line:\n"
+       << "                  eye_x eye_y eye_z center_x center_y center_z up_x up_y up_z\n"
+       << "  -v              print statistics of every frame\n";
+
+  exit(xcode);
+}
+
+
+// ----------------------------------------------------------------------------
+
+bool read_camera_path(const std::string& _filename, std::vector<Camera>& _path)
+{
+  std::ifstream ifs(_filename.c_str());
+  if (!ifs)
+    return false;
+
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::istringstream iss(line);
+    Camera cam;
+    iss >> cam.eye[0]    >> cam.eye[1]    >> cam.eye[2]
+        >> cam.center[0] >> cam.center[1] >> cam.center[2]
+        >> cam.up[0]     >> cam.up[1]     >> cam.up[2];
+    if (!iss)
+      return false;
+    _path.push_back(cam);
+  }
+  return !_path.empty();
+}
+
+
+// orbit around the model while moving closer and away again, false if
+// the mesh has no vertices
+bool make_orbit(const VDPMMesh& _mesh, unsigned int _n_frames, std::vector<Camera>& _path)
+{
+  if (_mesh.n_vertices() == 0)
+    return false;
+
+  VDPMMesh::ConstVertexIter v_it(_mesh.vertices_begin()), v_end(_mesh.vertices_end());
+  VDPMMesh::Point bb_min, bb_max;
+
+  bb_min = bb_max = _mesh.point(*v_it);
+  for (; v_it!=v_end; ++v_it)
+  {
+    bb_min.minimize(_mesh.point(*v_it));
+    bb_max.maximize(_mesh.point(*v_it));
+  }
+
+  Vec3f center = 0.5f * (bb_min + bb_max);
+  float radius = 0.5f * (bb_max - bb_min).norm();
+
+  for (unsigned int i=0; i<_n_frames; ++i)
+  {
+    float t = 2.0f * float(M_PI) * float(i) / float(_n_frames);
+    float d = radius * (2.0f + 1.2f * cosf(2.0f * t));
+
+    Camera cam;
+    cam.center = center;
+    cam.eye    = center + Vec3f(d * cosf(t), 0.3f * d, d * sinf(t));
+    cam.up     = Vec3f(0.0f, 1.0f, 0.0f);
+    _path.push_back(cam);
+  }
+  return true;
+}
+
+
+// ------------------------------------------------------------------ main ----
+
+int main(int argc, char **argv)
+{
+  int           c;
+  bool          verbose   = false;
+  double        budget    = 0.0;
+  float         tolerance = 0.001f;
+  unsigned int  n_frames  = 360;
+  std::string   camfname;
+
+  while ( (c=getopt(argc, argv, "b:c:hn:t:v"))!=-1 )
+  {
+    switch(c)
+    {
+      case 'b': budget    = atof(optarg) * 1e-3; break;
+      case 'c': camfname  = optarg; break;
+      case 'n': n_frames  = (unsigned int) atoi(optarg); break;
+      case 't': tolerance = (float) atof(optarg); break;
+      case 'v': verbose   = true; break;
+      case 'h': usage_and_exit(0);
+      default:  usage_and_exit(1);
+    }
+  }
+
+  if (optind >= argc)
+    usage_and_exit(1);
+
+  VDPMMesh                          mesh;
+  VDPM::VHierarchy                  vhierarchy;
+  VDPM::VFront                      vfront;
+  VDPM::ViewingParameters           viewing_parameters;
+  VDPM::AdaptiveRefinerT<VDPMMesh>  refiner(mesh, vhierarchy, vfront);
+
+  if (!refiner.open(argv[optind]))
+  {
+    std::cerr << "Error: could not read " << argv[optind] << std::endl;
+    return 1;
+  }
+
+  std::vector<Camera> path;
+  if (!camfname.empty())
+  {
+    if (!read_camera_path(camfname, path))
+    {
+      std::cerr << "Error: could not read camera path " << camfname << std::endl;
+      return 1;
+    }
+  }
+  else if (n_frames > 0)
+  {
+    if (!make_orbit(mesh, n_frames, path))
+    {
+      std::cerr << "Error: the base mesh has no vertices" << std::endl;
+      return 1;
+    }
+  }
+  else
+    usage_and_exit(1);
+
+  std::cout << "base mesh: " << refiner.n_base_vertices() << " vertices, "
+            << refiner.n_base_faces() << " faces, "
+            << refiner.n_details() << " detail vertices\n";
+
+  refiner.set_time_budget(budget);
+  viewing_parameters.set_tolerance_square(tolerance);
+
+  double  total = 0.0, max_frame = 0.0;
+  size_t  vsplits = 0, ecols = 0, faces = 0, interrupted = 0;
+
+  for (size_t i=0; i<path.size(); ++i)
+  {
+    viewing_parameters.set_look_at(path[i].eye, path[i].center, path[i].up);
+    viewing_parameters.update_viewing_configurations();
+
+    if (!refiner.refine(viewing_parameters))
+      ++interrupted;
+
+    total     += refiner.seconds();
+    max_frame  = std::max(max_frame, refiner.seconds());
+    vsplits   += refiner.n_vsplits();
+    ecols     += refiner.n_ecols();
+    faces     += mesh.n_faces();
+
+    if (verbose)
+      std::cout << "frame " << i << ": "
+                << refiner.seconds() * 1e3 << " ms, "
+                << refiner.n_vsplits() << " vsplits, "
+                << refiner.n_ecols() << " ecols, "
+                << mesh.n_faces() << " faces\n";
+  }
+
+  size_t n = path.size();
+  std::cout << "frames:              " << n << "\n"
+            << "total time:          " << total * 1e3 << " ms\n"
+            << "average frame:       " << total * 1e3 / n << " ms\n"
+            << "maximal frame:       " << max_frame * 1e3 << " ms\n"
+            << "vsplits / ecols:     " << vsplits << " / " << ecols << "\n"
+            << "average faces:       " << faces / n << "\n"
+            << "interrupted frames:  " << interrupted << "\n";
+
+  return 0;
+}
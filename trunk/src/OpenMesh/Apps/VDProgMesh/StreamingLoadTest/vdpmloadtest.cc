@@ -0,0 +1,433 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+// Load generator for vdpmstreamingserver: simulates many clients, each
+// requesting the base mesh and then sending a new view along an orbit in
+// fixed intervals, and reports throughput and latency of the server.
+
+// -------------------------------------------------------------- includes ----
+
+#include <OpenMesh/Core/System/config.h>
+// -------------------- STL
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+// -------------------- POSIX
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+// -------------------- OpenMesh
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Tools/Utils/getopt.h>
+#include <OpenMesh/Tools/Utils/Timer.hh>
+#include <OpenMesh/Tools/VDPM/StreamingDef.hh>
+#include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
+
+
+// ----------------------------------------------------------------------------
+
+using namespace OpenMesh;
+using namespace OpenMesh::VDPM;
+
+static const size_t HeaderSize = 8;
+
+
+// ----------------------------------------------------------------------------
+
+void usage_and_exit(int xcode)
+{
+  using namespace std;
+
+  cout << "Usage: vdpmloadtest [-h] [-s host] [-p port] [-u socket] [-n clients]\n"
+       << "                    [-f views] [-i interval] [-t tolerance] [-z]\n"
+       << "\n"
+       << "  -s host       server address (default: 127.0.0.1)\n"
+       << "  -p port       TCP port (default: " << VDPM_STREAMING_PORT << ")\n"
+       << "  -u socket     connect to a local (unix domain) socket instead\n"
+       << "  -n clients    number of simulated clients (default: 100)\n"
+       << "  -f views      views sent per client (default: 10)\n"
+       << "  -i interval   milliseconds between the views of a client\n"
+       << "                (default: 100)\n"
+       << "  -t tolerance  screen space tolerance (default: 0.001)\n"
+       << "  -z            request compressed vertex splits\n";
+
+  exit(xcode);
+}
+
+
+// ----------------------------------------------------------------------------
+
+struct Client
+{
+  Client()
+    : fd(-1), has_base_mesh(false), waiting(false), n_views(0),
+      n_vsplits(0), n_bytes(0), t_view(0.0), t_next_view(0.0),
+      first_batch(false)
+  {}
+
+  int           fd;
+  std::string   in;
+  std::string   out;
+  bool          has_base_mesh;
+  bool          waiting;         // waiting for refinement complete
+  unsigned int  n_views;
+  size_t        n_vsplits;
+  size_t        n_bytes;
+  double        t_view;          // time the current view was sent
+  double        t_next_view;
+  bool          first_batch;
+};
+
+
+// ----------------------------------------------------------------------------
+
+std::string message(unsigned int _type, const std::string& _payload)
+{
+  bool swap = Endian::local() != Endian::LSB;
+
+  std::ostringstream os;
+  IO::store(os, _type, swap);
+  IO::store(os, (unsigned int) _payload.size(), swap);
+  os << _payload;
+  return os.str();
+}
+
+
+std::string view_message(unsigned int _client, unsigned int _view,
+                         float _tolerance)
+{
+  // orbit around the unit cube, each client starting at another angle
+  double  angle  = 0.1 * _view + 0.37 * _client;
+  Vec3f   eye((float)(3.0 * cos(angle)), 1.0f, (float)(3.0 * sin(angle)));
+
+  ViewingParameters vp;
+  vp.set_look_at(eye, Vec3f(0.0f, 0.0f, 0.0f), Vec3f(0.0f, 1.0f, 0.0f));
+
+  bool swap = Endian::local() != Endian::LSB;
+  std::ostringstream payload;
+
+  double m[16];
+  vp.get_modelview_matrix(m);
+  for (int i=0; i<16; ++i)
+    IO::store(payload, m[i], swap);
+  IO::store(payload, vp.fovy(), swap);
+  IO::store(payload, vp.aspect(), swap);
+  IO::store(payload, _tolerance * _tolerance, swap);
+
+  return message(kMsgViewingParameters, payload.str());
+}
+
+
+// ----------------------------------------------------------------------------
+
+int connect_server(const std::string& _host, unsigned short _port,
+                   const std::string& _local)
+{
+  int fd;
+
+  if (_local.empty())
+  {
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(_port);
+    addr.sin_addr.s_addr = inet_addr(_host.c_str());
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr*) &addr, sizeof(addr)) != 0)
+      return -1;
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  else
+  {
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, _local.c_str(), sizeof(addr.sun_path)-1);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr*) &addr, sizeof(addr)) != 0)
+      return -1;
+  }
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  return fd;
+}
+
+
+double mean(const std::vector<double>& _v)
+{
+  double sum = 0.0;
+  for (size_t i=0; i<_v.size(); ++i)
+    sum += _v[i];
+  return _v.empty() ? 0.0 : sum / _v.size();
+}
+
+
+double percentile(std::vector<double> _v, double _p)
+{
+  if (_v.empty())
+    return 0.0;
+  std::sort(_v.begin(), _v.end());
+  return _v[std::min(_v.size()-1, (size_t)(_p * _v.size()))];
+}
+
+
+// ------------------------------------------------------------------ main ----
+
+int main(int argc, char **argv)
+{
+  int             c;
+  std::string     host        = "127.0.0.1";
+  unsigned short  port        = VDPM_STREAMING_PORT;
+  std::string     local;
+  unsigned int    n_clients   = 100;
+  unsigned int    n_views     = 10;
+  double          interval    = 0.1;
+  float           tolerance   = 0.001f;
+  bool            compressed  = false;
+
+  while ( (c=getopt(argc, argv, "f:hi:n:p:s:t:u:z"))!=-1 )
+  {
+    switch(c)
+    {
+      case 'f': n_views   = (unsigned int) atoi(optarg); break;
+      case 'i': interval  = atof(optarg) / 1000.0; break;
+      case 'n': n_clients = (unsigned int) atoi(optarg); break;
+      case 'p': port      = (unsigned short) atoi(optarg); break;
+      case 's': host      = optarg; break;
+      case 't': tolerance = (float) atof(optarg); break;
+      case 'u': local     = optarg; break;
+      case 'z': compressed = true; break;
+      case 'h': usage_and_exit(0);
+      default:  usage_and_exit(1);
+    }
+  }
+
+  if (n_clients == 0 || n_views == 0)
+    usage_and_exit(1);
+
+  signal(SIGPIPE, SIG_IGN);
+
+  std::vector<Client> clients(n_clients);
+  std::vector<double> first_batch, complete;
+
+  Utils::Timer timer;
+  timer.start();
+
+  for (unsigned int i=0; i<n_clients; ++i)
+  {
+    clients[i].fd = connect_server(host, port, local);
+    if (clients[i].fd < 0)
+    {
+      std::cerr << "Error: could not connect client " << i << ": "
+                << strerror(errno) << std::endl;
+      return 1;
+    }
+    std::ostringstream flags;
+    IO::store(flags, compressed ? (unsigned int) kStreamCompressed : 0u,
+              Endian::local() != Endian::LSB);
+    clients[i].out = message(kMsgBaseMeshRequest, flags.str());
+  }
+
+  unsigned int    n_active = n_clients;
+  std::vector<pollfd> fds(n_clients);
+
+  while (n_active > 0)
+  {
+    timer.stop();
+    double now = timer.seconds();
+    timer.cont();
+
+    // send due views
+    for (unsigned int i=0; i<n_clients; ++i)
+    {
+      Client& cl = clients[i];
+      if (cl.fd >= 0 && cl.has_base_mesh && !cl.waiting &&
+          cl.n_views < n_views && now >= cl.t_next_view)
+      {
+        cl.out        += view_message(i, cl.n_views, tolerance);
+        cl.waiting     = true;
+        cl.first_batch = false;
+        cl.t_view      = now;
+        cl.t_next_view = now + interval;
+        ++cl.n_views;
+      }
+    }
+
+    for (unsigned int i=0; i<n_clients; ++i)
+    {
+      fds[i].fd      = clients[i].fd;
+      fds[i].events  = POLLIN | (clients[i].out.empty() ? 0 : POLLOUT);
+      fds[i].revents = 0;
+    }
+
+    if (poll(&fds[0], fds.size(), 10) < 0 && errno != EINTR)
+      break;
+
+    timer.stop();
+    now = timer.seconds();
+    timer.cont();
+
+    for (unsigned int i=0; i<n_clients; ++i)
+    {
+      Client& cl = clients[i];
+      bool    ok = true;
+
+      if (cl.fd < 0)
+        continue;
+
+      if (fds[i].revents & POLLOUT)
+      {
+        ssize_t n = send(cl.fd, cl.out.data(), cl.out.size(), MSG_NOSIGNAL);
+        if (n > 0)
+          cl.out.erase(0, n);
+        else if (n < 0 && errno != EAGAIN && errno != EINTR)
+          ok = false;
+      }
+
+      if (ok && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+      {
+        char buf[16384];
+        ssize_t n;
+        while ((n = recv(cl.fd, buf, sizeof(buf), 0)) > 0)
+        {
+          cl.in.append(buf, n);
+          cl.n_bytes += n;
+        }
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR))
+          ok = false;
+      }
+
+      // handle complete messages
+      bool   swap = Endian::local() != Endian::LSB;
+      size_t pos  = 0;
+
+      while (cl.in.size() - pos >= HeaderSize)
+      {
+        unsigned int type, size;
+        std::istringstream header(cl.in.substr(pos, HeaderSize));
+        IO::restore(header, type, swap);
+        IO::restore(header, size, swap);
+
+        if (cl.in.size() - pos < HeaderSize + size)
+          break;
+
+        if (type == kMsgBaseMesh)
+        {
+          cl.has_base_mesh = true;
+          cl.t_next_view   = now;
+        }
+        else if (type == kMsgVSplits)
+        {
+          unsigned int n;
+          std::istringstream payload(cl.in.substr(pos + HeaderSize, 4));
+          IO::restore(payload, n, swap);
+          cl.n_vsplits += n;
+
+          if (cl.waiting && !cl.first_batch)
+          {
+            first_batch.push_back(now - cl.t_view);
+            cl.first_batch = true;
+          }
+        }
+        else if (type == kMsgRefinementComplete)
+        {
+          if (cl.waiting)
+            complete.push_back(now - cl.t_view);
+          cl.waiting = false;
+
+          if (cl.n_views == n_views)
+            ok = false;
+        }
+
+        pos += HeaderSize + size;
+      }
+      cl.in.erase(0, pos);
+
+      if (!ok)
+      {
+        close(cl.fd);
+        cl.fd = -1;
+        --n_active;
+      }
+    }
+  }
+
+  timer.stop();
+
+  size_t n_vsplits = 0, n_bytes = 0;
+  for (unsigned int i=0; i<n_clients; ++i)
+  {
+    n_vsplits += clients[i].n_vsplits;
+    n_bytes   += clients[i].n_bytes;
+  }
+
+  std::cout << n_clients << " clients, " << n_views << " views each, "
+            << (compressed ? "compressed, " : "")
+            << timer.as_string() << "\n"
+            << "  vertex splits:   " << n_vsplits << " ("
+            << n_vsplits / timer.seconds() << " per second)\n"
+            << "  bytes received:  " << n_bytes << " ("
+            << n_bytes / timer.seconds() / 1024.0 / 1024.0 << " MB/s)\n"
+            << "  first batch:     mean " << mean(first_batch) * 1000.0
+            << " ms, p95 " << percentile(first_batch, 0.95) * 1000.0 << " ms\n"
+            << "  refinement done: mean " << mean(complete) * 1000.0
+            << " ms, p95 " << percentile(complete, 0.95) * 1000.0 << " ms\n";
+
+  return 0;
+}
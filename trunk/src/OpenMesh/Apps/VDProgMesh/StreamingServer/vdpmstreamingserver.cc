@@ -0,0 +1,715 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+// VDPM streaming server: serves the vertex splits of a view-dependent
+// progressive mesh to many concurrent clients.
+//
+// One event loop thread multiplexes all sockets with poll(). Requests are
+// parsed there, the refinement and encoding of vertex splits for a client
+// is done by a pool of worker threads. Each client has its own send
+// buffer; new vertex splits are only generated while that buffer holds
+// less than the high watermark, so slow clients do not make the server
+// buffer unbounded amounts of data.
+
+// -------------------------------------------------------------- includes ----
+
+#include <OpenMesh/Core/System/config.h>
+// -------------------- STL
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+// -------------------- POSIX
+#include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+// -------------------- OpenMesh
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Tools/Utils/getopt.h>
+#include <OpenMesh/Tools/VDPM/StreamingDef.hh>
+#include <OpenMesh/Tools/VDPM/StreamingModel.hh>
+#include <OpenMesh/Tools/VDPM/StreamingSession.hh>
+#include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
+
+
+// ----------------------------------------------------------------------------
+
+using namespace OpenMesh;
+using namespace OpenMesh::VDPM;
+
+static const size_t       HeaderSize     = 8;
+static const unsigned int MaxMessageSize = 1 << 16;
+
+
+// ----------------------------------------------------------------------------
+
+void usage_and_exit(int xcode)
+{
+  using namespace std;
+
+  cout << "Usage: vdpmstreamingserver [-h] [-p port] [-u socket] [-w workers]\n"
+       << "                           [-b batch] [-m watermark] input.spm\n"
+       << "\n"
+       << "  -p port       TCP port (default: " << VDPM_STREAMING_PORT << ")\n"
+       << "  -u socket     listen on a local (unix domain) socket instead\n"
+       << "  -w workers    number of worker threads (default: 4)\n"
+       << "  -b batch      bytes of vertex splits per batch (default: 16384)\n"
+       << "  -m watermark  maximal pending bytes per client before new vertex\n"
+       << "                splits are held back (default: 65536)\n";
+
+  exit(xcode);
+}
+
+
+// ----------------------------------------------------------------------------
+
+std::string message(unsigned int _type, const std::string& _payload)
+{
+  bool swap = Endian::local() != Endian::LSB;
+
+  std::ostringstream os;
+  IO::store(os, _type, swap);
+  IO::store(os, (unsigned int) _payload.size(), swap);
+  os << _payload;
+  return os.str();
+}
+
+
+// ----------------------------------------------------------------------------
+
+/// Connection state. Fields marked (loop) are only used by the event loop,
+/// the others are guarded by mutex. The session is only used by the one
+/// worker holding the job of the client.
+struct Client
+{
+  explicit Client(int _fd, StreamingModel& _model)
+    : fd(_fd), session(_model), out_pos(0),
+      compressed(false), has_view(false), view_pending(false),
+      complete_sent(false), job_queued(false), closed(false), generation(0)
+  {
+    pthread_mutex_init(&mutex, NULL);
+  }
+
+  ~Client()
+  {
+    pthread_mutex_destroy(&mutex);
+  }
+
+  int                 fd;
+  StreamingSession    session;
+  std::string         in;             // (loop)
+
+  pthread_mutex_t     mutex;
+  std::string         out;
+  size_t              out_pos;
+  bool                compressed;
+  ViewingParameters   view;
+  bool                has_view;
+  bool                view_pending;
+  bool                complete_sent;
+  bool                job_queued;
+  bool                closed;
+  unsigned int        generation;     // base mesh requests so far
+
+  size_t pending() const { return out.size() - out_pos; }
+};
+
+
+// ----------------------------------------------------------------------------
+
+class Server
+{
+public:
+
+  Server(StreamingModel& _model, size_t _batch, size_t _watermark)
+    : model_(_model), batch_(_batch), watermark_(_watermark),
+      listen_fd_(-1), stop_(false)
+  {
+    base_mesh_[0] = message(kMsgBaseMesh, _model.base_mesh_payload(false));
+    base_mesh_[1] = message(kMsgBaseMesh, _model.base_mesh_payload(true));
+
+    pthread_mutex_init(&jobs_mutex_, NULL);
+    pthread_cond_init(&jobs_cond_, NULL);
+    wakeup_[0] = wakeup_[1] = -1;
+  }
+
+  bool listen_tcp(unsigned short _port);
+  bool listen_local(const std::string& _path);
+  void run(unsigned int _n_workers);
+
+private:
+
+  static void* worker_main(void* _server);
+  void worker();
+  void process(Client* _client);
+
+  void accept_clients();
+  bool read_client(Client* _client);
+  bool parse_messages(Client* _client);
+  bool write_client(Client* _client);
+  void schedule(Client* _client);
+  void wakeup();
+
+private:
+
+  StreamingModel&     model_;
+  size_t              batch_;
+  size_t              watermark_;
+  std::string         base_mesh_[2];    // uncompressed, compressed
+
+  int                 listen_fd_;
+  int                 wakeup_[2];
+
+  std::list<Client*>  clients_;
+  std::list<Client*>  closed_;
+
+  pthread_mutex_t     jobs_mutex_;
+  pthread_cond_t      jobs_cond_;
+  std::deque<Client*> jobs_;
+  bool                stop_;
+};
+
+
+// ----------------------------------------------------------------------------
+
+static bool set_nonblocking(int _fd)
+{
+  int flags = fcntl(_fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(_fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+
+bool Server::listen_tcp(unsigned short _port)
+{
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0)
+    return false;
+
+  int one = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port        = htons(_port);
+
+  return bind(listen_fd_, (sockaddr*) &addr, sizeof(addr)) == 0 &&
+         listen(listen_fd_, 1024) == 0 &&
+         set_nonblocking(listen_fd_);
+}
+
+
+bool Server::listen_local(const std::string& _path)
+{
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd_ < 0 || _path.size() >= sizeof(sockaddr_un().sun_path))
+    return false;
+
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, _path.c_str());
+  unlink(_path.c_str());
+
+  return bind(listen_fd_, (sockaddr*) &addr, sizeof(addr)) == 0 &&
+         listen(listen_fd_, 1024) == 0 &&
+         set_nonblocking(listen_fd_);
+}
+
+
+// ----------------------------------------------------------------------------
+
+void Server::run(unsigned int _n_workers)
+{
+  if (pipe(wakeup_) != 0)
+    return;
+  set_nonblocking(wakeup_[0]);
+  set_nonblocking(wakeup_[1]);
+
+  std::vector<pthread_t> workers(_n_workers);
+  for (unsigned int i=0; i<_n_workers; ++i)
+    pthread_create(&workers[i], NULL, &Server::worker_main, this);
+
+  std::vector<pollfd>   fds;
+  std::vector<Client*>  fd_clients;
+
+  while (true)
+  {
+    fds.clear();
+    fd_clients.clear();
+
+    pollfd pfd;
+    pfd.fd = listen_fd_;  pfd.events = POLLIN;  pfd.revents = 0;
+    fds.push_back(pfd);
+    pfd.fd = wakeup_[0];
+    fds.push_back(pfd);
+
+    for (std::list<Client*>::iterator c_it=clients_.begin(); c_it!=clients_.end(); ++c_it)
+    {
+      Client* c = *c_it;
+
+      pthread_mutex_lock(&c->mutex);
+      pfd.fd     = c->fd;
+      pfd.events = POLLIN | (c->pending() > 0 ? POLLOUT : 0);
+      pthread_mutex_unlock(&c->mutex);
+
+      fds.push_back(pfd);
+      fd_clients.push_back(c);
+    }
+
+    if (poll(&fds[0], fds.size(), -1) < 0 && errno != EINTR)
+      break;
+
+    if (fds[0].revents & POLLIN)
+      accept_clients();
+
+    if (fds[1].revents & POLLIN)
+    {
+      char buf[256];
+      while (read(wakeup_[0], buf, sizeof(buf)) > 0) ;
+    }
+
+    for (size_t i=0; i<fd_clients.size(); ++i)
+    {
+      Client* c  = fd_clients[i];
+      bool    ok = true;
+
+      if (fds[i+2].revents & (POLLERR | POLLHUP | POLLNVAL))
+        ok = false;
+      if (ok && (fds[i+2].revents & POLLIN))
+        ok = read_client(c);
+      if (ok && (fds[i+2].revents & POLLOUT))
+        ok = write_client(c);
+
+      if (!ok)
+      {
+        pthread_mutex_lock(&c->mutex);
+        c->closed = true;
+        pthread_mutex_unlock(&c->mutex);
+
+        close(c->fd);
+        clients_.remove(c);
+        closed_.push_back(c);
+      }
+      else
+        schedule(c);
+    }
+
+    // delete closed clients once no worker uses them any more
+    for (std::list<Client*>::iterator c_it=closed_.begin(); c_it!=closed_.end(); )
+    {
+      pthread_mutex_lock(&(*c_it)->mutex);
+      bool busy = (*c_it)->job_queued;
+      pthread_mutex_unlock(&(*c_it)->mutex);
+
+      if (busy)
+        ++c_it;
+      else
+      {
+        delete *c_it;
+        c_it = closed_.erase(c_it);
+      }
+    }
+  }
+
+  pthread_mutex_lock(&jobs_mutex_);
+  stop_ = true;
+  pthread_cond_broadcast(&jobs_cond_);
+  pthread_mutex_unlock(&jobs_mutex_);
+
+  for (unsigned int i=0; i<_n_workers; ++i)
+    pthread_join(workers[i], NULL);
+}
+
+
+void Server::accept_clients()
+{
+  int fd;
+  while ((fd = accept(listen_fd_, NULL, NULL)) >= 0)
+  {
+    set_nonblocking(fd);
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    clients_.push_back(new Client(fd, model_));
+  }
+}
+
+
+bool Server::read_client(Client* _client)
+{
+  char buf[4096];
+
+  while (true)
+  {
+    ssize_t n = recv(_client->fd, buf, sizeof(buf), 0);
+
+    if (n > 0)
+      _client->in.append(buf, n);
+    else if (n == 0)
+      return false;
+    else if (errno == EAGAIN || errno == EWOULDBLOCK)
+      break;
+    else if (errno != EINTR)
+      return false;
+  }
+
+  return parse_messages(_client);
+}
+
+
+bool Server::parse_messages(Client* _client)
+{
+  bool          swap = Endian::local() != Endian::LSB;
+  std::string&  in   = _client->in;
+  size_t        pos  = 0;
+
+  while (in.size() - pos >= HeaderSize)
+  {
+    unsigned int type, size;
+
+    std::istringstream header(in.substr(pos, HeaderSize));
+    IO::restore(header, type, swap);
+    IO::restore(header, size, swap);
+
+    if (size > MaxMessageSize)
+      return false;
+    if (in.size() - pos < HeaderSize + size)
+      break;
+
+    std::istringstream payload(in.substr(pos + HeaderSize, size));
+    pos += HeaderSize + size;
+
+    if (type == kMsgBaseMeshRequest)
+    {
+      unsigned int flags = 0;
+      if (size >= 4)
+        IO::restore(payload, flags, swap);
+
+      bool compressed = (flags & kStreamCompressed) != 0;
+
+      pthread_mutex_lock(&_client->mutex);
+      _client->out          += base_mesh_[compressed ? 1 : 0];
+      _client->compressed    = compressed;
+      _client->has_view      = false;
+      _client->view_pending  = false;
+      ++_client->generation;
+      pthread_mutex_unlock(&_client->mutex);
+
+      // the worker resets the session with the first view, a batch it is
+      // building meanwhile is dropped
+    }
+    else if (type == kMsgViewingParameters)
+    {
+      double  modelview_matrix[16];
+      float   fovy, aspect, tolerance_square;
+
+      for (int i=0; i<16; ++i)
+        IO::restore(payload, modelview_matrix[i], swap);
+      IO::restore(payload, fovy, swap);
+      IO::restore(payload, aspect, swap);
+      IO::restore(payload, tolerance_square, swap);
+
+      if (!payload)
+        return false;
+
+      pthread_mutex_lock(&_client->mutex);
+      _client->view.set_modelview_matrix(modelview_matrix);
+      _client->view.set_fovy(fovy);
+      _client->view.set_aspect(aspect);
+      _client->view.set_tolerance_square(tolerance_square);
+      _client->view.update_viewing_configurations();
+      _client->view_pending = true;
+      pthread_mutex_unlock(&_client->mutex);
+    }
+    else
+      return false;
+  }
+
+  in.erase(0, pos);
+  return true;
+}
+
+
+bool Server::write_client(Client* _client)
+{
+  bool ok = true;
+
+  pthread_mutex_lock(&_client->mutex);
+
+  while (_client->pending() > 0)
+  {
+    ssize_t n = send(_client->fd,
+                     _client->out.data() + _client->out_pos,
+                     _client->pending(), MSG_NOSIGNAL);
+    if (n > 0)
+      _client->out_pos += n;
+    else
+    {
+      if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        ok = false;
+      break;
+    }
+  }
+
+  // drop what has been sent
+  if (_client->out_pos > 0 && _client->out_pos * 2 >= _client->out.size())
+  {
+    _client->out.erase(0, _client->out_pos);
+    _client->out_pos = 0;
+  }
+
+  pthread_mutex_unlock(&_client->mutex);
+  return ok;
+}
+
+
+// ----------------------------------------------------------------------------
+
+void Server::schedule(Client* _client)
+{
+  pthread_mutex_lock(&_client->mutex);
+
+  bool work = !_client->job_queued && !_client->closed &&
+              _client->pending() < watermark_ &&
+              (_client->view_pending ||
+               (_client->has_view && !_client->complete_sent));
+
+  if (work)
+    _client->job_queued = true;
+
+  pthread_mutex_unlock(&_client->mutex);
+
+  if (work)
+  {
+    pthread_mutex_lock(&jobs_mutex_);
+    jobs_.push_back(_client);
+    pthread_cond_signal(&jobs_cond_);
+    pthread_mutex_unlock(&jobs_mutex_);
+  }
+}
+
+
+void Server::wakeup()
+{
+  char c = 0;
+  if (write(wakeup_[1], &c, 1) < 0)
+  {
+    // pipe full, the event loop wakes up anyway
+  }
+}
+
+
+void* Server::worker_main(void* _server)
+{
+  static_cast<Server*>(_server)->worker();
+  return NULL;
+}
+
+
+void Server::worker()
+{
+  while (true)
+  {
+    pthread_mutex_lock(&jobs_mutex_);
+    while (jobs_.empty() && !stop_)
+      pthread_cond_wait(&jobs_cond_, &jobs_mutex_);
+
+    if (stop_)
+    {
+      pthread_mutex_unlock(&jobs_mutex_);
+      return;
+    }
+
+    Client* client = jobs_.front();
+    jobs_.pop_front();
+    pthread_mutex_unlock(&jobs_mutex_);
+
+    process(client);
+    wakeup();
+  }
+}
+
+
+void Server::process(Client* _client)
+{
+  // take over a new view
+  pthread_mutex_lock(&_client->mutex);
+
+  bool closed     = _client->closed;
+  bool new_view   = _client->view_pending;
+  bool reset      = new_view && !_client->has_view;
+  bool compressed = _client->compressed;
+  unsigned int generation = _client->generation;
+  ViewingParameters view = _client->view;
+
+  if (new_view)
+  {
+    _client->view_pending  = false;
+    _client->has_view      = true;
+    _client->complete_sent = false;
+  }
+  pthread_mutex_unlock(&_client->mutex);
+
+  // refine outside of the lock, only this worker uses the session
+  std::string batch;
+  bool        complete = false;
+
+  if (!closed)
+  {
+    if (reset)
+      _client->session.set_compressed(compressed);
+    if (new_view)
+      _client->session.set_viewing_parameters(view);
+
+    std::ostringstream vsplits;
+    size_t n = _client->session.next_batch(batch_, vsplits);
+
+    if (n > 0)
+    {
+      bool swap = Endian::local() != Endian::LSB;
+      std::ostringstream payload;
+      IO::store(payload, (unsigned int) n, swap);
+      payload << vsplits.str();
+      batch = message(kMsgVSplits, payload.str());
+    }
+
+    complete = _client->session.complete();
+  }
+
+  pthread_mutex_lock(&_client->mutex);
+
+  // the client re-requested the base mesh while the batch was built, the
+  // batch refines the old front and must not follow the new base mesh
+  if (_client->generation != generation)
+  {
+    _client->job_queued = false;
+    pthread_mutex_unlock(&_client->mutex);
+    return;
+  }
+
+  _client->out += batch;
+
+  // a newer view may have arrived meanwhile, then the next job reports it
+  if (complete && !_client->view_pending && !_client->complete_sent)
+  {
+    _client->out += message(kMsgRefinementComplete, std::string());
+    _client->complete_sent = true;
+  }
+
+  _client->job_queued = false;
+  pthread_mutex_unlock(&_client->mutex);
+}
+
+
+// ------------------------------------------------------------------ main ----
+
+int main(int argc, char **argv)
+{
+  int             c;
+  unsigned short  port      = VDPM_STREAMING_PORT;
+  std::string     local;
+  unsigned int    n_workers = 4;
+  size_t          batch     = 16384;
+  size_t          watermark = 65536;
+
+  while ( (c=getopt(argc, argv, "b:hm:p:u:w:"))!=-1 )
+  {
+    switch(c)
+    {
+      case 'b': batch     = (size_t) atol(optarg); break;
+      case 'm': watermark = (size_t) atol(optarg); break;
+      case 'p': port      = (unsigned short) atoi(optarg); break;
+      case 'u': local     = optarg; break;
+      case 'w': n_workers = (unsigned int) atoi(optarg); break;
+      case 'h': usage_and_exit(0);
+      default:  usage_and_exit(1);
+    }
+  }
+
+  if (optind >= argc || n_workers == 0 || batch == 0)
+    usage_and_exit(1);
+
+  signal(SIGPIPE, SIG_IGN);
+
+  StreamingModel model;
+  if (!model.open(argv[optind]))
+  {
+    std::cerr << "Error: could not read " << argv[optind] << std::endl;
+    return 1;
+  }
+
+  std::cout << model.n_base_vertices() << " base vertices, "
+            << model.n_details() << " detail vertices\n";
+
+  Server server(model, batch, watermark);
+
+  if (local.empty() ? !server.listen_tcp(port) : !server.listen_local(local))
+  {
+    std::cerr << "Error: could not listen: " << strerror(errno) << std::endl;
+    return 1;
+  }
+
+  if (local.empty())
+    std::cout << "listening on port " << port;
+  else
+    std::cout << "listening on " << local;
+  std::cout << " with " << n_workers << " workers" << std::endl;
+
+  server.run(n_workers);
+
+  return 0;
+}
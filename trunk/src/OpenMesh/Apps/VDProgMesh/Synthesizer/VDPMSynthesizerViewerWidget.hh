@@ -64,6 +64,7 @@
 #include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
 #include <OpenMesh/Tools/VDPM/VHierarchy.hh>
 #include <OpenMesh/Tools/VDPM/VFront.hh>
+#include <OpenMesh/Tools/VDPM/AdaptiveRefinerT.hh>
 
 
 //== FORWARDDECLARATIONS ======================================================
@@ -100,6 +101,7 @@ typedef MeshViewerWidgetT<VDPMMesh>		MeshViewerWidget;
   using VDPM::VHierarchyNodeHandle;
   using VDPM::VHierarchyNodeHandleContainer;
   using VDPM::ViewingParameters;
+  using VDPM::AdaptiveRefinerT;
 
 
 //== CLASS DEFINITION =========================================================
@@ -127,28 +129,12 @@ private:
   VHierarchy          vhierarchy_;
   VFront              vfront_;
   ViewingParameters   viewing_parameters_;
-  float               kappa_square_;
+  AdaptiveRefinerT<VDPMMesh> refiner_;
   bool                adaptive_mode_;
 
-  unsigned int        n_base_vertices_;
-  unsigned int        n_base_edges_;
-  unsigned int        n_base_faces_;
-  unsigned int        n_details_;
-
     
 private:
 
-  bool outside_view_frustum(const OpenMesh::Vec3f &pos, float radius);
-
-  bool oriented_away(float sin_square, 
-		     float distance_square, 
-		     float product_value);
-
-  bool screen_space_error(float mue_square, 
-			  float sigma_square, 
-			  float distance_square, 
-			  float product_value);
-
   void update_viewing_parameters();
 
   virtual void keyPressEvent(QKeyEvent* _event);
@@ -161,24 +147,6 @@ protected:
 public:
 
   void adaptive_refinement();	
-
-  bool qrefine(VHierarchyNodeHandle _node_handle);		
-
-  void force_vsplit(VHierarchyNodeHandle _node_handle);
-
-  bool ecol_legal(VHierarchyNodeHandle _parent_handle, 
-		  VDPMMesh::HalfedgeHandle& v0v1);
-
-  void get_active_cuts(VHierarchyNodeHandle _node_handle, 
-		       VDPMMesh::VertexHandle &vl, VDPMMesh::VertexHandle &vr);
-
-  void vsplit(VHierarchyNodeHandle _node_handle, 
-	      VDPMMesh::VertexHandle vl, VDPMMesh::VertexHandle vr);
-
-  void ecol(VHierarchyNodeHandle _parent_handle, 
-	    const VDPMMesh::HalfedgeHandle& v0v1);
-
-  void init_vfront();
  
 };
 
@@ -83,7 +83,7 @@ int main(int argc, char **argv)
     w->open_vd_prog_mesh(argv[1]);
   else
   {
-    std::cerr << "Usage: vdpmsynthesizer <vdpm-file.spm>\n";
+    std::cerr << "Usage: vdpmsynthesizer <vdpm-file.spm|vdpm-file.pspm>\n";
     return 1;
   }
 
@@ -0,0 +1,606 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+//
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <dirent.h>
+#  include <sys/stat.h>
+#endif
+#ifdef USE_OPENMP
+#  include <omp.h>
+#endif
+//
+#include <OpenMesh/Core/IO/MeshIO.hh>
+#include <OpenMesh/Tools/Utils/Timer.hh>
+//
+#include "BatchConverter.hh"
+
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+std::string lower_case(std::string _s)
+{
+  std::transform(_s.begin(), _s.end(), _s.begin(), ::tolower);
+  return _s;
+}
+
+
+std::string extension(const std::string& _filename)
+{
+  std::string::size_type dot   = _filename.rfind('.');
+  std::string::size_type slash = _filename.find_last_of("/\\");
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+    return std::string();
+  return lower_case(_filename.substr(dot+1));
+}
+
+
+std::string basename(const std::string& _filename)
+{
+  std::string::size_type slash = _filename.find_last_of("/\\");
+  std::string name = slash == std::string::npos
+    ? _filename : _filename.substr(slash+1);
+  std::string::size_type dot = name.rfind('.');
+  return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+
+std::string directory(const std::string& _filename)
+{
+  std::string::size_type slash = _filename.find_last_of("/\\");
+  return slash == std::string::npos
+    ? std::string() : _filename.substr(0, slash+1);
+}
+
+
+size_t file_size(const std::string& _filename)
+{
+  std::ifstream ifs(_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!ifs)
+    return 0;
+  ifs.seekg(0, std::ios::end);
+  return static_cast<size_t>(ifs.tellg());
+}
+
+
+// Extensions of all registered readers, parsed from the "*.ext" tokens of
+// the read filters.
+std::vector<std::string> readable_extensions()
+{
+  std::vector<std::string> exts;
+  const std::string& filters = OpenMesh::IO::IOManager().qt_read_filters();
+
+  std::string::size_type pos = 0;
+  while ((pos = filters.find("*.", pos)) != std::string::npos)
+  {
+    pos += 2;
+    std::string::size_type end = filters.find_first_of(" );", pos);
+    std::string ext = lower_case(filters.substr(pos, end - pos));
+    if (!ext.empty() && std::find(exts.begin(), exts.end(), ext) == exts.end())
+      exts.push_back(ext);
+  }
+  return exts;
+}
+
+
+bool larger_input(const BatchConverter::Job& _a, const BatchConverter::Job& _b)
+{
+  return _a.input_size > _b.input_size;
+}
+
+
+// Rate of _amount per second, or "-" if _seconds is below the resolution of
+// the timer and the quotient would be meaningless.
+std::string throughput(double _amount, double _seconds, int _precision)
+{
+  if (_seconds < 1e-4)
+    return "-";
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(_precision) << _amount / _seconds;
+  return os.str();
+}
+
+
+#ifdef USE_OPENMP
+// Reader ("r.ext") and writer ("w.ext") modules that keep no per-file state
+// in members and can be used by several threads at once. All others (OBJ,
+// OFF, OM and PLY readers, OBJ and PLY writers, unknown formats) are locked.
+bool is_reentrant(const std::string& _key)
+{
+  static const char* keys[] = { "r.stl", "r.stla", "r.stlb",
+                                "w.stl", "w.stla", "w.stlb",
+                                "w.off", "w.om", "w.vtk" };
+  for (size_t i = 0; i < sizeof(keys)/sizeof(keys[0]); ++i)
+    if (_key == keys[i])
+      return true;
+  return false;
+}
+#endif
+
+
+const char* stage_name(int _stage)
+{
+  static const char* names[] = { "read", "process", "write" };
+  return names[_stage];
+}
+
+} // namespace
+
+
+// ----------------------------------------------------------------------------
+
+size_t weld_vertices(const MyMesh& _mesh, MyMesh& _welded)
+{
+  typedef std::map<MyMesh::Point, MyMesh::VertexHandle> PointMap;
+
+  PointMap                          points;
+  std::vector<MyMesh::VertexHandle> vmap(_mesh.n_vertices());
+
+  _welded.resize(0, 0, 0);
+  _welded.reserve(_mesh.n_vertices(), _mesh.n_edges(), _mesh.n_faces());
+
+  MyMesh::ConstVertexIter vit = _mesh.vertices_begin();
+  for (; vit != _mesh.vertices_end(); ++vit)
+  {
+    const MyMesh::Point& p = _mesh.point(*vit);
+    PointMap::iterator it = points.find(p);
+    if (it == points.end())
+    {
+      MyMesh::VertexHandle vh = _welded.add_vertex(p);
+      _welded.set_normal(vh, _mesh.normal(*vit));
+      _welded.set_color(vh, _mesh.color(*vit));
+      _welded.set_texcoord2D(vh, _mesh.texcoord2D(*vit));
+      it = points.insert(std::make_pair(p, vh)).first;
+    }
+    vmap[vit->idx()] = it->second;
+  }
+
+  std::vector<MyMesh::VertexHandle> fvh;
+  MyMesh::ConstFaceIter fit = _mesh.faces_begin();
+  for (; fit != _mesh.faces_end(); ++fit)
+  {
+    fvh.clear();
+    MyMesh::ConstFaceVertexIter fvit = _mesh.cfv_iter(*fit);
+    for (; fvit.is_valid(); ++fvit)
+      fvh.push_back(vmap[fvit->idx()]);
+
+    // faces that collapse to an edge or a point are dropped
+    if (fvh[0] == fvh[1] || fvh[1] == fvh[2] || fvh[0] == fvh[2])
+      continue;
+
+    MyMesh::FaceHandle fh = _welded.add_face(fvh);
+    if (fh.is_valid())
+    {
+      _welded.set_normal(fh, _mesh.normal(*fit));
+      _welded.set_color(fh, _mesh.color(*fit));
+    }
+  }
+
+  return _mesh.n_vertices() - _welded.n_vertices();
+}
+
+
+// ----------------------------------------------------------------------------
+
+/// One lock per reader and per writer format whose module keeps per-file
+/// state. Reentrant formats and, without OpenMP, all formats are not locked.
+class BatchConverter::FormatLocks
+{
+public:
+
+  explicit FormatLocks(const std::vector<Job>& _jobs, const std::string& _out_ext)
+  {
+#ifdef USE_OPENMP
+    for (size_t i = 0; i < _jobs.size(); ++i)
+      init("r." + extension(_jobs[i].input));
+    init("w." + _out_ext);
+#else
+    (void)_jobs; (void)_out_ext;
+#endif
+  }
+
+  ~FormatLocks()
+  {
+#ifdef USE_OPENMP
+    for (LockMap::iterator it = locks_.begin(); it != locks_.end(); ++it)
+    {
+      omp_destroy_lock(it->second);
+      delete it->second;
+    }
+#endif
+  }
+
+  void set(const std::string& _key)
+  {
+#ifdef USE_OPENMP
+    LockMap::iterator it = locks_.find(_key);
+    if (it != locks_.end())
+      omp_set_lock(it->second);
+#else
+    (void)_key;
+#endif
+  }
+
+  void unset(const std::string& _key)
+  {
+#ifdef USE_OPENMP
+    LockMap::iterator it = locks_.find(_key);
+    if (it != locks_.end())
+      omp_unset_lock(it->second);
+#else
+    (void)_key;
+#endif
+  }
+
+private:
+
+#ifdef USE_OPENMP
+  typedef std::map<std::string, omp_lock_t*> LockMap;
+
+  void init(const std::string& _key)
+  {
+    if (!is_reentrant(_key) && locks_.find(_key) == locks_.end())
+    {
+      omp_lock_t* lock = new omp_lock_t;
+      omp_init_lock(lock);
+      locks_[_key] = lock;
+    }
+  }
+
+  LockMap locks_;
+#endif
+};
+
+
+// ----------------------------------------------------------------------------
+
+BatchConverter::BatchConverter()
+  : out_ext_("off"),
+    n_threads_(0),
+    compute_normals_(false),
+    weld_(false)
+{
+}
+
+
+void BatchConverter::set_output_format(const std::string& _ext)
+{
+  out_ext_ = lower_case(_ext);
+  if (!out_ext_.empty() && out_ext_[0] == '.')
+    out_ext_.erase(0, 1);
+}
+
+
+void BatchConverter::add_file(const std::string& _filename)
+{
+  Job job;
+  job.input = _filename;
+  jobs_.push_back(job);
+}
+
+
+bool BatchConverter::add_file_list(const std::string& _filename)
+{
+  std::ifstream ifs(_filename.c_str());
+  if (!ifs)
+    return false;
+
+  std::string line;
+  while (std::getline(ifs, line))
+  {
+    // strip trailing white space (including '\r' of DOS line endings)
+    std::string::size_type end = line.find_last_not_of(" \t\r");
+    if (end == std::string::npos || line[0] == '#')
+      continue;
+    add_file(line.substr(0, end+1));
+  }
+  return true;
+}
+
+
+bool BatchConverter::add_directory(const std::string& _dir)
+{
+  std::vector<std::string> exts = readable_extensions();
+  std::vector<std::string> names;
+
+  std::string dir = _dir;
+  if (!dir.empty() && dir[dir.size()-1] != '/' && dir[dir.size()-1] != '\\')
+    dir += '/';
+
+#if defined(_WIN32)
+  WIN32_FIND_DATAA data;
+  HANDLE handle = FindFirstFileA((dir + "*").c_str(), &data);
+  if (handle == INVALID_HANDLE_VALUE)
+    return false;
+  do
+  {
+    if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+      names.push_back(data.cFileName);
+  } while (FindNextFileA(handle, &data));
+  FindClose(handle);
+#else
+  DIR* handle = opendir(dir.c_str());
+  if (!handle)
+    return false;
+  while (struct dirent* entry = readdir(handle))
+  {
+    struct stat st;
+    if (stat((dir + entry->d_name).c_str(), &st) == 0 && S_ISREG(st.st_mode))
+      names.push_back(entry->d_name);
+  }
+  closedir(handle);
+#endif
+
+  std::sort(names.begin(), names.end());
+  for (size_t i = 0; i < names.size(); ++i)
+    if (std::find(exts.begin(), exts.end(), extension(names[i])) != exts.end())
+      add_file(dir + names[i]);
+
+  return true;
+}
+
+
+// ----------------------------------------------------------------------------
+
+size_t BatchConverter::run()
+{
+  // Create the reader and writer modules before any thread uses them.
+  OpenMesh::IO::IOManager();
+
+  for (size_t i = 0; i < jobs_.size(); ++i)
+  {
+    Job& job = jobs_[i];
+    job.input_size = file_size(job.input);
+    job.output = (out_dir_.empty() ? directory(job.input) : out_dir_ + "/")
+               + basename(job.input) + "." + out_ext_;
+  }
+
+  // Inputs that differ only by extension would be written to the same file.
+  std::map<std::string, size_t> outputs;
+  for (size_t i = 0; i < jobs_.size(); ++i)
+    if (++outputs[jobs_[i].output] > 1)
+      jobs_[i].error = "output collides with a previous input";
+
+  // Large files first, so no thread is left with a big file at the end.
+  std::stable_sort(jobs_.begin(), jobs_.end(), larger_input);
+
+  FormatLocks locks(jobs_, out_ext_);
+
+  int n_threads = 1;
+#ifdef USE_OPENMP
+  n_threads = n_threads_ > 0 ? n_threads_ : omp_get_max_threads();
+#endif
+
+  std::cout << "converting " << jobs_.size() << " files to ." << out_ext_
+            << " with " << n_threads << " thread(s)" << std::endl;
+
+  OpenMesh::Utils::Timer wall;
+  wall.start();
+
+  long n_jobs = static_cast<long>(jobs_.size());
+
+#ifdef USE_OPENMP
+#pragma omp parallel num_threads(n_threads)
+#endif
+  {
+    // reused for all files converted by this thread
+    MyMesh mesh, welded;
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (long i = 0; i < n_jobs; ++i)
+    {
+      convert(jobs_[i], mesh, welded, locks);
+
+#ifdef USE_OPENMP
+#pragma omp critical (mconvert_report)
+#endif
+      print_job(jobs_[i], i);
+    }
+  }
+
+  wall.stop();
+  print_report(wall.seconds());
+
+  size_t n_failed = 0;
+  for (size_t i = 0; i < jobs_.size(); ++i)
+    if (!jobs_[i].ok)
+      ++n_failed;
+  return n_failed;
+}
+
+
+// ----------------------------------------------------------------------------
+
+void BatchConverter::convert(Job& _job, MyMesh& _mesh, MyMesh& _welded,
+                             FormatLocks& _locks) const
+{
+  OpenMesh::Utils::Timer timer;
+
+  if (!_job.error.empty())
+    return;
+  if (_job.output == _job.input)
+  {
+    _job.error = "output would overwrite input";
+    return;
+  }
+
+  // ---------------------------------------- read
+  OpenMesh::IO::Options ropt = ropt_;
+  std::string rkey = "r." + extension(_job.input);
+  bool rc;
+
+  timer.start();
+  _mesh.resize(0, 0, 0);
+  _locks.set(rkey);
+  rc = OpenMesh::IO::read_mesh(_mesh, _job.input, ropt, false);
+  _locks.unset(rkey);
+  timer.stop();
+
+  _job.stats[Read].seconds = timer.seconds();
+  _job.stats[Read].bytes   = _job.input_size;
+  _job.stats[Read].faces   = _mesh.n_faces();
+  if (!rc)
+  {
+    _job.error = "read failed";
+    return;
+  }
+
+  // ---------------------------------------- process
+  MyMesh* result = &_mesh;
+
+  timer.start();
+  if (weld_)
+  {
+    weld_vertices(_mesh, _welded);
+    result = &_welded;
+  }
+  if (compute_normals_ && (weld_ || !ropt.vertex_has_normal()))
+  {
+    result->update_face_normals();
+    result->update_vertex_normals();
+  }
+  timer.stop();
+
+  _job.stats[Process].seconds = timer.seconds();
+  _job.stats[Process].faces   = result->n_faces();
+
+  // ---------------------------------------- write
+  std::string wkey = "w." + out_ext_;
+
+  timer.start();
+  _locks.set(wkey);
+  rc = OpenMesh::IO::write_mesh(*result, _job.output, wopt_);
+  _locks.unset(wkey);
+  timer.stop();
+
+  _job.stats[Write].seconds = timer.seconds();
+  _job.stats[Write].faces   = result->n_faces();
+  if (!rc)
+  {
+    _job.error = "write failed";
+    return;
+  }
+  _job.stats[Write].bytes = file_size(_job.output);
+  _job.ok = true;
+}
+
+
+// ----------------------------------------------------------------------------
+
+void BatchConverter::print_job(const Job& _job, size_t _index) const
+{
+  std::ostringstream os;
+  os << "[" << (_index+1) << "/" << jobs_.size() << "] " << _job.input;
+  if (!_job.ok)
+  {
+    os << ": " << _job.error;
+    std::cerr << os.str() << std::endl;
+    return;
+  }
+
+  double seconds = 0.0;
+  for (int s = 0; s < NumStages; ++s)
+    seconds += _job.stats[s].seconds;
+
+  os << " -> " << _job.output
+     << "  #F " << _job.stats[Write].faces
+     << "  " << std::fixed << std::setprecision(3) << seconds << "s";
+  std::cout << os.str() << std::endl;
+}
+
+
+void BatchConverter::print_report(double _wall_seconds) const
+{
+  StageStats total[NumStages];
+  size_t n_ok = 0;
+
+  for (size_t i = 0; i < jobs_.size(); ++i)
+  {
+    if (!jobs_[i].ok)
+      continue;
+    ++n_ok;
+    for (int s = 0; s < NumStages; ++s)
+      total[s].add(jobs_[i].stats[s]);
+  }
+
+  const double MB = 1024.0 * 1024.0;
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(2);
+
+  os << "\nfiles    " << n_ok << " converted, "
+     << (jobs_.size() - n_ok) << " failed\n";
+  os << "input    " << total[Read].bytes / MB << " MB, "
+     << total[Read].faces << " faces\n";
+  os << "output   " << total[Write].bytes / MB << " MB, "
+     << total[Write].faces << " faces\n\n";
+
+  // Stage times are summed over all threads, the throughput is the one of a
+  // single thread.
+  os << "stage        time [s]      MB/s     faces/s\n";
+  for (int s = 0; s < NumStages; ++s)
+  {
+    os << std::left << std::setw(10) << stage_name(s) << std::right
+       << std::setw(11) << total[s].seconds
+       << std::setw(10) << throughput(total[s].bytes / MB, total[s].seconds, 2)
+       << std::setw(12) << throughput(double(total[s].faces), total[s].seconds, 0)
+       << "\n";
+  }
+
+  os << "\nwall     " << _wall_seconds << " s, "
+     << throughput(double(n_ok), _wall_seconds, 2) << " files/s, "
+     << throughput(total[Read].bytes / MB, _wall_seconds, 2) << " MB/s, "
+     << throughput(double(total[Write].faces), _wall_seconds, 0) << " faces/s";
+
+  std::cout << os.str() << std::endl;
+}
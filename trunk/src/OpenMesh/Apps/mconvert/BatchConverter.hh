@@ -0,0 +1,193 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+#ifndef OPENMESH_APPS_MCONVERT_BATCHCONVERTER_HH
+#define OPENMESH_APPS_MCONVERT_BATCHCONVERTER_HH
+
+#include <string>
+#include <vector>
+//
+#include <OpenMesh/Core/IO/Options.hh>
+#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+#include <OpenMesh/Core/Mesh/Attributes.hh>
+
+
+struct MyTraits : public OpenMesh::DefaultTraits
+{
+  VertexAttributes  ( OpenMesh::Attributes::Normal       |
+		      OpenMesh::Attributes::Color        |
+                      OpenMesh::Attributes::TexCoord2D   );
+  HalfedgeAttributes( OpenMesh::Attributes::PrevHalfedge );
+  FaceAttributes    ( OpenMesh::Attributes::Normal       |
+		      OpenMesh::Attributes::Color        );
+};
+
+  
+typedef OpenMesh::TriMesh_ArrayKernelT<MyTraits> MyMesh;
+
+
+// ----------------------------------------------------------------------------
+
+/// Merge vertices with identical positions.
+///
+/// The welded mesh is built in _welded. Vertex attributes are taken from the
+/// first vertex at each position.
+///
+/// \return Number of removed vertices.
+size_t weld_vertices(const MyMesh& _mesh, MyMesh& _welded);
+
+
+// ----------------------------------------------------------------------------
+
+/** Converts many files with a pool of threads.
+
+    Each thread reuses its meshes for all files it converts. The stages of
+    each conversion (reading, processing and writing) are timed separately
+    and reported per file and in total.
+
+    Most reader and writer modules keep per-file state, so these formats
+    are read (and written) by one thread at a time. Reentrant modules (STL,
+    and the OFF, OM and VTK writers), processing and the conversion of
+    different formats run in parallel. Threads are only
+    used if OpenMesh is built with OpenMP (USE_OPENMP).
+*/
+class BatchConverter
+{
+public:
+
+  /// Processing stages of a conversion
+  enum Stage { Read, Process, Write, NumStages };
+
+  /// Time and data volume of one stage
+  struct StageStats
+  {
+    StageStats() : seconds(0.0), bytes(0), faces(0) {}
+
+    void add(const StageStats& _other)
+    {
+      seconds += _other.seconds;
+      bytes   += _other.bytes;
+      faces   += _other.faces;
+    }
+
+    double seconds;
+    size_t bytes;
+    size_t faces;
+  };
+
+  /// A single conversion
+  struct Job
+  {
+    Job() : input_size(0), ok(false) {}
+
+    std::string input;
+    std::string output;
+    size_t      input_size;
+    bool        ok;
+    std::string error;
+    StageStats  stats[NumStages];
+  };
+
+public:
+
+  BatchConverter();
+
+  /// Output directory, empty to write next to the input files
+  void set_output_directory(const std::string& _dir) { out_dir_ = _dir; }
+
+  /// Output format given as extension (e.g. "ply")
+  void set_output_format(const std::string& _ext);
+
+  /// Number of threads, 0 uses the number of processors
+  void set_threads(int _n) { n_threads_ = _n; }
+
+  /// Compute vertex normals if the input does not provide them
+  void set_compute_normals(bool _b) { compute_normals_ = _b; }
+
+  /// Merge vertices with identical positions
+  void set_weld(bool _b) { weld_ = _b; }
+
+  /// Reader options
+  void set_read_options(const OpenMesh::IO::Options& _opt) { ropt_ = _opt; }
+
+  /// Writer options
+  void set_write_options(const OpenMesh::IO::Options& _opt) { wopt_ = _opt; }
+
+  /// Add an input file
+  void add_file(const std::string& _filename);
+
+  /// Add all files listed in a text file (one per line).
+  /// \return false if the list could not be read.
+  bool add_file_list(const std::string& _filename);
+
+  /// Add all readable files of a directory.
+  /// \return false if the directory could not be read.
+  bool add_directory(const std::string& _dir);
+
+  /// Convert all files and print a report to std::cout.
+  /// \return Number of failed conversions.
+  size_t run();
+
+  /// The jobs after run()
+  const std::vector<Job>& jobs() const { return jobs_; }
+
+private:
+
+  class FormatLocks;
+
+  void convert(Job& _job, MyMesh& _mesh, MyMesh& _welded, FormatLocks& _locks) const;
+  void print_job(const Job& _job, size_t _index) const;
+  void print_report(double _wall_seconds) const;
+
+private:
+
+  std::string           out_dir_;
+  std::string           out_ext_;
+  int                   n_threads_;
+  bool                  compute_normals_;
+  bool                  weld_;
+  OpenMesh::IO::Options ropt_;
+  OpenMesh::IO::Options wopt_;
+  std::vector<Job>      jobs_;
+};
+
+
+#endif // OPENMESH_APPS_MCONVERT_BATCHCONVERTER_HH
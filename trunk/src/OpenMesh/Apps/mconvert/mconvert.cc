@@ -39,40 +39,33 @@
  *                                                                           *
 \*===========================================================================*/
 
+#include <cstdlib>
 #include <iostream>
 #include <iterator>
 #include <fstream>
 #include <string>
+#include <vector>
 //
 #include <OpenMesh/Core/IO/MeshIO.hh>
-#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
-#include <OpenMesh/Core/Mesh/Attributes.hh>
 #include <OpenMesh/Tools/Utils/Timer.hh>
 #include <OpenMesh/Tools/Utils/getopt.h>
+//
+#include "BatchConverter.hh"
 
 
-struct MyTraits : public OpenMesh::DefaultTraits
-{
-  VertexAttributes  ( OpenMesh::Attributes::Normal       |
-		      OpenMesh::Attributes::Color        |
-                      OpenMesh::Attributes::TexCoord2D   );
-  HalfedgeAttributes( OpenMesh::Attributes::PrevHalfedge );
-  FaceAttributes    ( OpenMesh::Attributes::Normal       |
-		      OpenMesh::Attributes::Color        );
-};
-
-  
-typedef OpenMesh::TriMesh_ArrayKernelT<MyTraits> MyMesh;
-
 void usage_and_exit(int xcode)
 {
    using std::cout;
    using std::endl;
    
-   cout << "\nUsage: mconvert [option] <input> [<output>]\n\n";
+   cout << "\nUsage: mconvert [option] <input> [<output>]\n"
+        << "       mconvert [option] -e <ext> [-L <list>] [-D <dir>] [<input> ...]\n\n";
    cout << "   Convert from one 3D geometry format to another.\n"
         << "   Or simply display some information about the object\n"
         << "   stored in <input>.\n"
+        << "   The second form converts many files in parallel to the\n"
+        << "   format given by <ext> and reports the throughput of each\n"
+        << "   processing stage.\n"
         << endl;
    cout << "Options:\n"
         << endl;
@@ -90,6 +83,14 @@ void usage_and_exit(int xcode)
    cout << "  -t\tCopy vertex texture coordinates if provided by input file.\n" << endl;
    cout << "  -T \"x y z\"\tTranslate object by vector (x, y, z)'\"\n"
         << std::endl;
+   cout << "  -w\tWeld vertices with identical positions.\n" << endl;
+   cout << "Batch options:\n"
+        << endl;
+   cout << "  -e <ext>\tConvert all inputs to format <ext> (e.g. ply).\n" << endl;
+   cout << "  -L <list>\tConvert the files listed in <list>, one per line.\n" << endl;
+   cout << "  -D <dir>\tConvert all readable files in <dir>.\n" << endl;
+   cout << "  -O <dir>\tWrite to <dir> instead of next to the inputs.\n" << endl;
+   cout << "  -j <n>\tUse <n> threads (default: number of processors).\n" << endl;
    cout << endl;
    
    exit(xcode);
@@ -144,11 +145,16 @@ int main(int argc, char *argv[] )
   std::string ifname, ofname;
   bool rev_normals = false;
   bool obj_center  = false;
+  bool weld        = false;
   OpenMesh::IO::Options opt, ropt;
 
+  std::string              out_ext, out_dir;
+  std::vector<std::string> lists, dirs;
+  int                      n_threads = 0;
+
   Option< MyMesh::Point > tvec;
 
-  while ( (c=getopt(argc, argv, "bBcdCi:hlmnNo:sStT:"))!=-1 )
+  while ( (c=getopt(argc, argv, "bBcdCD:e:i:j:hlL:mnNo:O:sStT:w"))!=-1 )
   {
     switch(c)
     {
@@ -174,6 +180,12 @@ int main(int argc, char *argv[] )
       }
       case 'i': ifname = optarg; break;
       case 'o': ofname = optarg; break;
+      case 'w': weld = true; break;
+      case 'e': out_ext = optarg; break;
+      case 'L': lists.push_back(optarg); break;
+      case 'D': dirs.push_back(optarg); break;
+      case 'O': out_dir = optarg; break;
+      case 'j': n_threads = atoi(optarg); break;
       case 'h':
         usage_and_exit(0);
       case '?':
@@ -182,6 +194,45 @@ int main(int argc, char *argv[] )
     }
   }
 
+  // ------------------------------------------------------------ batch mode
+
+  if (!out_ext.empty() || !lists.empty() || !dirs.empty())
+  {
+    if (out_ext.empty())
+    {
+      std::cerr << "Batch mode requires the output format (-e)." << std::endl;
+      usage_and_exit(1);
+    }
+
+    BatchConverter batch;
+    batch.set_output_format(out_ext);
+    batch.set_output_directory(out_dir);
+    batch.set_threads(n_threads);
+    batch.set_compute_normals(opt.vertex_has_normal());
+    batch.set_weld(weld);
+    batch.set_read_options(ropt);
+    batch.set_write_options(opt);
+
+    if (!ifname.empty())
+      batch.add_file(ifname);
+    for (; optind < argc; ++optind)
+      batch.add_file(argv[optind]);
+    for (size_t i = 0; i < lists.size(); ++i)
+      if (!batch.add_file_list(lists[i]))
+        std::cerr << "Cannot read file list " << lists[i] << std::endl;
+    for (size_t i = 0; i < dirs.size(); ++i)
+      if (!batch.add_directory(dirs[i]))
+        std::cerr << "Cannot read directory " << dirs[i] << std::endl;
+
+    if (batch.jobs().empty())
+    {
+      std::cerr << "No input files." << std::endl;
+      return 1;
+    }
+
+    return batch.run() ? 1 : 0;
+  }
+
   if (ifname.empty())
   { 
     if (optind < argc)
@@ -247,6 +298,21 @@ int main(int argc, char *argv[] )
 
   // ------------------------------------------------------------ features
 
+  // ---------------------------------------- weld feature
+  if ( weld )
+  {
+    std::cout << "weld vertices" << std::endl;
+
+    MyMesh welded;
+    timer.start();
+    size_t n = weld_vertices(mesh, welded);
+    mesh = welded;
+    timer.stop();
+    std::cout << "  removed " << n
+              << " vertices in " << timer.as_string() << std::endl;
+    timer.reset();
+  }
+
   // ---------------------------------------- compute normal feature
   if ( opt.vertex_has_normal() && !ropt.vertex_has_normal())
   {
@@ -123,8 +123,19 @@ merge(const NormalConeT& _cone)
 
   if (fabs(dotp) < 0.99999f)
   {
-    // new angle
     Scalar centerAngle = acos(dotp);
+
+    // one cone encloses the other, no need to interpolate the axis
+    if (centerAngle + _cone.angle_ <= angle_)
+      return;
+
+    if (centerAngle + angle_ <= _cone.angle_)
+    {
+      *this = _cone;
+      return;
+    }
+
+    // new angle
     Scalar minAngle    = std::min(-angle(), centerAngle - _cone.angle());
     Scalar maxAngle    = std::max( angle(), centerAngle + _cone.angle());
     angle_     = (maxAngle - minAngle) * Scalar(0.5f);
@@ -148,6 +159,24 @@ merge(const NormalConeT& _cone)
 }
 
 
+//----------------------------------------------------------------------------
+
+
+template <typename Scalar>
+Scalar
+NormalConeT<Scalar>::
+merged_angle(const Vec3& _norm) const
+{
+  Scalar dotp = (center_normal_ | _norm);
+
+  // same as merge(), the minimum angle of the merged cone is -angle_
+  if (fabs(dotp) < 0.99999f)
+    return (std::max(angle_, Scalar(acos(dotp))) + angle_) * Scalar(0.5f);
+
+  return (dotp > 0.0f) ? angle_ : Scalar(2.0f * M_PI);
+}
+
+
 //=============================================================================
 } // namespace OpenMesh
 //=============================================================================
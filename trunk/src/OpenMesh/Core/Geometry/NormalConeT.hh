@@ -98,6 +98,10 @@ public:
   //! merge _cone; this instance will then enclose both former cones
   void merge(const NormalConeT&);
 
+  //! return the angle this cone would have after merging the unit vector
+  //! _norm, i.e. merge(NormalConeT(_norm)) without changing the cone
+  Scalar merged_angle(const Vec3& _norm) const;
+
   //! returns center normal
   const Vec3& center_normal() const { return center_normal_; }
 
@@ -58,6 +58,8 @@
 #include "Config.hh"
 #include <OpenMesh/Core/Geometry/VectorT.hh>
 #include <OpenMesh/Core/Utils/GenProg.hh>
+#include <vector>
+#include <algorithm>
 
 //== NAMESPACE ================================================================
 
@@ -201,6 +203,38 @@ public:
     return evaluate(_v, GenProg::Int2Type<_Vec::size_>());
   }
 
+  /** Find the 3D point _v at which the quadric is minimal.
+   *
+   *  Solves the 3x3 linear system of the quadric. Returns false and leaves
+   *  _v unchanged if the system is ill-conditioned, i.e. if the determinant
+   *  of the 3x3 block is at most _eps times the cube of its trace. This is
+   *  the case if the quadric is minimal along a line or plane, e.g. for
+   *  the planes of a flat or cylindrical region.
+   */
+  template <class _Vec3>
+  bool minimizer(_Vec3& _v, Scalar _eps = Scalar(1e-10)) const
+  {
+    // cofactors of the symmetric 3x3 block
+    const Scalar c00 = e_*h_ - f_*f_;
+    const Scalar c01 = c_*f_ - b_*h_;
+    const Scalar c02 = b_*f_ - c_*e_;
+    const Scalar c11 = a_*h_ - c_*c_;
+    const Scalar c12 = b_*c_ - a_*f_;
+    const Scalar c22 = a_*e_ - b_*b_;
+
+    const Scalar det   = a_*c00 + b_*c01 + c_*c02;
+    const Scalar trace = a_ + e_ + h_;
+
+    if (!(det > _eps * trace*trace*trace))
+      return false;
+
+    const Scalar inv = Scalar(-1) / det;
+    _v[0] = typename _Vec3::value_type((c00*d_ + c01*g_ + c02*i_) * inv);
+    _v[1] = typename _Vec3::value_type((c01*d_ + c11*g_ + c12*i_) * inv);
+    _v[2] = typename _Vec3::value_type((c02*d_ + c12*g_ + c22*i_) * inv);
+    return true;
+  }
+
   Scalar a() const { return a_; }
   Scalar b() const { return b_; }
   Scalar c() const { return c_; }
@@ -263,6 +297,141 @@ typedef QuadricT<float> Quadricf;
 typedef QuadricT<double> Quadricd;
 
 
+//== CLASS DEFINITION =========================================================
+
+
+/** /class QuadricBatchT Geometry/QuadricT.hh
+
+    Evaluates many quadrics, each at its own point, in one call.
+
+    The quadrics and points are stored in blocks of \c block_size entries.
+    Each block holds every coefficient of its entries next to each other
+    (structure of arrays), so evaluate() processes one block per iteration
+    with SIMD instructions. The template parameter selects the precision
+    of the evaluation: float gives twice as many SIMD lanes as double.
+
+    For a double batch the results are identical to QuadricT::operator().
+
+    \code
+    QuadricBatchd batch;
+    batch.clear();
+    for (...)
+      batch.push_back(q, p);
+    std::vector<double> errors(batch.size());
+    batch.evaluate(&errors[0]);
+    \endcode
+**/
+
+template <class Scalar>
+class QuadricBatchT
+{
+public:
+
+  typedef Scalar value_type;
+
+  /// Number of entries per block
+  enum { block_size = 4 };
+
+  /// Construct an empty batch
+  QuadricBatchT() : size_(0) {}
+
+  /// Remove all entries, the memory is kept for the next batch
+  void clear() { size_ = 0; }
+
+  /// Number of entries
+  size_t size() const { return size_; }
+
+  /// Reserve memory for _n entries
+  void reserve(size_t _n) { blocks_.reserve((_n + block_size - 1) / block_size); }
+
+  /// Add quadric _q, to be evaluated at 3D point _p
+  template <class _Scalar, class _Point>
+  void push_back(const QuadricT<_Scalar>& _q, const _Point& _p)
+  {
+    const size_t lane = size_ % block_size;
+
+    // new blocks are cleared, unused lanes keep finite values of earlier
+    // entries and are never written to the results
+    if (lane == 0 && blocks_.size() * block_size == size_)
+      blocks_.push_back(Block());
+
+    Block& block = blocks_[size_ / block_size];
+
+    block.a[lane] = Scalar(_q.a());
+    block.b[lane] = Scalar(_q.b());
+    block.c[lane] = Scalar(_q.c());
+    block.d[lane] = Scalar(_q.d());
+    block.e[lane] = Scalar(_q.e());
+    block.f[lane] = Scalar(_q.f());
+    block.g[lane] = Scalar(_q.g());
+    block.h[lane] = Scalar(_q.h());
+    block.i[lane] = Scalar(_q.i());
+    block.j[lane] = Scalar(_q.j());
+    block.x[lane] = Scalar(_p[0]);
+    block.y[lane] = Scalar(_p[1]);
+    block.z[lane] = Scalar(_p[2]);
+
+    ++size_;
+  }
+
+  /// Evaluate all quadrics at their points, writes size() values to _errors
+  template <class T>
+  void evaluate(T* _errors) const
+  {
+    const Scalar two(2);
+    Scalar       err[block_size];
+
+    for (size_t k = 0, n = 0; n < size_; ++k, n += block_size)
+    {
+      const Block& bl = blocks_[k];
+
+      // same order of operations as QuadricT::evaluate()
+      for (int l = 0; l < block_size; ++l)
+      {
+        const Scalar x(bl.x[l]), y(bl.y[l]), z(bl.z[l]);
+        err[l] = bl.a[l]*x*x + two*bl.b[l]*x*y + two*bl.c[l]*x*z + two*bl.d[l]*x
+                             +     bl.e[l]*y*y + two*bl.f[l]*y*z + two*bl.g[l]*y
+                                               +     bl.h[l]*z*z + two*bl.i[l]*z
+                                                                 +     bl.j[l];
+      }
+
+      const size_t m = std::min(size_t(block_size), size_ - n);
+      for (size_t l = 0; l < m; ++l)
+        _errors[n + l] = T(err[l]);
+    }
+  }
+
+private:
+
+  /// block_size entries, stored by coefficient
+  struct Block
+  {
+    Block()
+    {
+      for (int l = 0; l < block_size; ++l)
+        a[l] = b[l] = c[l] = d[l] = e[l] = f[l] = g[l] = h[l] = i[l] = j[l]
+             = x[l] = y[l] = z[l] = Scalar(0);
+    }
+
+    Scalar a[block_size], b[block_size], c[block_size], d[block_size],
+                          e[block_size], f[block_size], g[block_size],
+                                         h[block_size], i[block_size],
+                                                        j[block_size];
+    Scalar x[block_size], y[block_size], z[block_size];
+  };
+
+  std::vector<Block> blocks_;
+  size_t             size_;
+};
+
+
+/// Batch of quadrics evaluated with floats
+typedef QuadricBatchT<float> QuadricBatchf;
+
+/// Batch of quadrics evaluated with doubles
+typedef QuadricBatchT<double> QuadricBatchd;
+
+
 //=============================================================================
 } // END_NS_GEOMETRY
 } // END_NS_OPENMESH
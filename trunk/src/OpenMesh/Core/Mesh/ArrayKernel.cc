@@ -170,6 +170,115 @@ void ArrayKernel::garbage_collection(bool _v, bool _e, bool _f)
   garbage_collection( empty_vh,empty_hh,empty_fh,_v, _e, _f);
 }
 
+void ArrayKernel::permute(const std::vector<unsigned int>& _vertex_order,
+                          const std::vector<unsigned int>& _edge_order,
+                          const std::vector<unsigned int>& _face_order)
+{
+  const int nV = int(n_vertices());
+  const int nE = int(n_edges());
+  const int nF = int(n_faces());
+  int i, j, k;
+
+  assert(_vertex_order.empty() || _vertex_order.size() == n_vertices());
+  assert(_edge_order.empty()   || _edge_order.size()   == n_edges());
+  assert(_face_order.empty()   || _face_order.size()   == n_faces());
+
+  // old to new handle mapping
+  std::vector<int> vh_map(nV), hh_map(2*nE), fh_map(nF);
+
+  for (i=0; i<nV; ++i)
+    vh_map[_vertex_order.empty() ? i : _vertex_order[i]] = i;
+  for (i=0; i<nE; ++i)
+  {
+    j = _edge_order.empty() ? i : _edge_order[i];
+    hh_map[2*j]   = 2*i;
+    hh_map[2*j+1] = 2*i+1;
+  }
+  for (i=0; i<nF; ++i)
+    fh_map[_face_order.empty() ? i : _face_order[i]] = i;
+
+
+  // Apply the permutations cycle by cycle with the same swaps that are
+  // used by the garbage collection, so all properties follow their items.
+  std::vector<bool> done;
+
+  if (!_vertex_order.empty())
+  {
+    done.assign(nV, false);
+    for (i=0; i<nV; ++i)
+    {
+      for (j=i; !done[j]; j=k)
+      {
+        done[j] = true;
+        k = _vertex_order[j];
+        if (k == i) break;
+        std::swap(vertices_[j], vertices_[k]);
+        vprops_swap(j, k);
+      }
+    }
+  }
+
+  if (!_edge_order.empty())
+  {
+    done.assign(nE, false);
+    for (i=0; i<nE; ++i)
+    {
+      for (j=i; !done[j]; j=k)
+      {
+        done[j] = true;
+        k = _edge_order[j];
+        if (k == i) break;
+        std::swap(edges_[j], edges_[k]);
+        eprops_swap(j, k);
+        hprops_swap(2*j,   2*k);
+        hprops_swap(2*j+1, 2*k+1);
+      }
+    }
+  }
+
+  if (!_face_order.empty())
+  {
+    done.assign(nF, false);
+    for (i=0; i<nF; ++i)
+    {
+      for (j=i; !done[j]; j=k)
+      {
+        done[j] = true;
+        k = _face_order[j];
+        if (k == i) break;
+        std::swap(faces_[j], faces_[k]);
+        fprops_swap(j, k);
+      }
+    }
+  }
+
+
+  // update handles of vertices
+  for (i=0; i<nV; ++i)
+  {
+    VertexHandle vh(i);
+    if (!is_isolated(vh))
+      set_halfedge_handle(vh, HalfedgeHandle(hh_map[halfedge_handle(vh).idx()]));
+  }
+
+  // update handles of halfedges
+  for (i=0; i<2*nE; ++i)
+  {
+    HalfedgeHandle hh(i);
+    set_vertex_handle(hh, VertexHandle(vh_map[to_vertex_handle(hh).idx()]));
+    set_next_halfedge_handle(hh, HalfedgeHandle(hh_map[next_halfedge_handle(hh).idx()]));
+    if (!is_boundary(hh))
+      set_face_handle(hh, FaceHandle(fh_map[face_handle(hh).idx()]));
+  }
+
+  // update handles of faces
+  for (i=0; i<nF; ++i)
+  {
+    FaceHandle fh(i);
+    set_halfedge_handle(fh, HalfedgeHandle(hh_map[halfedge_handle(fh).idx()]));
+  }
+}
+
 void ArrayKernel::clean()
 {
 
@@ -287,6 +287,28 @@ public:
                           std_API_Container_FHandlePointer& fh_to_update,
                           bool _v=true, bool _e=true, bool _f=true);
 
+  /** \brief Reorder the mesh items
+   *
+   * Permutes the vertices, edges (and their halfedges) and faces together with
+   * all their properties and rewrites all handles stored in the connectivity.
+   * The i'th item after the call is the item with index _order[i] before the call.
+   * An empty order vector keeps the order of the corresponding items, otherwise
+   * its size has to match the number of items.
+   *
+   * This is used to improve the memory locality of mesh traversals, see
+   * OpenMesh::MeshReorderT.
+   *
+   * \note As with garbage collection, all handles stored outside of the mesh
+   *       are invalid after this call.
+   *
+   * @param _vertex_order Old index of each new vertex
+   * @param _edge_order   Old index of each new edge
+   * @param _face_order   Old index of each new face
+   */
+  void permute(const std::vector<unsigned int>& _vertex_order,
+               const std::vector<unsigned int>& _edge_order,
+               const std::vector<unsigned int>& _face_order);
+
   /** \brief Clear the whole mesh
    *
    *  This will remove all properties and elements from the mesh
@@ -42,6 +42,7 @@
 //== IMPLEMENTATION ==========================================================
 #include <OpenMesh/Core/Mesh/PolyConnectivity.hh>
 #include <set>
+#include <algorithm>
 
 namespace OpenMesh {
 
@@ -318,7 +319,44 @@ FaceHandle PolyConnectivity::add_face(const std::vector<VertexHandle>& _vhandles
 
 
 //-----------------------------------------------------------------------------
-bool PolyConnectivity::is_collapse_ok(HalfedgeHandle v0v1)
+bool PolyConnectivity::has_common_neighbor(VertexHandle _v0, VertexHandle _v1,
+                                           VertexHandle _vl, VertexHandle _vr) const
+{
+  // one-ring of _v1, on the heap only for very high valences
+  const size_t      n_stack = 32;
+  int               stack_ring[n_stack];
+  std::vector<int>  heap_ring;
+  size_t            n = 0;
+
+  for (ConstVertexVertexIter vv_it = cvv_iter(_v1); vv_it.is_valid(); ++vv_it, ++n)
+  {
+    if (n < n_stack)
+      stack_ring[n] = vv_it->idx();
+    else
+    {
+      if (n == n_stack)
+        heap_ring.assign(stack_ring, stack_ring + n_stack);
+      heap_ring.push_back(vv_it->idx());
+    }
+  }
+
+  const int* ring     = n <= n_stack ? stack_ring : &heap_ring[0];
+  const int* ring_end = ring + n;
+
+  // for typical valences a linear search beats sorting both rings
+  for (ConstVertexVertexIter vv_it = cvv_iter(_v0); vv_it.is_valid(); ++vv_it)
+  {
+    if (*vv_it == _vl || *vv_it == _vr)
+      continue;
+    if (std::find(ring, ring_end, vv_it->idx()) != ring_end)
+      return true;
+  }
+
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+bool PolyConnectivity::is_collapse_ok(HalfedgeHandle v0v1) const
 {
   //is edge already deleteed?
   if (status(edge_handle(v0v1)).deleted())
@@ -386,27 +424,12 @@ bool PolyConnectivity::is_collapse_ok(HalfedgeHandle v0v1)
   if ( is_boundary(v0) && is_boundary(v1) && !is_boundary(v0v1) && !is_boundary(v1v0))
     return false;
   
-  VertexVertexIter vv_it;
   // test intersection of the one-rings of v0 and v1
-  for (vv_it = vv_iter(v0); vv_it.is_valid(); ++vv_it)
+  if (has_common_neighbor(v0, v1,
+                          v0v1_triangle ? v_01_n : VertexHandle(),
+                          v1v0_triangle ? v_10_n : VertexHandle()))
   {
-    status(*vv_it).set_tagged(false);
-  }
-
-  for (vv_it = vv_iter(v1); vv_it.is_valid(); ++vv_it)
-  {
-    status(*vv_it).set_tagged(true);
-  }
-
-  for (vv_it = vv_iter(v0); vv_it.is_valid(); ++vv_it)
-  {
-    if (status(*vv_it).tagged() &&
-      !(*vv_it == v_01_n && v0v1_triangle) &&
-      !(*vv_it == v_10_n && v1v0_triangle)
-      )
-    {
-      return false;
-    }
+    return false;
   }
   
   //test for a face on the backside/other side that might degenerate
@@ -440,7 +463,8 @@ bool PolyConnectivity::is_collapse_ok(HalfedgeHandle v0v1)
     }
   }
 
-  if (status(*vv_it).tagged() && v_01_n == v_10_n && v0v1_triangle && v1v0_triangle)
+  // both triangles share their third vertex (which then is a common neighbor)
+  if (v_01_n == v_10_n && v0v1_triangle && v1v0_triangle)
   {
     return false;
   }
@@ -305,9 +305,10 @@ public:
 
   /** Returns whether collapsing halfedge _heh is ok or would lead to
       topological inconsistencies.
-      \attention This method need the Attributes::Status attribute and
-      changes the \em tagged bit.  */
-  bool is_collapse_ok(HalfedgeHandle _he);
+      \attention This method needs the Attributes::Status attribute. It
+      does not modify the mesh, so several threads may call it at the
+      same time.  */
+  bool is_collapse_ok(HalfedgeHandle _he) const;
     
     
   /** Mark vertex and all incident edges and faces deleted.
@@ -1068,6 +1069,13 @@ protected:
   /// Helper for halfedge collapse
   void collapse_loop(HalfedgeHandle _hh);
 
+  /** Helper for is_collapse_ok(): Do _v0 and _v1 have a common neighbor
+      other than _vl and _vr? The one-ring of _v1 is collected in a small
+      buffer on the stack, so the test neither allocates (up to valence 32)
+      nor writes to the mesh.  */
+  bool has_common_neighbor(VertexHandle _v0, VertexHandle _v1,
+                           VertexHandle _vl, VertexHandle _vr) const;
+
 
 
 private: // Working storage for add_face()
@@ -99,7 +99,7 @@ FaceHandle TriConnectivity::add_face(VertexHandle _vh0, VertexHandle _vh1, Verte
 
 //-----------------------------------------------------------------------------
 
-bool TriConnectivity::is_collapse_ok(HalfedgeHandle v0v1)
+bool TriConnectivity::is_collapse_ok(HalfedgeHandle v0v1) const
 {
   // is the edge already deleted?
   if ( status(edge_handle(v0v1)).deleted() )
@@ -150,18 +150,9 @@ bool TriConnectivity::is_collapse_ok(HalfedgeHandle v0v1)
   // if vl and vr are equal or both invalid -> fail
   if (vl == vr) return false;
 
-  VertexVertexIter  vv_it;
-
   // test intersection of the one-rings of v0 and v1
-  for (vv_it = vv_iter(v0); vv_it.is_valid(); ++vv_it)
-    status(*vv_it).set_tagged(false);
-
-  for (vv_it = vv_iter(v1); vv_it.is_valid(); ++vv_it)
-    status(*vv_it).set_tagged(true);
-
-  for (vv_it = vv_iter(v0); vv_it.is_valid(); ++vv_it)
-    if (status(*vv_it).tagged() && *vv_it != vl && *vv_it != vr)
-      return false;
+  if (has_common_neighbor(v0, v1, vl, vr))
+    return false;
 
 
   // edge between two boundary vertices should be a boundary edge
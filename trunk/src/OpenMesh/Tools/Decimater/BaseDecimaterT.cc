@@ -97,7 +97,7 @@ BaseDecimaterT<Mesh>::~BaseDecimaterT() {
 //-----------------------------------------------------------------------------
 
 template<class Mesh>
-bool BaseDecimaterT<Mesh>::is_collapse_legal(const CollapseInfo& _ci) {
+bool BaseDecimaterT<Mesh>::is_collapse_legal(const CollapseInfo& _ci) const {
   //   std::clog << "McDecimaterT<>::is_collapse_legal()\n";
 
   // locked ?
@@ -152,13 +152,23 @@ bool BaseDecimaterT<Mesh>::is_collapse_legal(const CollapseInfo& _ci) {
 
 template<class Mesh>
 float BaseDecimaterT<Mesh>::collapse_priority(const CollapseInfo& _ci) {
+  if (!is_collapse_accepted(_ci))
+    return ModBaseT< Mesh >::ILLEGAL_COLLAPSE;
+
+  return cmodule_->collapse_priority(_ci);
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+bool BaseDecimaterT<Mesh>::is_collapse_accepted(const CollapseInfo& _ci) {
   typename ModuleList::iterator m_it, m_end = bmodules_.end();
 
   for (m_it = bmodules_.begin(); m_it != m_end; ++m_it) {
     if ((*m_it)->collapse_priority(_ci) < 0.0)
-      return ModBaseT< Mesh >::ILLEGAL_COLLAPSE;
+      return false;
   }
-  return cmodule_->collapse_priority(_ci);
+  return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -277,6 +287,15 @@ bool BaseDecimaterT<Mesh>::initialize() {
     return false;
   }
 
+  // the other modules test a collapse with the remaining vertex at p1
+  for (ModuleListIterator m_it = all_modules_.begin(), m_end =
+      all_modules_.end(); m_it != m_end; ++m_it) {
+    if ((*m_it)->moves_vertex() && all_modules_.size() > 1) {
+      set_uninitialized();
+      return false;
+    }
+  }
+
   // set pmodule as the current priority module
   cmodule_ = pmodule;
 
@@ -55,6 +55,7 @@
 //== INCLUDES =================================================================
 
 #include <memory>
+#include <vector>
 
 #include <OpenMesh/Core/Utils/Property.hh>
 #include <OpenMesh/Tools/Decimater/ModBaseT.hh>
@@ -99,8 +100,10 @@ public: //------------------------------------------------------ public methods
 
       Return values:
       true   ok
-      false  No ore more than one non-binary module exist. In that case
-             the decimater is uninitialized!
+      false  No ore more than one non-binary module exist, or a module
+             that moves the remaining vertex (ModBaseT::moves_vertex())
+             is combined with other modules. In that case the decimater
+             is uninitialized!
    */
   bool initialize();
 
@@ -108,6 +111,13 @@ public: //------------------------------------------------------ public methods
   /// Returns whether decimater has been successfully initialized.
   bool is_initialized() const { return initialized_; }
 
+  /** Reset the status of this class
+   *
+   * You have to call initialize again!! This allows to reuse the decimater
+   * and its modules after the mesh has been changed (e.g. reloaded).
+   */
+  void reset(){ set_uninitialized(); };
+
 
   /// Print information about modules to _os
   void info( std::ostream& _os );
@@ -190,8 +200,8 @@ protected:
   {
     if (observer() && _n_collapses % observer()->get_interval() == 0)
     {
-      observer()->notify(_n_collapses);
-      return !observer()->abort();
+      observer()->notify(_n_collapses);
+      return !observer()->abort();
     }
     return true;
   }
@@ -216,13 +226,24 @@ protected: //---------------------------------------------------- private method
 
   /// Is an edge collapse legal?  Performs topological test only.
   /// The method evaluates the status bit Locked, Deleted, and Feature.
-  /// \attention The method temporarily sets the bit Tagged. After usage
-  ///            the bit will be disabled!
-  bool is_collapse_legal(const CollapseInfo& _ci);
+  /// It does not modify the mesh and may be called from several threads.
+  bool is_collapse_legal(const CollapseInfo& _ci) const;
 
   /// Calculate priority of an halfedge collapse (using the modules)
   float collapse_priority(const CollapseInfo& _ci);
 
+  /// Is the collapse accepted by all binary modules?
+  bool is_collapse_accepted(const CollapseInfo& _ci);
+
+  /// Calculate the priorities of several collapses with the priority
+  /// module. The collapses have to pass is_collapse_legal() and
+  /// is_collapse_accepted(), see ModBaseT::collapse_priorities().
+  void collapse_priorities(const std::vector<typename Mesh::HalfedgeHandle>& _collapses,
+                           float* _priorities)
+  {
+    cmodule_->collapse_priorities(_collapses, _priorities);
+  }
+
   /// Pre-process a collapse
   void preprocess_collapse(CollapseInfo& _ci);
 
@@ -239,12 +260,6 @@ protected: //---------------------------------------------------- private method
    */
   void set_error_tolerance_factor(double _factor);
 
-  /** Reset the status of this class
-   *
-   * You have to call initialize again!!
-   */
-  void reset(){ initialized_ = false; };
-
 
 private: //------------------------------------------------------- private data
 
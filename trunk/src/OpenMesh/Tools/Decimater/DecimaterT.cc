@@ -99,18 +99,27 @@ void DecimaterT<Mesh>::heap_vertex(VertexHandle _vh) {
   float prio, best_prio(FLT_MAX);
   typename Mesh::HalfedgeHandle heh, collapse_target;
 
-  // find best target in one ring
+  // collect the legal collapses in one ring
+  collapses_.clear();
   typename Mesh::VertexOHalfedgeIter voh_it(mesh_, _vh);
   for (; voh_it.is_valid(); ++voh_it) {
     heh = *voh_it;
     CollapseInfo ci(mesh_, heh);
 
-    if (this->is_collapse_legal(ci)) {
-      prio = this->collapse_priority(ci);
-      if (prio >= 0.0 && prio < best_prio) {
-        best_prio = prio;
-        collapse_target = heh;
-      }
+    if (this->is_collapse_legal(ci) && this->is_collapse_accepted(ci))
+      collapses_.push_back(heh);
+  }
+
+  // find best target, the priority module scores all collapses at once
+  priorities_.resize(collapses_.size());
+  if (!collapses_.empty())
+    this->collapse_priorities(collapses_, &priorities_[0]);
+
+  for (size_t k = 0; k < collapses_.size(); ++k) {
+    prio = priorities_[k];
+    if (prio >= 0.0 && prio < best_prio) {
+      best_prio = prio;
+      collapse_target = collapses_[k];
     }
   }
 
@@ -136,119 +145,90 @@ void DecimaterT<Mesh>::heap_vertex(VertexHandle _vh) {
     mesh_.property(priority_, _vh) = -1;
   }
 }
-
-//-----------------------------------------------------------------------------
-template<class Mesh>
-size_t DecimaterT<Mesh>::decimate(size_t _n_collapses) {
-
-  if (!this->is_initialized())
-    return 0;
-
-  typename Mesh::VertexIter v_it, v_end(mesh_.vertices_end());
-  typename Mesh::VertexHandle vp;
-  typename Mesh::HalfedgeHandle v0v1;
-  typename Mesh::VertexVertexIter vv_it;
-  typename Mesh::VertexFaceIter vf_it;
-  unsigned int n_collapses(0);
 
-  typedef std::vector<typename Mesh::VertexHandle> Support;
-  typedef typename Support::iterator SupportIterator;
+//-----------------------------------------------------------------------------
+template<class Mesh>
+size_t DecimaterT<Mesh>::decimate(size_t _n_collapses) {
 
-  Support support(15);
-  SupportIterator s_it, s_end;
+  if (!this->is_initialized())
+    return 0;
 
   // check _n_collapses
   if (!_n_collapses)
     _n_collapses = mesh_.n_vertices();
 
-  // initialize heap
-  HeapInterface HI(mesh_, priority_, heap_position_);
-  heap_ = std::auto_ptr<DeciHeap>(new DeciHeap(HI));
-  heap_->reserve(mesh_.n_vertices());
+  CollapseTarget target(_n_collapses);
+  return decimate_heap(target);
+}
 
-  for (v_it = mesh_.vertices_begin(); v_it != v_end; ++v_it) {
-    heap_->reset_heap_position(*v_it);
-    if (!mesh_.status(*v_it).deleted())
-      heap_vertex(*v_it);
-  }
+//-----------------------------------------------------------------------------
 
-  const bool update_normals = mesh_.has_face_normals();
+template<class Mesh>
+size_t DecimaterT<Mesh>::decimate_to_faces(size_t _nv, size_t _nf) {
 
-  // process heap
-  while ((!heap_->empty()) && (n_collapses < _n_collapses)) {
-    // get 1st heap entry
-    vp = heap_->front();
-    v0v1 = mesh_.property(collapse_target_, vp);
-    heap_->pop_front();
+  if (!this->is_initialized())
+    return 0;
 
-    // setup collapse info
-    CollapseInfo ci(mesh_, v0v1);
+  if (_nv >= mesh_.n_vertices() || _nf >= mesh_.n_faces())
+    return 0;
 
-    // check topological correctness AGAIN !
-    if (!this->is_collapse_legal(ci))
-      continue;
+  FaceTarget target(_nv, _nf, mesh_.n_vertices(), mesh_.n_faces());
+  return decimate_heap(target);
+}
 
-    // store support (= one ring of *vp)
-    vv_it = mesh_.vv_iter(ci.v0);
-    support.clear();
-    for (; vv_it.is_valid(); ++vv_it)
-      support.push_back(*vv_it);
+//-----------------------------------------------------------------------------
 
-    // perform collapse
-    mesh_.collapse(v0v1);
-    ++n_collapses;
+template<class Mesh>
+size_t DecimaterT<Mesh>::decimate_to_lods(const std::vector<size_t>& _n_faces,
+                                          std::vector<LevelOfDetail>& _lods) {
+  return decimate_lods(&_n_faces, 0, _lods);
+}
 
-    if (update_normals)
-    {
-      // update triangle normals
-      vf_it = mesh_.vf_iter(ci.v1);
-      for (; vf_it.is_valid(); ++vf_it)
-        if (!mesh_.status(*vf_it).deleted())
-          mesh_.set_normal(*vf_it, mesh_.calc_face_normal(*vf_it));
-    }
+//-----------------------------------------------------------------------------
 
-    // post-process collapse
-    this->postprocess_collapse(ci);
+template<class Mesh>
+size_t DecimaterT<Mesh>::decimate_to_priorities(const std::vector<float>& _priorities,
+                                                std::vector<LevelOfDetail>& _lods) {
+  return decimate_lods(0, &_priorities, _lods);
+}
 
-    // update heap (former one ring of decimated vertex)
-    for (s_it = support.begin(), s_end = support.end(); s_it != s_end; ++s_it) {
-      assert(!mesh_.status(*s_it).deleted());
-      heap_vertex(*s_it);
-    }
-
-    // notify observer and stop if the observer requests it
-    if (!this->notify_observer(n_collapses))
-        return n_collapses;
-  }
-
-  // delete heap
-  heap_.reset();
+//-----------------------------------------------------------------------------
 
+template<class Mesh>
+size_t DecimaterT<Mesh>::decimate_lods(const std::vector<size_t>*  _n_faces,
+                                       const std::vector<float>*   _priorities,
+                                       std::vector<LevelOfDetail>& _lods) {
 
+  _lods.clear();
 
-  // DON'T do garbage collection here! It's up to the application.
-  return n_collapses;
+  if (!this->is_initialized())
+    return 0;
+
+  typename Mesh::FaceIter f_it, f_end(mesh_.faces_end());
+  size_t nf = 0;
+
+  // the mesh may contain deleted faces
+  for (f_it = mesh_.faces_begin(); f_it != f_end; ++f_it)
+    if (!mesh_.status(*f_it).deleted())
+      ++nf;
+
+  LodTarget target(*this, _n_faces, _priorities, nf, _lods);
+  return decimate_heap(target);
 }
 
-//-----------------------------------------------------------------------------
-
-template<class Mesh>
-size_t DecimaterT<Mesh>::decimate_to_faces(size_t _nv, size_t _nf) {
-
-  if (!this->is_initialized())
-    return 0;
+//-----------------------------------------------------------------------------
 
-  if (_nv >= mesh_.n_vertices() || _nf >= mesh_.n_faces())
-    return 0;
+template<class Mesh>
+template<class Target>
+size_t DecimaterT<Mesh>::decimate_heap(Target& _target) {
 
   typename Mesh::VertexIter v_it, v_end(mesh_.vertices_end());
   typename Mesh::VertexHandle vp;
   typename Mesh::HalfedgeHandle v0v1;
   typename Mesh::VertexVertexIter vv_it;
   typename Mesh::VertexFaceIter vf_it;
-  size_t nv = mesh_.n_vertices();
-  size_t nf = mesh_.n_faces();
-  unsigned int n_collapses = 0;
+  unsigned int n_collapses(0);
+  size_t n_removed_faces;
 
   typedef std::vector<typename Mesh::VertexHandle> Support;
   typedef typename Support::iterator SupportIterator;
@@ -270,7 +250,8 @@ size_t DecimaterT<Mesh>::decimate_to_faces(size_t _nv, size_t _nf) {
   const bool update_normals = mesh_.has_face_normals();
 
   // process heap
-  while ((!heap_->empty()) && (_nv < nv) && (_nf < nf)) {
+  while ((!heap_->empty()) &&
+         (!_target.reached(mesh_.property(priority_, heap_->front())))) {
     // get 1st heap entry
     vp = heap_->front();
     v0v1 = mesh_.property(collapse_target_, vp);
@@ -289,19 +270,20 @@ size_t DecimaterT<Mesh>::decimate_to_faces(size_t _nv, size_t _nf) {
     for (; vv_it.is_valid(); ++vv_it)
       support.push_back(*vv_it);
 
-    // adjust complexity in advance (need boundary status)
-    ++n_collapses;
-    --nv;
+    // count the removed faces in advance (need boundary status)
     if (mesh_.is_boundary(ci.v0v1) || mesh_.is_boundary(ci.v1v0))
-      --nf;
+      n_removed_faces = 1;
     else
-      nf -= 2;
+      n_removed_faces = 2;
 
-    // pre-processing
+    // pre-processing, may move v1 (optimal placement)
     this->preprocess_collapse(ci);
+    const bool moved = (mesh_.point(ci.v1) != ci.p1);
 
     // perform collapse
     mesh_.collapse(v0v1);
+    ++n_collapses;
+    _target.collapsed(n_removed_faces);
 
     // update triangle normals
     if (update_normals)
@@ -315,25 +297,65 @@ size_t DecimaterT<Mesh>::decimate_to_faces(size_t _nv, size_t _nf) {
     // post-process collapse
     this->postprocess_collapse(ci);
 
+    // if v1 has moved, the collapses of v1 and its whole one ring have
+    // changed, which contains the former one ring of v0
+    if (moved) {
+      support.clear();
+      support.push_back(ci.v1);
+      for (vv_it = mesh_.vv_iter(ci.v1); vv_it.is_valid(); ++vv_it)
+        support.push_back(*vv_it);
+    }
+
     // update heap (former one ring of decimated vertex)
     for (s_it = support.begin(), s_end = support.end(); s_it != s_end; ++s_it) {
-      assert(!mesh_.status(*s_it).deleted());
-      heap_vertex(*s_it);
-    }
-
-    // notify observer and stop if the observer requests it
-    if (!this->notify_observer(n_collapses))
-        return n_collapses;
-  }
-
-  // delete heap
-  heap_.reset();
+      assert(!mesh_.status(*s_it).deleted());
+      heap_vertex(*s_it);
+    }
 
+    // notify observer and stop if the observer requests it
+    if (!this->notify_observer(n_collapses)) {
+      heap_.reset();
+      return n_collapses;
+    }
+  }
+
+  // the heap is empty or the target reached
+  _target.finish();
+
+  // delete heap
+  heap_.reset();
 
   // DON'T do garbage collection here! It's up to the application.
   return n_collapses;
 }
 
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+void DecimaterT<Mesh>::snapshot(LevelOfDetail& _lod, std::vector<int>& _index) {
+
+  typename Mesh::FaceIter f_it, f_end(mesh_.faces_end());
+  typename Mesh::FaceVertexIter fv_it;
+
+  _index.assign(mesh_.n_vertices(), -1);
+
+  // number the vertices in the order of their first face
+  for (f_it = mesh_.faces_begin(); f_it != f_end; ++f_it) {
+    if (mesh_.status(*f_it).deleted())
+      continue;
+
+    for (fv_it = mesh_.fv_iter(*f_it); fv_it.is_valid(); ++fv_it) {
+      int& idx = _index[fv_it->idx()];
+      if (idx < 0) {
+        idx = int(_lod.vertices.size());
+        _lod.vertices.push_back(*fv_it);
+        _lod.points.push_back(mesh_.point(*fv_it));
+      }
+      _lod.indices.push_back(idx);
+    }
+  }
+}
+
 //=============================================================================
 }// END_NS_DECIMATER
 } // END_NS_OPENMESH
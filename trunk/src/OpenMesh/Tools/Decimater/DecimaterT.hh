@@ -55,6 +55,7 @@
 //== INCLUDES =================================================================
 
 #include <memory>
+#include <vector>
 
 #include <OpenMesh/Core/Utils/Property.hh>
 #include <OpenMesh/Tools/Utils/HeapT.hh>
@@ -119,6 +120,42 @@ public:
   typedef typename Mesh::VertexHandle    VertexHandle;
   typedef typename Mesh::HalfedgeHandle  HalfedgeHandle;
 
+  /** Snapshot of the mesh taken by decimate_to_lods() and
+   *  decimate_to_priorities(): the vertices in use, their positions at
+   *  that time and a triangle index buffer into them.
+   */
+  struct LevelOfDetail
+  {
+    /// Vertices in use, valid until the garbage collection of the mesh
+    std::vector<VertexHandle>          vertices;
+
+    /// Positions of the vertices
+    std::vector<typename Mesh::Point>  points;
+
+    /// Three indices into vertices per face
+    std::vector<unsigned int>          indices;
+
+    /// Number of faces
+    size_t n_faces() const { return indices.size() / 3; }
+  };
+
+  /** Decimate to several face counts in one run and take a snapshot
+   *  whenever the next count is reached. The counts should decrease,
+   *  a count that is not below the current number of faces gives a
+   *  snapshot of the current mesh. _lods receives one snapshot per
+   *  count, fewer if the observer aborts. Returns the number of
+   *  performed collapses.
+   */
+  size_t decimate_to_lods( const std::vector<size_t>& _n_faces,
+                           std::vector<LevelOfDetail>& _lods );
+
+  /** Decimate in one run and take a snapshot before the first collapse
+   *  whose priority exceeds the next value of _priorities, which should
+   *  increase. See decimate_to_lods().
+   */
+  size_t decimate_to_priorities( const std::vector<float>& _priorities,
+                                 std::vector<LevelOfDetail>& _lods );
+
   /// Heap interface
   class HeapInterface
   {
@@ -161,6 +198,100 @@ private: //---------------------------------------------------- private methods
   /// Insert vertex in heap
   void heap_vertex(VertexHandle _vh);
 
+  /// Decimate to face counts or priorities with snapshots
+  size_t decimate_lods(const std::vector<size_t>*     _n_faces,
+                       const std::vector<float>*      _priorities,
+                       std::vector<LevelOfDetail>&    _lods);
+
+  /// Take a snapshot of the mesh, _index maps vertices to snapshot indices
+  void snapshot(LevelOfDetail& _lod, std::vector<int>& _index);
+
+  /** Collapse the front of the heap until it is empty or _target is
+   *  reached. The Target provides
+   *  - bool reached(float _priority): stop before the next collapse, which
+   *    has priority _priority?
+   *  - void collapsed(size_t _n_faces): a collapse removed _n_faces faces.
+   *  - void finish(): the heap is empty or the target reached (not called
+   *    if the observer aborts).
+   *
+   *  Returns the number of performed collapses.
+   */
+  template <class Target>
+  size_t decimate_heap(Target& _target);
+
+  /// Target of decimate(): a number of collapses
+  class CollapseTarget
+  {
+  public:
+    CollapseTarget(size_t _n_collapses) : n_(_n_collapses), i_(0) { }
+    bool reached(float) const { return i_ >= n_; }
+    void collapsed(size_t)    { ++i_; }
+    void finish()             { }
+  private:
+    size_t n_, i_;
+  };
+
+  /// Target of decimate_to_faces(): a number of vertices or faces
+  class FaceTarget
+  {
+  public:
+    FaceTarget(size_t _target_nv, size_t _target_nf, size_t _nv, size_t _nf)
+      : target_nv_(_target_nv), target_nf_(_target_nf), nv_(_nv), nf_(_nf) { }
+    bool reached(float) const { return nv_ <= target_nv_ || nf_ <= target_nf_; }
+    void collapsed(size_t _n_faces) { --nv_; nf_ -= _n_faces; }
+    void finish() { }
+  private:
+    size_t target_nv_, target_nf_, nv_, nf_;
+  };
+
+  /// Target of decimate_lods(): takes a snapshot at every face count or
+  /// priority passed, reached when all snapshots are taken
+  class LodTarget
+  {
+  public:
+    LodTarget(DecimaterT&                  _decimater,
+              const std::vector<size_t>*   _n_faces,
+              const std::vector<float>*    _priorities,
+              size_t                       _nf,
+              std::vector<LevelOfDetail>&  _lods)
+      : decimater_(_decimater), n_faces_(_n_faces), priorities_(_priorities),
+        n_lods_(_n_faces ? _n_faces->size() : _priorities->size()),
+        nf_(_nf), lods_(_lods) { }
+
+    bool reached(float _priority)
+    {
+      // take the snapshots of all reached targets
+      while (lods_.size() < n_lods_ &&
+             ((n_faces_    && nf_ <= (*n_faces_)[lods_.size()]) ||
+              (priorities_ && _priority > (*priorities_)[lods_.size()])))
+        take_snapshot();
+      return lods_.size() == n_lods_;
+    }
+
+    void collapsed(size_t _n_faces) { nf_ -= _n_faces; }
+
+    void finish()
+    {
+      while (lods_.size() < n_lods_)
+        take_snapshot();
+    }
+
+  private:
+    void take_snapshot()
+    {
+      lods_.push_back(LevelOfDetail());
+      decimater_.snapshot(lods_.back(), index_);
+    }
+
+    DecimaterT&                  decimater_;
+    const std::vector<size_t>*   n_faces_;
+    const std::vector<float>*    priorities_;
+    size_t                       n_lods_;
+    size_t                       nf_;
+    std::vector<LevelOfDetail>&  lods_;
+    std::vector<int>             index_;
+  };
+
 private: //------------------------------------------------------- private data
 
 
@@ -175,6 +306,10 @@ private: //------------------------------------------------------- private data
   VPropHandleT<float>           priority_;
   VPropHandleT<int>             heap_position_;
 
+  // candidate collapses and their priorities in heap_vertex()
+  std::vector<HalfedgeHandle>   collapses_;
+  std::vector<float>            priorities_;
+
 };
 
 //=============================================================================
@@ -0,0 +1,327 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------*
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         *
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/
+
+/*===========================================================================*\
+ *                                                                           *
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+
+/** \file ModAttribQuadricT.cc
+    Bodies of template member function.
+ */
+
+//=============================================================================
+//
+//  CLASS ModAttribQuadricT - IMPLEMENTATION
+//
+//=============================================================================
+
+#define OPENMESH_DECIMATER_MODATTRIBQUADRICT_CC
+
+//== INCLUDES =================================================================
+
+#include <OpenMesh/Tools/Decimater/ModAttribQuadricT.hh>
+
+
+//== NAMESPACE ===============================================================
+
+namespace OpenMesh { // BEGIN_NS_OPENMESH
+namespace Decimater { // BEGIN_NS_DECIMATER
+
+
+//== IMPLEMENTATION ==========================================================
+
+
+template<class MeshT>
+void
+ModAttribQuadricT<MeshT>::
+initialize()
+{
+  Mesh& mesh = Base::mesh();
+
+  use_texcoords_ = mesh.has_vertex_texcoords2D() && texcoord_weight_ > 0.0;
+  use_colors_    = mesh.has_vertex_colors()      && color_weight_    > 0.0;
+  use_normals_   = mesh.has_vertex_normals()     && normal_weight_   > 0.0;
+
+  const unsigned int n = 3 + (use_texcoords_ ? 2 : 0)
+                           + (use_colors_    ? 3 : 0)
+                           + (use_normals_   ? 3 : 0);
+  dimension_ = n;
+  stride_    = n * (n + 1) / 2 + n + 1;
+
+  // clear quadrics
+  quadrics_.assign(mesh.n_vertices() * stride_, 0.0);
+
+  // calc (area weighted) quadrics
+  typename Mesh::FaceIter          f_it  = mesh.faces_begin(),
+                                   f_end = mesh.faces_end();
+
+  typename Mesh::FaceVertexIter    fv_it;
+  typename Mesh::VertexHandle      vh0, vh1, vh2;
+
+  double p0[max_dimension], p1[max_dimension], p2[max_dimension];
+  double q[max_dimension * (max_dimension + 3) / 2 + 1];
+
+  for (; f_it != f_end; ++f_it)
+  {
+    fv_it = mesh.fv_iter(*f_it);
+    vh0 = *fv_it;  ++fv_it;
+    vh1 = *fv_it;  ++fv_it;
+    vh2 = *fv_it;
+
+    attributes(vh0, p0);
+    attributes(vh1, p1);
+    attributes(vh2, p2);
+
+    if (!face_quadric(p0, p1, p2, q))
+      continue;
+
+    double* q0 = quadric(vh0);
+    double* q1 = quadric(vh1);
+    double* q2 = quadric(vh2);
+
+    for (unsigned int i = 0; i < stride_; ++i)
+    {
+      q0[i] += q[i];
+      q1[i] += q[i];
+      q2[i] += q[i];
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+float
+ModAttribQuadricT<MeshT>::
+collapse_priority(const CollapseInfo& _ci)
+{
+  double v[max_dimension];
+  attributes(_ci.v1, v);
+
+  // the error of q0+q1 is the sum of both errors
+  double err = error(quadric(_ci.v0), v) + error(quadric(_ci.v1), v);
+
+  // rounding may give tiny negative values
+  if (err < 0.0)
+    err = 0.0;
+
+  return float( (err < max_err_) ? err : float( Base::ILLEGAL_COLLAPSE ) );
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+void
+ModAttribQuadricT<MeshT>::
+postprocess_collapse(const CollapseInfo& _ci)
+{
+  const double* q0 = quadric(_ci.v0);
+  double*       q1 = quadric(_ci.v1);
+
+  for (unsigned int i = 0; i < stride_; ++i)
+    q1[i] += q0[i];
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+void
+ModAttribQuadricT<MeshT>::
+attributes(typename Mesh::VertexHandle _vh, double* _v)
+{
+  Mesh& mesh = Base::mesh();
+
+  const Vec3d p = vector_cast<Vec3d>(mesh.point(_vh));
+  _v[0] = p[0];
+  _v[1] = p[1];
+  _v[2] = p[2];
+  _v += 3;
+
+  if (use_texcoords_)
+  {
+    const Vec2d t = vector_cast<Vec2d>(mesh.texcoord2D(_vh));
+    _v[0] = texcoord_weight_ * t[0];
+    _v[1] = texcoord_weight_ * t[1];
+    _v += 2;
+  }
+
+  if (use_colors_)
+  {
+    const Vec3f c = color_cast<Vec3f>(mesh.color(_vh));
+    _v[0] = color_weight_ * c[0];
+    _v[1] = color_weight_ * c[1];
+    _v[2] = color_weight_ * c[2];
+    _v += 3;
+  }
+
+  if (use_normals_)
+  {
+    const Vec3d n = vector_cast<Vec3d>(mesh.normal(_vh));
+    _v[0] = normal_weight_ * n[0];
+    _v[1] = normal_weight_ * n[1];
+    _v[2] = normal_weight_ * n[2];
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+bool
+ModAttribQuadricT<MeshT>::
+face_quadric(const double* _p, const double* _q, const double* _r,
+             double* _quadric) const
+{
+  const unsigned int n = dimension_;
+
+  // orthonormal basis e1, e2 of the triangle plane in R^n
+  double e1[max_dimension], e2[max_dimension];
+
+  double l1 = 0.0, d = 0.0;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    e1[i] = _q[i] - _p[i];
+    e2[i] = _r[i] - _p[i];
+    l1 += e1[i] * e1[i];
+  }
+
+  l1 = sqrt(l1);
+  if (l1 < FLT_MIN)
+    return false;
+
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    e1[i] /= l1;
+    d += e1[i] * e2[i];
+  }
+
+  double l2 = 0.0;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    e2[i] -= d * e1[i];
+    l2 += e2[i] * e2[i];
+  }
+
+  l2 = sqrt(l2);
+  if (l2 < FLT_MIN)
+    return false;
+
+  for (unsigned int i = 0; i < n; ++i)
+    e2[i] /= l2;
+
+  // weight by the area of the geometric triangle
+  const Vec3d a(_q[0] - _p[0], _q[1] - _p[1], _q[2] - _p[2]);
+  const Vec3d b(_r[0] - _p[0], _r[1] - _p[1], _r[2] - _p[2]);
+  const double area = 0.5 * (a % b).norm();
+
+  double pe1 = 0.0, pe2 = 0.0, pp = 0.0;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    pe1 += _p[i] * e1[i];
+    pe2 += _p[i] * e2[i];
+    pp  += _p[i] * _p[i];
+  }
+
+  // A = I - e1 e1^T - e2 e2^T (upper triangle, row by row)
+  double* q = _quadric;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    *q++ = area * (1.0 - e1[i] * e1[i] - e2[i] * e2[i]);
+    for (unsigned int j = i + 1; j < n; ++j)
+      *q++ = -area * (e1[i] * e1[j] + e2[i] * e2[j]);
+  }
+
+  // b = (p.e1) e1 + (p.e2) e2 - p
+  for (unsigned int i = 0; i < n; ++i)
+    *q++ = area * (pe1 * e1[i] + pe2 * e2[i] - _p[i]);
+
+  // c = p.p - (p.e1)^2 - (p.e2)^2
+  *q = area * (pp - pe1 * pe1 - pe2 * pe2);
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+double
+ModAttribQuadricT<MeshT>::
+error(const double* _quadric, const double* _v) const
+{
+  const unsigned int n = dimension_;
+  const double*      q = _quadric;
+
+  // v^T A v, the off-diagonal entries count twice
+  double vav = 0.0;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    double s = 0.5 * *q++ * _v[i];
+    for (unsigned int j = i + 1; j < n; ++j)
+      s += *q++ * _v[j];
+    vav += s * _v[i];
+  }
+
+  // 2 b^T v + c
+  double bv = 0.0;
+  for (unsigned int i = 0; i < n; ++i)
+    bv += *q++ * _v[i];
+
+  return 2.0 * (vav + bv) + *q;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+void ModAttribQuadricT<MeshT>::set_error_tolerance_factor(double _factor) {
+  if (this->is_binary()) {
+    if (_factor >= 0.0 && _factor <= 1.0) {
+      // the smaller the factor, the smaller max_err_ gets
+      // thus creating a stricter constraint
+      // division by error_tolerance_factor_ is for normalization
+      double max_err = max_err_ * _factor / this->error_tolerance_factor_;
+      set_max_err(max_err);
+      this->error_tolerance_factor_ = _factor;
+
+      initialize();
+    }
+  }
+}
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
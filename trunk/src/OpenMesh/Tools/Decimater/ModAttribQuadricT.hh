@@ -0,0 +1,247 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------*
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         *
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/
+
+/*===========================================================================*\
+ *                                                                           *
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+
+
+//=============================================================================
+//
+//  CLASS ModAttribQuadricT
+//
+//=============================================================================
+
+#ifndef OPENMESH_DECIMATER_MODATTRIBQUADRICT_HH
+#define OPENMESH_DECIMATER_MODATTRIBQUADRICT_HH
+
+
+//== INCLUDES =================================================================
+
+#include <float.h>
+#include <cmath>
+#include <vector>
+#include <OpenMesh/Tools/Decimater/ModBaseT.hh>
+#include <OpenMesh/Core/Utils/vector_cast.hh>
+#include <OpenMesh/Core/Utils/color_cast.hh>
+
+
+//== NAMESPACE ================================================================
+
+namespace OpenMesh  {
+namespace Decimater {
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** \brief Mesh decimation module computing collapse priority based on
+ *  error quadrics over positions and vertex attributes.
+ *
+ *  The quadrics are built over vectors that append the vertex texture
+ *  coordinates, colors and normals to the position, as described in
+ *  "Simplifying Surfaces with Color and Texture using Quadric Error
+ *  Metrics", Garland and Heckbert, 1998. Collapses that smear texture
+ *  seams or color borders over the surface therefore get a high error,
+ *  while ModQuadricT only sees the geometry.
+ *
+ *  An attribute is used if the mesh has the vertex property when
+ *  initialize() is called and its weight is positive. The attributes
+ *  are scaled by their weights, colors are mapped to [0,1] before. The
+ *  quadrics of all vertices are stored in one contiguous array, each
+ *  one holding the upper triangle of its matrix, the vector and the
+ *  constant.
+ *
+ *  The remaining vertex keeps its position and attributes. This module
+ *  can be used as a binary and non-binary module.
+ */
+template <class MeshT>
+class ModAttribQuadricT : public ModBaseT<MeshT>
+{
+public:
+
+  // Defines the types Self, Handle, Base, Mesh, and CollapseInfo
+  // and the memberfunction name()
+  DECIMATING_MODULE( ModAttribQuadricT, MeshT, AttribQuadric );
+
+public:
+
+  /// Largest dimension of the attribute vectors (position, texture
+  /// coordinate, color and normal)
+  enum { max_dimension = 11 };
+
+  /** Constructor
+   *  \internal
+   */
+  ModAttribQuadricT( MeshT &_mesh )
+    : Base(_mesh, false),
+      texcoord_weight_(1.0), color_weight_(1.0), normal_weight_(1.0),
+      use_texcoords_(false), use_colors_(false), use_normals_(false),
+      dimension_(3), stride_(0)
+  {
+    unset_max_err();
+  }
+
+
+  /// Destructor
+  virtual ~ModAttribQuadricT()
+  {
+  }
+
+
+public: // inherited
+
+  /// Initalize the module and prepare the mesh for decimation.
+  virtual void initialize(void);
+
+  /** Compute collapse priority based on the attribute quadrics.
+   *
+   *  \see ModBaseT::collapse_priority() for return values
+   *  \see set_max_err()
+   */
+  virtual float collapse_priority(const CollapseInfo& _ci);
+
+  /// Post-process halfedge collapse (accumulate quadrics)
+  virtual void postprocess_collapse(const CollapseInfo& _ci);
+
+  /// set the percentage of maximum quadric error
+  void set_error_tolerance_factor(double _factor);
+
+
+public: // specific methods
+
+  /** Set maximum quadric error constraint and enable binary mode.
+   *  \param _err    Maximum error allowed
+   *  \param _binary Let the module work in non-binary mode in spite of the
+   *                 enabled constraint.
+   *  \see unset_max_err()
+   */
+  void set_max_err(double _err, bool _binary=true)
+  {
+    max_err_ = _err;
+    Base::set_binary(_binary);
+  }
+
+  /// Unset maximum quadric error constraint and restore non-binary mode.
+  /// \see set_max_err()
+  void unset_max_err(void)
+  {
+    max_err_ = DBL_MAX;
+    Base::set_binary(false);
+  }
+
+  /// Return value of max. allowed error.
+  double max_err() const { return max_err_; }
+
+  /// Set the weight of the vertex texture coordinates, 0 ignores them.
+  /// Takes effect in initialize().
+  void set_texcoord_weight(double _w) { texcoord_weight_ = _w; }
+
+  /// Return the weight of the vertex texture coordinates.
+  double texcoord_weight() const { return texcoord_weight_; }
+
+  /// Set the weight of the vertex colors, 0 ignores them.
+  /// Takes effect in initialize().
+  void set_color_weight(double _w) { color_weight_ = _w; }
+
+  /// Return the weight of the vertex colors.
+  double color_weight() const { return color_weight_; }
+
+  /// Set the weight of the vertex normals, 0 ignores them.
+  /// Takes effect in initialize().
+  void set_normal_weight(double _w) { normal_weight_ = _w; }
+
+  /// Return the weight of the vertex normals.
+  double normal_weight() const { return normal_weight_; }
+
+  /// Dimension of the attribute vectors, 3 plus the number of attribute
+  /// components in use. Valid after initialize().
+  unsigned int dimension() const { return dimension_; }
+
+
+private:
+
+  // write the weighted attribute vector of _vh to _v
+  void attributes(typename Mesh::VertexHandle _vh, double* _v);
+
+  // area weighted quadric of the triangle (_p, _q, _r), false if degenerate
+  bool face_quadric(const double* _p, const double* _q, const double* _r,
+                    double* _quadric) const;
+
+  // error of _quadric at _v
+  double error(const double* _quadric, const double* _v) const;
+
+  // quadric of vertex _vh
+  double* quadric(typename Mesh::VertexHandle _vh)
+  { return &quadrics_[_vh.idx() * stride_]; }
+
+private:
+
+  // maximum quadric error
+  double max_err_;
+
+  // attribute weights
+  double texcoord_weight_;
+  double color_weight_;
+  double normal_weight_;
+
+  // attributes in use
+  bool use_texcoords_;
+  bool use_colors_;
+  bool use_normals_;
+
+  // dimension of the attribute vectors and number of values per quadric
+  unsigned int dimension_;
+  unsigned int stride_;
+
+  // quadrics of all vertices, indexed by vertex
+  std::vector<double> quadrics_;
+};
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
+#if defined(OM_INCLUDE_TEMPLATES) && !defined(OPENMESH_DECIMATER_MODATTRIBQUADRICT_CC)
+#define OPENMESH_DECIMATER_MODATTRIBQUADRICT_TEMPLATES
+#include "ModAttribQuadricT.cc"
+#endif
+//=============================================================================
+#endif // OPENMESH_DECIMATER_MODATTRIBQUADRICT_HH defined
+//=============================================================================
+
@@ -58,6 +58,7 @@
 #include <OpenMesh/Core/Utils/Noncopyable.hh>
 #include <OpenMesh/Tools/Decimater/CollapseInfoT.hh>
 #include <string>
+#include <vector>
 
 
 //== NAMESPACE ================================================================
@@ -243,6 +244,31 @@ public: // common interface
    virtual float collapse_priority(const CollapseInfoT<MeshT>& /* _ci */)
    { return LEGAL_COLLAPSE; }
 
+   /** Return the priorities of several collapses at once.
+    *
+    *  The collapses are given by their halfedges. They are legal and have
+    *  passed all binary modules. The priority of _collapses[k] is written
+    *  to _priorities[k], see collapse_priority() for the values.
+    *
+    *  The default implementation calls collapse_priority() for every
+    *  collapse. Priority modules that score several collapses faster at
+    *  once overwrite it (see ModQuadricT). DecimaterT scores all outgoing
+    *  halfedges of a vertex with one call.
+    */
+   virtual void collapse_priorities(const std::vector<typename MeshT::HalfedgeHandle>& _collapses,
+                                    float* _priorities)
+   {
+     for (size_t k = 0; k < _collapses.size(); ++k)
+       _priorities[k] = collapse_priority(CollapseInfoT<MeshT>(mesh_, _collapses[k]));
+   }
+
+   /** Does preprocess_collapse() move the remaining vertex away from
+    *  \c p1? All other modules test a collapse with the remaining vertex
+    *  at \c p1, so BaseDecimaterT::initialize() fails if such a module is
+    *  combined with any other module.
+    */
+   virtual bool moves_vertex() const { return false; }
+
    /** Before _from_vh has been collapsed into _to_vh, this method
        will be called.
     */
@@ -65,124 +65,231 @@ namespace Decimater {
 //== IMPLEMENTATION ==========================================================
 
 template <class MeshT>
-typename ModHausdorffT<MeshT>::Scalar
+void
 ModHausdorffT<MeshT>::
-distPointTriangleSquared( const Point& _p,
-                          const Point& _v0,
-                          const Point& _v1,
-                          const Point& _v2 )
+prepare_triangle(FaceHandle _fh, Triangle& _t) const
 {
-  const Point v0v1 = _v1 - _v0;
-  const Point v0v2 = _v2 - _v0;
-  const Point n = v0v1 % v0v2; // not normalized !
-  const double d = n.sqrnorm();
+  typename Mesh::CFVIter  fv_it = mesh_.cfv_iter(_fh);
+  const Point&            p0    = mesh_.point(*fv_it);
+  const Point&            p1    = mesh_.point(*(++fv_it));
+  const Point&            p2    = mesh_.point(*(++fv_it));
+
+  const Point v0v1 = p1 - p0;
+  const Point v0v2 = p2 - p0;
+  const Point v1v2 = p2 - p1;
+  const Point n    = v0v1 % v0v2; // not normalized !
+  const Scalar d   = n.sqrnorm();
+
+  for (int i = 0; i < 3; ++i) {
+    _t.v0[i]  = p0[i];
+    _t.e01[i] = v0v1[i];
+    _t.e02[i] = v0v2[i];
+    _t.e12[i] = v1v2[i];
+    _t.n[i]   = n[i];
+  }
+
+  _t.d00 = v0v1.sqrnorm();
+  _t.d01 = (v0v1 | v0v2);
+  _t.d11 = v0v2.sqrnorm();
+
+  // degenerated triangles are measured by their edges only
+  _t.valid   = !(d < FLT_MIN && d > -FLT_MIN);
+  _t.inv_det = _t.valid ? Scalar(1) / d : Scalar(0);
+
+  // zero length edges are clamped to their first vertex
+  const Scalar d22 = v1v2.sqrnorm();
+  _t.inv_d00 = _t.d00 > Scalar(0) ? Scalar(1) / _t.d00 : Scalar(0);
+  _t.inv_d11 = _t.d11 > Scalar(0) ? Scalar(1) / _t.d11 : Scalar(0);
+  _t.inv_d22 = d22    > Scalar(0) ? Scalar(1) / d22    : Scalar(0);
+}
 
 
-  // Check if the triangle is degenerated
-  if (d < FLT_MIN && d > -FLT_MIN) {
-    return -1.0;
+//-----------------------------------------------------------------------------
+
+
+template <class MeshT>
+void
+ModHausdorffT<MeshT>::
+sqr_distances(const Triangle& _t, size_t _n)
+{
+  const Scalar* px = &px_[0];
+  const Scalar* py = &py_[0];
+  const Scalar* pz = &pz_[0];
+  Scalar*       dist = &dist_[0];
+
+  const Scalar zero(0), one(1);
+
+  // keep the triangle in registers
+  const Scalar v0x  = _t.v0[0],  v0y  = _t.v0[1],  v0z  = _t.v0[2];
+  const Scalar e01x = _t.e01[0], e01y = _t.e01[1], e01z = _t.e01[2];
+  const Scalar e02x = _t.e02[0], e02y = _t.e02[1], e02z = _t.e02[2];
+  const Scalar e12x = _t.e12[0], e12y = _t.e12[1], e12z = _t.e12[2];
+  const Scalar nx   = _t.n[0],   ny   = _t.n[1],   nz   = _t.n[2];
+  const Scalar d00  = _t.d00, d01 = _t.d01, d11 = _t.d11, inv_det = _t.inv_det;
+  const Scalar inv_d00 = _t.inv_d00, inv_d11 = _t.inv_d11, inv_d22 = _t.inv_d22;
+
+  // degenerated triangles never take the interior case
+  const Scalar max_bary = _t.valid ? one : Scalar(-1);
+
+  for (size_t i = 0; i < _n; ++i) {
+    const Scalar x = px[i] - v0x;
+    const Scalar y = py[i] - v0y;
+    const Scalar z = pz[i] - v0z;
+
+    // barycentric coordinates of the projection into the plane
+    const Scalar d20 = x*e01x + y*e01y + z*e01z;
+    const Scalar d21 = x*e02x + y*e02y + z*e02z;
+    const Scalar b1  = (d11*d20 - d01*d21) * inv_det;
+    const Scalar b2  = (d00*d21 - d01*d20) * inv_det;
+
+    // distance to the plane
+    const Scalar dn = x*nx + y*ny + z*nz;
+
+    // distance to edge v0v1
+    const Scalar s01 = clamp01(d20 * inv_d00);
+    const Scalar ax = x - e01x*s01, ay = y - e01y*s01, az = z - e01z*s01;
+    const Scalar d_01 = ax*ax + ay*ay + az*az;
+
+    // distance to edge v0v2
+    const Scalar s02 = clamp01(d21 * inv_d11);
+    const Scalar bx = x - e02x*s02, by = y - e02y*s02, bz = z - e02z*s02;
+    const Scalar d_02 = bx*bx + by*by + bz*bz;
+
+    // distance to edge v1v2
+    const Scalar qx = x - e01x, qy = y - e01y, qz = z - e01z;
+    const Scalar s12 = clamp01((qx*e12x + qy*e12y + qz*e12z) * inv_d22);
+    const Scalar cx = qx - e12x*s12, cy = qy - e12y*s12, cz = qz - e12z*s12;
+    const Scalar d_12 = cx*cx + cy*cy + cz*cz;
+
+    const Scalar dedge = std::min(std::min(d_01, d_02), d_12);
+
+    // The plane distance never exceeds the edge distance. Writing it as
+    // std::min() also keeps the compiler from moving the product into a
+    // branch, which would prevent vectorization.
+    const Scalar dplane = std::min(dn*dn*inv_det, dedge);
+
+    // the projection lies outside if any barycentric coordinate is negative
+    const Scalar outside = positive(-b1) + positive(-b2) + positive(b1 + b2 - max_bary);
+    dist[i] = outside > zero ? dedge : dplane;
   }
-  const double invD = 1.0 / d;
-
-  // these are not needed for every point, should still perform
-  // better with many points against one triangle
-  const Point v1v2 = _v2 - _v1;
-  const double inv_v0v2_2 = 1.0 / v0v2.sqrnorm();
-  const double inv_v0v1_2 = 1.0 / v0v1.sqrnorm();
-  const double inv_v1v2_2 = 1.0 / v1v2.sqrnorm();
-
-
-  Point v0p = _p - _v0;
-  Point t = v0p % n;
-  typename Point::value_type  s01, s02, s12;
-  const double a = (t | v0v2) * -invD;
-  const double b = (t | v0v1) * invD;
-
-  if (a < 0)
-  {
-    // Calculate the distance to an edge or a corner vertex
-    s02 = ( v0v2 | v0p ) * inv_v0v2_2;
-    if (s02 < 0.0)
-    {
-      s01 = ( v0v1 | v0p ) * inv_v0v1_2;
-      if (s01 <= 0.0) {
-        v0p = _v0;
-      } else if (s01 >= 1.0) {
-        v0p = _v1;
-      } else {
-        v0p = _v0 + v0v1 * s01;
-      }
-    } else if (s02 > 1.0) {
-      s12 = ( v1v2 | ( _p - _v1 )) * inv_v1v2_2;
-      if (s12 >= 1.0) {
-        v0p = _v2;
-      } else if (s12 <= 0.0) {
-        v0p = _v1;
-      } else {
-        v0p = _v1 + v1v2 * s12;
-      }
-    } else {
-      v0p = _v0 + v0v2 * s02;
-    }
-  } else if (b < 0.0) {
-    // Calculate the distance to an edge or a corner vertex
-    s01 = ( v0v1 | v0p ) * inv_v0v1_2;
-    if (s01 < 0.0)
-    {
-  // const Point n = v0v1 % v0v2; // not normalized !
-      s02 = ( v0v2 |  v0p ) * inv_v0v2_2;
-      if (s02 <= 0.0) {
-        v0p = _v0;
-      } else if (s02 >= 1.0) {
-        v0p = _v2;
-      } else {
-        v0p = _v0 + v0v2 * s02;
-      }
-    } else if (s01 > 1.0) {
-      s12 = ( v1v2 | ( _p - _v1 )) * inv_v1v2_2;
-      if (s12 >= 1.0) {
-        v0p = _v2;
-      } else if (s12 <= 0.0) {
-        v0p = _v1;
-      } else {
-        v0p = _v1 + v1v2 * s12;
-      }
-    } else {
-      v0p = _v0 + v0v1 * s01;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class MeshT>
+void
+ModHausdorffT<MeshT>::
+append_point(const Point& _p, Scalar _sqr_tol, int _src)
+{
+  px_.push_back(_p[0]);
+  py_.push_back(_p[1]);
+  pz_.push_back(_p[2]);
+  sqr_tol_.push_back(_sqr_tol);
+  src_.push_back(_src);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class MeshT>
+void
+ModHausdorffT<MeshT>::
+append_points(const Points& _points, Scalar _sqr_tol)
+{
+  const size_t n0 = px_.size();
+  const size_t n  = n0 + _points.size();
+
+  px_.resize(n);
+  py_.resize(n);
+  pz_.resize(n);
+  sqr_tol_.resize(n, _sqr_tol);
+  src_.resize(n, -1);
+
+  for (size_t i = n0; i < n; ++i) {
+    const Point& p = _points[i - n0];
+    px_[i] = p[0];
+    py_[i] = p[1];
+    pz_[i] = p[2];
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class MeshT>
+size_t
+ModHausdorffT<MeshT>::
+remove_covered_points(size_t _n)
+{
+  dist_.resize(_n);
+
+  for (size_t f = 0; _n > 0 && f < faces_.size(); ++f) {
+
+    // the triangles are only set up when they are needed, because most
+    // points are covered by the first faces
+    if (f == n_triangles_) {
+      prepare_triangle(faces_[f], triangles_[f]);
+      ++n_triangles_;
     }
-  } else if (a+b > 1.0) {
-    // Calculate the distance to an edge or a corner vertex
-    s12 = ( v1v2 | ( _p - _v1 )) * inv_v1v2_2;
-    if (s12 >= 1.0) {
-      s02 = ( v0v2 | v0p ) * inv_v0v2_2;
-      if (s02 <= 0.0) {
-        v0p = _v0;
-      } else if (s02 >= 1.0) {
-        v0p = _v2;
-      } else {
-        v0p = _v0 + v0v2*s02;
-      }
-    } else if (s12 <= 0.0) {
-      s01 = ( v0v1 |  v0p ) * inv_v0v1_2;
-      if (s01 <= 0.0) {
-        v0p = _v0;
-      } else if (s01 >= 1.0) {
-        v0p = _v1;
-      } else {
-        v0p = _v0 + v0v1 * s01;
+
+    sqr_distances(triangles_[f], _n);
+
+    size_t n_left = 0;
+    for (size_t i = 0; i < _n; ++i) {
+      if (dist_[i] > sqr_tol_[i]) {
+        px_[n_left]      = px_[i];
+        py_[n_left]      = py_[i];
+        pz_[n_left]      = pz_[i];
+        sqr_tol_[n_left] = sqr_tol_[i];
+        src_[n_left]     = src_[i];
+        ++n_left;
       }
-    } else {
-      v0p = _v1 + v1v2 * s12;
     }
-  } else {
-    // Calculate the distance to an interior point of the triangle
-    return ( (_p - n*((n|v0p) * invD)) - _p).sqrnorm();
+    _n = n_left;
   }
 
-  return (v0p - _p).sqrnorm();
+  return _n;
 }
 
 
+//-----------------------------------------------------------------------------
+
+
+template <class MeshT>
+void
+ModHausdorffT<MeshT>::
+update_sphere(FaceHandle _fh)
+{
+  const Points& points = mesh_.property(points_, _fh);
+  Sphere&       sphere = mesh_.property(spheres_, _fh);
+
+  sphere.center = Point(0, 0, 0);
+  sphere.radius = 0;
+
+  if (points.empty())
+    return;
+
+  typename Points::const_iterator p_it, p_end(points.end());
+
+  for (p_it=points.begin(); p_it!=p_end; ++p_it)
+    sphere.center += *p_it;
+  sphere.center /= Scalar(points.size());
+
+  Scalar sqr_radius(0);
+  for (p_it=points.begin(); p_it!=p_end; ++p_it)
+    sqr_radius = std::max(sqr_radius, (*p_it - sphere.center).sqrnorm());
+
+  sphere.radius = std::sqrt(sqr_radius);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
 template <class MeshT>
 void
 ModHausdorffT<MeshT>::
@@ -190,8 +297,10 @@ initialize()
 {
   typename Mesh::FIter  f_it(mesh_.faces_begin()), f_end(mesh_.faces_end());
 
-  for (; f_it!=f_end; ++f_it)
+  for (; f_it!=f_end; ++f_it) {
     mesh_.property(points_, *f_it).clear();
+    update_sphere(*f_it);
+  }
 }
 
 
@@ -203,59 +312,81 @@ float
 ModHausdorffT<MeshT>::
 collapse_priority(const CollapseInfo& _ci)
 {
-  std::vector<FaceHandle>        faces;   faces.reserve(20);
   typename Mesh::VertexFaceIter  vf_it;
   typename Mesh::FaceHandle      fh;
-  const typename Mesh::Scalar    sqr_tolerace = tolerance_*tolerance_;
-  typename Mesh::CFVIter         fv_it;
-  bool                           ok;
-
-  // Clear the temporary point storage
-  tmp_points_.clear();
+  const Scalar                   sqr_tolerace = tolerance_*tolerance_;
 
-  // collect all points to be tested
   // collect all faces to be tested against
+  faces_.clear();
   for (vf_it=mesh_.vf_iter(_ci.v0); vf_it.is_valid(); ++vf_it) {
     fh = *vf_it;
-
     if (fh != _ci.fl && fh != _ci.fr)
-      faces.push_back(fh);
-
-    Points& pts = mesh_.property(points_, fh);
-    std::copy(pts.begin(), pts.end(), std::back_inserter(tmp_points_));
+      faces_.push_back(fh);
   }
 
-  // add point to be removed
-  tmp_points_.push_back(_ci.p0);
-
-  // setup iterators
-  typename std::vector<FaceHandle>::iterator  fh_it, fh_end(faces.end());
-  typename Points::const_iterator             p_it, p_end(tmp_points_.end());
-
   // simulate collapse
   mesh_.set_point(_ci.v0, _ci.p1);
 
-  // for each point: try to find a face such that error is < tolerance
-  ok = true;
+  triangles_.resize(faces_.size());
+  n_triangles_ = 0;
+
+  // The removed point is the most likely one to violate the tolerance,
+  // so it is tested first.
+  px_.clear(); py_.clear(); pz_.clear(); sqr_tol_.clear(); src_.clear();
+  append_point(_ci.p0, sqr_tolerace, -1);
+
+  size_t n = remove_covered_points(1);
+
+  // collect all points to be tested
+  if (n == 0) {
+    px_.clear(); py_.clear(); pz_.clear(); sqr_tol_.clear(); src_.clear();
+
+    for (vf_it=mesh_.vf_iter(_ci.v0); vf_it.is_valid(); ++vf_it) {
+      fh = *vf_it;
+
+      const Points& pts = mesh_.property(points_, fh);
+      if (pts.empty())
+        continue;
+
+      // A point is at most the radius farther away from a face than the
+      // center of the sphere, so the center is tested with a smaller
+      // tolerance for all points of the face.
+      const Sphere& sphere = mesh_.property(spheres_, fh);
+      if (sphere.radius < tolerance_) {
+        const Scalar tol = tolerance_ - sphere.radius;
+        append_point(sphere.center, tol*tol, fh.idx());
+      }
+      else
+        append_points(pts, sqr_tolerace);
+    }
+
+    // for each face: remove all points with an error < tolerance
+    n = remove_covered_points(px_.size());
+  }
+
+  // test the points of all spheres that are not covered as a whole
+  if (n > 0) {
+    bool spheres_only = true;
+    for (size_t i = 0; spheres_only && i < n; ++i)
+      spheres_only = (src_[i] >= 0);
 
-  for (p_it=tmp_points_.begin(); ok && p_it!=p_end; ++p_it) {
-    ok = false;
+    if (spheres_only) {
+      // best_ is only used by postprocess_collapse(), keep the sources there
+      best_.assign(src_.begin(), src_.begin() + n);
 
-    for (fh_it=faces.begin(); !ok && fh_it!=fh_end; ++fh_it) {
-      fv_it=mesh_.cfv_iter(*fh_it);
-      const Point& p0 = mesh_.point(*fv_it);
-      const Point& p1 = mesh_.point(*(++fv_it));
-      const Point& p2 = mesh_.point(*(++fv_it));
+      px_.clear(); py_.clear(); pz_.clear(); sqr_tol_.clear(); src_.clear();
+      for (size_t i = 0; i < best_.size(); ++i)
+        append_points(mesh_.property(points_, FaceHandle(best_[i])), sqr_tolerace);
 
-      if (  distPointTriangleSquared(*p_it, p0, p1, p2) <= sqr_tolerace)
-        ok = true;
+      n = remove_covered_points(px_.size());
     }
   }
 
   // undo simulation changes
   mesh_.set_point(_ci.v0, _ci.p0);
 
-  return ( ok ? Base::LEGAL_COLLAPSE : Base::ILLEGAL_COLLAPSE );
+  // the collapse is ok if no point is left
+  return ( n == 0 ? Base::LEGAL_COLLAPSE : Base::ILLEGAL_COLLAPSE );
 }
 
 //-----------------------------------------------------------------------------
@@ -281,69 +412,67 @@ postprocess_collapse(const CollapseInfo& _ci)
 {
   typename Mesh::VertexFaceIter  vf_it;
   FaceHandle                     fh;
-  std::vector<FaceHandle>        faces;
 
 
   // collect points & neighboring triangles
 
-  tmp_points_.clear();
-  faces.reserve(20);
+  px_.clear(); py_.clear(); pz_.clear(); sqr_tol_.clear(); src_.clear();
+  faces_.clear();
 
   // collect active faces and their points
   for (vf_it=mesh_.vf_iter(_ci.v1); vf_it.is_valid(); ++vf_it) {
     fh = *vf_it;
-    faces.push_back(fh);
+    faces_.push_back(fh);
 
     Points& pts = mesh_.property(points_, fh);
-    std::copy(pts.begin(), pts.end(), std::back_inserter(tmp_points_));
+    append_points(pts, 0);
     pts.clear();
   }
-  if (faces.empty()) return; // should not happen anyway...
+  if (faces_.empty()) return; // should not happen anyway...
 
 
   // collect points of the 2 deleted faces
   if ((fh=_ci.fl).is_valid()) {
     Points& pts = mesh_.property(points_, fh);
-    std::copy(pts.begin(), pts.end(), std::back_inserter(tmp_points_));
+    append_points(pts, 0);
     pts.clear();
   }
   if ((fh=_ci.fr).is_valid()) {
     Points& pts = mesh_.property(points_, fh);
-    std::copy(pts.begin(), pts.end(), std::back_inserter(tmp_points_));
+    append_points(pts, 0);
     pts.clear();
   }
 
   // add the deleted point
-  tmp_points_.push_back(_ci.p0);
-
+  append_point(_ci.p0, 0, -1);
 
-  // setup iterators
-  typename std::vector<FaceHandle>::iterator  fh_it, fh_end(faces.end());
-  typename Points::const_iterator             p_it, p_end(tmp_points_.end());
 
-  // re-distribute points
-  Scalar                  emin, e;
-  typename Mesh::CFVIter  fv_it;
+  // re-distribute points to the face with the smallest error
+  const size_t n = px_.size();
 
-  for (p_it=tmp_points_.begin(); p_it!=p_end; ++p_it) {
-    emin = FLT_MAX;
+  dist_.resize(n);
+  emin_.assign(n, FLT_MAX);
+  best_.assign(n, 0);
 
-    for (fh_it=faces.begin(); fh_it!=fh_end; ++fh_it) {
-      fv_it=mesh_.cfv_iter(*fh_it);
-      const Point& p0 = mesh_.point(*fv_it);
-      const Point& p1 = mesh_.point(*(++fv_it));
-      const Point& p2 = mesh_.point(*(++fv_it));
+  Triangle triangle;
 
-      e =  distPointTriangleSquared(*p_it, p0, p1, p2);
-      if (e < emin) {
-        emin = e;
-        fh   = *fh_it;
-      }
+  for (size_t f = 0; f < faces_.size(); ++f) {
+    prepare_triangle(faces_[f], triangle);
+    sqr_distances(triangle, n);
 
+    const int face = int(f);
+    for (size_t i = 0; i < n; ++i) {
+      const bool closer = dist_[i] < emin_[i];
+      emin_[i] = closer ? dist_[i] : emin_[i];
+      best_[i] = closer ? face     : best_[i];
     }
-
-    mesh_.property(points_, fh).push_back(*p_it);
   }
+
+  for (size_t i = 0; i < n; ++i)
+    mesh_.property(points_, faces_[best_[i]]).push_back(Point(px_[i], py_[i], pz_[i]));
+
+  for (size_t f = 0; f < faces_.size(); ++f)
+    update_sphere(faces_[f]);
 }
 
 
@@ -353,30 +482,18 @@ postprocess_collapse(const CollapseInfo& _ci)
 template <class MeshT>
 typename ModHausdorffT<MeshT>::Scalar
 ModHausdorffT<MeshT>::
-compute_sqr_error(FaceHandle _fh, const Point& _p) const
+compute_sqr_error(FaceHandle _fh, const Point& _p)
 {
-  typename Mesh::CFVIter           fv_it = mesh_.cfv_iter(_fh);
-  const Point&                     p0    = mesh_.point(fv_it);
-  const Point&                     p1    = mesh_.point(++fv_it);
-  const Point&                     p2    = mesh_.point(++fv_it);
-
-  const Points&                    points = mesh_.property(points_, _fh);
-  typename Points::const_iterator  p_it   = points.begin();
-  typename Points::const_iterator  p_end  = points.end();
-
-  Point  dummy;
-  Scalar e;
-  Scalar emax =  distPointTriangleSquared(_p, p0, p1, p2);
+  px_.clear(); py_.clear(); pz_.clear(); sqr_tol_.clear(); src_.clear();
+  append_points(mesh_.property(points_, _fh), 0);
+  append_point(_p, 0, -1);
+  dist_.resize(px_.size());
 
+  Triangle triangle;
+  prepare_triangle(_fh, triangle);
+  sqr_distances(triangle, px_.size());
 
-
-  for (; p_it!=p_end; ++p_it) {
-    e =  distPointTriangleSquared(*p_it, p0, p1, p2);
-    if (e > emax)
-      emax = e;
-  }
-
-  return emax;
+  return *std::max_element(dist_.begin(), dist_.end());
 }
 
 
@@ -56,6 +56,8 @@
 #include <OpenMesh/Tools/Decimater/ModBaseT.hh>
 #include <OpenMesh/Core/Utils/Property.hh>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include <cfloat>
 
 //== NAMESPACES ===============================================================
@@ -67,11 +69,16 @@ namespace Decimater {
 
 /** \brief Use Hausdorff distance to control decimation
  *
- * This module computes the aspect ratio.
- *
- * In binary mode, the collapse is legal if:
+ * Each face keeps the points that were removed in its area. In binary
+ * mode, the collapse is legal if:
  *  - The distance after the collapse is lower than the given tolerance
  *
+ * The point list of each face is bounded by a sphere. If the center of
+ * the sphere is closer to the one-ring than the tolerance minus the
+ * radius, all points of the list are within the tolerance and are not
+ * tested individually. The remaining points are tested in batches
+ * (see sqr_distances()).
+ *
  * No continuous mode
  */
 template<class MeshT>
@@ -89,11 +96,13 @@ class ModHausdorffT: public ModBaseT<MeshT> {
     ModHausdorffT(MeshT& _mesh, Scalar _error_tolerance = FLT_MAX) :
         Base(_mesh, true), mesh_(Base::mesh()), tolerance_(_error_tolerance) {
       mesh_.add_property(points_);
+      mesh_.add_property(spheres_);
     }
 
     /// Destructor
     ~ModHausdorffT() {
       mesh_.remove_property(points_);
+      mesh_.remove_property(spheres_);
     }
 
     /// get max error tolerance
@@ -129,21 +138,85 @@ class ModHausdorffT: public ModBaseT<MeshT> {
 
   private:
 
-    /// squared distance from point _p to triangle (_v0, _v1, _v2)
-    Scalar distPointTriangleSquared(const Point& _p, const Point& _v0, const Point& _v1, const Point& _v2);
+    /// Bounding sphere of the point list of a face
+    struct Sphere {
+      Point  center;
+      Scalar radius;
+    };
+
+    /** Triangle with all terms of the point-triangle distance that do not
+     *  depend on the point. Preparing the triangles of a one-ring once per
+     *  collapse avoids recomputing them for every sample point. */
+    struct Triangle {
+      Scalar v0[3];       ///< first corner
+      Scalar e01[3];      ///< edge v0 -> v1
+      Scalar e02[3];      ///< edge v0 -> v2
+      Scalar e12[3];      ///< edge v1 -> v2
+      Scalar n[3];        ///< normal, not normalized
+      Scalar d00, d01, d11, inv_det;       ///< barycentric coordinates
+      Scalar inv_d00, inv_d11, inv_d22;    ///< inverse squared edge lengths
+      bool   valid;       ///< false for degenerate triangles
+    };
+
+    /** clamp _t to [0,1] without comparisons. The other std::min/std::max
+     *  calls of the distance loop become min/max instructions, but with the
+     *  three edge clamps also written as std::min(std::max()) GCC leaves
+     *  branches in the loop and does not vectorize it. */
+    static Scalar clamp01(Scalar _t) {
+      return Scalar(0.5) * (std::fabs(_t) - std::fabs(_t - Scalar(1)) + Scalar(1));
+    }
+
+    /// max(_t, 0)
+    static Scalar positive(Scalar _t) {
+      return std::max(_t, Scalar(0));
+    }
+
+    /// setup the distance terms of face _fh
+    void prepare_triangle(FaceHandle _fh, Triangle& _t) const;
+
+    /** \brief squared distances from the points in px_, py_, pz_ to _t
+     *
+     * The first _n points are processed and the results are written to
+     * dist_. The loop has no branches, so the compiler can process
+     * several points per SIMD register.
+     */
+    void sqr_distances(const Triangle& _t, size_t _n);
+
+    /// append _p with squared tolerance _sqr_tol and source face _src
+    void append_point(const Point& _p, Scalar _sqr_tol, int _src);
+
+    /// append _points with squared tolerance _sqr_tol
+    void append_points(const Points& _points, Scalar _sqr_tol);
+
+    /** remove all of the first _n points that are within their tolerance
+     *  of a face in faces_. Returns the number of points left. */
+    size_t remove_covered_points(size_t _n);
+
+    /// recompute the bounding sphere of the point list of face _fh
+    void update_sphere(FaceHandle _fh);
 
     /// compute max error for face _fh w.r.t. its point list and _p
-    Scalar compute_sqr_error(FaceHandle _fh, const Point& _p) const;
+    Scalar compute_sqr_error(FaceHandle _fh, const Point& _p);
 
   private:
 
-    /// Temporary point storage
-    Points tmp_points_;
+    /// Temporary faces of the one-ring and their triangles, which are
+    /// set up on demand
+    std::vector<FaceHandle> faces_;
+    std::vector<Triangle>   triangles_;
+    size_t                  n_triangles_;
+
+    /// Temporary point storage as structure of arrays: coordinates,
+    /// squared tolerance, source face of a sphere center (or -1) and
+    /// distances
+    std::vector<Scalar> px_, py_, pz_, sqr_tol_, dist_, emin_;
+    std::vector<int>    src_, best_;
 
     Mesh&  mesh_;
     Scalar tolerance_;
 
     OpenMesh::FPropHandleT<Points> points_;
+    OpenMesh::FPropHandleT<Sphere> spheres_;
 };
 
 //=============================================================================
@@ -57,6 +57,7 @@
 
 #include <OpenMesh/Tools/Decimater/ModBaseT.hh>
 #include <OpenMesh/Core/Utils/Property.hh>
+#include <OpenMesh/Core/Utils/vector_cast.hh>
 #include <OpenMesh/Core/Geometry/NormalConeT.hh>
 
 
@@ -165,39 +166,39 @@ public:
    * @return Half of the normal cones size (radius in radians)
    */
   float collapse_priority(const CollapseInfo& _ci) {
-    // simulate collapse
-    mesh_.set_point(_ci.v0, _ci.p1);
-
-
-    typename Mesh::Scalar               max_angle(0.0);
-    typename Mesh::ConstVertexFaceIter  vf_it(mesh_, _ci.v0);
-    typename Mesh::FaceHandle           fh, fhl, fhr;
+    typename Mesh::Scalar   max_angle(0.0), angle;
+    typename Mesh::FaceHandle fh, fhl, fhr;
 
     if (_ci.v0vl.is_valid())  fhl = mesh_.face_handle(_ci.v0vl);
     if (_ci.vrv0.is_valid())  fhr = mesh_.face_handle(_ci.vrv0);
 
-    for (; vf_it.is_valid(); ++vf_it) {
-      fh = *vf_it;
-      if (fh != _ci.fl && fh != _ci.fr) {
-        NormalCone nc = mesh_.property(normal_cones_, fh);
+    // the faces around v0 after moving it to p1, without modifying the mesh
+    typename Mesh::ConstVertexOHalfedgeIter voh_it(mesh_, _ci.v0);
+    for (; voh_it.is_valid(); ++voh_it) {
+      fh = mesh_.face_handle(*voh_it);
+      if (!fh.is_valid() || fh == _ci.fl || fh == _ci.fr)
+        continue;
 
-        nc.merge(NormalCone(mesh_.calc_face_normal(fh)));
+      const Normal n = collapsed_normal(fh, _ci);
+      const NormalCone& cone = mesh_.property(normal_cones_, fh);
+
+      if (fh == fhl || fh == fhr) {
+        NormalCone nc = cone;
+        nc.merge(NormalCone(n));
         if (fh == fhl) nc.merge(mesh_.property(normal_cones_, _ci.fl));
         if (fh == fhr) nc.merge(mesh_.property(normal_cones_, _ci.fr));
+        angle = nc.angle();
+      }
+      else
+        angle = cone.merged_angle(n);
 
-        if (nc.angle() > max_angle) {
-          max_angle = nc.angle();
-          if (max_angle > 0.5 * normal_deviation_)
-            break;
-        }
+      if (angle > max_angle) {
+        max_angle = angle;
+        if (max_angle > 0.5 * normal_deviation_)
+          break;
       }
     }
 
-
-    // undo simulation changes
-    mesh_.set_point(_ci.v0, _ci.p0);
-
-
     return (max_angle < 0.5 * normal_deviation_ ? max_angle : float( Base::ILLEGAL_COLLAPSE ));
   }
 
@@ -242,6 +243,28 @@ public:
 
 
 
+private:
+
+  /// Normal of face _fh after v0 of the collapse is moved to p1. Computed
+  /// like TriMeshT::calc_face_normal(), without modifying the mesh.
+  Normal collapsed_normal(FaceHandle _fh, const CollapseInfo& _ci) const {
+    typename Mesh::HalfedgeHandle heh = mesh_.halfedge_handle(_fh);
+    Point p[3];
+    for (int i = 0; i < 3; ++i) {
+      const VertexHandle vh = mesh_.to_vertex_handle(heh);
+      p[i] = (vh == _ci.v0) ? _ci.p1 : mesh_.point(vh);
+      heh  = mesh_.next_halfedge_handle(heh);
+    }
+
+    Normal p1p0(vector_cast<Normal>(p[0]));  p1p0 -= vector_cast<Normal>(p[1]);
+    Normal p1p2(vector_cast<Normal>(p[2]));  p1p2 -= vector_cast<Normal>(p[1]);
+
+    Normal n = cross(p1p2, p1p0);
+    const Scalar norm = n.length();
+
+    return (norm != Scalar(0)) ? ((n *= (Scalar(1)/norm)),n) : Normal(0,0,0);
+  }
+
 private:
 
   Mesh&                               mesh_;
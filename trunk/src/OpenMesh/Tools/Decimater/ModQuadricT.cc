@@ -130,6 +130,150 @@ initialize()
 
 //-----------------------------------------------------------------------------
 
+template<class MeshT>
+void ModQuadricT<MeshT>::
+collapse_priorities(const std::vector<typename Mesh::HalfedgeHandle>& _collapses,
+                    float* _priorities)
+{
+  typedef Geometry::QuadricT<double> Q;
+
+  // the placement is not batched
+  if (optimal_placement_)
+  {
+    Base::collapse_priorities(_collapses, _priorities);
+    return;
+  }
+
+  Mesh& mesh = Base::mesh();
+
+  // collapsing v0 into v1 gives the error of q0+q1 at p1
+  batch_.clear();
+  for (size_t k = 0; k < _collapses.size(); ++k)
+  {
+    typename Mesh::VertexHandle v0 = mesh.from_vertex_handle(_collapses[k]);
+    typename Mesh::VertexHandle v1 = mesh.to_vertex_handle(_collapses[k]);
+
+    Q q = mesh.property(quadrics_, v0);
+    q += mesh.property(quadrics_, v1);
+
+    batch_.push_back(q, mesh.point(v1));
+  }
+
+  errors_.resize(batch_.size());
+  if (!errors_.empty())
+    batch_.evaluate(&errors_[0]);
+
+  for (size_t k = 0; k < errors_.size(); ++k)
+  {
+    const double err = errors_[k];
+    _priorities[k] = float( (err < max_err_) ? err : float( Base::ILLEGAL_COLLAPSE ) );
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+typename MeshT::Point
+ModQuadricT<MeshT>::
+placement(const CollapseInfo& _ci, double& _err)
+{
+  typedef Geometry::QuadricT<double> Q;
+
+  Q q = Base::mesh().property(quadrics_, _ci.v0);
+  q += Base::mesh().property(quadrics_, _ci.v1);
+
+  _err = q(_ci.p1);
+
+  if (!optimal_placement_ || is_fixed(_ci.v1))
+    return _ci.p1;
+
+  const Vec3d p0 = vector_cast<Vec3d>(_ci.p0);
+  const Vec3d p1 = vector_cast<Vec3d>(_ci.p1);
+
+  Vec3d  p;
+  double err;
+
+  if (is_fixed(_ci.v0))
+  {
+    // v1 takes over the position of v0
+    p   = p0;
+    err = q(p0);
+  }
+  else
+  {
+    const Vec3d mid = (p0 + p1) * 0.5;
+
+    if (q.minimizer(p) && (p - mid).sqrnorm() <= (p1 - p0).sqrnorm())
+      err = q(p);
+    else
+    {
+      // ill-conditioned, use the best point on the edge
+      p   = p1;
+      err = _err;
+
+      const double err0 = q(p0), err_mid = q(mid);
+      if (err0 < err)    { p = p0;  err = err0;    }
+      if (err_mid < err) { p = mid; err = err_mid; }
+    }
+  }
+
+  if (p == p1 || flips(_ci, p))
+    return _ci.p1;
+
+  _err = err;
+  return vector_cast<typename Mesh::Point>(p);
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+bool ModQuadricT<MeshT>::is_fixed(typename Mesh::VertexHandle _vh)
+{
+  Mesh& mesh = Base::mesh();
+
+  return mesh.is_boundary(_vh) ||
+         mesh.status(_vh).locked() ||
+         mesh.status(_vh).feature();
+}
+
+//-----------------------------------------------------------------------------
+
+template<class MeshT>
+bool ModQuadricT<MeshT>::flips(const CollapseInfo& _ci, const Vec3d& _p)
+{
+  Mesh& mesh = Base::mesh();
+
+  typename Mesh::VertexHandle vh[2] = { _ci.v0, _ci.v1 };
+
+  // the remaining faces around v0 and v1, with either vertex moved to _p
+  for (int k = 0; k < 2; ++k)
+  {
+    const Vec3d p = vector_cast<Vec3d>(mesh.point(vh[k]));
+
+    typename Mesh::VertexOHalfedgeIter voh_it = mesh.voh_iter(vh[k]);
+    for (; voh_it.is_valid(); ++voh_it)
+    {
+      typename Mesh::FaceHandle fh = mesh.face_handle(*voh_it);
+      if (!fh.is_valid() || fh == _ci.fl || fh == _ci.fr)
+        continue;
+
+      typename Mesh::HalfedgeHandle heh = mesh.next_halfedge_handle(*voh_it);
+      const Vec3d pa = vector_cast<Vec3d>(mesh.point(mesh.from_vertex_handle(heh)));
+      const Vec3d pb = vector_cast<Vec3d>(mesh.point(mesh.to_vertex_handle(heh)));
+
+      const Vec3d n_old = (pa - p)  % (pb - p);
+      const Vec3d n_new = (pa - _p) % (pb - _p);
+
+      if ((n_old | n_new) <= 0.0)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+
 template<class MeshT>
 void ModQuadricT<MeshT>::set_error_tolerance_factor(double _factor) {
   if (this->is_binary()) {
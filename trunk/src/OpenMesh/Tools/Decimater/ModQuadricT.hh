@@ -71,6 +71,10 @@ namespace Decimater {
 /** \brief Mesh decimation module computing collapse priority based on error quadrics.
  *
  *  This module can be used as a binary and non-binary module.
+ *
+ *  By default the remaining vertex of a collapse keeps its position. With
+ *  set_optimal_placement() it is moved to the point with the smallest
+ *  quadric error instead.
  */
 template <class MeshT>
 class ModQuadricT : public ModBaseT<MeshT>
@@ -87,7 +91,7 @@ public:
    *  \internal
    */
   ModQuadricT( MeshT &_mesh )
-    : Base(_mesh, false)
+    : Base(_mesh, false), optimal_placement_(false)
   {
     unset_max_err();
     Base::mesh().add_property( quadrics_ );
@@ -117,10 +121,17 @@ public: // inherited
 
     typedef Geometry::QuadricT<double> Q;
 
-    Q q = Base::mesh().property(quadrics_, _ci.v0);
-    q += Base::mesh().property(quadrics_, _ci.v1);
+    double err;
+
+    if (optimal_placement_)
+      placement(_ci, err);
+    else
+    {
+      Q q = Base::mesh().property(quadrics_, _ci.v0);
+      q += Base::mesh().property(quadrics_, _ci.v1);
 
-    double err = q(_ci.p1);
+      err = q(_ci.p1);
+    }
 
     //min_ = std::min(err, min_);
     //max_ = std::max(err, max_);
@@ -131,6 +142,29 @@ public: // inherited
   }
 
 
+  /** Compute the priorities of several collapses with one batched
+   *  evaluation of the error quadrics.
+   *
+   *  \see ModBaseT::collapse_priorities()
+   */
+  virtual void collapse_priorities(const std::vector<typename Mesh::HalfedgeHandle>& _collapses,
+                                   float* _priorities);
+
+
+  /// Pre-process halfedge collapse (move the remaining vertex if
+  /// optimal placement is enabled)
+  virtual void preprocess_collapse(const CollapseInfo& _ci)
+  {
+    if (optimal_placement_)
+    {
+      double err;
+      Base::mesh().set_point(_ci.v1, placement(_ci, err));
+    }
+  }
+
+  /// Does the module move the remaining vertex? \see set_optimal_placement()
+  virtual bool moves_vertex() const { return optimal_placement_; }
+
   /// Post-process halfedge collapse (accumulate quadrics)
   virtual void postprocess_collapse(const CollapseInfo& _ci)
   {
@@ -168,14 +202,54 @@ public: // specific methods
   /// Return value of max. allowed error.
   double max_err() const { return max_err_; }
 
+  /** Enable or disable optimal placement of the remaining vertex.
+   *
+   *  The optimal point of a collapse minimizes the sum of the quadrics of
+   *  both vertices (see Geometry::QuadricT::minimizer()). If this system is
+   *  ill-conditioned or its solution lies farther from the edge midpoint
+   *  than the edge is long, the best of the midpoint and the two endpoints
+   *  is used. Boundary, locked and feature vertices keep their position.
+   *  If the new position would flip a face, the vertex stays at \c p1.
+   *
+   *  The priority of a collapse is the error at its placement, and the
+   *  vertex is moved in preprocess_collapse(). The other modules test a
+   *  collapse at \c p1, so with optimal placement the module has to be
+   *  the only one: BaseDecimaterT::initialize() fails otherwise.
+   */
+  void set_optimal_placement(bool _b) { optimal_placement_ = _b; }
+
+  /// Is optimal placement enabled? \see set_optimal_placement()
+  bool optimal_placement() const { return optimal_placement_; }
+
+  /** Return the position of the remaining vertex after the collapse and
+   *  its quadric error in _err. This is \c p1 unless optimal placement is
+   *  enabled.
+   */
+  typename MeshT::Point placement(const CollapseInfo& _ci, double& _err);
+
+
+private:
+
+  // can the vertex not be moved?
+  bool is_fixed(typename Mesh::VertexHandle _vh);
+
+  // does moving the remaining vertex to _p flip a face?
+  bool flips(const CollapseInfo& _ci, const Vec3d& _p);
 
 private:
 
   // maximum quadric error
   double max_err_;
 
+  // move the remaining vertex to the optimal point
+  bool optimal_placement_;
+
   // this vertex property stores a quadric for each vertex
   VPropHandleT< Geometry::QuadricT<double> >  quadrics_;
+
+  // quadrics and errors of collapse_priorities()
+  Geometry::QuadricBatchd  batch_;
+  std::vector<double>      errors_;
 };
 
 //=============================================================================
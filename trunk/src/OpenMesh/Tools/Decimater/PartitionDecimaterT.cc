@@ -0,0 +1,367 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------*
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         *
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/
+
+/*===========================================================================*\
+ *                                                                           *
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+
+/** \file PartitionDecimaterT.cc
+ */
+
+//=============================================================================
+//
+//  CLASS PartitionDecimaterT - IMPLEMENTATION
+//
+//=============================================================================
+
+#define OPENMESH_DECIMATER_PARTITIONDECIMATERT_CC
+
+//== INCLUDES =================================================================
+
+#include <algorithm>
+#include <cfloat>
+#include <OpenMesh/Core/Utils/vector_cast.hh>
+#include <OpenMesh/Tools/Decimater/PartitionDecimaterT.hh>
+#ifdef USE_OPENMP
+#  include <omp.h>
+#endif
+
+
+//== NAMESPACE ===============================================================
+
+namespace OpenMesh {
+namespace Decimater {
+
+
+//== IMPLEMENTATION ==========================================================
+
+template<class Mesh>
+PartitionDecimaterT<Mesh>::PartitionDecimaterT(Mesh& _mesh) :
+  mesh_(_mesh), n_chunks_(8), n_threads_(0), seam_rings_(2),
+  n_seam_vertices_(0), n_seam_collapses_(0), n_stitch_failures_(0) {
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+size_t PartitionDecimaterT<Mesh>::decimate_to_faces(size_t _n_faces, Setup& _setup) {
+
+  n_seam_vertices_ = n_seam_collapses_ = n_stitch_failures_ = 0;
+
+  if (mesh_.has_vertex_status() && mesh_.has_edge_status() && mesh_.has_face_status())
+    mesh_.garbage_collection();
+
+  const size_t n_vertices = mesh_.n_vertices();
+  const size_t n_faces    = mesh_.n_faces();
+
+  if (_n_faces >= n_faces)
+    return 0;
+
+  typename Mesh::FaceIter        f_it, f_end(mesh_.faces_end());
+  typename Mesh::VertexIter      v_it, v_end(mesh_.vertices_end());
+  typename Mesh::FaceVertexIter  fv_it;
+  typename Mesh::VertexFaceIter  vf_it;
+
+  // ---- 1 - split the faces at the median of their centroids
+
+  std::vector<Vec3f> centroids(n_faces);
+  for (f_it = mesh_.faces_begin(); f_it != f_end; ++f_it) {
+    Vec3f c(0.0f, 0.0f, 0.0f);
+    int   n = 0;
+    for (fv_it = mesh_.fv_iter(*f_it); fv_it.is_valid(); ++fv_it, ++n)
+      c += vector_cast<Vec3f>(mesh_.point(*fv_it));
+    centroids[f_it->idx()] = c / float(n);
+  }
+
+  order_.resize(n_faces);
+  for (size_t i = 0; i < n_faces; ++i)
+    order_[i] = (unsigned int) i;
+
+  offsets_.assign(n_chunks_ + 1, n_faces);
+  partition(0, n_faces, n_chunks_, 0, centroids);
+
+  std::vector<unsigned int> face_chunk(n_faces);
+  for (unsigned int c = 0; c < n_chunks_; ++c)
+    for (size_t i = offsets_[c]; i < offsets_[c+1]; ++i)
+      face_chunk[order_[i]] = c;
+
+  // ---- 2 - find the vertices of several chunks
+
+  seam_.assign(n_vertices, false);
+  for (v_it = mesh_.vertices_begin(); v_it != v_end; ++v_it) {
+    vf_it = mesh_.vf_iter(*v_it);
+    if (!vf_it.is_valid())
+      continue;
+
+    const unsigned int c = face_chunk[vf_it->idx()];
+    for (++vf_it; vf_it.is_valid(); ++vf_it)
+      if (face_chunk[vf_it->idx()] != c) {
+        seam_[v_it->idx()] = true;
+        ++n_seam_vertices_;
+        break;
+      }
+  }
+
+  // ---- 3 - decimate the chunks in parallel
+
+  const double ratio = double(_n_faces) / double(n_faces);
+
+  std::vector<Mesh>                chunks(n_chunks_);
+  std::vector< VPropHandleT<int> > global(n_chunks_);
+  std::vector<size_t>              collapses(n_chunks_, 0);
+
+  const int n_chunks = int(n_chunks_);
+
+#ifdef USE_OPENMP
+  const int n_threads = n_threads_ > 0 ? int(n_threads_) : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic, 1) num_threads(n_threads)
+#endif
+  for (int c = 0; c < n_chunks; ++c)
+    collapses[c] = decimate_chunk(c, ratio, _setup, chunks[c], global[c]);
+
+  // ---- 4 - stitch the chunks, the seam vertices are shared
+
+  std::vector<bool> locked(n_vertices, false);
+  if (mesh_.has_vertex_status())
+    for (size_t i = 0; i < n_vertices; ++i)
+      locked[i] = mesh_.status(mesh_.vertex_handle((unsigned int) i)).locked();
+
+  mesh_.clear();
+
+  std::vector<int>           vertex(n_vertices, -1);
+  std::vector<bool>          new_locked, near_seam;
+  std::vector<VertexHandle>  fvh;
+
+  for (unsigned int c = 0; c < n_chunks_; ++c) {
+    Mesh& chunk = chunks[c];
+
+    for (v_it = chunk.vertices_begin(); v_it != chunk.vertices_end(); ++v_it) {
+      const int g = chunk.property(global[c], *v_it);
+      if (vertex[g] < 0) {
+        VertexHandle vh = mesh_.add_vertex(chunk.point(*v_it));
+        copy_vertex(chunk, *v_it, mesh_, vh);
+        vertex[g] = vh.idx();
+        new_locked.push_back(locked[g]);
+        near_seam.push_back(seam_[g]);
+      }
+    }
+
+    for (f_it = chunk.faces_begin(); f_it != chunk.faces_end(); ++f_it) {
+      fvh.clear();
+      for (fv_it = chunk.fv_iter(*f_it); fv_it.is_valid(); ++fv_it)
+        fvh.push_back(mesh_.vertex_handle(vertex[chunk.property(global[c], *fv_it)]));
+      if (!mesh_.add_face(fvh).is_valid())
+        ++n_stitch_failures_;
+    }
+
+    chunk.clear();
+  }
+
+  if (n_stitch_failures_ > 0)
+    omerr() << "[PartitionDecimater] : " << n_stitch_failures_
+            << " faces could not be stitched\n";
+
+  // ---- 5 - decimate the rings around the seams
+
+  for (unsigned int r = 0; r < seam_rings_; ++r) {
+    std::vector<bool> ring(near_seam);
+    for (v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it)
+      if (near_seam[v_it->idx()])
+        for (typename Mesh::VertexVertexIter vv_it = mesh_.vv_iter(*v_it); vv_it.is_valid(); ++vv_it)
+          ring[vv_it->idx()] = true;
+    near_seam.swap(ring);
+  }
+
+  mesh_.request_vertex_status();
+  for (v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it)
+    mesh_.status(*v_it).set_locked(new_locked[v_it->idx()] || !near_seam[v_it->idx()]);
+
+  if (mesh_.has_face_normals())
+    mesh_.update_face_normals();
+
+  {
+    Decimater decimater(mesh_);
+    _setup.add_modules(decimater);
+
+    if (decimater.initialize())
+      n_seam_collapses_ = decimater.decimate_to_faces(0, _n_faces);
+
+    for (v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it)
+      mesh_.status(*v_it).set_locked(new_locked[v_it->idx()]);
+
+    mesh_.garbage_collection();
+  }
+
+  mesh_.release_vertex_status();
+
+  size_t n_collapses = n_seam_collapses_;
+  for (unsigned int c = 0; c < n_chunks_; ++c)
+    n_collapses += collapses[c];
+
+  return n_collapses;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+void PartitionDecimaterT<Mesh>::partition(size_t _first, size_t _last,
+                                          unsigned int _n, unsigned int _chunk,
+                                          const std::vector<Vec3f>& _centroids) {
+  if (_n == 1) {
+    offsets_[_chunk] = _first;
+    return;
+  }
+
+  // cut the longest side of the bounding box of the centroids
+  Vec3f bb_min(FLT_MAX, FLT_MAX, FLT_MAX), bb_max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+  for (size_t i = _first; i < _last; ++i) {
+    bb_min.minimize(_centroids[order_[i]]);
+    bb_max.maximize(_centroids[order_[i]]);
+  }
+
+  const Vec3f size = bb_max - bb_min;
+  int axis = 0;
+  if (size[1] > size[axis]) axis = 1;
+  if (size[2] > size[axis]) axis = 2;
+
+  const unsigned int n0  = _n / 2;
+  const size_t       mid = _first + (_last - _first) * n0 / _n;
+
+  std::nth_element(order_.begin() + _first, order_.begin() + mid,
+                   order_.begin() + _last, CentroidLess(_centroids, axis));
+
+  partition(_first, mid, n0, _chunk, _centroids);
+  partition(mid, _last, _n - n0, _chunk + n0, _centroids);
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+size_t PartitionDecimaterT<Mesh>::decimate_chunk(unsigned int _c, double _ratio,
+                                                 Setup& _setup, Mesh& _chunk,
+                                                 VPropHandleT<int>& _global) {
+  typename Mesh::FaceVertexIter fv_it;
+
+  // the vertices of the chunk, sorted by their index in the mesh
+  std::vector<unsigned int> vertices;
+  for (size_t i = offsets_[_c]; i < offsets_[_c+1]; ++i)
+    for (fv_it = mesh_.fv_iter(FaceHandle(order_[i])); fv_it.is_valid(); ++fv_it)
+      vertices.push_back(fv_it->idx());
+
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+  request_attributes(mesh_, _chunk);
+  _chunk.request_vertex_status();
+  _chunk.add_property(_global);
+  _chunk.reserve(vertices.size(), 3 * (offsets_[_c+1] - offsets_[_c]),
+                 offsets_[_c+1] - offsets_[_c]);
+
+  const bool has_status = mesh_.has_vertex_status();
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    VertexHandle src = mesh_.vertex_handle(vertices[i]);
+    VertexHandle vh  = _chunk.add_vertex(mesh_.point(src));
+    copy_vertex(mesh_, src, _chunk, vh);
+    _chunk.property(_global, vh) = int(vertices[i]);
+
+    // the seams and their one-rings must not change, otherwise two chunks
+    // could connect the same seam vertices by an edge
+    bool locked = seam_[vertices[i]] || (has_status && mesh_.status(src).locked());
+    for (typename Mesh::VertexVertexIter vv_it = mesh_.vv_iter(src); !locked && vv_it.is_valid(); ++vv_it)
+      locked = seam_[vv_it->idx()];
+    _chunk.status(vh).set_locked(locked);
+  }
+
+  std::vector<VertexHandle> fvh;
+  for (size_t i = offsets_[_c]; i < offsets_[_c+1]; ++i) {
+    fvh.clear();
+    for (fv_it = mesh_.fv_iter(FaceHandle(order_[i])); fv_it.is_valid(); ++fv_it)
+      fvh.push_back(_chunk.vertex_handle((unsigned int)
+        (std::lower_bound(vertices.begin(), vertices.end(), (unsigned int) fv_it->idx()) - vertices.begin())));
+    _chunk.add_face(fvh);
+  }
+
+  if (_chunk.has_face_normals())
+    _chunk.update_face_normals();
+
+  size_t n_collapses = 0;
+  {
+    Decimater decimater(_chunk);
+    _setup.add_modules(decimater);
+
+    if (decimater.initialize())
+      n_collapses = decimater.decimate_to_faces(0, size_t(_ratio * double(_chunk.n_faces()) + 0.5));
+
+    _chunk.garbage_collection();
+  }
+
+  return n_collapses;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+void PartitionDecimaterT<Mesh>::copy_vertex(Mesh& _src, VertexHandle _sv,
+                                            Mesh& _dst, VertexHandle _dv) {
+  if (_src.has_vertex_normals() && _dst.has_vertex_normals())
+    _dst.set_normal(_dv, _src.normal(_sv));
+  if (_src.has_vertex_colors() && _dst.has_vertex_colors())
+    _dst.set_color(_dv, _src.color(_sv));
+  if (_src.has_vertex_texcoords2D() && _dst.has_vertex_texcoords2D())
+    _dst.set_texcoord2D(_dv, _src.texcoord2D(_sv));
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+void PartitionDecimaterT<Mesh>::request_attributes(Mesh& _src, Mesh& _dst) {
+  if (_src.has_vertex_normals())
+    _dst.request_vertex_normals();
+  if (_src.has_vertex_colors())
+    _dst.request_vertex_colors();
+  if (_src.has_vertex_texcoords2D())
+    _dst.request_vertex_texcoords2D();
+  if (_src.has_face_normals())
+    _dst.request_face_normals();
+}
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
@@ -0,0 +1,207 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------*
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         *
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/
+
+/*===========================================================================*\
+ *                                                                           *
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+
+/** \file PartitionDecimaterT.hh
+ */
+
+//=============================================================================
+//
+//  CLASS PartitionDecimaterT
+//
+//=============================================================================
+
+#ifndef OPENMESH_DECIMATER_PARTITIONDECIMATERT_HH
+#define OPENMESH_DECIMATER_PARTITIONDECIMATERT_HH
+
+
+//== INCLUDES =================================================================
+
+#include <vector>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
+
+
+//== NAMESPACE ================================================================
+
+namespace OpenMesh  {
+namespace Decimater {
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** \brief Decimation of large meshes in spatial chunks.
+
+    The faces are split into chunks by recursive median cuts of their
+    centroids. Every chunk is copied into a mesh of its own and decimated
+    by a DecimaterT, in parallel if OpenMesh is built with OpenMP. The
+    vertices shared by several chunks (the seams) and their neighbors are
+    locked, so the chunks still fit together and are stitched into the
+    input mesh afterwards. A final pass decimates the stitched mesh with only the
+    vertices near the seams unlocked to reach the target and to remove
+    the denser seam tessellation.
+
+    The modules of each decimater are registered by a Setup object.
+    Vertices that are locked in the input mesh stay locked. Only the
+    points and the vertex normals, colors and texture coordinates are
+    kept, other properties of the input mesh are cleared.
+*/
+template < typename MeshT >
+class PartitionDecimaterT
+{
+public: //-------------------------------------------------------- public types
+
+  typedef MeshT                          Mesh;
+  typedef DecimaterT<MeshT>              Decimater;
+  typedef typename Mesh::VertexHandle    VertexHandle;
+  typedef typename Mesh::FaceHandle      FaceHandle;
+
+  /** Registers and parameterizes the modules of a decimater. It is
+   *  called for every chunk and for the final pass, possibly from
+   *  several threads at once.
+   */
+  class Setup
+  {
+  public:
+    virtual ~Setup() {}
+
+    /// Add the modules to _decimater, initialize() is called afterwards
+    virtual void add_modules(Decimater& _decimater) = 0;
+  };
+
+public: //------------------------------------------------------ public methods
+
+  /// Constructor
+  PartitionDecimaterT( Mesh& _mesh );
+
+  /// Set the number of chunks (default 8)
+  void set_n_chunks(unsigned int _n) { n_chunks_ = _n > 0 ? _n : 1; }
+
+  /// Number of chunks
+  unsigned int n_chunks() const { return n_chunks_; }
+
+  /// Set the number of threads, 0 uses the OpenMP default
+  void set_n_threads(unsigned int _n) { n_threads_ = _n; }
+
+  /// Set the number of vertex rings around the seams that are unlocked
+  /// in the final pass (default 2)
+  void set_seam_rings(unsigned int _n) { seam_rings_ = _n; }
+
+  /** Decimate the mesh to _n_faces faces. Afterwards the mesh is garbage
+   *  collected. Returns the number of collapses of all chunks and the
+   *  final pass.
+   */
+  size_t decimate_to_faces( size_t _n_faces, Setup& _setup );
+
+  /// Number of seam vertices of the last decimation
+  size_t n_seam_vertices() const { return n_seam_vertices_; }
+
+  /// Number of collapses in the final pass of the last decimation
+  size_t n_seam_collapses() const { return n_seam_collapses_; }
+
+  /// Number of faces of the chunks that could not be added to the stitched
+  /// mesh in the last decimation (they are missing from the result)
+  size_t n_stitch_failures() const { return n_stitch_failures_; }
+
+private: //---------------------------------------------------- private types
+
+  // compares faces by one coordinate of their centroids
+  struct CentroidLess
+  {
+    CentroidLess(const std::vector<Vec3f>& _centroids, int _axis)
+      : centroids_(_centroids), axis_(_axis) {}
+
+    bool operator()(unsigned int _f0, unsigned int _f1) const
+    { return centroids_[_f0][axis_] < centroids_[_f1][axis_]; }
+
+    const std::vector<Vec3f>& centroids_;
+    int                       axis_;
+  };
+
+private: //---------------------------------------------------- private methods
+
+  // sort the faces [_first, _last) of order_ into _n chunks from _chunk on
+  void partition(size_t _first, size_t _last, unsigned int _n, unsigned int _chunk,
+                 const std::vector<Vec3f>& _centroids);
+
+  // copy chunk _c into _chunk and decimate it by _ratio
+  size_t decimate_chunk(unsigned int _c, double _ratio, Setup& _setup,
+                        Mesh& _chunk, VPropHandleT<int>& _global);
+
+  // copy the vertex attributes of _sv in _src to _dv in _dst
+  static void copy_vertex(Mesh& _src, VertexHandle _sv, Mesh& _dst, VertexHandle _dv);
+
+  // request the vertex attributes of _src in _dst
+  static void request_attributes(Mesh& _src, Mesh& _dst);
+
+private: //------------------------------------------------------- private data
+
+  // reference to mesh
+  Mesh&                      mesh_;
+
+  unsigned int               n_chunks_;
+  unsigned int               n_threads_;
+  unsigned int               seam_rings_;
+
+  // faces sorted by chunk, chunk c has the faces [offsets_[c], offsets_[c+1])
+  std::vector<unsigned int>  order_;
+  std::vector<size_t>        offsets_;
+
+  // vertices shared by several chunks
+  std::vector<bool>          seam_;
+
+  size_t                     n_seam_vertices_;
+  size_t                     n_seam_collapses_;
+  size_t                     n_stitch_failures_;
+};
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
+#if defined(OM_INCLUDE_TEMPLATES) && !defined(OPENMESH_DECIMATER_PARTITIONDECIMATERT_CC)
+#define OPENMESH_DECIMATER_PARTITIONDECIMATERT_TEMPLATES
+#include "PartitionDecimaterT.cc"
+#endif
+//=============================================================================
+#endif // OPENMESH_DECIMATER_PARTITIONDECIMATERT_HH defined
+//=============================================================================
@@ -0,0 +1,333 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file ProgMesh.cc
+ */
+
+//=============================================================================
+//
+//  CLASS ProgMesh - IMPLEMENTATION
+//
+//=============================================================================
+
+
+//== INCLUDES =================================================================
+
+#include <algorithm>
+#include <fstream>
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
+#include <OpenMesh/Tools/Decimater/ProgMesh.hh>
+
+
+//== NAMESPACE ================================================================
+
+namespace OpenMesh  {
+namespace Decimater {
+
+
+//== IMPLEMENTATION ==========================================================
+
+
+ProgMesh::
+ProgMesh()
+  : n_base_vertices_(0),
+    n_base_faces_(0),
+    lod_(0)
+{
+}
+
+
+void
+ProgMesh::
+clear()
+{
+  n_base_vertices_ = n_base_faces_ = lod_ = 0;
+
+  points_.clear();
+  indices_.clear();
+  vsplits_.clear();
+  corners_.clear();
+}
+
+
+bool
+ProgMesh::
+read(const std::string& _filename)
+{
+  typedef TriMesh_ArrayKernelT<> Mesh;
+
+  char          c[10];
+  unsigned int  i, n_details, fvi[3], v1, vl, vr;
+  Vec3f         p;
+
+  clear();
+
+  std::ifstream ifs(_filename.c_str(), std::ios::binary);
+  if (!ifs)
+    return false;
+
+  const bool swap = Endian::local() != Endian::LSB;
+
+  // read header
+  ifs.read(c, 8); c[8] = '\0';
+  if (!ifs || std::string(c) != std::string("ProgMesh"))
+    return false;
+
+  IO::restore(ifs, n_base_vertices_, swap);
+  IO::restore(ifs, n_base_faces_, swap);
+  IO::restore(ifs, n_details, swap);
+  if (!ifs)
+    return false;
+
+  // the counts must fit into the rest of the file, a corrupt header must
+  // not make the reserves fail (a point and three indices take 12 bytes)
+  const std::streampos start = ifs.tellg();
+  ifs.seekg(0, std::ios::end);
+  size_t size = size_t(ifs.tellg() - start);
+  ifs.seekg(start);
+
+  if (!ifs || n_base_vertices_ > size / 12)
+    return false;
+  size -= 12 * size_t(n_base_vertices_);
+  if (n_base_faces_ > size / 12)
+    return false;
+  size -= 12 * size_t(n_base_faces_);
+  if (n_details > size / 24)
+    return false;
+
+  // the splits are replayed once on a mesh to find their corners
+  Mesh mesh;
+
+  const size_t max_vertices = size_t(n_base_vertices_) + n_details;
+  const size_t max_faces    = size_t(n_base_faces_) + 2 * size_t(n_details);
+
+  points_.reserve(max_vertices);
+  indices_.reserve(3 * max_faces);
+  vsplits_.reserve(n_details);
+  mesh.reserve(max_vertices, max_vertices + max_faces, max_faces);
+
+  // base mesh
+  for (i = 0; i < n_base_vertices_; ++i)
+  {
+    IO::restore(ifs, p, swap);
+    points_.push_back(p);
+    mesh.add_vertex(Mesh::Point(p));
+  }
+
+  for (i = 0; i < n_base_faces_; ++i)
+  {
+    IO::restore(ifs, fvi[0], swap);
+    IO::restore(ifs, fvi[1], swap);
+    IO::restore(ifs, fvi[2], swap);
+
+    if (!ifs || fvi[0] >= n_base_vertices_ || fvi[1] >= n_base_vertices_ ||
+        fvi[2] >= n_base_vertices_)
+      break;
+
+    if (!mesh.add_face(mesh.vertex_handle(fvi[0]), mesh.vertex_handle(fvi[1]),
+                       mesh.vertex_handle(fvi[2])).is_valid())
+      break;
+
+    indices_.insert(indices_.end(), fvi, fvi + 3);
+  }
+
+  if (i < n_base_faces_)
+  {
+    clear();
+    return false;
+  }
+
+  // vertex splits
+  for (i = 0; i < n_details; ++i)
+  {
+    IO::restore(ifs, p, swap);
+    IO::restore(ifs, v1, swap);
+    IO::restore(ifs, vl, swap);
+    IO::restore(ifs, vr, swap);
+
+    const unsigned int v0 = n_base_vertices_ + i;
+
+    // vl and vr are -1 at the boundary
+    Mesh::VertexHandle vh1(v1), vhl(vl), vhr(vr);
+
+    if (!ifs || v1 >= v0 ||
+        (vhl.is_valid() && (vl >= v0 || !mesh.find_halfedge(vh1, vhl).is_valid())) ||
+        (vhr.is_valid() && (vr >= v0 || !mesh.find_halfedge(vhr, vh1).is_valid())) ||
+        ((!vhl.is_valid() || !vhr.is_valid()) && !mesh.is_boundary(vh1)))
+      break;
+
+    const unsigned int n_faces = (unsigned int) mesh.n_faces();
+
+    points_.push_back(p);
+    Mesh::VertexHandle vh0 = mesh.add_vertex(Mesh::Point(p));
+    mesh.vertex_split(vh0, vh1, vhl, vhr);
+
+    VSplit vsplit;
+    vsplit.v1           = v1;
+    vsplit.first_corner = (unsigned int) corners_.size();
+
+    // the old faces around v0 had v1 at this corner
+    bool ok = true;
+    for (Mesh::VertexFaceIter vf_it = mesh.vf_iter(vh0); vf_it.is_valid(); ++vf_it)
+    {
+      const unsigned int f = vf_it->idx();
+      if (f >= n_faces)
+        continue;
+
+      unsigned int k = 0;
+      while (k < 3 && indices_[3*f+k] != v1)
+        ++k;
+
+      if (k == 3)
+      {
+        ok = false;
+        break;
+      }
+
+      corners_.push_back(3*f+k);
+      indices_[3*f+k] = v0;
+    }
+
+    if (!ok)
+      break;
+
+    // the new faces
+    for (unsigned int f = n_faces; f < mesh.n_faces(); ++f)
+      for (Mesh::FaceVertexIter fv_it = mesh.fv_iter(mesh.face_handle(f)); fv_it.is_valid(); ++fv_it)
+        indices_.push_back(fv_it->idx());
+
+    vsplit.n_corners = (unsigned int) corners_.size() - vsplit.first_corner;
+    vsplit.n_faces   = (unsigned int) mesh.n_faces();
+    vsplits_.push_back(vsplit);
+  }
+
+  if (i < n_details)
+  {
+    clear();
+    return false;
+  }
+
+  // start at the base mesh
+  lod_ = n_details;
+  set_lod(0);
+
+  return true;
+}
+
+
+unsigned int
+ProgMesh::
+lod_for_faces(unsigned int _n_faces) const
+{
+  // the number of faces grows with each split
+  unsigned int lo = 0, hi = n_details();
+  while (lo < hi)
+  {
+    const unsigned int mid = lo + (hi - lo + 1) / 2;
+    if (vsplits_[mid - 1].n_faces <= _n_faces)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+
+void
+ProgMesh::
+set_lod(unsigned int _lod)
+{
+  if (_lod > n_details())
+    _lod = n_details();
+
+  // refine
+  for (; lod_ < _lod; ++lod_)
+  {
+    const VSplit& vsplit = vsplits_[lod_];
+    for (unsigned int k = 0; k < vsplit.n_corners; ++k)
+      indices_[corners_[vsplit.first_corner + k]] = n_base_vertices_ + lod_;
+  }
+
+  // coarsen
+  for (; lod_ > _lod; --lod_)
+  {
+    const VSplit& vsplit = vsplits_[lod_ - 1];
+    for (unsigned int k = 0; k < vsplit.n_corners; ++k)
+      indices_[corners_[vsplit.first_corner + k]] = vsplit.v1;
+  }
+}
+
+
+void
+ProgMesh::
+index_buffer(unsigned int _n_faces, std::vector<unsigned int>& _indices) const
+{
+  const unsigned int lod = lod_for_faces(_n_faces);
+
+  // the faces beyond the current level are stored as they were created,
+  // so the splits in between can be applied to a copy
+  const unsigned int n = 3 * std::max(n_faces(lod_), n_faces(lod));
+  _indices.assign(indices_.begin(), indices_.begin() + n);
+
+  for (unsigned int l = lod_; l < lod; ++l)
+  {
+    const VSplit& vsplit = vsplits_[l];
+    for (unsigned int k = 0; k < vsplit.n_corners; ++k)
+      _indices[corners_[vsplit.first_corner + k]] = n_base_vertices_ + l;
+  }
+
+  for (unsigned int l = lod_; l > lod; --l)
+  {
+    const VSplit& vsplit = vsplits_[l - 1];
+    for (unsigned int k = 0; k < vsplit.n_corners; ++k)
+      _indices[corners_[vsplit.first_corner + k]] = vsplit.v1;
+  }
+
+  _indices.resize(3 * n_faces(lod));
+}
+
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
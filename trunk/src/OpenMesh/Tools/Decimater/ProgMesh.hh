@@ -0,0 +1,179 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file ProgMesh.hh
+ */
+
+//=============================================================================
+//
+//  CLASS ProgMesh
+//
+//=============================================================================
+
+#ifndef OPENMESH_DECIMATER_PROGMESH_HH
+#define OPENMESH_DECIMATER_PROGMESH_HH
+
+
+//== INCLUDES =================================================================
+
+#include <string>
+#include <vector>
+#include <OpenMesh/Core/System/config.h>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+
+
+//== NAMESPACE ================================================================
+
+namespace OpenMesh  {
+namespace Decimater {
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** \brief Playback of a progressive mesh as written by ModProgMeshT::write().
+
+    The progressive mesh is kept as a vertex array, a triangle index
+    buffer and one compact record per vertex split instead of a mesh.
+    Vertices and faces are sorted by the level of detail at which they
+    appear, so the current level uses a prefix of both arrays. A split
+    appends the new vertex and one or two faces and changes the corners
+    of the other faces around the new vertex from \c v1 to the new
+    vertex. Both directions only touch these corners, so switching
+    between two levels takes time proportional to the number of
+    affected faces.
+
+    The file is read once with read(), which replays the vertex splits
+    on a temporary mesh to find the corners of each split.
+*/
+class OPENMESHDLLEXPORT ProgMesh
+{
+public:
+
+  /// One vertex split, the new vertex is n_base_vertices() plus the
+  /// index of the split
+  struct VSplit
+  {
+    unsigned int v1;            ///< vertex that is split
+    unsigned int first_corner;  ///< first of its corners in corners()
+    unsigned int n_corners;     ///< number of corners that switch to the new vertex
+    unsigned int n_faces;       ///< number of faces after the split
+  };
+
+public:
+
+  ProgMesh();
+
+  /// Read a .pm file and switch to the base mesh. Returns false if the
+  /// file cannot be read or does not describe valid vertex splits.
+  bool read(const std::string& _filename);
+
+  /// Remove all data.
+  void clear();
+
+  unsigned int n_base_vertices() const { return n_base_vertices_; }
+  unsigned int n_base_faces() const    { return n_base_faces_; }
+  unsigned int n_details() const       { return (unsigned int) vsplits_.size(); }
+
+  /// Number of vertices and faces of the finest level
+  unsigned int n_max_vertices() const  { return (unsigned int) points_.size(); }
+  unsigned int n_max_faces() const     { return (unsigned int) indices_.size() / 3; }
+
+  /// The current level of detail, i.e. the number of applied vertex splits
+  unsigned int lod() const { return lod_; }
+
+  /// Number of vertices and faces of the current level
+  unsigned int n_vertices() const { return n_base_vertices_ + lod_; }
+  unsigned int n_faces() const    { return n_faces(lod_); }
+
+  /// Number of faces of level _lod
+  unsigned int n_faces(unsigned int _lod) const
+  { return _lod == 0 ? n_base_faces_ : vsplits_[_lod - 1].n_faces; }
+
+  /// Finest level with at most _n_faces faces, 0 if even the base mesh
+  /// has more faces
+  unsigned int lod_for_faces(unsigned int _n_faces) const;
+
+  /// Switch to level _lod (clamped to n_details()) by applying or undoing
+  /// the vertex splits in between.
+  void set_lod(unsigned int _lod);
+
+  /// Switch to the finest level with at most _n_faces faces.
+  void set_n_faces(unsigned int _n_faces) { set_lod(lod_for_faces(_n_faces)); }
+
+  /// Positions of all vertices, the first n_vertices() belong to the
+  /// current level.
+  const Vec3f* points() const { return points_.empty() ? 0 : &points_[0]; }
+
+  /// Vertex indices of the 3 * n_faces() corners of the current level.
+  const unsigned int* indices() const { return indices_.empty() ? 0 : &indices_[0]; }
+
+  /** Write the index buffer of the finest level with at most _n_faces
+      faces to _indices without changing the current level. Costs a copy
+      of the buffer plus the splits between both levels.
+   */
+  void index_buffer(unsigned int _n_faces, std::vector<unsigned int>& _indices) const;
+
+  /// The vertex split records
+  const std::vector<VSplit>& vsplits() const { return vsplits_; }
+
+  /// Corners (3 * face + vertex of face) changed by the vertex splits
+  const std::vector<unsigned int>& corners() const { return corners_; }
+
+private:
+
+  unsigned int               n_base_vertices_;
+  unsigned int               n_base_faces_;
+  unsigned int               lod_;
+
+  std::vector<Vec3f>         points_;
+  std::vector<unsigned int>  indices_;
+  std::vector<VSplit>        vsplits_;
+  std::vector<unsigned int>  corners_;
+};
+
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
+#endif // OPENMESH_DECIMATER_PROGMESH_HH defined
+//=============================================================================
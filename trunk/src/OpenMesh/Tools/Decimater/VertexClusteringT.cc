@@ -0,0 +1,429 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------*
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         *
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/
+
+/*===========================================================================*\
+ *                                                                           *
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+
+/** \file VertexClusteringT.cc
+ */
+
+//=============================================================================
+//
+//  CLASS VertexClusteringT - IMPLEMENTATION
+//
+//=============================================================================
+
+#define OPENMESH_DECIMATER_VERTEXCLUSTERINGT_CC
+
+//== INCLUDES =================================================================
+
+#include <algorithm>
+#include <cfloat>
+#include <OpenMesh/Core/Utils/vector_cast.hh>
+#include <OpenMesh/Tools/Decimater/VertexClusteringT.hh>
+#ifdef USE_OPENMP
+#  include <omp.h>
+#endif
+
+
+//== NAMESPACE ===============================================================
+
+namespace OpenMesh {
+namespace Decimater {
+
+
+//== IMPLEMENTATION ==========================================================
+
+template<class Mesh>
+VertexClusteringT<Mesh>::Triangle::Triangle(unsigned int _c0, unsigned int _c1, unsigned int _c2) {
+  // keep the orientation
+  if (_c1 < _c0 && _c1 < _c2)      { c[0] = _c1; c[1] = _c2; c[2] = _c0; }
+  else if (_c2 < _c0 && _c2 < _c1) { c[0] = _c2; c[1] = _c0; c[2] = _c1; }
+  else                             { c[0] = _c0; c[1] = _c1; c[2] = _c2; }
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+VertexClusteringT<Mesh>::VertexClusteringT(const Mesh& _mesh) :
+  mesh_(_mesh), grid_size_(64), representative_(Quadric), n_threads_(0),
+  n_cells_(0), n_dropped_(0) {
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+size_t VertexClusteringT<Mesh>::simplify(Mesh& _out) {
+
+  n_cells_ = n_dropped_ = 0;
+  _out.clear();
+
+  // ---- 1 - grid of cubic cells over the bounding box
+
+  Vec3d bb_min(DBL_MAX, DBL_MAX, DBL_MAX), bb_max(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+  for (typename Mesh::ConstVertexIter v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it) {
+    bb_min.minimize(vector_cast<Vec3d>(mesh_.point(*v_it)));
+    bb_max.maximize(vector_cast<Vec3d>(mesh_.point(*v_it)));
+  }
+
+  if (bb_min[0] > bb_max[0])
+    return 0;
+
+  const Vec3d  extent    = bb_max - bb_min;
+  const double longest   = std::max(extent[0], std::max(extent[1], extent[2]));
+  const double cell_size = longest > 0.0 ? longest / grid_size_ : 1.0;
+
+  size_t dim[3];
+  for (int i = 0; i < 3; ++i)
+    dim[i] = std::min(size_t(grid_size_), size_t(extent[i] / cell_size) + 1);
+
+  // ---- 2 - merge the vertices of each cell
+
+  n_cells_ = assign_cells(bb_min, cell_size, dim);
+
+  std::vector<Vec3d> points;
+  compute_representatives(n_cells_, bb_min, cell_size, dim, points);
+
+  // ---- 3 - keep the faces with vertices in three cells, once
+
+  std::vector<Triangle> triangles;
+  collect_triangles(triangles);
+
+  std::sort(triangles.begin(), triangles.end());
+  triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+  // a triangle and its flipped copy enclose no volume, drop both
+  std::vector<bool> keep(triangles.size(), true);
+  for (size_t i = 0; i < triangles.size(); ++i) {
+    const Triangle& t = triangles[i];
+    keep[i] = !std::binary_search(triangles.begin(), triangles.end(), Triangle(t.c[0], t.c[2], t.c[1]));
+  }
+
+  // ---- 4 - write the cells of the kept triangles and the triangles
+
+  std::vector<int> vertex(n_cells_, -1);
+  size_t n_vertices = 0, n_faces = 0;
+  for (size_t i = 0; i < triangles.size(); ++i)
+    if (keep[i]) {
+      ++n_faces;
+      for (int j = 0; j < 3; ++j)
+        if (vertex[triangles[i].c[j]] < 0)
+          vertex[triangles[i].c[j]] = 0;
+    }
+
+  for (size_t c = 0; c < n_cells_; ++c)
+    if (vertex[c] == 0)
+      ++n_vertices;
+
+  _out.reserve(n_vertices, 3 * n_faces / 2 + n_vertices, n_faces);
+
+  for (size_t c = 0; c < n_cells_; ++c)
+    if (vertex[c] == 0)
+      vertex[c] = _out.add_vertex(vector_cast<typename Mesh::Point>(points[c])).idx();
+
+  // clusters are often non-manifold, the faces add_face() would reject
+  // are counted instead of reported one by one
+  for (size_t i = 0; i < triangles.size(); ++i)
+    if (keep[i]) {
+      const Triangle& t = triangles[i];
+      VertexHandle vh[3];
+      for (int j = 0; j < 3; ++j)
+        vh[j] = _out.vertex_handle(vertex[t.c[j]]);
+
+      if (is_manifold_face(_out, vh))
+        _out.add_face(vh[0], vh[1], vh[2]);
+      else
+        ++n_dropped_;
+    }
+
+  return _out.n_faces();
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+size_t VertexClusteringT<Mesh>::assign_cells(const Vec3d& _bb_min, double _cell_size,
+                                             const size_t _dim[3]) {
+  const int    n_vertices = int(mesh_.n_vertices());
+  const size_t invalid    = size_t(-1);
+  const bool   status     = mesh_.has_vertex_status();
+
+  // index of the cell of every vertex in the full grid
+  std::vector<size_t> key(n_vertices);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(n_threads())
+#endif
+  for (int i = 0; i < n_vertices; ++i) {
+    const VertexHandle vh(i);
+    if (status && mesh_.status(vh).deleted()) {
+      key[i] = invalid;
+      continue;
+    }
+
+    const Vec3d p = (vector_cast<Vec3d>(mesh_.point(vh)) - _bb_min) / _cell_size;
+    size_t idx[3];
+    for (int j = 0; j < 3; ++j)
+      idx[j] = std::min(size_t(std::max(p[j], 0.0)), _dim[j] - 1);
+    key[i] = idx[0] + _dim[0] * (idx[1] + _dim[1] * idx[2]);
+  }
+
+  // number the occupied cells in the order of the grid, with a table of
+  // the full grid if it is small, by sorting the keys otherwise
+  const size_t n_grid = _dim[0] * _dim[1] * _dim[2];
+  size_t       n_cells = 0;
+  cell_.resize(n_vertices);
+
+  if (n_grid <= 4 * size_t(n_vertices) + 65536) {
+    std::vector<unsigned int> table(n_grid, 0);
+    for (int i = 0; i < n_vertices; ++i)
+      if (key[i] != invalid)
+        table[key[i]] = 1;
+
+    for (size_t k = 0; k < n_grid; ++k)
+      if (table[k])
+        table[k] = (unsigned int) ++n_cells;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(n_threads())
+#endif
+    for (int i = 0; i < n_vertices; ++i)
+      cell_[i] = key[i] != invalid ? table[key[i]] - 1 : ~0u;
+  }
+  else {
+    std::vector<size_t> keys(key);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    if (!keys.empty() && keys.back() == invalid)
+      keys.pop_back();
+    n_cells = keys.size();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(n_threads())
+#endif
+    for (int i = 0; i < n_vertices; ++i)
+      cell_[i] = key[i] != invalid ?
+        (unsigned int) (std::lower_bound(keys.begin(), keys.end(), key[i]) - keys.begin()) : ~0u;
+  }
+
+  return n_cells;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+void VertexClusteringT<Mesh>::compute_representatives(size_t _n_cells, const Vec3d& _bb_min,
+                                                      double _cell_size, const size_t _dim[3],
+                                                      std::vector<Vec3d>& _points) const {
+  const size_t n_vertices = mesh_.n_vertices();
+
+  // sort the vertices by cell
+  std::vector<unsigned int> offsets(_n_cells + 1, 0), vertices(n_vertices);
+  for (size_t i = 0; i < n_vertices; ++i)
+    if (cell_[i] != ~0u)
+      ++offsets[cell_[i] + 1];
+  for (size_t c = 0; c < _n_cells; ++c)
+    offsets[c+1] += offsets[c];
+
+  std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < n_vertices; ++i)
+    if (cell_[i] != ~0u)
+      vertices[fill[cell_[i]]++] = (unsigned int) i;
+
+  _points.resize(_n_cells);
+
+  const int n_cells = int(_n_cells);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1024) num_threads(n_threads())
+#endif
+  for (int c = 0; c < n_cells; ++c) {
+    Vec3d              mean(0.0, 0.0, 0.0);
+    Geometry::Quadricd q;
+
+    for (unsigned int i = offsets[c]; i < offsets[c+1]; ++i) {
+      const VertexHandle vh(vertices[i]);
+      mean += vector_cast<Vec3d>(mesh_.point(vh));
+
+      // the face quadrics are recomputed for each vertex, which is
+      // cheaper than storing them for large meshes
+      if (representative_ == Quadric)
+        for (typename Mesh::ConstVertexFaceIter vf_it = mesh_.cvf_iter(vh); vf_it.is_valid(); ++vf_it)
+          q += face_quadric(*vf_it);
+    }
+    mean /= double(offsets[c+1] - offsets[c]);
+    _points[c] = mean;
+
+    if (representative_ != Quadric)
+      continue;
+
+    // the minimizer must stay in the cell, otherwise the mean is used
+    Vec3d p;
+    if (q.minimizer(p)) {
+      const Vec3d lo = (mean - _bb_min) / _cell_size;
+      bool inside = true;
+      for (int j = 0; j < 3 && inside; ++j) {
+        const double cell = double(std::min(size_t(std::max(lo[j], 0.0)), _dim[j] - 1));
+        const double x    = (p[j] - _bb_min[j]) / _cell_size;
+        inside = x >= cell && x <= cell + 1.0;
+      }
+      if (inside)
+        _points[c] = p;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+Geometry::Quadricd VertexClusteringT<Mesh>::face_quadric(FaceHandle _fh) const {
+  if (mesh_.has_face_status() && mesh_.status(_fh).deleted())
+    return Geometry::Quadricd();
+
+  typename Mesh::ConstFaceVertexIter fv_it = mesh_.cfv_iter(_fh);
+  const Vec3d p0 = vector_cast<Vec3d>(mesh_.point(*fv_it));  ++fv_it;
+  const Vec3d p1 = vector_cast<Vec3d>(mesh_.point(*fv_it));  ++fv_it;
+  const Vec3d p2 = vector_cast<Vec3d>(mesh_.point(*fv_it));
+
+  Vec3d  n    = (p1 - p0) % (p2 - p0);
+  double area = n.norm();
+  if (area > FLT_MIN) {
+    n /= area;
+    area *= 0.5;
+  }
+
+  Geometry::Quadricd q(n[0], n[1], n[2], -(p0 | n));
+  q *= area;
+  return q;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+void VertexClusteringT<Mesh>::collect_triangles(std::vector<Triangle>& _triangles) const {
+  const int  n_faces = int(mesh_.n_faces());
+  const bool status  = mesh_.has_face_status();
+
+  _triangles.clear();
+
+#ifdef USE_OPENMP
+#pragma omp parallel num_threads(n_threads())
+#endif
+  {
+    std::vector<Triangle>     triangles;
+    std::vector<unsigned int> cells;
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int i = 0; i < n_faces; ++i) {
+      const FaceHandle fh(i);
+      if (status && mesh_.status(fh).deleted())
+        continue;
+
+      cells.clear();
+      for (typename Mesh::ConstFaceVertexIter fv_it = mesh_.cfv_iter(fh); fv_it.is_valid(); ++fv_it)
+        cells.push_back(cell_[fv_it->idx()]);
+
+      // split polygons into fans
+      for (size_t j = 1; j + 1 < cells.size(); ++j)
+        if (cells[0] != cells[j] && cells[j] != cells[j+1] && cells[j+1] != cells[0])
+          triangles.push_back(Triangle(cells[0], cells[j], cells[j+1]));
+    }
+
+#ifdef USE_OPENMP
+#pragma omp critical
+#endif
+    _triangles.insert(_triangles.end(), triangles.begin(), triangles.end());
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+bool VertexClusteringT<Mesh>::is_manifold_face(const Mesh& _mesh, const VertexHandle _vh[3]) {
+  typedef typename Mesh::HalfedgeHandle HalfedgeHandle;
+
+  // the tests of add_face(): the vertices and the existing edges must be
+  // on the boundary
+  HalfedgeHandle heh[3];
+  for (int i = 0; i < 3; ++i) {
+    if (!_mesh.is_boundary(_vh[i]))
+      return false;
+
+    heh[i] = _mesh.find_halfedge(_vh[i], _vh[(i+1)%3]);
+    if (heh[i].is_valid() && !_mesh.is_boundary(heh[i]))
+      return false;
+  }
+
+  // two existing edges that do not follow each other need a free gap
+  // in the boundary around their common vertex to relink the patch
+  for (int i = 0; i < 3; ++i) {
+    const HalfedgeHandle inner_prev = heh[i], inner_next = heh[(i+1)%3];
+    if (!inner_prev.is_valid() || !inner_next.is_valid() ||
+        _mesh.next_halfedge_handle(inner_prev) == inner_next)
+      continue;
+
+    HalfedgeHandle boundary_prev = _mesh.opposite_halfedge_handle(inner_next);
+    do
+      boundary_prev = _mesh.opposite_halfedge_handle(_mesh.next_halfedge_handle(boundary_prev));
+    while (!_mesh.is_boundary(boundary_prev) || boundary_prev == inner_prev);
+
+    if (_mesh.next_halfedge_handle(boundary_prev) == inner_next)
+      return false;
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class Mesh>
+int VertexClusteringT<Mesh>::n_threads() const {
+#ifdef USE_OPENMP
+  return n_threads_ > 0 ? int(n_threads_) : omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
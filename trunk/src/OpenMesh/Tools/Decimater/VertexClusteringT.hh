@@ -0,0 +1,200 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------*
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         *
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/
+
+/*===========================================================================*\
+ *                                                                           *
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+
+/** \file VertexClusteringT.hh
+ */
+
+//=============================================================================
+//
+//  CLASS VertexClusteringT
+//
+//=============================================================================
+
+#ifndef OPENMESH_DECIMATER_VERTEXCLUSTERINGT_HH
+#define OPENMESH_DECIMATER_VERTEXCLUSTERINGT_HH
+
+
+//== INCLUDES =================================================================
+
+#include <vector>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+#include <OpenMesh/Core/Geometry/QuadricT.hh>
+
+
+//== NAMESPACE ================================================================
+
+namespace OpenMesh  {
+namespace Decimater {
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** \brief Simplification by vertex clustering (Rossignac and Borrel 1993).
+
+    The bounding box of the mesh is divided into a uniform grid of cubic
+    cells. All vertices of a cell are merged into one representative,
+    which is either their mean or the point that minimizes the sum of the
+    error quadrics of their faces (Lindstrom 2000). Faces whose vertices
+    end up in less than three cells vanish, the others are written into
+    an output mesh.
+
+    The running time is linear in the size of the mesh apart from sorting
+    the remaining faces, and the vertices, cells and faces are processed
+    in parallel if OpenMesh is built with OpenMP. The result is much
+    coarser than that of DecimaterT for the same number of faces and is
+    not guaranteed to be manifold; faces that add_face() would reject
+    are dropped. It is meant for previews and far levels of detail.
+
+    Polygonal faces are split into triangle fans.
+*/
+template < typename MeshT >
+class VertexClusteringT
+{
+public: //-------------------------------------------------------- public types
+
+  typedef MeshT                          Mesh;
+  typedef typename Mesh::VertexHandle    VertexHandle;
+  typedef typename Mesh::FaceHandle      FaceHandle;
+
+  /// How the representative of a cell is computed
+  enum Representative {
+    Mean,     ///< mean of the points in the cell
+    Quadric   ///< minimizer of the face quadrics, the mean if it is not in the cell
+  };
+
+public: //------------------------------------------------------ public methods
+
+  /// Constructor
+  VertexClusteringT( const Mesh& _mesh );
+
+  /// Set the number of cells along the longest side of the bounding box (default 64)
+  void set_grid_size(unsigned int _n) { grid_size_ = _n > 0 ? _n : 1; }
+
+  /// Number of cells along the longest side of the bounding box
+  unsigned int grid_size() const { return grid_size_; }
+
+  /// Set how the representatives are computed (default Quadric)
+  void set_representative(Representative _r) { representative_ = _r; }
+
+  /// Set the number of threads, 0 uses the OpenMP default
+  void set_n_threads(unsigned int _n) { n_threads_ = _n; }
+
+  /** Write the simplified mesh into _out, which is cleared first.
+   *  Returns the number of faces of _out.
+   */
+  size_t simplify( Mesh& _out );
+
+  /// Number of cells that contained vertices in the last simplification
+  size_t n_cells() const { return n_cells_; }
+
+  /// Number of non-manifold faces dropped in the last simplification
+  size_t n_dropped_faces() const { return n_dropped_; }
+
+private: //---------------------------------------------------- private types
+
+  // triangle of cells, rotated so that the smallest cell comes first
+  struct Triangle
+  {
+    Triangle() {}
+    Triangle(unsigned int _c0, unsigned int _c1, unsigned int _c2);
+
+    bool operator<(const Triangle& _t) const
+    {
+      return c[0] != _t.c[0] ? c[0] < _t.c[0] :
+             c[1] != _t.c[1] ? c[1] < _t.c[1] : c[2] < _t.c[2];
+    }
+
+    bool operator==(const Triangle& _t) const
+    { return c[0] == _t.c[0] && c[1] == _t.c[1] && c[2] == _t.c[2]; }
+
+    unsigned int c[3];
+  };
+
+private: //---------------------------------------------------- private methods
+
+  // set cell_ of every vertex, returns the number of occupied cells
+  size_t assign_cells(const Vec3d& _bb_min, double _cell_size, const size_t _dim[3]);
+
+  // compute the point of every cell
+  void compute_representatives(size_t _n_cells, const Vec3d& _bb_min,
+                               double _cell_size, const size_t _dim[3],
+                               std::vector<Vec3d>& _points) const;
+
+  // plane quadric of face _fh, weighted by its area
+  Geometry::Quadricd face_quadric(FaceHandle _fh) const;
+
+  // the triangles of all faces with vertices in three cells
+  void collect_triangles(std::vector<Triangle>& _triangles) const;
+
+  // true if add_face() accepts the triangle _vh in _mesh
+  static bool is_manifold_face(const Mesh& _mesh, const VertexHandle _vh[3]);
+
+  int n_threads() const;
+
+private: //------------------------------------------------------- private data
+
+  // reference to mesh
+  const Mesh&                mesh_;
+
+  unsigned int               grid_size_;
+  Representative             representative_;
+  unsigned int               n_threads_;
+
+  // occupied cell of every vertex
+  std::vector<unsigned int>  cell_;
+
+  size_t                     n_cells_;
+  size_t                     n_dropped_;
+};
+
+//=============================================================================
+} // END_NS_DECIMATER
+} // END_NS_OPENMESH
+//=============================================================================
+#if defined(OM_INCLUDE_TEMPLATES) && !defined(OPENMESH_DECIMATER_VERTEXCLUSTERINGT_CC)
+#define OPENMESH_DECIMATER_VERTEXCLUSTERINGT_TEMPLATES
+#include "VertexClusteringT.cc"
+#endif
+//=============================================================================
+#endif // OPENMESH_DECIMATER_VERTEXCLUSTERINGT_HH defined
+//=============================================================================
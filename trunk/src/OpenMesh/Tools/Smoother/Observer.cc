@@ -0,0 +1,91 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file Smoother/Observer.cc
+ */
+
+//=============================================================================
+//
+//  CLASS Observer - IMPLEMENTATION
+//
+//=============================================================================
+
+//== INCLUDES =================================================================
+
+#include <OpenMesh/Tools/Smoother/Observer.hh>
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace Smoother {
+
+//== IMPLEMENTATION ==========================================================
+
+Observer::Observer()
+{
+}
+
+Observer::~Observer()
+{
+}
+
+bool Observer::abort() const
+{
+  return false;
+}
+
+const char* Observer::stage_name(Stage _stage)
+{
+  switch (_stage)
+  {
+    case ComputeNewPositions:   return "compute_new_positions";
+    case ProjectToTangentPlane: return "project_to_tangent_plane";
+    case LocalErrorCheck:       return "local_error_check";
+    case MovePoints:            return "move_points";
+  }
+  return "unknown";
+}
+
+
+//=============================================================================
+} // namespace Smoother
+} // namespace OpenMesh
+//=============================================================================
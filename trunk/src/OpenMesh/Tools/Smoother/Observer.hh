@@ -0,0 +1,124 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file Smoother/Observer.hh
+ *
+ * This file contains an observer class which is used to monitor the progress
+ * and the timing of the single stages of a smoother.
+ *
+ */
+
+//=============================================================================
+//
+//  CLASS Observer
+//
+//=============================================================================
+
+#ifndef OPENMESH_SMOOTHER_OBSERVER_HH
+#define OPENMESH_SMOOTHER_OBSERVER_HH
+
+//== INCLUDES =================================================================
+
+#include <OpenMesh/Core/System/config.h>
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace Smoother {
+
+//== CLASS DEFINITION =========================================================
+
+/** \brief Observer class
+ *
+ * Observers can be used to monitor the progress of the smoothing, to measure
+ * the time spent in each stage of an iteration and to abort the smoothing
+ * in between.
+ */
+class OPENMESHDLLEXPORT Observer
+{
+public:
+
+  /// Stages of a single smoothing iteration (see SmootherT::smooth())
+  enum Stage {
+    ComputeNewPositions,    ///< compute_new_positions()
+    ProjectToTangentPlane,  ///< project_to_tangent_plane()
+    LocalErrorCheck,        ///< local_error_check()
+    MovePoints              ///< move_points()
+  };
+
+  /// Create an observer
+  Observer();
+
+  /// Destructor
+  virtual ~Observer();
+
+  /** \brief callback
+   *
+   * This function has to be overloaded. It will be called after each stage
+   * of each smoothing iteration.
+   *
+   * @param _iteration Current iteration of the smoother (starting with 0)
+   * @param _stage     Stage that has just been finished
+   * @param _seconds   Wall clock time spent in this stage
+   */
+  virtual void notify(unsigned int _iteration, Stage _stage, double _seconds) = 0;
+
+  /** \brief Abort callback
+   *
+   * After each iteration, this function is called by the smoother. If the
+   * function returns true, the smoother will stop. Otherwise it will continue.
+   *
+   * @return abort Yes or No
+   */
+  virtual bool abort() const;
+
+  /// Get a printable name of a stage
+  static const char* stage_name(Stage _stage);
+};
+
+
+//=============================================================================
+} // namespace Smoother
+} // namespace OpenMesh
+//=============================================================================
+#endif // OPENMESH_SMOOTHER_OBSERVER_HH defined
+//=============================================================================
+
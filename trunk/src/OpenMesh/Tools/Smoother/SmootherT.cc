@@ -70,7 +70,8 @@ template <class Mesh>
 SmootherT<Mesh>::
 SmootherT(Mesh& _mesh)
   : mesh_(_mesh),
-    skip_features_(false)
+    skip_features_(false),
+    observer_(NULL)
 {
   // request properties
   mesh_.request_vertex_status();
@@ -119,7 +120,7 @@ void
 SmootherT<Mesh>::
 initialize(Component _comp, Continuity _cont)
 {
-  typename Mesh::VertexIter  v_it, v_end(mesh_.vertices_end());
+  const int n_vertices = static_cast<int>(mesh_.n_vertices());
 
 
   // store smoothing settings
@@ -133,10 +134,17 @@ initialize(Component _comp, Continuity _cont)
 
 
   // store original points & normals
-  for (v_it=mesh_.vertices_begin(); v_it!=v_end; ++v_it)
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i=0; i<n_vertices; ++i)
   {
-    mesh_.property(original_positions_, *v_it) = mesh_.point(*v_it);
-    mesh_.property(original_normals_,   *v_it) = mesh_.normal(*v_it);
+    const VertexHandle vh(i);
+    if (mesh_.has_vertex_status() && mesh_.status(vh).deleted())
+      continue;
+
+    mesh_.property(original_positions_, vh) = mesh_.point(vh);
+    mesh_.property(original_normals_,   vh) = mesh_.normal(vh);
   }
 }
 
@@ -253,16 +261,16 @@ set_relative_local_error(Scalar _err)
 
     // compute bounding box
     Point  bb_min, bb_max;
-    bb_min = bb_max = mesh_.point(v_it);
+    bb_min = bb_max = mesh_.point(*v_it);
     for (++v_it; v_it!=v_end; ++v_it)
     {
-      bb_min.minimize(mesh_.point(v_it));
-      bb_max.minimize(mesh_.point(v_it));
+      bb_min.minimize(mesh_.point(*v_it));
+      bb_max.maximize(mesh_.point(*v_it));
     }
 
 
     // abs. error = rel. error * bounding-diagonal
-    set_absolute_error(_err * (bb_max-bb_min).norm());
+    set_absolute_local_error(_err * (bb_max-bb_min).norm());
   }
 }
 
@@ -299,21 +307,54 @@ void
 SmootherT<Mesh>::
 smooth(unsigned int _n)
 {
+  Utils::Timer timer;
+
   // mark active vertices
   set_active_vertices();
 
   // smooth _n iterations
-  while (_n--)
+  for (unsigned int iteration=0; iteration<_n; ++iteration)
   {
+    timer.start();
+
     compute_new_positions();
+    notify_observer(iteration, Observer::ComputeNewPositions, timer);
 
     if (component_ == Tangential)
+    {
       project_to_tangent_plane();
+      notify_observer(iteration, Observer::ProjectToTangentPlane, timer);
+    }
 
     else if (tolerance_ >= 0.0)
-	local_error_check();
+    {
+      local_error_check();
+      notify_observer(iteration, Observer::LocalErrorCheck, timer);
+    }
 
     move_points();
+    notify_observer(iteration, Observer::MovePoints, timer);
+
+    // stop if the observer requests it
+    if (observer_ && observer_->abort())
+      break;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SmootherT<Mesh>::
+notify_observer(unsigned int _iteration, Observer::Stage _stage, Utils::Timer& _timer)
+{
+  if (observer_)
+  {
+    _timer.stop();
+    observer_->notify(_iteration, _stage, _timer.seconds());
+    _timer.start();
   }
 }
 
@@ -350,23 +391,30 @@ void
 SmootherT<Mesh>::
 project_to_tangent_plane()
 {
-  typename Mesh::VertexIter  v_it(mesh_.vertices_begin()),
-                             v_end(mesh_.vertices_end());
-  // Normal should be a vector type. In some environment a vector type
-  // is different from point type, e.g. OpenSG!
-  typename Mesh::Normal      translation, normal;
+  const int n_vertices = static_cast<int>(mesh_.n_vertices());
 
 
-  for (; v_it != v_end; ++v_it)
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i=0; i<n_vertices; ++i)
   {
-    if (is_active(*v_it))
+    const VertexHandle vh(i);
+    if (mesh_.has_vertex_status() && mesh_.status(vh).deleted())
+      continue;
+
+    if (is_active(vh))
     {
-      translation  = new_position(*v_it)-orig_position(*v_it);
-      normal       = orig_normal(*v_it);
+      // Normal should be a vector type. In some environment a vector type
+      // is different from point type, e.g. OpenSG!
+      typename Mesh::Normal translation, normal;
+
+      translation  = new_position(vh)-orig_position(vh);
+      normal       = orig_normal(vh);
       normal      *= dot(translation, normal);
       translation -= normal;
-      translation += vector_cast<typename Mesh::Normal>(orig_position(*v_it));
-      set_new_position(*v_it, translation);
+      translation += vector_cast<typename Mesh::Normal>(orig_position(vh));
+      set_new_position(vh, translation);
     }
   }
 }
@@ -380,26 +428,29 @@ void
 SmootherT<Mesh>::
 local_error_check()
 {
-  typename Mesh::VertexIter  v_it(mesh_.vertices_begin()),
-                             v_end(mesh_.vertices_end());
+  const int n_vertices = static_cast<int>(mesh_.n_vertices());
 
-  typename Mesh::Normal      translation;
-  typename Mesh::Scalar      s;
 
-
-  for (; v_it != v_end; ++v_it)
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i=0; i<n_vertices; ++i)
   {
-    if (is_active(*v_it))
+    const VertexHandle vh(i);
+    if (mesh_.has_vertex_status() && mesh_.status(vh).deleted())
+      continue;
+
+    if (is_active(vh))
     {
-      translation  = new_position(*v_it) - orig_position(*v_it);
+      typename Mesh::Normal translation = new_position(vh) - orig_position(vh);
 
-      s = fabs(dot(translation, orig_normal(*v_it)));
+      typename Mesh::Scalar s = fabs(dot(translation, orig_normal(vh)));
 
       if (s > tolerance_)
       {
         translation *= (tolerance_ / s);
-        translation += vector_cast<NormalType>(orig_position(*v_it));
-        set_new_position(*v_it, translation);
+        translation += vector_cast<NormalType>(orig_position(vh));
+        set_new_position(vh, translation);
       }
     }
   }
@@ -414,12 +465,20 @@ void
 SmootherT<Mesh>::
 move_points()
 {
-  typename Mesh::VertexIter  v_it(mesh_.vertices_begin()),
-                             v_end(mesh_.vertices_end());
+  const int n_vertices = static_cast<int>(mesh_.n_vertices());
 
-  for (; v_it != v_end; ++v_it)
-    if (is_active(*v_it))
-      mesh_.set_point(*v_it, mesh_.property(new_positions_, *v_it));
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i=0; i<n_vertices; ++i)
+  {
+    const VertexHandle vh(i);
+    if (mesh_.has_vertex_status() && mesh_.status(vh).deleted())
+      continue;
+
+    if (is_active(vh))
+      mesh_.set_point(vh, mesh_.property(new_positions_, vh));
+  }
 }
 
 
@@ -58,6 +58,8 @@
 #include <OpenMesh/Core/System/config.hh>
 #include <OpenMesh/Core/Utils/Property.hh>
 #include <OpenMesh/Core/Utils/Noncopyable.hh>
+#include <OpenMesh/Tools/Smoother/Observer.hh>
+#include <OpenMesh/Tools/Utils/Timer.hh>
 
 //== FORWARDDECLARATIONS ======================================================
 
@@ -127,10 +129,26 @@ public:
    */
   void skip_features( bool _state ){ skip_features_ = _state; };
 
-  /// Do _n smoothing iterations
+  /** \brief Do _n smoothing iterations
+   *
+   * The single stages of each iteration are computed in parallel if
+   * OpenMesh is built with OpenMP (USE_OPENMP).
+   */
   virtual void smooth(unsigned int _n);
 
 
+  /** \brief Set observer
+   *
+   * The observer is notified after each stage of each iteration with the
+   * time spent in this stage and can abort the smoothing after an iteration.
+   * Set it to NULL to disable notifications.
+   */
+  void set_observer(Observer* _o) { observer_ = _o; }
+
+  /// Get current observer of the smoother
+  Observer* observer() { return observer_; }
+
+
 
   /// Find active vertices. Resets tagged status !
   void set_active_vertices();
@@ -144,6 +162,8 @@ private:
   void local_error_check();
   void move_points();
 
+  // stop _timer, notify observer and restart _timer
+  void notify_observer(unsigned int _iteration, Observer::Stage _stage, Utils::Timer& _timer);
 
 
 protected:
@@ -188,6 +208,7 @@ private:
   Scalar      normal_deviation_;
   Component   component_;
   Continuity  continuity_;
+  Observer*   observer_;
 
   OpenMesh::VPropHandleT<Point>      original_positions_;
   OpenMesh::VPropHandleT<NormalType> original_normals_;
@@ -0,0 +1,481 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file SparseLaplaceSmootherT.cc
+    
+ */
+
+//=============================================================================
+//
+//  CLASS SparseLaplaceSmootherT - IMPLEMENTATION
+//
+//=============================================================================
+
+#define OPENMESH_SPARSE_LAPLACE_SMOOTHERT_C
+
+//== INCLUDES =================================================================
+
+#include <OpenMesh/Core/Utils/vector_cast.hh>
+#include <OpenMesh/Tools/Smoother/SparseLaplaceSmootherT.hh>
+#include <cmath>
+
+
+//== NAMESPACES ===============================================================
+
+
+namespace OpenMesh {
+namespace Smoother {
+
+
+//== IMPLEMENTATION ========================================================== 
+
+
+template <class Mesh>
+SparseLaplaceSmootherT<Mesh>::
+SparseLaplaceSmootherT(Mesh& _mesh)
+  : LaplaceSmootherT<Mesh>(_mesh),
+    solver_(Explicit),
+    time_step_(1.0),
+    cg_max_iters_(1000),
+    cg_tolerance_(static_cast<Scalar>(1e-6)),
+    cg_iterations_(0),
+    dirty_(true),
+    n_active_(0)
+{
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SparseLaplaceSmootherT<Mesh>::
+initialize(Component _comp, Continuity _cont)
+{
+  Base::initialize(_comp, _cont);
+  dirty_ = true;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SparseLaplaceSmootherT<Mesh>::
+smooth(unsigned int _n)
+{
+  // active vertices are recomputed by SmootherT::smooth(), the matrix is
+  // assembled on the first iteration and reused for all others
+  dirty_ = true;
+
+  Base::smooth(_n);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SparseLaplaceSmootherT<Mesh>::
+assemble()
+{
+  Mesh& mesh = Base::mesh_;
+  typename Mesh::VertexIter                v_it, v_end(mesh.vertices_end());
+  typename Mesh::ConstVertexOHalfedgeIter  voh_it;
+  typename Mesh::ConstVertexVertexIter     vv_it;
+
+  row_vertex_.clear();
+  vertex_row_.assign(mesh.n_vertices(), -1);
+
+  // active vertices first
+  for (v_it=mesh.vertices_begin(); v_it!=v_end; ++v_it)
+    if (this->is_active(*v_it))
+    {
+      vertex_row_[v_it->idx()] = static_cast<int>(row_vertex_.size());
+      row_vertex_.push_back(v_it->idx());
+    }
+  n_active_ = row_vertex_.size();
+
+  // C1 needs the umbrellas of the one-ring of all active vertices
+  if (this->continuity() == Base::C1)
+    for (size_t r=0; r<n_active_; ++r)
+      for (vv_it=mesh.cvv_iter(VertexHandle(row_vertex_[r])); vv_it.is_valid(); ++vv_it)
+        if (vertex_row_[vv_it->idx()] == -1)
+        {
+          vertex_row_[vv_it->idx()] = static_cast<int>(row_vertex_.size());
+          row_vertex_.push_back(vv_it->idx());
+        }
+
+  const size_t n_rows = row_vertex_.size();
+
+  row_start_.resize(n_rows+1);
+  row_weight_.resize(n_rows);
+  col_vertex_.clear();
+  col_row_.clear();
+  col_weight_.clear();
+
+  for (size_t r=0; r<n_rows; ++r)
+  {
+    VertexHandle vh(row_vertex_[r]);
+
+    row_start_[r]  = static_cast<unsigned int>(col_vertex_.size());
+    row_weight_[r] = this->weight(vh);
+
+    for (voh_it=mesh.cvoh_iter(vh); voh_it.is_valid(); ++voh_it)
+    {
+      const int vj = mesh.to_vertex_handle(*voh_it).idx();
+      const int rj = vertex_row_[vj];
+
+      col_vertex_.push_back(vj);
+      col_row_.push_back(rj >= 0 && rj < static_cast<int>(n_active_) ? rj : -1);
+      col_weight_.push_back(this->weight(mesh.edge_handle(*voh_it)));
+    }
+  }
+  row_start_[n_rows] = static_cast<unsigned int>(col_vertex_.size());
+
+  // C1: constant diagonal of the squared Laplacian
+  if (this->continuity() == Base::C1)
+  {
+    c1_diag_.resize(n_active_);
+    for (size_t r=0; r<n_active_; ++r)
+    {
+      Scalar diag(0.0);
+      for (unsigned int k=row_start_[r]; k<row_start_[r+1]; ++k)
+      {
+        const Scalar w = col_weight_[k];
+        diag += (w * this->weight(VertexHandle(col_vertex_[k])) + static_cast<Scalar>(1.0) ) * w;
+      }
+      c1_diag_[r] = diag * row_weight_[r];
+    }
+    umbrellas_.resize(n_rows);
+  }
+
+  dirty_ = false;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SparseLaplaceSmootherT<Mesh>::
+compute_new_positions_C0()
+{
+  if (dirty_)
+    assemble();
+
+  if (solver_ == Implicit)
+  {
+    implicit_step();
+    return;
+  }
+
+  const typename Mesh::Point* points = Base::mesh_.points();
+  const int n_active = static_cast<int>(n_active_);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int r=0; r<n_active; ++r)
+  {
+    Normal u(0,0,0), p;
+
+    // umbrella
+    for (unsigned int k=row_start_[r]; k<row_start_[r+1]; ++k)
+      u += vector_cast<Normal>(points[col_vertex_[k]]) * col_weight_[k];
+
+    p  = vector_cast<Normal>(points[row_vertex_[r]]);
+    u *= row_weight_[r];
+    u -= p;
+
+    // damping
+    u *= 0.5;
+
+    p += u;
+    this->set_new_position(VertexHandle(row_vertex_[r]), p);
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SparseLaplaceSmootherT<Mesh>::
+compute_new_positions_C1()
+{
+  if (dirty_)
+    assemble();
+
+  const typename Mesh::Point* points = Base::mesh_.points();
+  const int n_rows   = static_cast<int>(row_vertex_.size());
+  const int n_active = static_cast<int>(n_active_);
+
+  // 1st pass: compute umbrellas of the active vertices and their one-ring
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int r=0; r<n_rows; ++r)
+  {
+    Normal u(0,0,0);
+
+    for (unsigned int k=row_start_[r]; k<row_start_[r+1]; ++k)
+      u -= vector_cast<Normal>(points[col_vertex_[k]]) * col_weight_[k];
+
+    u *= row_weight_[r];
+    u += vector_cast<Normal>(points[row_vertex_[r]]);
+
+    umbrellas_[r] = u;
+  }
+
+  // 2nd pass: compute updates
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int r=0; r<n_active; ++r)
+  {
+    Normal uu(0,0,0), p;
+
+    for (unsigned int k=row_start_[r]; k<row_start_[r+1]; ++k)
+      uu -= umbrellas_[vertex_row_[col_vertex_[k]]];
+
+    uu *= row_weight_[r];
+    uu += umbrellas_[r];
+    if (c1_diag_[r]) uu *= static_cast<Scalar>(1.0) / c1_diag_[r];
+
+    // damping
+    uu *= 0.25;
+
+    p  = vector_cast<Normal>(points[row_vertex_[r]]);
+    p -= uu;
+    this->set_new_position(VertexHandle(row_vertex_[r]), p);
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SparseLaplaceSmootherT<Mesh>::
+implicit_step()
+{
+  // Each row i of (I + lambda L) x = p is scaled by the sum of its edge
+  // weights D_i, which makes the system symmetric:
+  //   (1+lambda) D_i x_i - lambda sum_j w_ij x_j = D_i p_i
+  // Inactive neighbors are fixed and move to the right hand side.
+
+  const typename Mesh::Point* points = Base::mesh_.points();
+  const int n_active = static_cast<int>(n_active_);
+
+  std::vector<Scalar> b(n_active_), x(n_active_);
+
+  cg_iterations_ = 0;
+
+  for (int c=0; c<3; ++c)
+  {
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int r=0; r<n_active; ++r)
+    {
+      Scalar d(0.0), rhs(0.0);
+
+      for (unsigned int k=row_start_[r]; k<row_start_[r+1]; ++k)
+      {
+        d += col_weight_[k];
+        if (col_row_[k] < 0)
+          rhs += col_weight_[k] * points[col_vertex_[k]][c];
+      }
+
+      x[r] = points[row_vertex_[r]][c];
+      b[r] = d * x[r] + time_step_ * rhs;
+    }
+
+    cg_iterations_ += solve_cg(b, x);
+
+    for (int r=0; r<n_active; ++r)
+    {
+      Normal p = vector_cast<Normal>(this->new_position(VertexHandle(row_vertex_[r])));
+      p[c] = x[r];
+      this->set_new_position(VertexHandle(row_vertex_[r]), p);
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+SparseLaplaceSmootherT<Mesh>::
+multiply(const std::vector<Scalar>& _x, std::vector<Scalar>& _y) const
+{
+  const int n_active = static_cast<int>(n_active_);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int r=0; r<n_active; ++r)
+  {
+    Scalar d(0.0), off(0.0);
+
+    for (unsigned int k=row_start_[r]; k<row_start_[r+1]; ++k)
+    {
+      d += col_weight_[k];
+      if (col_row_[k] >= 0)
+        off += col_weight_[k] * _x[col_row_[k]];
+    }
+
+    _y[r] = (static_cast<Scalar>(1.0) + time_step_) * d * _x[r] - time_step_ * off;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+typename SparseLaplaceSmootherT<Mesh>::Scalar
+SparseLaplaceSmootherT<Mesh>::
+dot_product(const std::vector<Scalar>& _a, const std::vector<Scalar>& _b) const
+{
+  const int n = static_cast<int>(_a.size());
+  double    s(0.0);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for reduction(+:s)
+#endif
+  for (int i=0; i<n; ++i)
+    s += _a[i] * _b[i];
+
+  return static_cast<Scalar>(s);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+unsigned int
+SparseLaplaceSmootherT<Mesh>::
+solve_cg(const std::vector<Scalar>& _b, std::vector<Scalar>& _x)
+{
+  const int n = static_cast<int>(_b.size());
+
+  if (n == 0)
+    return 0;
+
+  std::vector<Scalar> r(n), z(n), p(n), q(n), inv_diag(n);
+
+  // Jacobi preconditioner
+  for (int i=0; i<n; ++i)
+  {
+    Scalar d(0.0);
+    for (unsigned int k=row_start_[i]; k<row_start_[i+1]; ++k)
+      d += col_weight_[k];
+    d *= static_cast<Scalar>(1.0) + time_step_;
+    inv_diag[i] = (d > 0) ? static_cast<Scalar>(1.0) / d : static_cast<Scalar>(1.0);
+  }
+
+  multiply(_x, q);
+  for (int i=0; i<n; ++i)
+  {
+    r[i] = _b[i] - q[i];
+    z[i] = inv_diag[i] * r[i];
+    p[i] = z[i];
+  }
+
+  const Scalar b_norm = std::sqrt(dot_product(_b, _b));
+  const Scalar eps    = cg_tolerance_ * (b_norm > 0 ? b_norm : static_cast<Scalar>(1.0));
+  Scalar       rz     = dot_product(r, z);
+
+  unsigned int iter = 0;
+  for (; iter<cg_max_iters_; ++iter)
+  {
+    if (std::sqrt(dot_product(r, r)) <= eps)
+      break;
+
+    multiply(p, q);
+
+    // system is not positive definite (e.g. negative cotangent weights)
+    const Scalar pq = dot_product(p, q);
+    if (pq <= 0)
+      break;
+
+    const Scalar alpha = rz / pq;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<n; ++i)
+    {
+      _x[i] += alpha * p[i];
+      r[i]  -= alpha * q[i];
+      z[i]   = inv_diag[i] * r[i];
+    }
+
+    const Scalar rz_new = dot_product(r, z);
+    const Scalar beta   = rz_new / rz;
+    rz = rz_new;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<n; ++i)
+      p[i] = z[i] + beta * p[i];
+  }
+
+  return iter;
+}
+
+
+//=============================================================================
+} // namespace Smoother
+} // namespace OpenMesh
+//=============================================================================
@@ -0,0 +1,206 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+/** \file SparseLaplaceSmootherT.hh
+    
+ */
+
+
+//=============================================================================
+//
+//  CLASS SparseLaplaceSmootherT
+//
+//=============================================================================
+
+#ifndef OPENMESH_SPARSE_LAPLACE_SMOOTHERT_HH
+#define OPENMESH_SPARSE_LAPLACE_SMOOTHERT_HH
+
+
+//== INCLUDES =================================================================
+
+#include <OpenMesh/Tools/Smoother/LaplaceSmootherT.hh>
+#include <vector>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace Smoother {
+
+//== CLASS DEFINITION =========================================================
+
+/** Laplacian smoothing on a sparse matrix.
+ *
+ * The (uniform or cotangent) Laplacian weights computed by LaplaceSmootherT
+ * are assembled once per call of smooth() into a compressed sparse row (CSR)
+ * matrix over the active vertices. Each iteration is then either an explicit
+ * Jacobi step (a sparse matrix vector product, identical to
+ * JacobiLaplaceSmootherT) or an implicit fairing step
+ * \f$ (I + \lambda L) x^{n+1} = x^n \f$ solved with a preconditioned
+ * conjugate gradient solver. Inactive neighbors act as fixed boundary
+ * conditions.
+ *
+ * The Component, Continuity and local error check of SmootherT are applied
+ * to the computed positions as usual. Implicit steps are only available for
+ * C0 continuity, C1 always uses explicit steps.
+ *
+ * If OpenMesh is compiled with OpenMP (USE_OPENMP), matrix products and
+ * vector updates are evaluated in parallel.
+ */
+template <class Mesh>
+class SparseLaplaceSmootherT : public LaplaceSmootherT<Mesh>
+{
+private:
+  typedef LaplaceSmootherT<Mesh>            Base;
+
+public:
+
+  typedef typename Base::Component     Component;
+  typedef typename Base::Continuity    Continuity;
+  typedef typename Base::Scalar        Scalar;
+  typedef typename Base::VertexHandle  VertexHandle;
+  typedef typename Mesh::Normal        Normal;
+
+  /// How new positions are computed in each iteration
+  enum Solver {
+    Explicit, ///< Damped Jacobi step, one sparse matrix vector product
+    Implicit  ///< Implicit fairing step, solved with conjugate gradients
+  };
+
+  SparseLaplaceSmootherT( Mesh& _mesh );
+  virtual ~SparseLaplaceSmootherT() {}
+
+
+  void initialize(Component _comp, Continuity _cont);
+
+  // override: assemble matrix for the current active vertices
+  void smooth(unsigned int _n);
+
+
+  /** Select the solver.
+   *
+   * @param _solver    Explicit or Implicit steps
+   * @param _time_step Step size \f$ \lambda \f$ of an implicit step
+   */
+  void set_solver(Solver _solver, Scalar _time_step = 1.0)
+  { solver_ = _solver; time_step_ = _time_step; }
+
+  Solver solver() const { return solver_; }
+
+  /** Set the stopping criteria of the conjugate gradient solver.
+   *
+   * @param _max_iters Maximum number of iterations per implicit step
+   * @param _tolerance Stop if the residual norm dropped by this factor
+   */
+  void set_cg_parameters(unsigned int _max_iters, Scalar _tolerance)
+  { cg_max_iters_ = _max_iters; cg_tolerance_ = _tolerance; }
+
+  /// Number of cg iterations used by the last implicit step (all coordinates)
+  unsigned int cg_iterations() const { return cg_iterations_; }
+
+  /// Number of rows of the currently assembled matrix (active vertices)
+  size_t n_rows() const { return n_active_; }
+
+  /// Number of non-zero off-diagonal entries of the assembled matrix
+  size_t n_nonzeros() const { return n_active_ ? row_start_[n_active_] : 0; }
+
+
+protected:
+
+  virtual void compute_new_positions_C0();
+  virtual void compute_new_positions_C1();
+
+
+private:
+
+  /// Build the CSR matrix (rows: active vertices, C1: plus their one-ring)
+  void assemble();
+
+  /// Solve the implicit system for one coordinate, _x holds the initial guess
+  unsigned int solve_cg(const std::vector<Scalar>& _b, std::vector<Scalar>& _x);
+
+  /// _y = A _x restricted to the active rows (implicit system matrix)
+  void multiply(const std::vector<Scalar>& _x, std::vector<Scalar>& _y) const;
+
+  /// Parallel dot product of two row vectors
+  Scalar dot_product(const std::vector<Scalar>& _a,
+                     const std::vector<Scalar>& _b) const;
+
+  void implicit_step();
+
+
+private:
+
+  Solver        solver_;
+  Scalar        time_step_;
+  unsigned int  cg_max_iters_;
+  Scalar        cg_tolerance_;
+  unsigned int  cg_iterations_;
+  bool          dirty_;
+
+  // CSR matrix. Rows [0,n_active_) are the active vertices, for C1 the
+  // remaining rows are the not active one-ring of the active vertices.
+  size_t                     n_active_;
+  std::vector<int>           row_vertex_;   // vertex index of each row
+  std::vector<int>           vertex_row_;   // row of each vertex or -1
+  std::vector<unsigned int>  row_start_;    // n_rows+1 offsets into columns
+  std::vector<int>           col_vertex_;   // vertex index of each entry
+  std::vector<int>           col_row_;      // active row of each entry or -1
+  std::vector<Scalar>        col_weight_;   // edge weight of each entry
+  std::vector<Scalar>        row_weight_;   // one over sum of edge weights
+  std::vector<Scalar>        c1_diag_;      // C1: diagonal of active rows
+
+  std::vector<Normal>        umbrellas_;    // C1: umbrella per row
+};
+
+
+//=============================================================================
+} // namespace Smoother
+} // namespace OpenMesh
+//=============================================================================
+#if defined(OM_INCLUDE_TEMPLATES) && !defined(OPENMESH_SPARSE_LAPLACE_SMOOTHERT_C)
+#define OPENMESH_SPARSE_LAPLACE_SMOOTHERT_TEMPLATES
+#include "SparseLaplaceSmootherT.cc"
+#endif
+//=============================================================================
+#endif // OPENMESH_SPARSE_LAPLACE_SMOOTHERT_HH defined
+//=============================================================================
+
@@ -493,8 +493,8 @@ private:
     _m.set_halfedge_handle(    fh, n_heh);
     _m.set_halfedge_handle(new_fh, heh);
 
-#undef set_next_halfedge_handle
-#undef next_halfedge_handle
+#undef set_next_heh
+#undef next_heh
 
   }
 
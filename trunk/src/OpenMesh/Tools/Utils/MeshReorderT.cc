@@ -0,0 +1,301 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+//=============================================================================
+//
+//  CLASS MeshReorderT - IMPLEMENTATION
+//
+//=============================================================================
+
+#define OPENMESH_MESHREORDERT_C
+
+//== INCLUDES =================================================================
+
+#include <OpenMesh/Tools/Utils/MeshReorderT.hh>
+#include <OpenMesh/Core/IO/SR_types.hh>
+#include <algorithm>
+#include <utility>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+
+
+//== IMPLEMENTATION ==========================================================
+
+
+template <class Mesh>
+MeshReorderT<Mesh>::
+MeshReorderT(Mesh& _mesh) :
+    mesh_(_mesh)
+{
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+MeshReorderT<Mesh>::
+~MeshReorderT()
+{
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+MeshReorderT<Mesh>::
+reorder(Ordering _ordering)
+{
+  compute_vertex_order(_ordering, vertex_order_);
+  compute_edge_face_order();
+
+  mesh_.permute(vertex_order_, edge_order_, face_order_);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+MeshReorderT<Mesh>::
+compute_vertex_order(Ordering _ordering, Order& _order) const
+{
+  switch (_ordering)
+  {
+    case Morton:
+      morton_order(_order);
+      break;
+
+    case ReverseCuthillMcKee:
+      rcm_order(_order);
+      break;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+MeshReorderT<Mesh>::
+morton_order(Order& _order) const
+{
+  typedef IO::uint64_t                         Key;
+  typedef std::pair<Key, unsigned int>         KeyIndex;
+
+  const unsigned int n_vertices = static_cast<unsigned int>(mesh_.n_vertices());
+
+  _order.resize(n_vertices);
+  if (n_vertices == 0)
+    return;
+
+  // bounding box
+  typename Mesh::Point bb_min, bb_max;
+  bb_min = bb_max = mesh_.point(typename Mesh::VertexHandle(0));
+  for (unsigned int i=1; i<n_vertices; ++i)
+  {
+    bb_min.minimize(mesh_.point(typename Mesh::VertexHandle(i)));
+    bb_max.maximize(mesh_.point(typename Mesh::VertexHandle(i)));
+  }
+
+  // quantize to 21 bits per coordinate and interleave the bits
+  const double max_coord = double((1 << 21) - 1);
+  double       scale[3];
+  for (int c=0; c<3; ++c)
+    scale[c] = (bb_max[c] > bb_min[c]) ? max_coord / double(bb_max[c] - bb_min[c]) : 0.0;
+
+  std::vector<KeyIndex> keys(n_vertices);
+  for (unsigned int i=0; i<n_vertices; ++i)
+  {
+    const typename Mesh::Point& p = mesh_.point(typename Mesh::VertexHandle(i));
+    Key key(0);
+
+    for (int c=0; c<3; ++c)
+    {
+      Key x = static_cast<Key>(double(p[c] - bb_min[c]) * scale[c]);
+
+      // spread the lower 21 bits of x to every third bit
+      x &= 0x1fffff;
+      x = (x | (x << 32)) & ((Key(0x001f0000) << 32) | Key(0x0000ffff));
+      x = (x | (x << 16)) & ((Key(0x001f0000) << 32) | Key(0xff0000ff));
+      x = (x | (x <<  8)) & ((Key(0x100f00f0) << 32) | Key(0x0f00f00f));
+      x = (x | (x <<  4)) & ((Key(0x10c30c30) << 32) | Key(0xc30c30c3));
+      x = (x | (x <<  2)) & ((Key(0x12492492) << 32) | Key(0x49249249));
+
+      key |= x << c;
+    }
+
+    keys[i] = KeyIndex(key, i);
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  for (unsigned int i=0; i<n_vertices; ++i)
+    _order[i] = keys[i].second;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+MeshReorderT<Mesh>::
+rcm_order(Order& _order) const
+{
+  typedef std::pair<unsigned int, unsigned int>   ValenceIndex;
+
+  const unsigned int n_vertices = static_cast<unsigned int>(mesh_.n_vertices());
+
+  _order.clear();
+  _order.reserve(n_vertices);
+
+  std::vector<unsigned int> valence(n_vertices);
+  std::vector<ValenceIndex> seeds(n_vertices);
+  for (unsigned int i=0; i<n_vertices; ++i)
+  {
+    valence[i] = mesh_.valence(typename Mesh::VertexHandle(i));
+    seeds[i]   = ValenceIndex(valence[i], i);
+  }
+
+  // start each component at a vertex of minimal valence
+  std::sort(seeds.begin(), seeds.end());
+
+  std::vector<bool>         visited(n_vertices, false);
+  std::vector<ValenceIndex> neighbors;
+
+  for (unsigned int s=0; s<n_vertices; ++s)
+  {
+    const unsigned int seed = seeds[s].second;
+    if (visited[seed])
+      continue;
+
+    // breadth first search, neighbors sorted by increasing valence
+    size_t head = _order.size();
+    _order.push_back(seed);
+    visited[seed] = true;
+
+    while (head < _order.size())
+    {
+      typename Mesh::VertexHandle      vh(_order[head++]);
+      typename Mesh::ConstVertexVertexIter vv_it;
+
+      neighbors.clear();
+      for (vv_it=mesh_.cvv_iter(vh); vv_it.is_valid(); ++vv_it)
+        if (!visited[vv_it->idx()])
+        {
+          visited[vv_it->idx()] = true;
+          neighbors.push_back(ValenceIndex(valence[vv_it->idx()], vv_it->idx()));
+        }
+
+      std::sort(neighbors.begin(), neighbors.end());
+      for (size_t i=0; i<neighbors.size(); ++i)
+        _order.push_back(neighbors[i].second);
+    }
+  }
+
+  std::reverse(_order.begin(), _order.end());
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+MeshReorderT<Mesh>::
+compute_edge_face_order()
+{
+  typedef std::pair<unsigned int, unsigned int>   KeyIndex;
+
+  const unsigned int n_vertices = static_cast<unsigned int>(mesh_.n_vertices());
+  const unsigned int n_edges    = static_cast<unsigned int>(mesh_.n_edges());
+  const unsigned int n_faces    = static_cast<unsigned int>(mesh_.n_faces());
+
+  // new index of each vertex
+  std::vector<unsigned int> new_index(n_vertices);
+  for (unsigned int i=0; i<n_vertices; ++i)
+    new_index[vertex_order_[i]] = i;
+
+  std::vector<KeyIndex> keys;
+
+  // edges
+  keys.resize(n_edges);
+  for (unsigned int i=0; i<n_edges; ++i)
+  {
+    typename Mesh::HalfedgeHandle hh = mesh_.halfedge_handle(typename Mesh::EdgeHandle(i), 0);
+    keys[i] = KeyIndex(std::min(new_index[mesh_.to_vertex_handle(hh).idx()],
+                                new_index[mesh_.from_vertex_handle(hh).idx()]), i);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  edge_order_.resize(n_edges);
+  for (unsigned int i=0; i<n_edges; ++i)
+    edge_order_[i] = keys[i].second;
+
+  // faces
+  keys.resize(n_faces);
+  for (unsigned int i=0; i<n_faces; ++i)
+  {
+    typename Mesh::ConstFaceVertexIter fv_it = mesh_.cfv_iter(typename Mesh::FaceHandle(i));
+    unsigned int key = n_vertices;
+    for (; fv_it.is_valid(); ++fv_it)
+      key = std::min(key, new_index[fv_it->idx()]);
+    keys[i] = KeyIndex(key, i);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  face_order_.resize(n_faces);
+  for (unsigned int i=0; i<n_faces; ++i)
+    face_order_[i] = keys[i].second;
+}
+
+
+//=============================================================================
+} // namespace OpenMesh
+//=============================================================================
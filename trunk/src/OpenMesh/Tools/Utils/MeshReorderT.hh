@@ -0,0 +1,150 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+//=============================================================================
+//
+//  CLASS MeshReorderT
+//
+//=============================================================================
+
+
+#ifndef OPENMESH_MESHREORDERT_HH
+#define OPENMESH_MESHREORDERT_HH
+
+
+//== INCLUDES =================================================================
+
+#include <vector>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** \class MeshReorderT MeshReorderT.hh <OpenMesh/Tools/Utils/MeshReorderT.hh>
+
+    This class reorders the vertices, edges and faces of a mesh into a
+    locality preserving order. Meshes loaded from files often store their
+    items in an order with poor spatial locality, which causes cache misses
+    in all circulator based algorithms (smoothing, decimation, normals).
+
+    Vertices are sorted either along a Morton (Z-order) curve of their
+    positions or by the reverse Cuthill-McKee ordering of the vertex graph.
+    Edges and faces are then sorted by their smallest vertex index, so they
+    are stored close to their vertices.
+
+    The reordering is applied with ArrayKernel::permute(), which moves all
+    properties and rewrites all handles of the connectivity. Handles stored
+    outside of the mesh are invalid afterwards, the applied permutations are
+    available via vertex_order(), edge_order() and face_order().
+
+    The mesh should not contain deleted items, call garbage_collection() first.
+*/
+
+template <class Mesh>
+class MeshReorderT
+{
+public:
+
+  typedef std::vector<unsigned int>  Order;
+
+  /// Vertex orderings
+  enum Ordering {
+    Morton,               ///< Z-order curve on the vertex positions
+    ReverseCuthillMcKee   ///< Bandwidth reducing order of the vertex graph
+  };
+
+
+  /// Constructor
+  MeshReorderT(Mesh& _mesh);
+
+  /// Destructor
+  ~MeshReorderT();
+
+  /// Reorder vertices, edges and faces of the mesh
+  void reorder(Ordering _ordering = Morton);
+
+  /// Compute a vertex order without applying it (old index of each new vertex)
+  void compute_vertex_order(Ordering _ordering, Order& _order) const;
+
+  /// Old index of each vertex after the last reorder()
+  const Order& vertex_order() const { return vertex_order_; }
+
+  /// Old index of each edge after the last reorder()
+  const Order& edge_order() const { return edge_order_; }
+
+  /// Old index of each face after the last reorder()
+  const Order& face_order() const { return face_order_; }
+
+
+private:
+
+  void morton_order(Order& _order) const;
+  void rcm_order(Order& _order) const;
+
+  /// sort edges and faces by their smallest new vertex index
+  void compute_edge_face_order();
+
+
+private:
+
+  Mesh&   mesh_;
+  Order   vertex_order_;
+  Order   edge_order_;
+  Order   face_order_;
+};
+
+
+//=============================================================================
+} // namespace OpenMesh
+//=============================================================================
+#if defined(OM_INCLUDE_TEMPLATES) && !defined(OPENMESH_MESHREORDERT_C)
+#define OPENMESH_MESHREORDERT_TEMPLATES
+#include "MeshReorderT.cc"
+#endif
+//=============================================================================
+#endif // OPENMESH_MESHREORDERT_HH defined
+//=============================================================================
+
@@ -0,0 +1,420 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+//=============================================================================
+//
+//  CLASS VertexCacheOptimizerT - IMPLEMENTATION
+//
+//=============================================================================
+
+#define OPENMESH_VERTEXCACHEOPTIMIZERT_C
+
+//== INCLUDES =================================================================
+
+#include <OpenMesh/Tools/Utils/VertexCacheOptimizerT.hh>
+#include <algorithm>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+
+
+//== IMPLEMENTATION ==========================================================
+
+
+#ifndef DOXY_IGNORE_THIS
+
+// sort triangles by the coordinate of their centroid
+struct VertexCacheOptimizerKeyLess
+{
+  VertexCacheOptimizerKeyLess(const std::vector<float>& _keys) : keys_(_keys) {}
+  bool operator()(unsigned int _a, unsigned int _b) const { return keys_[_a] < keys_[_b]; }
+  const std::vector<float>& keys_;
+};
+
+#endif
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+VertexCacheOptimizerT<Mesh>::
+VertexCacheOptimizerT(const Mesh& _mesh, unsigned int _cache_size) :
+    mesh_(_mesh),
+    cache_size_(_cache_size)
+{
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+VertexCacheOptimizerT<Mesh>::
+~VertexCacheOptimizerT()
+{
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+VertexCacheOptimizerT<Mesh>::
+triangulate(Indices& _triangles) const
+{
+  typename Mesh::ConstFaceIter          f_it, f_end(mesh_.faces_end());
+  typename Mesh::ConstFaceVertexIter    fv_it;
+
+  _triangles.clear();
+  _triangles.reserve(3 * mesh_.n_faces());
+
+  for (f_it=mesh_.faces_begin(); f_it!=f_end; ++f_it)
+  {
+    fv_it = mesh_.cfv_iter(*f_it);
+    const Index v0 = fv_it->idx(); ++fv_it;
+    Index       v1 = fv_it->idx(); ++fv_it;
+
+    for (; fv_it.is_valid(); ++fv_it)
+    {
+      const Index v2 = fv_it->idx();
+      _triangles.push_back(v0);
+      _triangles.push_back(v1);
+      _triangles.push_back(v2);
+      v1 = v2;
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+size_t
+VertexCacheOptimizerT<Mesh>::
+optimize(unsigned int _n_partitions)
+{
+  Indices triangles;
+  triangulate(triangles);
+
+  const size_t n_triangles = triangles.size() / 3;
+
+  indices_.clear();
+  vertex_order_.clear();
+
+  if (n_triangles == 0)
+    return 0;
+
+  // do not create partitions with less than a few cache sizes of triangles
+  const size_t min_size = 16 * static_cast<size_t>(cache_size_);
+  size_t n_parts = std::max(1u, _n_partitions);
+  if (n_parts > 1 && n_triangles / n_parts < min_size)
+    n_parts = std::max(static_cast<size_t>(1), n_triangles / min_size);
+
+  std::vector<Indices> parts(n_parts), optimized(n_parts);
+
+  if (n_parts == 1)
+  {
+    parts[0].swap(triangles);
+  }
+  else
+  {
+    // split into slabs along the longest axis of the bounding box
+    typename Mesh::Point bb_min, bb_max;
+    bb_min = bb_max = mesh_.point(typename Mesh::VertexHandle(triangles[0]));
+    for (size_t i=1; i<triangles.size(); ++i)
+    {
+      bb_min.minimize(mesh_.point(typename Mesh::VertexHandle(triangles[i])));
+      bb_max.maximize(mesh_.point(typename Mesh::VertexHandle(triangles[i])));
+    }
+
+    int axis = 0;
+    for (int c=1; c<3; ++c)
+      if (bb_max[c]-bb_min[c] > bb_max[axis]-bb_min[axis])
+        axis = c;
+
+    std::vector<float> keys(n_triangles);
+    Indices            order(n_triangles);
+    for (size_t t=0; t<n_triangles; ++t)
+    {
+      keys[t] = static_cast<float>(  mesh_.point(typename Mesh::VertexHandle(triangles[3*t  ]))[axis]
+                                   + mesh_.point(typename Mesh::VertexHandle(triangles[3*t+1]))[axis]
+                                   + mesh_.point(typename Mesh::VertexHandle(triangles[3*t+2]))[axis]);
+      order[t] = static_cast<Index>(t);
+    }
+    std::sort(order.begin(), order.end(), VertexCacheOptimizerKeyLess(keys));
+
+    for (size_t p=0; p<n_parts; ++p)
+    {
+      const size_t begin = (n_triangles *  p   ) / n_parts;
+      const size_t end   = (n_triangles * (p+1)) / n_parts;
+
+      parts[p].reserve(3 * (end - begin));
+      for (size_t t=begin; t<end; ++t)
+      {
+        parts[p].push_back(triangles[3*order[t]  ]);
+        parts[p].push_back(triangles[3*order[t]+1]);
+        parts[p].push_back(triangles[3*order[t]+2]);
+      }
+    }
+  }
+
+  const int n_parts_int = static_cast<int>(n_parts);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int p=0; p<n_parts_int; ++p)
+  {
+    if (n_parts_int == 1)
+      tipsify(parts[p], mesh_.n_vertices(), optimized[p]);
+    else
+      optimize_partition(parts[p], optimized[p]);
+  }
+
+  // renumber vertices in order of their first use
+  std::vector<int> new_index(mesh_.n_vertices(), -1);
+
+  indices_.reserve(3 * n_triangles);
+  for (size_t p=0; p<n_parts; ++p)
+  {
+    for (size_t i=0; i<optimized[p].size(); ++i)
+    {
+      const Index v = optimized[p][i];
+      if (new_index[v] == -1)
+      {
+        new_index[v] = static_cast<int>(vertex_order_.size());
+        vertex_order_.push_back(v);
+      }
+      indices_.push_back(static_cast<Index>(new_index[v]));
+    }
+  }
+
+  return n_triangles;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+VertexCacheOptimizerT<Mesh>::
+optimize_partition(const Indices& _in, Indices& _out) const
+{
+  // compact vertex indices of this partition
+  Indices vertices(_in);
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+  Indices local(_in.size());
+  for (size_t i=0; i<_in.size(); ++i)
+    local[i] = static_cast<Index>(std::lower_bound(vertices.begin(), vertices.end(), _in[i]) - vertices.begin());
+
+  Indices reordered;
+  tipsify(local, vertices.size(), reordered);
+
+  _out.resize(reordered.size());
+  for (size_t i=0; i<reordered.size(); ++i)
+    _out[i] = vertices[reordered[i]];
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+VertexCacheOptimizerT<Mesh>::
+tipsify(const Indices& _in, size_t _n_vertices, Indices& _out) const
+{
+  const size_t n_triangles = _in.size() / 3;
+  const int    n_vertices  = static_cast<int>(_n_vertices);
+  const int    cache_size  = static_cast<int>(cache_size_);
+
+  // vertex-triangle adjacency
+  std::vector<int> live(_n_vertices, 0);
+  for (size_t i=0; i<_in.size(); ++i)
+    ++live[_in[i]];
+
+  std::vector<unsigned int> adj_start(_n_vertices+1, 0);
+  for (size_t v=0; v<_n_vertices; ++v)
+    adj_start[v+1] = adj_start[v] + live[v];
+
+  std::vector<unsigned int> adj(_in.size()), fill(adj_start.begin(), adj_start.end()-1);
+  for (size_t i=0; i<_in.size(); ++i)
+    adj[fill[_in[i]]++] = static_cast<unsigned int>(i / 3);
+
+  std::vector<int>   cache_time(_n_vertices, 0);
+  std::vector<bool>  emitted(n_triangles, false);
+  std::vector<int>   dead_end;
+  std::vector<int>   candidates;
+
+  int time_stamp = cache_size + 1;
+  int cursor     = 1;
+  int fanning    = 0;
+
+  _out.clear();
+  _out.reserve(_in.size());
+
+  while (fanning >= 0)
+  {
+    candidates.clear();
+
+    // emit all not yet emitted triangles of the fanning vertex
+    for (unsigned int k=adj_start[fanning]; k<adj_start[fanning+1]; ++k)
+    {
+      const unsigned int t = adj[k];
+      if (emitted[t])
+        continue;
+
+      for (int c=0; c<3; ++c)
+      {
+        const int v = static_cast<int>(_in[3*t+c]);
+        _out.push_back(static_cast<Index>(v));
+        dead_end.push_back(v);
+        candidates.push_back(v);
+        --live[v];
+
+        // vertex is not in cache
+        if (time_stamp - cache_time[v] > cache_size)
+          cache_time[v] = time_stamp++;
+      }
+      emitted[t] = true;
+    }
+
+    // select the next fanning vertex among the candidates
+    int best = -1, best_priority = -1;
+    for (size_t i=0; i<candidates.size(); ++i)
+    {
+      const int v = candidates[i];
+      if (live[v] > 0)
+      {
+        int priority = 0;
+
+        // vertex will still be in the cache after fanning around it
+        if (time_stamp - cache_time[v] + 2 * live[v] <= cache_size)
+          priority = time_stamp - cache_time[v];
+
+        if (priority > best_priority)
+        {
+          best          = v;
+          best_priority = priority;
+        }
+      }
+    }
+
+    // dead end: take the most recently used vertex with remaining triangles
+    while (best == -1 && !dead_end.empty())
+    {
+      const int v = dead_end.back();
+      dead_end.pop_back();
+      if (live[v] > 0)
+        best = v;
+    }
+
+    // otherwise continue with the next vertex in input order
+    while (best == -1 && cursor < n_vertices)
+    {
+      if (live[cursor] > 0)
+        best = cursor;
+      else
+        ++cursor;
+    }
+
+    fanning = best;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+double
+VertexCacheOptimizerT<Mesh>::
+acmr_original() const
+{
+  Indices triangles;
+  triangulate(triangles);
+  return compute_acmr(triangles, cache_size_);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+double
+VertexCacheOptimizerT<Mesh>::
+compute_acmr(const Indices& _indices, unsigned int _cache_size)
+{
+  if (_indices.size() < 3)
+    return 0.0;
+
+  const Index max_index = *std::max_element(_indices.begin(), _indices.end());
+
+  // a vertex is in the FIFO cache if less than _cache_size misses
+  // happened since it has been loaded
+  std::vector<size_t> load_time(max_index+1, 0);
+  size_t              misses(0);
+
+  for (size_t i=0; i<_indices.size(); ++i)
+  {
+    const Index v = _indices[i];
+    if (load_time[v] == 0 || misses - load_time[v] >= _cache_size)
+    {
+      ++misses;
+      load_time[v] = misses;
+    }
+  }
+
+  return static_cast<double>(misses) / static_cast<double>(_indices.size() / 3);
+}
+
+
+//=============================================================================
+} // namespace OpenMesh
+//=============================================================================
@@ -0,0 +1,169 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+
+//=============================================================================
+//
+//  CLASS VertexCacheOptimizerT
+//
+//=============================================================================
+
+
+#ifndef OPENMESH_VERTEXCACHEOPTIMIZERT_HH
+#define OPENMESH_VERTEXCACHEOPTIMIZERT_HH
+
+
+//== INCLUDES =================================================================
+
+#include <vector>
+#include <cstddef>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** \class VertexCacheOptimizerT VertexCacheOptimizerT.hh <OpenMesh/Tools/Utils/VertexCacheOptimizerT.hh>
+
+    This class computes a triangle index buffer of a mesh which is optimized
+    for the post-transform vertex cache of the GPU. It is an alternative to
+    the StripifierT for indexed triangle list rendering.
+
+    Triangles are reordered with the Tipsify algorithm (Sander, Nehab and
+    Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced
+    Overdraw", SIGGRAPH 2007), vertices are then renumbered in order of
+    their first use, which improves the locality of vertex fetches.
+
+    Large meshes can be split into spatially coherent partitions (slabs
+    along the longest axis of the bounding box) which are optimized
+    independently and in parallel if OpenMP is available. Polygonal faces
+    are triangulated as fans.
+
+    The mesh itself is not modified.
+*/
+
+template <class Mesh>
+class VertexCacheOptimizerT
+{
+public:
+
+  typedef unsigned int                      Index;
+  typedef std::vector<Index>                Indices;
+
+
+  /** Constructor
+   *
+   * @param _mesh       Mesh to be optimized
+   * @param _cache_size Size of the simulated FIFO vertex cache
+   */
+  VertexCacheOptimizerT(const Mesh& _mesh, unsigned int _cache_size = 16);
+
+  /// Destructor
+  ~VertexCacheOptimizerT();
+
+  /** Compute the optimized index buffer, returns number of triangles
+   *
+   * @param _n_partitions Number of spatial partitions optimized independently
+   */
+  size_t optimize(unsigned int _n_partitions = 1);
+
+  /// delete the index buffer
+  void clear() { Indices().swap(indices_); Indices().swap(vertex_order_); }
+
+  /// is the index buffer computed?
+  bool is_valid() const { return !indices_.empty(); }
+
+  /// Triangle list, three indices into vertex_order() per triangle
+  const Indices& indices() const { return indices_; }
+
+  /// Original vertex index of each vertex of the index buffer
+  const Indices& vertex_order() const { return vertex_order_; }
+
+  /// Number of triangles of the index buffer
+  size_t n_triangles() const { return indices_.size() / 3; }
+
+  /// Average cache miss ratio (vertex transforms per triangle) of the index buffer
+  double acmr() const { return compute_acmr(indices_, cache_size_); }
+
+  /// Average cache miss ratio of the triangles in the original face order
+  double acmr_original() const;
+
+  /** Average cache miss ratio of an arbitrary triangle list for a FIFO
+   *  cache with _cache_size entries. Between 0.5 (best) and 3 (worst).
+   */
+  static double compute_acmr(const Indices& _indices, unsigned int _cache_size);
+
+
+private:
+
+  /// collect the triangles of all faces in mesh order
+  void triangulate(Indices& _triangles) const;
+
+  /// reorder a triangle list with compact vertex indices [0, _n_vertices)
+  void tipsify(const Indices& _in, size_t _n_vertices, Indices& _out) const;
+
+  /// optimize a triangle list with global vertex indices
+  void optimize_partition(const Indices& _in, Indices& _out) const;
+
+
+private:
+
+  const Mesh&   mesh_;
+  unsigned int  cache_size_;
+  Indices       indices_;
+  Indices       vertex_order_;
+};
+
+
+//=============================================================================
+} // namespace OpenMesh
+//=============================================================================
+#if defined(OM_INCLUDE_TEMPLATES) && !defined(OPENMESH_VERTEXCACHEOPTIMIZERT_C)
+#define OPENMESH_VERTEXCACHEOPTIMIZERT_TEMPLATES
+#include "VertexCacheOptimizerT.cc"
+#endif
+//=============================================================================
+#endif // OPENMESH_VERTEXCACHEOPTIMIZERT_HH defined
+//=============================================================================
+
@@ -0,0 +1,565 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS AdaptiveRefinerT - IMPLEMENTATION
+//
+//=============================================================================
+
+#define OPENMESH_VDPROGMESH_ADAPTIVEREFINERT_C
+
+//== INCLUDES =================================================================
+
+#include <map>
+#include <cmath>
+#include <OpenMesh/Tools/Utils/Timer.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyReader.hh>
+#include <OpenMesh/Tools/VDPM/AdaptiveRefinerT.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== IMPLEMENTATION ==========================================================
+
+
+template <class Mesh>
+AdaptiveRefinerT<Mesh>::
+AdaptiveRefinerT(Mesh& _mesh, VHierarchy& _vhierarchy, VFront& _vfront)
+  : mesh_(_mesh),
+    vhierarchy_(_vhierarchy),
+    vfront_(_vfront),
+    n_base_vertices_(0),
+    n_base_faces_(0),
+    n_details_(0),
+    kappa_square_(0.0f),
+    time_budget_(0.0),
+    resume_(false),
+    n_vsplits_(0),
+    n_ecols_(0),
+    seconds_(0.0)
+{
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+void
+AdaptiveRefinerT<Mesh>::
+set_params(VHierarchyNode& _node, const VHierarchyNodeParams& _params)
+{
+  _node.set_radius(_params.radius);
+  _node.set_normal(_params.normal);
+  _node.set_sin_square(_params.sin_square);
+  _node.set_mue_square(_params.mue_square);
+  _node.set_sigma_square(_params.sigma_square);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+open(const std::string& _filename)
+{
+  unsigned int                    i;
+  unsigned int                    fvi[3];
+  Vec3f                           p;
+  VHierarchyNodeParams            params;
+  VSplitRecord                    record;
+  VHierarchyNodeHandleContainer   roots;
+  VertexHandle                    vertex_handle;
+  VHierarchyNodeIndex             node_index;
+  VHierarchyNodeHandle            node_handle;
+
+  std::map<VHierarchyNodeIndex, VHierarchyNodeHandle> index2handle_map;
+
+  mesh_.clear();
+  vfront_.clear();
+  vhierarchy_.clear();
+  resume_ = false;
+
+  // paged files: read the base mesh only
+  if (pager_.open(_filename))
+  {
+    n_base_vertices_ = pager_.n_base_vertices();
+    n_base_faces_    = pager_.n_base_faces();
+    n_details_       = pager_.n_details();
+
+    pager_.init_hierarchy(vhierarchy_);
+
+    for (i=0; i<n_base_vertices_; ++i)
+    {
+      vertex_handle = mesh_.add_vertex(pager_.base_point(i));
+      node_handle   = vhierarchy_.root_handle(i);
+
+      vhierarchy_.node(node_handle).set_vertex_handle(vertex_handle);
+      mesh_.data(vertex_handle).set_vhierarchy_node_handle(node_handle);
+      mesh_.set_normal(vertex_handle, pager_.base_params(i).normal);
+
+      roots.push_back(node_handle);
+    }
+    vfront_.init(roots, n_details_);
+
+    for (i=0; i<n_base_faces_; ++i)
+    {
+      const unsigned int* face = pager_.base_face(i);
+      mesh_.add_face(mesh_.vertex_handle(face[0]),
+                     mesh_.vertex_handle(face[1]),
+                     mesh_.vertex_handle(face[2]));
+    }
+
+    mesh_.update_face_normals();
+
+    return true;
+  }
+
+  // reads .spm and compressed files
+  VHierarchyReader reader;
+  if (!reader.open(_filename))
+    return false;
+
+  n_base_vertices_ = reader.n_base_vertices();
+  n_base_faces_    = reader.n_base_faces();
+  n_details_       = reader.n_details();
+
+  vhierarchy_.set_num_roots(n_base_vertices_);
+
+  // load base mesh
+  for (i=0; i<n_base_vertices_; ++i)
+  {
+    if (!reader.read_base_vertex(p, params))
+      return false;
+
+    vertex_handle = mesh_.add_vertex(p);
+    node_index    = vhierarchy_.generate_node_index(i, 1);
+    node_handle   = vhierarchy_.add_node();
+
+    VHierarchyNode &node = vhierarchy_.node(node_handle);
+
+    node.set_index(node_index);
+    node.set_vertex_handle(vertex_handle);
+    mesh_.data(vertex_handle).set_vhierarchy_node_handle(node_handle);
+
+    set_params(node, params);
+    mesh_.set_normal(vertex_handle, params.normal);
+
+    index2handle_map[node_index] = node_handle;
+    roots.push_back(node_handle);
+  }
+  vfront_.init(roots, n_details_);
+
+  for (i=0; i<n_base_faces_; ++i)
+  {
+    if (!reader.read_base_face(fvi))
+      return false;
+
+    mesh_.add_face(mesh_.vertex_handle(fvi[0]),
+                   mesh_.vertex_handle(fvi[1]),
+                   mesh_.vertex_handle(fvi[2]));
+  }
+
+  // load details
+  for (i=0; i<n_details_; ++i)
+  {
+    if (!reader.read_vsplit(record))
+      return false;
+
+    node_handle = index2handle_map[VHierarchyNodeIndex(record.node_index)];
+    vhierarchy_.make_children(node_handle);
+
+    VHierarchyNode &node   = vhierarchy_.node(node_handle);
+    VHierarchyNode &lchild = vhierarchy_.node(node.lchild_handle());
+    VHierarchyNode &rchild = vhierarchy_.node(node.rchild_handle());
+
+    node.set_fund_lcut(VHierarchyNodeIndex(record.fund_lcut_index));
+    node.set_fund_rcut(VHierarchyNodeIndex(record.fund_rcut_index));
+
+    // position of v0
+    vertex_handle = mesh_.add_vertex(record.point);
+    lchild.set_vertex_handle(vertex_handle);
+    rchild.set_vertex_handle(node.vertex_handle());
+
+    index2handle_map[lchild.node_index()] = node.lchild_handle();
+    index2handle_map[rchild.node_index()] = node.rchild_handle();
+
+    // view-dependent parameters
+    set_params(lchild, record.lchild);
+    set_params(rchild, record.rchild);
+  }
+
+  mesh_.update_face_normals();
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+refine(ViewingParameters& _viewing_parameters)
+{
+  Utils::Timer    timer;
+  HalfedgeHandle  v0v1;
+  unsigned int    steps     = 0;
+  bool            completed = true;
+
+  timer.start();
+  n_vsplits_ = n_ecols_ = 0;
+
+  // view dependent quantities are constant during the pass
+  eye_pos_ = _viewing_parameters.eye_pos();
+  _viewing_parameters.frustum_planes(frustum_plane_);
+
+  float tan_value = tanf(_viewing_parameters.fovy() / 2.0f);
+  kappa_square_ = 4.0f * tan_value * tan_value * _viewing_parameters.tolerance_square();
+
+  // continue an interrupted pass, page in the visible blocks for a new one
+  if (!resume_)
+  {
+    if (pager_.is_open())
+      pager_.prefetch(_viewing_parameters);
+    vfront_.begin();
+  }
+  resume_ = false;
+
+  while (!vfront_.end())
+  {
+    // poll the timer only every few nodes
+    if (time_budget_ > 0.0 && (++steps & 31) == 0)
+    {
+      timer.stop();
+      bool spent = timer.seconds() >= time_budget_;
+      timer.cont();
+
+      if (spent)
+      {
+        completed = false;
+        resume_   = true;
+        break;
+      }
+    }
+
+    VHierarchyNodeHandle
+      node_handle   = vfront_.node_handle(),
+      parent_handle = vhierarchy_.parent_handle(node_handle);
+
+    // leaves of a paged hierarchy may have children on disk
+    if ((vhierarchy_.is_leaf_node(node_handle) != true || pager_.is_open()) &&
+        qrefine(node_handle) == true &&
+        force_vsplit(node_handle) == true)
+    {
+      continue;
+    }
+
+    if (vhierarchy_.is_root_node(node_handle) != true &&
+             ecol_legal(parent_handle, v0v1) == true       &&
+             qrefine(parent_handle) != true)
+    {
+      ecol(parent_handle, v0v1);
+    }
+    else
+    {
+      vfront_.next();
+    }
+  }
+
+  // free memories tagged as 'deleted'
+  mesh_.garbage_collection(false, true, true);
+  mesh_.update_face_normals();
+
+  timer.stop();
+  seconds_ = timer.seconds();
+
+  return completed;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+qrefine(VHierarchyNodeHandle _node_handle)
+{
+  VHierarchyNode &node    = vhierarchy_.node(_node_handle);
+  Vec3f           p       = mesh_.point(node.vertex_handle());
+  Vec3f           eye_dir = p - eye_pos_;
+
+  float distance      = eye_dir.length();
+  float distance2     = distance * distance;
+  float product_value = dot(eye_dir, node.normal());
+
+  if (outside_view_frustum(p, node.radius()) == true)
+    return false;
+
+  if (oriented_away(node.sin_square(), distance2, product_value) == true)
+    return false;
+
+  if (screen_space_error(node.mue_square(),
+                         node.sigma_square(),
+                         distance2,
+                         product_value) == true)
+    return false;
+
+  return true;
+}
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+force_vsplit(VHierarchyNodeHandle _node_handle)
+{
+  VertexHandle vl, vr;
+
+  if (!load_children(_node_handle))
+    return false;
+
+  get_active_cuts(_node_handle, vl, vr);
+
+  while (vl == vr)
+  {
+    if (!force_vsplit(mesh_.data(vl).vhierarchy_node_handle()))
+      return false;
+    get_active_cuts(_node_handle, vl, vr);
+  }
+
+  vsplit(_node_handle, vl, vr);
+  return true;
+}
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+load_children(VHierarchyNodeHandle _node_handle)
+{
+  Vec3f p;
+
+  if (vhierarchy_.is_leaf_node(_node_handle) != true)
+    return true;
+
+  if (!pager_.is_open() || !pager_.make_children(vhierarchy_, _node_handle, p))
+    return false;
+
+  // as in open(): v0 is a new vertex, v1 keeps the one of the parent
+  VHierarchyNode& node = vhierarchy_.node(_node_handle);
+  vhierarchy_.node(node.lchild_handle()).set_vertex_handle(mesh_.add_vertex(p));
+  vhierarchy_.node(node.rchild_handle()).set_vertex_handle(node.vertex_handle());
+
+  return true;
+}
+
+
+template <class Mesh>
+void
+AdaptiveRefinerT<Mesh>::
+vsplit(VHierarchyNodeHandle _node_handle, VertexHandle _vl, VertexHandle _vr)
+{
+  VHierarchyNodeHandle
+    lchild_handle = vhierarchy_.lchild_handle(_node_handle),
+    rchild_handle = vhierarchy_.rchild_handle(_node_handle);
+
+  VertexHandle v0 = vhierarchy_.vertex_handle(lchild_handle);
+  VertexHandle v1 = vhierarchy_.vertex_handle(rchild_handle);
+
+  mesh_.vertex_split(v0, v1, _vl, _vr);
+  mesh_.set_normal(v0, vhierarchy_.normal(lchild_handle));
+  mesh_.set_normal(v1, vhierarchy_.normal(rchild_handle));
+  mesh_.data(v0).set_vhierarchy_node_handle(lchild_handle);
+  mesh_.data(v1).set_vhierarchy_node_handle(rchild_handle);
+  mesh_.status(v0).set_deleted(false);
+  mesh_.status(v1).set_deleted(false);
+
+  vfront_.remove(_node_handle);
+  vfront_.add(lchild_handle);
+  vfront_.add(rchild_handle);
+
+  ++n_vsplits_;
+}
+
+
+template <class Mesh>
+void
+AdaptiveRefinerT<Mesh>::
+ecol(VHierarchyNodeHandle _node_handle, const HalfedgeHandle& _v0v1)
+{
+  VHierarchyNodeHandle
+    lchild_handle = vhierarchy_.lchild_handle(_node_handle),
+    rchild_handle = vhierarchy_.rchild_handle(_node_handle);
+
+  VertexHandle v0 = vhierarchy_.vertex_handle(lchild_handle);
+  VertexHandle v1 = vhierarchy_.vertex_handle(rchild_handle);
+
+  mesh_.collapse(_v0v1);
+  mesh_.set_normal(v1, vhierarchy_.normal(_node_handle));
+  mesh_.data(v0).set_vhierarchy_node_handle(lchild_handle);
+  mesh_.data(v1).set_vhierarchy_node_handle(_node_handle);
+  mesh_.status(v0).set_deleted(false);
+  mesh_.status(v1).set_deleted(false);
+
+  vfront_.add(_node_handle);
+  vfront_.remove(lchild_handle);
+  vfront_.remove(rchild_handle);
+
+  ++n_ecols_;
+}
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+ecol_legal(VHierarchyNodeHandle _parent_handle, HalfedgeHandle& _v0v1)
+{
+  VHierarchyNodeHandle
+    lchild_handle = vhierarchy_.lchild_handle(_parent_handle),
+    rchild_handle = vhierarchy_.rchild_handle(_parent_handle);
+
+  // test whether lchild & rchild present in the current vfront
+  if ( vfront_.is_active(lchild_handle) != true ||
+       vfront_.is_active(rchild_handle) != true)
+    return false;
+
+  VertexHandle v0 = vhierarchy_.vertex_handle(lchild_handle);
+  VertexHandle v1 = vhierarchy_.vertex_handle(rchild_handle);
+
+  _v0v1 = mesh_.find_halfedge(v0, v1);
+
+  return mesh_.is_collapse_ok(_v0v1);
+}
+
+
+template <class Mesh>
+void
+AdaptiveRefinerT<Mesh>::
+get_active_cuts(VHierarchyNodeHandle _node_handle,
+                VertexHandle& _vl, VertexHandle& _vr)
+{
+  typename Mesh::VertexVertexIter  vv_it;
+  VHierarchyNodeHandle             nnode_handle;
+
+  VHierarchyNodeIndex
+    nnode_index,
+    fund_lcut_index = vhierarchy_.fund_lcut_index(_node_handle),
+    fund_rcut_index = vhierarchy_.fund_rcut_index(_node_handle);
+
+  _vl = Mesh::InvalidVertexHandle;
+  _vr = Mesh::InvalidVertexHandle;
+
+  for (vv_it=mesh_.vv_iter(vhierarchy_.vertex_handle(_node_handle));
+       vv_it.is_valid(); ++vv_it)
+  {
+    nnode_handle = mesh_.data(*vv_it).vhierarchy_node_handle();
+    nnode_index  = vhierarchy_.node_index(nnode_handle);
+
+    if (_vl == Mesh::InvalidVertexHandle &&
+        vhierarchy_.is_ancestor(nnode_index, fund_lcut_index) == true)
+      _vl = *vv_it;
+
+    if (_vr == Mesh::InvalidVertexHandle &&
+        vhierarchy_.is_ancestor(nnode_index, fund_rcut_index) == true)
+      _vr = *vv_it;
+
+    if (_vl != Mesh::InvalidVertexHandle &&
+        _vr != Mesh::InvalidVertexHandle)
+      break;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+outside_view_frustum(const Vec3f& _pos, float _radius)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    if (frustum_plane_[i].signed_distance(_pos) < -_radius)
+      return true;
+  }
+  return false;
+}
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+oriented_away(float _sin_square, float _distance_square, float _product_value) const
+{
+  return (_product_value > 0 &&
+          _product_value * _product_value > _distance_square * _sin_square);
+}
+
+
+template <class Mesh>
+bool
+AdaptiveRefinerT<Mesh>::
+screen_space_error(float _mue_square, float _sigma_square,
+                   float _distance_square, float _product_value) const
+{
+  // true if the error of the node is below the tolerance
+  if ((_mue_square >= kappa_square_ * _distance_square) ||
+      (_sigma_square * (_distance_square - _product_value * _product_value) >=
+       kappa_square_ * _distance_square * _distance_square))
+    return false;
+  else
+    return true;
+}
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
@@ -0,0 +1,238 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS AdaptiveRefinerT
+//
+//=============================================================================
+
+#ifndef OPENMESH_VDPROGMESH_ADAPTIVEREFINERT_HH
+#define OPENMESH_VDPROGMESH_ADAPTIVEREFINERT_HH
+
+
+//== INCLUDES =================================================================
+
+#include <string>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+#include <OpenMesh/Core/Geometry/Plane3d.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchy.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyPager.hh>
+#include <OpenMesh/Tools/VDPM/VFront.hh>
+#include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
+#include <OpenMesh/Tools/VDPM/VSplitRecord.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== CLASS DEFINITION =========================================================
+
+
+/** \class AdaptiveRefinerT AdaptiveRefinerT.hh <OpenMesh/Tools/VDPM/AdaptiveRefinerT.hh>
+
+    View-dependent refinement of a progressive mesh (Kim and Lee, "Truly
+    Selective Refinement of Progressive Meshes", GI 2001) independent of
+    any GUI.
+
+    The refiner works on a mesh, its vertex hierarchy and the active
+    front. Each call of refine() walks the front once: nodes which are
+    visible, not oriented away and exceed the screen-space error are
+    split, parents whose error became small enough are collapsed.
+
+    A time budget limits the work done per call. When it is spent the
+    pass stops and the next call continues at the same position of the
+    front, so an interactive application keeps its frame rate while the
+    mesh converges over several frames.
+
+    A paged file (see VHierarchyPager) is refined out of core: only the
+    base mesh is read by open(), the children of a node are paged in
+    when the node is split for the first time. Each new pass over the
+    front first prefetches the blocks in the view frustum. Nodes, once
+    paged in, stay in the vertex hierarchy.
+
+    The mesh type needs the vertex traits of VDPM::MeshTraits.
+
+    \code
+    MyMesh      mesh;
+    VHierarchy  vhierarchy;
+    VFront      vfront;
+
+    AdaptiveRefinerT<MyMesh> refiner(mesh, vhierarchy, vfront);
+    refiner.open("model.spm");
+    refiner.set_time_budget(0.010);  // 10 ms per frame
+
+    // every frame
+    viewing_parameters.update_viewing_configurations();
+    refiner.refine(viewing_parameters);
+    \endcode
+*/
+template <class Mesh>
+class AdaptiveRefinerT
+{
+public:
+
+  typedef typename Mesh::VertexHandle    VertexHandle;
+  typedef typename Mesh::HalfedgeHandle  HalfedgeHandle;
+
+public:
+
+  AdaptiveRefinerT(Mesh& _mesh, VHierarchy& _vhierarchy, VFront& _vfront);
+  ~AdaptiveRefinerT() { }
+
+  /** Reads a view-dependent progressive mesh (.spm or compressed, see
+      VHierarchyReader) into the mesh, the vertex hierarchy and the
+      front. The mesh is set to the base mesh. Of a paged file only the
+      base mesh is read, the vertex splits are paged in by refine().
+  */
+  bool open(const std::string& _filename);
+
+  /// Is the open model a paged file?
+  bool is_paged() const { return pager_.is_open(); }
+
+  /// The pager of a paged file, e.g. to set its cache size
+  VHierarchyPager& pager() { return pager_; }
+
+  unsigned int n_base_vertices() const { return n_base_vertices_; }
+  unsigned int n_base_faces() const    { return n_base_faces_; }
+  unsigned int n_details() const       { return n_details_; }
+
+public:
+
+  /// Sets the time in seconds one call of refine() may take, 0 means unlimited.
+  void set_time_budget(double _seconds) { time_budget_ = _seconds; }
+
+  double time_budget() const { return time_budget_; }
+
+  /** Adapts the mesh to the viewing parameters (which must be up to
+      date, see ViewingParameters::update_viewing_configurations()).
+      \return true if the pass over the front was completed, false if it
+      was interrupted by the time budget.
+  */
+  bool refine(ViewingParameters& _viewing_parameters);
+
+  /// Vertex splits of the last call of refine()
+  size_t n_vsplits() const  { return n_vsplits_; }
+
+  /// Edge collapses of the last call of refine()
+  size_t n_ecols() const    { return n_ecols_; }
+
+  /// Duration in seconds of the last call of refine()
+  double seconds() const    { return seconds_; }
+
+public: // refinement operations
+
+  /// Returns true if the node should be split for the current view.
+  bool qrefine(VHierarchyNodeHandle _node_handle);
+
+  /** Splits the node, splitting its neighborhood first if necessary.
+      \return false if the node or a neighbor is a leaf of the hierarchy
+      or its vertex split cannot be paged in.
+  */
+  bool force_vsplit(VHierarchyNodeHandle _node_handle);
+
+  bool ecol_legal(VHierarchyNodeHandle _parent_handle, HalfedgeHandle& _v0v1);
+
+  void get_active_cuts(VHierarchyNodeHandle _node_handle,
+                       VertexHandle& _vl, VertexHandle& _vr);
+
+  void vsplit(VHierarchyNodeHandle _node_handle,
+              VertexHandle _vl, VertexHandle _vr);
+
+  void ecol(VHierarchyNodeHandle _parent_handle, const HalfedgeHandle& _v0v1);
+
+private:
+
+  // pages in the children of a leaf, true if the node has children
+  bool load_children(VHierarchyNodeHandle _node_handle);
+
+  static void set_params(VHierarchyNode&             _node,
+                         const VHierarchyNodeParams& _params);
+
+  bool outside_view_frustum(const Vec3f& _pos, float _radius);
+
+  bool oriented_away(float _sin_square,
+                     float _distance_square,
+                     float _product_value) const;
+
+  bool screen_space_error(float _mue_square,
+                          float _sigma_square,
+                          float _distance_square,
+                          float _product_value) const;
+
+private:
+
+  Mesh&         mesh_;
+  VHierarchy&   vhierarchy_;
+  VFront&       vfront_;
+
+  VHierarchyPager pager_;
+
+  unsigned int  n_base_vertices_;
+  unsigned int  n_base_faces_;
+  unsigned int  n_details_;
+
+  // per pass
+  Vec3f         eye_pos_;
+  Plane3d       frustum_plane_[4];
+  float         kappa_square_;
+
+  double        time_budget_;
+  bool          resume_;
+
+  size_t        n_vsplits_;
+  size_t        n_ecols_;
+  double        seconds_;
+};
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
+#if defined(OM_INCLUDE_TEMPLATES) && !defined(OPENMESH_VDPROGMESH_ADAPTIVEREFINERT_C)
+#define OPENMESH_VDPROGMESH_ADAPTIVEREFINERT_TEMPLATES
+#include "AdaptiveRefinerT.cc"
+#endif
+//=============================================================================
+#endif // OPENMESH_VDPROGMESH_ADAPTIVEREFINERT_HH defined
+//=============================================================================
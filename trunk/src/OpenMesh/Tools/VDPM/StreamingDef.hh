@@ -77,6 +77,25 @@ enum VDPMStreamingPhase     { kBaseMesh, kVSplitHeader, kVSplits };
 enum VDPMClientMode         { kStatic, kDynamic };
 enum VHierarchySearchMode   { kBruteForce, kUseHashing };
 
+/** Messages of the VDPM streaming protocol (see StreamingSession).
+    Every message starts with its type and the size of its payload in
+    bytes, both as 32 bit unsigned integers. All values are little endian.
+*/
+enum VDPMMessageType
+{
+  kMsgBaseMeshRequest     = 1, ///< client: empty payload or VDPMStreamFlags
+  kMsgViewingParameters   = 2, ///< client: 16 doubles modelview, fovy, aspect, tolerance^2
+  kMsgBaseMesh            = 3, ///< server: StreamingModel::base_mesh_payload()
+  kMsgVSplits             = 4, ///< server: number of vsplits, followed by the vsplits
+  kMsgRefinementComplete  = 5  ///< server: empty payload, view is fully refined
+};
+
+/// Flags of a kMsgBaseMeshRequest
+enum VDPMStreamFlags
+{
+  kStreamCompressed       = 1  ///< vertex splits coded by VSplitEncoder
+};
+
 
 //=============================================================================
 } // namespace VDPM
@@ -0,0 +1,283 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS StreamingModel - IMPLEMENTATION
+//
+//=============================================================================
+
+
+//== INCLUDES =================================================================
+
+#include <sstream>
+#include <map>
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyReader.hh>
+#include <OpenMesh/Tools/VDPM/StreamingModel.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== IMPLEMENTATION ==========================================================
+
+
+StreamingModel::
+StreamingModel()
+  : n_base_vertices_(0),
+    n_base_faces_(0),
+    n_details_(0)
+{
+}
+
+
+static void set_params(VHierarchyNode& _node, const VHierarchyNodeParams& _params)
+{
+  _node.set_radius(_params.radius);
+  _node.set_normal(_params.normal);
+  _node.set_sin_square(_params.sin_square);
+  _node.set_mue_square(_params.mue_square);
+  _node.set_sigma_square(_params.sigma_square);
+}
+
+
+bool
+StreamingModel::
+open(const std::string& _filename)
+{
+  unsigned int          i, fvi[3];
+  Vec3f                 p;
+  VHierarchyNodeParams  params;
+  VSplitRecord          record;
+  VHierarchyNodeIndex   node_index;
+  VHierarchyNodeHandle  node_handle;
+
+  std::map<VHierarchyNodeIndex, VHierarchyNodeHandle> index2handle_map;
+
+  VHierarchyReader reader;
+  if (!reader.open(_filename))
+    return false;
+
+  bool swap = Endian::local() != Endian::LSB;
+
+  n_base_vertices_ = reader.n_base_vertices();
+  n_base_faces_    = reader.n_base_faces();
+  n_details_       = reader.n_details();
+
+  vhierarchy_.clear();
+  vhierarchy_.set_num_roots(n_base_vertices_);
+  points_.clear();
+  points_.reserve(n_base_vertices_ + 2*n_details_);
+
+  // the base mesh is sent to clients as it is stored in a .spm file
+  std::ostringstream base_mesh;
+  IO::store(base_mesh, n_base_vertices_, swap);
+  IO::store(base_mesh, n_base_faces_, swap);
+  IO::store(base_mesh, n_details_, swap);
+
+  for (i=0; i<n_base_vertices_; ++i)
+  {
+    if (!reader.read_base_vertex(p, params))
+      return false;
+
+    IO::store(base_mesh, p, swap);
+    IO::store(base_mesh, params.radius, swap);
+    IO::store(base_mesh, params.normal, swap);
+    IO::store(base_mesh, params.sin_square, swap);
+    IO::store(base_mesh, params.mue_square, swap);
+    IO::store(base_mesh, params.sigma_square, swap);
+
+    node_index  = vhierarchy_.generate_node_index(i, 1);
+    node_handle = vhierarchy_.add_node();
+
+    VHierarchyNode &node = vhierarchy_.node(node_handle);
+    node.set_index(node_index);
+    set_params(node, params);
+
+    points_.push_back(p);
+    index2handle_map[node_index] = node_handle;
+  }
+
+  for (i=0; i<n_base_faces_; ++i)
+  {
+    if (!reader.read_base_face(fvi))
+      return false;
+
+    IO::store(base_mesh, fvi[0], swap);
+    IO::store(base_mesh, fvi[1], swap);
+    IO::store(base_mesh, fvi[2], swap);
+  }
+
+  base_mesh_ = base_mesh.str();
+
+  for (i=0; i<n_details_; ++i)
+  {
+    if (!reader.read_vsplit(record))
+      return false;
+
+    std::map<VHierarchyNodeIndex, VHierarchyNodeHandle>::iterator
+      m_it = index2handle_map.find(VHierarchyNodeIndex(record.node_index));
+    if (m_it == index2handle_map.end())
+      return false;
+
+    node_handle = m_it->second;
+    vhierarchy_.make_children(node_handle);
+
+    VHierarchyNode &node   = vhierarchy_.node(node_handle);
+    VHierarchyNode &lchild = vhierarchy_.node(node.lchild_handle());
+    VHierarchyNode &rchild = vhierarchy_.node(node.rchild_handle());
+
+    node.set_fund_lcut(VHierarchyNodeIndex(record.fund_lcut_index));
+    node.set_fund_rcut(VHierarchyNodeIndex(record.fund_rcut_index));
+
+    // lchild gets the new vertex, rchild keeps the one of the parent
+    points_.push_back(record.point);
+    points_.push_back(points_[node_handle.idx()]);
+
+    index2handle_map[lchild.node_index()] = node.lchild_handle();
+    index2handle_map[rchild.node_index()] = node.rchild_handle();
+
+    set_params(lchild, record.lchild);
+    set_params(rchild, record.rchild);
+  }
+
+  // quantization for clients requesting compressed vertex splits
+  if (reader.is_compressed())
+    quantization_ = reader.quantization();
+  else
+  {
+    Vec3f bb_min( 1e30f,  1e30f,  1e30f);
+    Vec3f bb_max(-1e30f, -1e30f, -1e30f);
+    for (i=0; i<points_.size(); ++i)
+    {
+      bb_min.minimize(points_[i]);
+      bb_max.maximize(points_[i]);
+    }
+    if (points_.empty())
+      bb_min = bb_max = Vec3f(0.0f, 0.0f, 0.0f);
+
+    quantization_ = VSplitCoder::quantization(bb_min, bb_max);
+  }
+
+  IO::store(base_mesh, quantization_.bb_min, swap);
+  IO::store(base_mesh, quantization_.bb_size, swap);
+  IO::store(base_mesh, quantization_.position_bits, swap);
+  IO::store(base_mesh, quantization_.normal_bits, swap);
+  coded_base_mesh_ = base_mesh.str();
+
+  return true;
+}
+
+
+void
+StreamingModel::
+roots(VHierarchyNodeHandleContainer& _roots) const
+{
+  _roots.clear();
+  for (unsigned int i=0; i<n_base_vertices_; ++i)
+    _roots.push_back(vhierarchy_.root_handle(i));
+}
+
+
+void
+StreamingModel::
+params(VHierarchyNodeHandle _node_handle, VHierarchyNodeParams& _params) const
+{
+  const VHierarchyNode& node = vhierarchy_.node(_node_handle);
+
+  _params.radius       = node.radius();
+  _params.normal       = node.normal();
+  _params.sin_square   = node.sin_square();
+  _params.mue_square   = node.mue_square();
+  _params.sigma_square = node.sigma_square();
+}
+
+
+void
+StreamingModel::
+vsplit_record(VHierarchyNodeHandle _node_handle, VSplitRecord& _record)
+{
+  VHierarchyNode& node = vhierarchy_.node(_node_handle);
+
+  _record.point           = points_[node.lchild_handle().idx()];
+  _record.node_index      = node.node_index().value();
+  _record.fund_lcut_index = node.fund_lcut_index().value();
+  _record.fund_rcut_index = node.fund_rcut_index().value();
+
+  params(node.lchild_handle(), _record.lchild);
+  params(node.rchild_handle(), _record.rchild);
+}
+
+
+void
+StreamingModel::
+write_vsplit(std::ostream& _os, VHierarchyNodeHandle _node_handle)
+{
+  bool          swap = Endian::local() != Endian::LSB;
+  VSplitRecord  record;
+
+  vsplit_record(_node_handle, record);
+
+  VHierarchyNodeParams* children[2] = { &record.lchild, &record.rchild };
+
+  IO::store(_os, record.point, swap);
+  IO::store(_os, record.node_index, swap);
+  IO::store(_os, record.fund_lcut_index, swap);
+  IO::store(_os, record.fund_rcut_index, swap);
+
+  for (int c=0; c<2; ++c)
+  {
+    IO::store(_os, children[c]->radius, swap);
+    IO::store(_os, children[c]->normal, swap);
+    IO::store(_os, children[c]->sin_square, swap);
+    IO::store(_os, children[c]->mue_square, swap);
+    IO::store(_os, children[c]->sigma_square, swap);
+  }
+}
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
@@ -0,0 +1,149 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS StreamingModel
+//
+//=============================================================================
+
+#ifndef OPENMESH_VDPROGMESH_STREAMINGMODEL_HH
+#define OPENMESH_VDPROGMESH_STREAMINGMODEL_HH
+
+
+//== INCLUDES =================================================================
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <OpenMesh/Core/System/config.h>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchy.hh>
+#include <OpenMesh/Tools/VDPM/VSplitRecord.hh>
+#include <OpenMesh/Tools/VDPM/VSplitCoder.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== CLASS DEFINITION =========================================================
+
+
+/** Server side representation of a view-dependent progressive mesh.
+
+    Holds the complete vertex hierarchy of a .spm file together with the
+    position of every node, and encodes the messages of the streaming
+    protocol (see VDPMMessageType). The model is not modified after
+    open(), so any number of StreamingSession's may share it, also from
+    different threads.
+*/
+class OPENMESHDLLEXPORT StreamingModel
+{
+public:
+
+  /// Size in bytes of an encoded vertex split
+  static const unsigned int VSplitSize = 80;
+
+public:
+
+  StreamingModel();
+
+  /// Reads a .spm or compressed file (see VHierarchyReader).
+  bool open(const std::string& _filename);
+
+  unsigned int n_base_vertices() const { return n_base_vertices_; }
+  unsigned int n_base_faces() const    { return n_base_faces_; }
+  unsigned int n_details() const       { return n_details_; }
+
+  VHierarchy& vhierarchy()             { return vhierarchy_; }
+
+  /// Position of the vertex of a node
+  const Vec3f& point(VHierarchyNodeHandle _node_handle) const
+  { return points_[_node_handle.idx()]; }
+
+  /// Handles of the roots of the hierarchy, i.e. of the base mesh vertices
+  void roots(VHierarchyNodeHandleContainer& _roots) const;
+
+  /// Refinement parameters of a node
+  void params(VHierarchyNodeHandle _node_handle,
+              VHierarchyNodeParams& _params) const;
+
+  /// Vertex split of a (non-leaf) node
+  void vsplit_record(VHierarchyNodeHandle _node_handle,
+                     VSplitRecord& _record);
+
+  /** Quantization for compressed vertex splits: the one of the file if
+      it was compressed, else 16 bit positions in the bounding box.
+  */
+  const VSplitQuantization& quantization() const { return quantization_; }
+
+  /** Payload of the kMsgBaseMesh message. If the client requested
+      compressed vertex splits (kStreamCompressed), the quantization
+      follows the base mesh: bounding box minimum, size, position bits
+      and normal bits.
+  */
+  const std::string& base_mesh_payload(bool _compressed = false) const
+  { return _compressed ? coded_base_mesh_ : base_mesh_; }
+
+  /// Writes the vertex split of a (non-leaf) node, VSplitSize bytes.
+  void write_vsplit(std::ostream& _os, VHierarchyNodeHandle _node_handle);
+
+private:
+
+  VHierarchy          vhierarchy_;
+  std::vector<Vec3f>  points_;
+  std::string         base_mesh_;
+  std::string         coded_base_mesh_;
+  VSplitQuantization  quantization_;
+
+  unsigned int        n_base_vertices_;
+  unsigned int        n_base_faces_;
+  unsigned int        n_details_;
+};
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
+#endif // OPENMESH_VDPROGMESH_STREAMINGMODEL_HH defined
+//=============================================================================
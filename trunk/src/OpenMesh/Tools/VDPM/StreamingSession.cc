@@ -0,0 +1,285 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS StreamingSession - IMPLEMENTATION
+//
+//=============================================================================
+
+
+//== INCLUDES =================================================================
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <sstream>
+#include <OpenMesh/Tools/VDPM/StreamingSession.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== IMPLEMENTATION ==========================================================
+
+
+StreamingSession::
+StreamingSession(StreamingModel& _model)
+  : model_(_model),
+    vhierarchy_(_model.vhierarchy()),
+    kappa_square_(0.0f),
+    n_vsplits_(0),
+    compressed_(false)
+{
+  vhwindow_.set_vertex_hierarchy(vhierarchy_);
+  reset();
+}
+
+
+void
+StreamingSession::
+reset()
+{
+  VHierarchyNodeHandleContainer roots;
+  model_.roots(roots);
+  vhwindow_.init(roots);
+
+  queue_     = std::priority_queue<QueueEntry>();
+  n_vsplits_ = 0;
+
+  if (compressed_)
+  {
+    VHierarchyNodeParams params;
+
+    encoder_.reset(model_.n_base_vertices(), model_.quantization());
+    for (unsigned int i=0; i<roots.size(); ++i)
+    {
+      model_.params(roots[i], params);
+      encoder_.add_root(i, model_.point(roots[i]), params);
+    }
+  }
+}
+
+
+void
+StreamingSession::
+set_compressed(bool _compressed)
+{
+  compressed_ = _compressed;
+  reset();
+}
+
+
+void
+StreamingSession::
+set_viewing_parameters(ViewingParameters& _viewing_parameters)
+{
+  eye_pos_ = _viewing_parameters.eye_pos();
+  _viewing_parameters.frustum_planes(frustum_plane_);
+
+  float tan_value = tanf(_viewing_parameters.fovy() / 2.0f);
+  kappa_square_ = 4.0f * tan_value * tan_value * _viewing_parameters.tolerance_square();
+
+  queue_ = std::priority_queue<QueueEntry>();
+
+  for (vhwindow_.begin(); vhwindow_.end() != true; vhwindow_.next())
+    enqueue(vhwindow_.node_handle());
+}
+
+
+size_t
+StreamingSession::
+next_batch(size_t _max_bytes, std::ostream& _os)
+{
+  size_t              n = 0;
+  std::ostringstream  coded;
+
+  if (compressed_)
+    encoder_.begin(coded);
+
+  while (!queue_.empty() &&
+         (compressed_ ? (size_t) coded.tellp() : n * StreamingModel::VSplitSize) < _max_bytes)
+  {
+    VHierarchyNodeHandle node_handle(queue_.top().second);
+    queue_.pop();
+
+    // already split as a dependency of another node
+    if (vhwindow_.is_active(node_handle) != true)
+      continue;
+
+    force_vsplit(node_handle, compressed_ ? coded : _os, n);
+  }
+
+  if (compressed_)
+  {
+    encoder_.end();
+    _os << coded.str();
+  }
+
+  n_vsplits_ += n;
+  return n;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+bool
+StreamingSession::
+qrefine(VHierarchyNodeHandle _node_handle, float& _error)
+{
+  const VHierarchyNode& node = vhierarchy_.node(_node_handle);
+
+  const Vec3f& p       = model_.point(_node_handle);
+  Vec3f        eye_dir = p - eye_pos_;
+
+  float distance2     = eye_dir.sqrnorm();
+  float product_value = dot(eye_dir, node.normal());
+
+  for (int i=0; i<4; ++i)
+  {
+    if (frustum_plane_[i].signed_distance(p) < -node.radius())
+      return false;
+  }
+
+  if (product_value > 0 &&
+      product_value * product_value > distance2 * node.sin_square())
+    return false;
+
+  // screen-space error relative to the tolerance, refine if >= 1
+  float kd2 = kappa_square_ * distance2;
+  if (kd2 <= 0.0f)
+  {
+    _error = FLT_MAX;
+    return true;
+  }
+
+  _error = std::max(node.mue_square() / kd2,
+                    node.sigma_square() * (distance2 - product_value * product_value) /
+                    (kd2 * distance2));
+
+  return _error >= 1.0f;
+}
+
+
+void
+StreamingSession::
+enqueue(VHierarchyNodeHandle _node_handle)
+{
+  float error;
+
+  if (vhierarchy_.is_leaf_node(_node_handle) != true &&
+      qrefine(_node_handle, error) == true)
+    queue_.push(QueueEntry(error, _node_handle.idx()));
+}
+
+
+void
+StreamingSession::
+force_vsplit(VHierarchyNodeHandle _node_handle, std::ostream& _os, size_t& _n)
+{
+  VHierarchyNodeIndex
+    fund_lcut_index = vhierarchy_.fund_lcut_index(_node_handle),
+    fund_rcut_index = vhierarchy_.fund_rcut_index(_node_handle);
+
+  VHierarchyNodeHandle
+    lcut_handle = active_ancestor_handle(fund_lcut_index),
+    rcut_handle = active_ancestor_handle(fund_rcut_index);
+
+  while (lcut_handle.is_valid() && lcut_handle == rcut_handle)
+  {
+    force_vsplit(lcut_handle, _os, _n);
+    lcut_handle = active_ancestor_handle(fund_lcut_index);
+    rcut_handle = active_ancestor_handle(fund_rcut_index);
+  }
+
+  vsplit(_node_handle, _os, _n);
+}
+
+
+void
+StreamingSession::
+vsplit(VHierarchyNodeHandle _node_handle, std::ostream& _os, size_t& _n)
+{
+  VHierarchyNodeHandle
+    lchild_handle = vhierarchy_.lchild_handle(_node_handle),
+    rchild_handle = vhierarchy_.rchild_handle(_node_handle);
+
+  vhwindow_.inactivate(_node_handle);
+  vhwindow_.activate(lchild_handle);
+  vhwindow_.activate(rchild_handle);
+
+  if (compressed_)
+  {
+    VSplitRecord record;
+    model_.vsplit_record(_node_handle, record);
+    encoder_.encode(record);
+  }
+  else
+    model_.write_vsplit(_os, _node_handle);
+  ++_n;
+
+  enqueue(lchild_handle);
+  enqueue(rchild_handle);
+}
+
+
+VHierarchyNodeHandle
+StreamingSession::
+active_ancestor_handle(VHierarchyNodeIndex _node_index)
+{
+  if (_node_index.is_valid(vhierarchy_.tree_id_bits()) != true)
+    return InvalidVHierarchyNodeHandle;
+
+  VHierarchyNodeHandle node_handle = vhierarchy_.node_handle(_node_index);
+
+  while (node_handle.is_valid() && vhwindow_.is_active(node_handle) != true)
+    node_handle = vhierarchy_.parent_handle(node_handle);
+
+  return node_handle;
+}
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
@@ -0,0 +1,159 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS StreamingSession
+//
+//=============================================================================
+
+#ifndef OPENMESH_VDPROGMESH_STREAMINGSESSION_HH
+#define OPENMESH_VDPROGMESH_STREAMINGSESSION_HH
+
+
+//== INCLUDES =================================================================
+
+#include <queue>
+#include <vector>
+#include <utility>
+#include <iosfwd>
+#include <OpenMesh/Core/System/config.h>
+#include <OpenMesh/Core/Geometry/Plane3d.hh>
+#include <OpenMesh/Tools/VDPM/StreamingModel.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyWindow.hh>
+#include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
+#include <OpenMesh/Tools/VDPM/VSplitCoder.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== CLASS DEFINITION =========================================================
+
+
+/** State of one client of a VDPM streaming server.
+
+    The session keeps track of the vertex hierarchy nodes the client
+    currently has (a VHierarchyWindow on the shared StreamingModel) and
+    decides which vertex splits to send next. After
+    set_viewing_parameters() all active nodes which need refinement are
+    ordered by their screen-space error. next_batch() then emits vertex
+    splits, largest error first, until a byte limit is reached. The
+    vertex splits a split depends on are emitted before it, and the
+    children of a split node are queued again if they need refinement,
+    so a client converges to the same mesh as with sequential refinement
+    but sees the most visible detail first.
+
+    Sessions only read the model, several sessions may run concurrently
+    in different threads. A session itself is not thread-safe. It
+    performs no I/O: the server decides when to call next_batch(), for
+    example only while the client's send buffer is below a watermark.
+*/
+class OPENMESHDLLEXPORT StreamingSession
+{
+public:
+
+  explicit StreamingSession(StreamingModel& _model);
+
+  /// Back to the base mesh, e.g. after the client re-requested it.
+  void reset();
+
+  /** Emit vertex splits compressed by a VSplitEncoder (with the model's
+      quantization) instead of StreamingModel::write_vsplit(). The
+      encoder is flushed at the end of every batch. Resets the session.
+  */
+  void set_compressed(bool _compressed);
+  bool compressed() const { return compressed_; }
+
+  /// Reprioritizes the vertex splits for a new view.
+  void set_viewing_parameters(ViewingParameters& _viewing_parameters);
+
+  /** Writes vertex splits to _os until at least _max_bytes are written
+      or the view is fully refined.
+      \return the number of vertex splits written
+  */
+  size_t next_batch(size_t _max_bytes, std::ostream& _os);
+
+  /// True if no more vertex splits are needed for the current view
+  bool complete() const { return queue_.empty(); }
+
+  /// Vertex splits sent since the last reset()
+  size_t n_vsplits() const { return n_vsplits_; }
+
+private:
+
+  // disabled, the window owns a raw buffer
+  StreamingSession(const StreamingSession&);
+  StreamingSession& operator=(const StreamingSession&);
+
+  bool qrefine(VHierarchyNodeHandle _node_handle, float& _error);
+  void enqueue(VHierarchyNodeHandle _node_handle);
+  void force_vsplit(VHierarchyNodeHandle _node_handle, std::ostream& _os, size_t& _n);
+  void vsplit(VHierarchyNodeHandle _node_handle, std::ostream& _os, size_t& _n);
+  VHierarchyNodeHandle active_ancestor_handle(VHierarchyNodeIndex _node_index);
+
+private:
+
+  typedef std::pair<float, int>   QueueEntry;  // error, node handle
+
+  StreamingModel&                 model_;
+  VHierarchy&                     vhierarchy_;
+  VHierarchyWindow                vhwindow_;
+
+  Vec3f                           eye_pos_;
+  Plane3d                         frustum_plane_[4];
+  float                           kappa_square_;
+
+  std::priority_queue<QueueEntry> queue_;
+  size_t                          n_vsplits_;
+
+  bool                            compressed_;
+  VSplitEncoder                   encoder_;
+};
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
+#endif // OPENMESH_VDPROGMESH_STREAMINGSESSION_HH defined
+//=============================================================================
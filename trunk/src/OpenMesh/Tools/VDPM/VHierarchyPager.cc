@@ -0,0 +1,838 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS VHierarchyPager - IMPLEMENTATION
+//
+//=============================================================================
+
+
+//== INCLUDES =================================================================
+
+#include <algorithm>
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Core/Geometry/Plane3d.hh>
+#include <OpenMesh/Core/System/omstream.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyPager.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== IMPLEMENTATION ==========================================================
+
+
+namespace {
+
+const char          PagedMagic[]  = "VDPMPaged";
+const unsigned int  PagedVersion  = 1;
+
+// size of a VSplitRecord on disk
+const unsigned int  RecordSize    = 3*4 + 3*4 + 2*(4 + 3*4 + 3*4);
+
+// sizes of a base vertex (point and node parameters), a base face and a
+// directory entry on disk
+const unsigned int  VertexSize    = 3*4 + 4 + 3*4 + 3*4;
+const unsigned int  FaceSize      = 3*4;
+const unsigned int  BlockSize     = 4*4 + 3*4 + 4;
+
+
+// bytes from the current position to the end of the stream
+size_t remaining_bytes(std::istream& _is)
+{
+  const std::streampos start = _is.tellg();
+  _is.seekg(0, std::ios::end);
+  const std::streampos end = _is.tellg();
+  _is.seekg(start);
+
+  return (start < 0 || end < start) ? 0 : size_t(end - start);
+}
+
+
+void restore_params(std::istream& _is, VHierarchyNodeParams& _p, bool _swap)
+{
+  IO::restore(_is, _p.radius, _swap);
+  IO::restore(_is, _p.normal, _swap);
+  IO::restore(_is, _p.sin_square, _swap);
+  IO::restore(_is, _p.mue_square, _swap);
+  IO::restore(_is, _p.sigma_square, _swap);
+}
+
+void store_params(std::ostream& _os, const VHierarchyNodeParams& _p, bool _swap)
+{
+  IO::store(_os, _p.radius, _swap);
+  IO::store(_os, _p.normal, _swap);
+  IO::store(_os, _p.sin_square, _swap);
+  IO::store(_os, _p.mue_square, _swap);
+  IO::store(_os, _p.sigma_square, _swap);
+}
+
+void restore_record(std::istream& _is, VSplitRecord& _r, bool _swap)
+{
+  IO::restore(_is, _r.point, _swap);
+  IO::restore(_is, _r.node_index, _swap);
+  IO::restore(_is, _r.fund_lcut_index, _swap);
+  IO::restore(_is, _r.fund_rcut_index, _swap);
+  restore_params(_is, _r.lchild, _swap);
+  restore_params(_is, _r.rchild, _swap);
+}
+
+void store_record(std::ostream& _os, const VSplitRecord& _r, bool _swap)
+{
+  IO::store(_os, _r.point, _swap);
+  IO::store(_os, _r.node_index, _swap);
+  IO::store(_os, _r.fund_lcut_index, _swap);
+  IO::store(_os, _r.fund_rcut_index, _swap);
+  store_params(_os, _r.lchild, _swap);
+  store_params(_os, _r.rchild, _swap);
+}
+
+// same as VHierarchy::set_num_roots()
+unsigned char tree_id_bits(unsigned int _n_roots)
+{
+  unsigned char bits = 0;
+  while (_n_roots > ((unsigned int) 0x00000001 << bits))
+    ++bits;
+  return bits;
+}
+
+unsigned int bit_length(unsigned int _x)
+{
+  unsigned int n = 0;
+  for (; _x; _x >>= 1)
+    ++n;
+  return n;
+}
+
+// interleave the lower 10 bits of _x, _y, _z
+unsigned int morton_code(unsigned int _x, unsigned int _y, unsigned int _z)
+{
+  unsigned int code = 0;
+  for (unsigned int b=0; b<10; ++b)
+  {
+    code |= ((_x >> b) & 1u) << (3*b);
+    code |= ((_y >> b) & 1u) << (3*b+1);
+    code |= ((_z >> b) & 1u) << (3*b+2);
+  }
+  return code;
+}
+
+} // namespace
+
+
+//-----------------------------------------------------------------------------
+
+
+bool
+VHierarchyPager::Key::
+operator<(const Key& _other) const
+{
+  if (rank != _other.rank)
+    return rank < _other.rank;
+
+  // preorder: bring both ids to the same depth, an ancestor comes first
+  unsigned int a  = node_id;
+  unsigned int b  = _other.node_id;
+  unsigned int la = bit_length(a);
+  unsigned int lb = bit_length(b);
+
+  if (la < lb)
+  {
+    b >>= (lb - la);
+    return (a == b) ? true : (a < b);
+  }
+  if (la > lb)
+  {
+    a >>= (la - lb);
+    return (a == b) ? false : (a < b);
+  }
+  return a < b;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+VHierarchyPager::
+VHierarchyPager()
+  : swap_(false),
+    records_offset_(0),
+    n_base_vertices_(0),
+    n_base_faces_(0),
+    n_details_(0),
+    records_per_block_(0),
+    tree_id_bits_(0),
+    cache_size_(64),
+    n_hits_(0),
+    n_loads_(0)
+{
+}
+
+
+VHierarchyPager::
+~VHierarchyPager()
+{
+  close();
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+bool
+VHierarchyPager::
+convert(const std::string& _spm_filename,
+        const std::string& _paged_filename,
+        unsigned int       _records_per_block)
+{
+  unsigned int  i, n_base_vertices, n_base_faces, n_details;
+  char          c[11];
+
+  if (_records_per_block == 0)
+    return false;
+
+  std::ifstream ifs(_spm_filename.c_str(), std::ios::binary);
+  if (!ifs)
+    return false;
+
+  bool swap = Endian::local() != Endian::LSB;
+
+  ifs.read(c, 10); c[10] = '\0';
+  if (!ifs || std::string(c) != std::string("VDProgMesh"))
+    return false;
+
+  IO::restore(ifs, n_base_vertices, swap);
+  IO::restore(ifs, n_base_faces, swap);
+  IO::restore(ifs, n_details, swap);
+
+  // the counts must fit into the rest of the file, a corrupt header must
+  // not make the allocations fail
+  size_t size = remaining_bytes(ifs);
+
+  if (!ifs || n_base_vertices > size / VertexSize)
+    return false;
+  size -= VertexSize * size_t(n_base_vertices);
+  if (n_base_faces > size / FaceSize)
+    return false;
+  size -= FaceSize * size_t(n_base_faces);
+  if (n_details > size / RecordSize)
+    return false;
+
+  std::vector<Vec3f>                 points(n_base_vertices);
+  std::vector<VHierarchyNodeParams>  params(n_base_vertices);
+  std::vector<unsigned int>          faces(3*n_base_faces);
+  std::vector<VSplitRecord>          records(n_details);
+
+  for (i=0; i<n_base_vertices; ++i)
+  {
+    IO::restore(ifs, points[i], swap);
+    restore_params(ifs, params[i], swap);
+  }
+  for (i=0; i<3*n_base_faces; ++i)
+    IO::restore(ifs, faces[i], swap);
+  for (i=0; i<n_details; ++i)
+    restore_record(ifs, records[i], swap);
+
+  if (!ifs)
+    return false;
+  ifs.close();
+
+  // the faces and records index the base vertices
+  unsigned char bits = tree_id_bits(n_base_vertices);
+
+  for (i=0; i<3*n_base_faces; ++i)
+    if (faces[i] >= n_base_vertices)
+      return false;
+  for (i=0; i<n_details; ++i)
+  {
+    VHierarchyNodeIndex index(records[i].node_index);
+    if (!index.is_valid(bits) || index.tree_id(bits) >= n_base_vertices)
+      return false;
+  }
+
+
+  // order the trees along a Morton curve through their roots
+  Vec3f bb_min(0.0f, 0.0f, 0.0f), bb_max(0.0f, 0.0f, 0.0f);
+  if (n_base_vertices)
+    bb_min = bb_max = points[0];
+  for (i=0; i<n_base_vertices; ++i)
+  {
+    bb_min.minimize(points[i]);
+    bb_max.maximize(points[i]);
+  }
+
+  Vec3f extent = bb_max - bb_min;
+  float scale  = std::max(extent[0], std::max(extent[1], extent[2]));
+  scale = (scale > 0.0f) ? 1023.0f / scale : 0.0f;
+
+  std::vector< std::pair<unsigned int, unsigned int> > codes(n_base_vertices);
+  for (i=0; i<n_base_vertices; ++i)
+  {
+    Vec3f q = (points[i] - bb_min) * scale;
+    codes[i] = std::make_pair(morton_code((unsigned int) q[0],
+                                          (unsigned int) q[1],
+                                          (unsigned int) q[2]), i);
+  }
+  std::sort(codes.begin(), codes.end());
+
+  std::vector<unsigned int> tree_rank(n_base_vertices);
+  for (i=0; i<n_base_vertices; ++i)
+    tree_rank[codes[i].second] = i;
+
+
+  // sort the records by tree rank, then preorder within each tree
+  std::vector< std::pair<Key, unsigned int> > order(n_details);
+  for (i=0; i<n_details; ++i)
+  {
+    VHierarchyNodeIndex index(records[i].node_index);
+    order[i].first.rank    = tree_rank[index.tree_id(bits)];
+    order[i].first.node_id = index.node_id(bits);
+    order[i].second        = i;
+  }
+  std::sort(order.begin(), order.end());
+
+
+  // block directory
+  unsigned int n_blocks = (n_details + _records_per_block - 1) / _records_per_block;
+  std::vector<Block> blocks(n_blocks);
+
+  for (unsigned int b=0; b<n_blocks; ++b)
+  {
+    Block& block = blocks[b];
+    block.first        = order[b*_records_per_block].first;
+    block.first_record = b*_records_per_block;
+    block.n_records    = std::min(_records_per_block, n_details - block.first_record);
+
+    Vec3f center(0.0f, 0.0f, 0.0f);
+    for (i=0; i<block.n_records; ++i)
+      center += records[order[block.first_record+i].second].point;
+    center /= float(block.n_records);
+
+    float radius = 0.0f;
+    for (i=0; i<block.n_records; ++i)
+    {
+      const VSplitRecord& r = records[order[block.first_record+i].second];
+      radius = std::max(radius, (r.point - center).norm() +
+                        std::max(r.lchild.radius, r.rchild.radius));
+    }
+
+    block.center = center;
+    block.radius = radius;
+  }
+
+
+  // write paged file
+  std::ofstream ofs(_paged_filename.c_str(), std::ios::binary);
+  if (!ofs)
+    return false;
+
+  ofs.write(PagedMagic, sizeof(PagedMagic)-1);
+  IO::store(ofs, PagedVersion, swap);
+  IO::store(ofs, n_base_vertices, swap);
+  IO::store(ofs, n_base_faces, swap);
+  IO::store(ofs, n_details, swap);
+  IO::store(ofs, _records_per_block, swap);
+  IO::store(ofs, n_blocks, swap);
+
+  for (i=0; i<n_base_vertices; ++i)
+  {
+    IO::store(ofs, points[i], swap);
+    store_params(ofs, params[i], swap);
+  }
+  for (i=0; i<3*n_base_faces; ++i)
+    IO::store(ofs, faces[i], swap);
+  for (i=0; i<n_base_vertices; ++i)
+    IO::store(ofs, tree_rank[i], swap);
+
+  for (unsigned int b=0; b<n_blocks; ++b)
+  {
+    IO::store(ofs, blocks[b].first.rank, swap);
+    IO::store(ofs, blocks[b].first.node_id, swap);
+    IO::store(ofs, blocks[b].first_record, swap);
+    IO::store(ofs, blocks[b].n_records, swap);
+    IO::store(ofs, blocks[b].center, swap);
+    IO::store(ofs, blocks[b].radius, swap);
+  }
+
+  for (i=0; i<n_details; ++i)
+    store_record(ofs, records[order[i].second], swap);
+
+  return ofs.good();
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+bool
+VHierarchyPager::
+open(const std::string& _filename)
+{
+  unsigned int  i, version, n_blocks;
+  char          c[sizeof(PagedMagic)];
+
+  close();
+
+  ifs_.open(_filename.c_str(), std::ios::binary);
+  if (!ifs_)
+    return false;
+
+  swap_ = Endian::local() != Endian::LSB;
+
+  ifs_.read(c, sizeof(PagedMagic)-1); c[sizeof(PagedMagic)-1] = '\0';
+  if (!ifs_ || std::string(c) != std::string(PagedMagic))
+  {
+    close();
+    return false;
+  }
+
+  IO::restore(ifs_, version, swap_);
+  if (version != PagedVersion)
+  {
+    close();
+    return false;
+  }
+
+  IO::restore(ifs_, n_base_vertices_, swap_);
+  IO::restore(ifs_, n_base_faces_, swap_);
+  IO::restore(ifs_, n_details_, swap_);
+  IO::restore(ifs_, records_per_block_, swap_);
+  IO::restore(ifs_, n_blocks, swap_);
+
+  // the counts of the base mesh and the directory must fit into the rest
+  // of the file and agree with each other, a corrupt header must not make
+  // the allocations fail
+  size_t size = remaining_bytes(ifs_);
+
+  if (!ifs_ || records_per_block_ == 0 ||
+      n_blocks != n_details_ / records_per_block_ +
+                  (n_details_ % records_per_block_ ? 1 : 0) ||
+      n_base_vertices_ > size / (VertexSize + 4))
+  {
+    close();
+    return false;
+  }
+  size -= (VertexSize + 4) * size_t(n_base_vertices_);   // and tree ranks
+  if (n_base_faces_ > size / FaceSize)
+  {
+    close();
+    return false;
+  }
+  size -= FaceSize * size_t(n_base_faces_);
+  if (n_blocks > size / BlockSize)
+  {
+    close();
+    return false;
+  }
+
+  // the records are read on demand, load_block() detects a truncated file
+
+  tree_id_bits_ = tree_id_bits(n_base_vertices_);
+
+  base_points_.resize(n_base_vertices_);
+  base_params_.resize(n_base_vertices_);
+  base_faces_.resize(3*n_base_faces_);
+  tree_rank_.resize(n_base_vertices_);
+  blocks_.resize(n_blocks);
+
+  for (i=0; i<n_base_vertices_; ++i)
+  {
+    IO::restore(ifs_, base_points_[i], swap_);
+    restore_params(ifs_, base_params_[i], swap_);
+  }
+  for (i=0; i<3*n_base_faces_; ++i)
+    IO::restore(ifs_, base_faces_[i], swap_);
+  for (i=0; i<n_base_vertices_; ++i)
+    IO::restore(ifs_, tree_rank_[i], swap_);
+
+  for (i=0; i<n_blocks; ++i)
+  {
+    IO::restore(ifs_, blocks_[i].first.rank, swap_);
+    IO::restore(ifs_, blocks_[i].first.node_id, swap_);
+    IO::restore(ifs_, blocks_[i].first_record, swap_);
+    IO::restore(ifs_, blocks_[i].n_records, swap_);
+    IO::restore(ifs_, blocks_[i].center, swap_);
+    IO::restore(ifs_, blocks_[i].radius, swap_);
+  }
+
+  if (!ifs_)
+  {
+    close();
+    return false;
+  }
+
+  // the faces index the base vertices, the blocks the records
+  for (i=0; i<3*n_base_faces_; ++i)
+    if (base_faces_[i] >= n_base_vertices_)
+    {
+      close();
+      return false;
+    }
+  for (i=0; i<n_blocks; ++i)
+    if (blocks_[i].n_records > records_per_block_ ||
+        blocks_[i].first_record > n_details_ - blocks_[i].n_records)
+    {
+      close();
+      return false;
+    }
+
+  records_offset_ = ifs_.tellg();
+  return true;
+}
+
+
+void
+VHierarchyPager::
+close()
+{
+  if (ifs_.is_open())
+    ifs_.close();
+  ifs_.clear();
+
+  n_base_vertices_ = n_base_faces_ = n_details_ = records_per_block_ = 0;
+  tree_id_bits_    = 0;
+  records_offset_  = 0;
+
+  base_points_.clear();
+  base_params_.clear();
+  base_faces_.clear();
+  tree_rank_.clear();
+  blocks_.clear();
+
+  cache_.clear();
+  lru_.clear();
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+void
+VHierarchyPager::
+init_hierarchy(VHierarchy& _vhierarchy) const
+{
+  _vhierarchy.clear();
+  _vhierarchy.set_num_roots(n_base_vertices_);
+
+  for (unsigned int i=0; i<n_base_vertices_; ++i)
+  {
+    VHierarchyNodeHandle  node_handle = _vhierarchy.add_node();
+    VHierarchyNode&       node        = _vhierarchy.node(node_handle);
+    const VHierarchyNodeParams& params = base_params_[i];
+
+    node.set_index(_vhierarchy.generate_node_index(i, 1));
+    node.set_radius(params.radius);
+    node.set_normal(params.normal);
+    node.set_sin_square(params.sin_square);
+    node.set_mue_square(params.mue_square);
+    node.set_sigma_square(params.sigma_square);
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+VHierarchyPager::Key
+VHierarchyPager::
+key(VHierarchyNodeIndex _node_index) const
+{
+  Key k;
+  k.rank    = tree_rank_[_node_index.tree_id(tree_id_bits_)];
+  k.node_id = _node_index.node_id(tree_id_bits_);
+  return k;
+}
+
+
+int
+VHierarchyPager::
+find_block(const Key& _key) const
+{
+  // last block whose first key is not greater than _key
+  int lo = 0, hi = (int) blocks_.size();
+  while (lo < hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (_key < blocks_[mid].first)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo - 1;
+}
+
+
+const VHierarchyPager::CacheEntry*
+VHierarchyPager::
+load_block(unsigned int _block, bool _count_hit)
+{
+  Cache::iterator c_it = cache_.find(_block);
+  if (c_it != cache_.end())
+  {
+    lru_.splice(lru_.begin(), lru_, c_it->second.lru_it);
+    if (_count_hit)
+      ++n_hits_;
+    return &c_it->second;
+  }
+
+  while (!lru_.empty() && cache_.size() >= cache_size_)
+  {
+    cache_.erase(lru_.back());
+    lru_.pop_back();
+  }
+
+  const Block& block = blocks_[_block];
+  CacheEntry&  entry = cache_[_block];
+
+  entry.records.resize(block.n_records);
+  ifs_.clear();
+  ifs_.seekg(records_offset_ + std::streamoff(block.first_record) * RecordSize);
+  for (unsigned int i=0; i<block.n_records; ++i)
+    restore_record(ifs_, entry.records[i], swap_);
+
+  // never cache the records of a truncated or unreadable file, their
+  // tree ids index the base vertices
+  bool ok = !ifs_.fail();
+  for (unsigned int i=0; ok && i<block.n_records; ++i)
+  {
+    VHierarchyNodeIndex index(entry.records[i].node_index);
+    ok = index.is_valid(tree_id_bits_) &&
+         index.tree_id(tree_id_bits_) < n_base_vertices_;
+  }
+
+  if (!ok)
+  {
+    omerr() << "VHierarchyPager: cannot read block " << _block << std::endl;
+    cache_.erase(_block);
+    return NULL;
+  }
+
+  lru_.push_front(_block);
+  entry.lru_it = lru_.begin();
+  ++n_loads_;
+
+  return &entry;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+bool
+VHierarchyPager::
+vsplit(VHierarchyNodeIndex _node_index, VSplitRecord& _record)
+{
+  if (!is_open() || !_node_index.is_valid(tree_id_bits_) ||
+      _node_index.tree_id(tree_id_bits_) >= n_base_vertices_)
+    return false;
+
+  Key k     = key(_node_index);
+  int block = find_block(k);
+  if (block < 0)
+    return false;
+
+  const CacheEntry* entry = load_block(block, true);
+  if (!entry)
+    return false;
+
+  const std::vector<VSplitRecord>& records = entry->records;
+
+  int lo = 0, hi = (int) records.size();
+  while (lo < hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (key(VHierarchyNodeIndex(records[mid].node_index)) < k)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (lo == (int) records.size() ||
+      records[lo].node_index != _node_index.value())
+    return false;
+
+  _record = records[lo];
+  return true;
+}
+
+
+bool
+VHierarchyPager::
+make_children(VHierarchy&          _vhierarchy,
+              VHierarchyNodeHandle _node_handle,
+              Vec3f&               _point)
+{
+  VSplitRecord record;
+
+  if (!vsplit(_vhierarchy.node_index(_node_handle), record))
+    return false;
+
+  if (_vhierarchy.is_leaf_node(_node_handle))
+    _vhierarchy.make_children(_node_handle);
+
+  VHierarchyNodeHandle children[2] = { _vhierarchy.lchild_handle(_node_handle),
+                                       _vhierarchy.rchild_handle(_node_handle) };
+  const VHierarchyNodeParams* params[2] = { &record.lchild, &record.rchild };
+
+  for (int i=0; i<2; ++i)
+  {
+    VHierarchyNode& child = _vhierarchy.node(children[i]);
+    child.set_radius(params[i]->radius);
+    child.set_normal(params[i]->normal);
+    child.set_sin_square(params[i]->sin_square);
+    child.set_mue_square(params[i]->mue_square);
+    child.set_sigma_square(params[i]->sigma_square);
+  }
+
+  _vhierarchy.fund_lcut_index(_node_handle) = VHierarchyNodeIndex(record.fund_lcut_index);
+  _vhierarchy.fund_rcut_index(_node_handle) = VHierarchyNodeIndex(record.fund_rcut_index);
+
+  _point = record.point;
+  return true;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+size_t
+VHierarchyPager::
+prefetch(ViewingParameters& _viewing_parameters)
+{
+  if (!is_open())
+    return 0;
+
+  Plane3d frustum_plane[4];
+  _viewing_parameters.frustum_planes(frustum_plane);
+
+  const Vec3f& eye_pos = _viewing_parameters.eye_pos();
+
+  std::vector< std::pair<float, unsigned int> > visible;
+  for (unsigned int b=0; b<blocks_.size(); ++b)
+  {
+    const Block& block = blocks_[b];
+    bool outside = false;
+    for (int i=0; i<4 && !outside; ++i)
+      outside = frustum_plane[i].signed_distance(block.center) < -block.radius;
+
+    if (!outside)
+      visible.push_back(std::make_pair((block.center - eye_pos).norm() - block.radius, b));
+  }
+  std::sort(visible.begin(), visible.end());
+
+  // load farthest first, so the nearest blocks end up most recently used
+  size_t n      = std::min(visible.size(), cache_size_);
+  size_t loaded = 0;
+  for (size_t i=n; i>0; --i)
+  {
+    size_t before = n_loads_;
+    load_block(visible[i-1].second, false);
+    loaded += n_loads_ - before;
+  }
+  return loaded;
+}
+
+
+size_t
+VHierarchyPager::
+prefetch(VHierarchy& _vhierarchy, VFront& _vfront)
+{
+  if (!is_open())
+    return 0;
+
+  // blocks of all front nodes that can still be split, in front order
+  std::vector<unsigned int> needed;
+  std::vector<bool>         marked(blocks_.size(), false);
+
+  for (_vfront.begin(); !_vfront.end() && needed.size() < cache_size_; _vfront.next())
+  {
+    VHierarchyNodeHandle node_handle = _vfront.node_handle();
+    if (!_vhierarchy.is_leaf_node(node_handle))
+      continue;
+
+    VHierarchyNodeIndex node_index = _vhierarchy.node_index(node_handle);
+    if (!node_index.is_valid(tree_id_bits_) ||
+        node_index.tree_id(tree_id_bits_) >= n_base_vertices_)
+      continue;
+
+    int block = find_block(key(node_index));
+    if (block >= 0 && !marked[block])
+    {
+      marked[block] = true;
+      needed.push_back(block);
+    }
+  }
+
+  size_t loaded = 0;
+  for (size_t i=needed.size(); i>0; --i)
+  {
+    size_t before = n_loads_;
+    load_block(needed[i-1], false);
+    loaded += n_loads_ - before;
+  }
+  return loaded;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+void
+VHierarchyPager::
+set_cache_size(size_t _n_blocks)
+{
+  cache_size_ = std::max(_n_blocks, size_t(1));
+
+  while (cache_.size() > cache_size_)
+  {
+    cache_.erase(lru_.back());
+    lru_.pop_back();
+  }
+}
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
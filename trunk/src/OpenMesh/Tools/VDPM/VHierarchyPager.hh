@@ -0,0 +1,267 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS VHierarchyPager
+//
+//=============================================================================
+
+#ifndef OPENMESH_VDPROGMESH_VHIERARCHYPAGER_HH
+#define OPENMESH_VDPROGMESH_VHIERARCHYPAGER_HH
+
+
+//== INCLUDES =================================================================
+
+#include <vector>
+#include <list>
+#include <map>
+#include <string>
+#include <fstream>
+#include <OpenMesh/Core/System/config.h>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchy.hh>
+#include <OpenMesh/Tools/VDPM/VSplitRecord.hh>
+#include <OpenMesh/Tools/VDPM/VFront.hh>
+#include <OpenMesh/Tools/VDPM/ViewingParameters.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== CLASS DEFINITION =========================================================
+
+
+/** Out-of-core access to the vertex hierarchy of a view-dependent
+    progressive mesh.
+
+    convert() rewrites a .spm file (as written by vdpmanalyzer) into a
+    paged file: the base mesh, followed by the vertex split records
+    grouped into fixed size blocks. Trees of the hierarchy are ordered
+    along a Morton curve through their root positions and the nodes of
+    each tree are stored in preorder, hence every block covers a
+    spatially coherent part of the model. Each block carries a bounding
+    sphere, so the blocks needed for a view can be determined without
+    touching the records.
+
+    After open() only the base mesh and the block directory are kept in
+    memory. vsplit() pages in the block holding a node's record on
+    demand; at most cache_size() blocks are held at a time, the least
+    recently used one is dropped first. prefetch() loads the blocks
+    needed by the current view or by the active front ahead of
+    refinement.
+
+    \code
+    VHierarchyPager::convert("city.spm", "city.pspm");
+
+    VHierarchyPager pager;
+    pager.open("city.pspm");
+    pager.set_cache_size(1024);
+    pager.init_hierarchy(vhierarchy);
+    ...
+    pager.prefetch(viewing_parameters);
+    if (pager.make_children(vhierarchy, node_handle, point))
+      ...  // perform the vertex split on the mesh
+    \endcode
+*/
+class OPENMESHDLLEXPORT VHierarchyPager
+{
+public:
+
+  VHierarchyPager();
+  ~VHierarchyPager();
+
+  /** Converts a .spm file into a paged file holding _records_per_block
+      vertex splits per block. The conversion is done in memory.
+      \return false if the input could not be read or the output written.
+  */
+  static bool convert(const std::string& _spm_filename,
+                      const std::string& _paged_filename,
+                      unsigned int       _records_per_block = 256);
+
+  /// Opens a paged file and reads its base mesh and block directory.
+  bool open(const std::string& _filename);
+
+  /// Closes the file and drops all cached blocks.
+  void close();
+
+  bool is_open() const { return ifs_.is_open(); }
+
+public: // base mesh
+
+  unsigned int n_base_vertices() const { return n_base_vertices_; }
+  unsigned int n_base_faces() const    { return n_base_faces_; }
+  unsigned int n_details() const       { return n_details_; }
+
+  /// Position of base vertex _i
+  const Vec3f& base_point(unsigned int _i) const { return base_points_[_i]; }
+
+  /// Refinement parameters of the root node of tree _i
+  const VHierarchyNodeParams& base_params(unsigned int _i) const
+  { return base_params_[_i]; }
+
+  /// Vertex indices of base face _i (3 entries starting at the returned pointer)
+  const unsigned int* base_face(unsigned int _i) const
+  { return &base_faces_[3*_i]; }
+
+  /** Sets up the roots of _vhierarchy from the base mesh. Vertex handles
+      are left for the caller to assign.
+  */
+  void init_hierarchy(VHierarchy& _vhierarchy) const;
+
+public: // vertex splits
+
+  /** Looks up the vertex split of node _node_index, paging in its block
+      if necessary.
+      \return false if the node is a leaf of the hierarchy or its block
+      cannot be read.
+  */
+  bool vsplit(VHierarchyNodeIndex _node_index, VSplitRecord& _record);
+
+  /** Creates the children of _node_handle in _vhierarchy if they do not
+      exist yet and sets their refinement parameters and the fundamental
+      cut of the parent from the paged record. _point receives the
+      position of the left child vertex.
+      \return false if the node is a leaf of the hierarchy.
+  */
+  bool make_children(VHierarchy&          _vhierarchy,
+                     VHierarchyNodeHandle _node_handle,
+                     Vec3f&               _point);
+
+  /** Loads the blocks intersecting the view frustum, nearest to the eye
+      first, until the cache is full.
+      \return the number of blocks read from disk.
+  */
+  size_t prefetch(ViewingParameters& _viewing_parameters);
+
+  /** Loads the blocks holding the vertex splits of the nodes on the
+      active front, until the cache is full.
+      \return the number of blocks read from disk.
+  */
+  size_t prefetch(VHierarchy& _vhierarchy, VFront& _vfront);
+
+public: // cache
+
+  /// Sets the maximal number of blocks held in memory (at least one).
+  void set_cache_size(size_t _n_blocks);
+
+  size_t cache_size() const           { return cache_size_; }
+  size_t n_cached_blocks() const      { return cache_.size(); }
+  unsigned int n_blocks() const       { return (unsigned int) blocks_.size(); }
+  unsigned int records_per_block() const { return records_per_block_; }
+
+  /// Number of lookups served from the cache
+  size_t n_hits() const               { return n_hits_; }
+
+  /// Number of blocks read from disk
+  size_t n_loads() const              { return n_loads_; }
+
+  void reset_statistics()             { n_hits_ = n_loads_ = 0; }
+
+private:
+
+  /// Position of a record in the file: tree rank, then preorder in the tree
+  struct Key
+  {
+    unsigned int rank;
+    unsigned int node_id;
+
+    bool operator<(const Key& _other) const;
+  };
+
+  struct Block
+  {
+    Key           first;
+    unsigned int  first_record;
+    unsigned int  n_records;
+    Vec3f         center;
+    float         radius;
+  };
+
+  typedef std::list<unsigned int>     LRUList;
+
+  struct CacheEntry
+  {
+    std::vector<VSplitRecord> records;
+    LRUList::iterator         lru_it;
+  };
+
+  typedef std::map<unsigned int, CacheEntry>  Cache;
+
+  Key key(VHierarchyNodeIndex _node_index) const;
+  int find_block(const Key& _key) const;
+  // NULL if the block cannot be read
+  const CacheEntry* load_block(unsigned int _block, bool _count_hit);
+
+private:
+
+  std::ifstream                       ifs_;
+  bool                                swap_;
+  std::streamoff                      records_offset_;
+
+  unsigned int                        n_base_vertices_;
+  unsigned int                        n_base_faces_;
+  unsigned int                        n_details_;
+  unsigned int                        records_per_block_;
+  unsigned char                       tree_id_bits_;
+
+  std::vector<Vec3f>                  base_points_;
+  std::vector<VHierarchyNodeParams>   base_params_;
+  std::vector<unsigned int>           base_faces_;
+  std::vector<unsigned int>           tree_rank_;
+  std::vector<Block>                  blocks_;
+
+  size_t                              cache_size_;
+  Cache                               cache_;
+  LRUList                             lru_;
+
+  size_t                              n_hits_;
+  size_t                              n_loads_;
+};
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
+#endif // OPENMESH_VDPROGMESH_VHIERARCHYPAGER_HH defined
+//=============================================================================
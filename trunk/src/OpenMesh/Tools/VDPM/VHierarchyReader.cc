@@ -0,0 +1,227 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS VHierarchyReader - IMPLEMENTATION
+//
+//=============================================================================
+
+
+//== INCLUDES =================================================================
+
+#include <cstring>
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyReader.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== IMPLEMENTATION ==========================================================
+
+
+VHierarchyReader::
+VHierarchyReader()
+  : compressed_(false),
+    swap_(Endian::local() != Endian::LSB),
+    n_base_vertices_(0),
+    n_base_faces_(0),
+    n_details_(0),
+    n_read_base_vertices_(0),
+    n_read_details_(0)
+{
+}
+
+
+bool
+VHierarchyReader::
+open(const std::string& _filename)
+{
+  char fileformat[16];
+
+  close();
+
+  ifs_.open(_filename.c_str(), std::ios::binary);
+  if (!ifs_)
+    return false;
+
+  // "VDProgMesh" or "VDPMCoded"
+  ifs_.read(fileformat, 9); fileformat[9] = '\0';
+  if (!ifs_)
+    return false;
+
+  if (strcmp(fileformat, "VDPMCoded") == 0)
+  {
+    unsigned int        version;
+    VSplitQuantization  q;
+
+    IO::restore(ifs_, version, swap_);
+    if (version != 1)
+      return false;
+
+    IO::restore(ifs_, n_base_vertices_, swap_);
+    IO::restore(ifs_, n_base_faces_, swap_);
+    IO::restore(ifs_, n_details_, swap_);
+    IO::restore(ifs_, q.bb_min, swap_);
+    IO::restore(ifs_, q.bb_size, swap_);
+    IO::restore(ifs_, q.position_bits, swap_);
+    IO::restore(ifs_, q.normal_bits, swap_);
+
+    if (q.position_bits > 30 || q.normal_bits > 15)
+      return false;
+
+    compressed_ = true;
+    decoder_.reset(n_base_vertices_, q);
+  }
+  else
+  {
+    fileformat[9]  = (char) ifs_.get();
+    fileformat[10] = '\0';
+    if (strcmp(fileformat, "VDProgMesh") != 0)
+      return false;
+
+    IO::restore(ifs_, n_base_vertices_, swap_);
+    IO::restore(ifs_, n_base_faces_, swap_);
+    IO::restore(ifs_, n_details_, swap_);
+  }
+
+  return ifs_.good();
+}
+
+
+void
+VHierarchyReader::
+close()
+{
+  if (ifs_.is_open())
+    ifs_.close();
+  ifs_.clear();
+
+  compressed_           = false;
+  n_base_vertices_      = 0;
+  n_base_faces_         = 0;
+  n_details_            = 0;
+  n_read_base_vertices_ = 0;
+  n_read_details_       = 0;
+}
+
+
+bool
+VHierarchyReader::
+read_base_vertex(Vec3f& _point, VHierarchyNodeParams& _params)
+{
+  IO::restore(ifs_, _point, swap_);
+  IO::restore(ifs_, _params.radius, swap_);
+  IO::restore(ifs_, _params.normal, swap_);
+  IO::restore(ifs_, _params.sin_square, swap_);
+  IO::restore(ifs_, _params.mue_square, swap_);
+  IO::restore(ifs_, _params.sigma_square, swap_);
+
+  if (compressed_)
+    decoder_.add_root(n_read_base_vertices_, _point, _params);
+  ++n_read_base_vertices_;
+
+  return ifs_.good();
+}
+
+
+bool
+VHierarchyReader::
+read_base_face(unsigned int _fvi[3])
+{
+  IO::restore(ifs_, _fvi[0], swap_);
+  IO::restore(ifs_, _fvi[1], swap_);
+  IO::restore(ifs_, _fvi[2], swap_);
+
+  return ifs_.good();
+}
+
+
+bool
+VHierarchyReader::
+read_vsplit(VSplitRecord& _record)
+{
+  if (n_read_details_ >= n_details_)
+    return false;
+
+  if (compressed_)
+  {
+    if (n_read_details_ == 0)
+      decoder_.begin(ifs_);
+
+    if (!decoder_.decode(_record))
+      return false;
+
+    if (++n_read_details_ == n_details_)
+      decoder_.end();
+
+    return true;
+  }
+
+  VHierarchyNodeParams* children[2] = { &_record.lchild, &_record.rchild };
+
+  IO::restore(ifs_, _record.point, swap_);
+  IO::restore(ifs_, _record.node_index, swap_);
+  IO::restore(ifs_, _record.fund_lcut_index, swap_);
+  IO::restore(ifs_, _record.fund_rcut_index, swap_);
+
+  for (int c=0; c<2; ++c)
+  {
+    IO::restore(ifs_, children[c]->radius, swap_);
+    IO::restore(ifs_, children[c]->normal, swap_);
+    IO::restore(ifs_, children[c]->sin_square, swap_);
+    IO::restore(ifs_, children[c]->mue_square, swap_);
+    IO::restore(ifs_, children[c]->sigma_square, swap_);
+  }
+
+  ++n_read_details_;
+
+  return ifs_.good();
+}
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
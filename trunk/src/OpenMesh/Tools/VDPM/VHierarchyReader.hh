@@ -0,0 +1,135 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASS VHierarchyReader
+//
+//=============================================================================
+
+#ifndef OPENMESH_VDPROGMESH_VHIERARCHYREADER_HH
+#define OPENMESH_VDPROGMESH_VHIERARCHYREADER_HH
+
+
+//== INCLUDES =================================================================
+
+#include <string>
+#include <fstream>
+#include <OpenMesh/Core/System/config.h>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+#include <OpenMesh/Tools/VDPM/VSplitRecord.hh>
+#include <OpenMesh/Tools/VDPM/VSplitCoder.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== CLASS DEFINITION =========================================================
+
+
+/** Sequential reader of view-dependent progressive meshes, either .spm
+    files as written by vdpmanalyzer or compressed files as written by
+    VSplitEncoder::compress().
+
+    After open() the base vertices, the base faces and the vertex splits
+    have to be read in this order. Compressed vertex splits are decoded
+    one at a time while reading, the whole hierarchy is never held in
+    memory by the reader.
+
+    The compressed format starts with the magic "VDPMCoded", a version,
+    the number of base vertices, base faces and details and the
+    VSplitQuantization. The base mesh follows as in a .spm file, then
+    the range coded vertex splits.
+*/
+class OPENMESHDLLEXPORT VHierarchyReader
+{
+public:
+
+  VHierarchyReader();
+
+  /// Opens a .spm or compressed file and reads its header.
+  bool open(const std::string& _filename);
+
+  void close();
+
+  bool is_open() const       { return ifs_.is_open(); }
+  bool is_compressed() const { return compressed_; }
+
+  unsigned int n_base_vertices() const { return n_base_vertices_; }
+  unsigned int n_base_faces() const    { return n_base_faces_; }
+  unsigned int n_details() const       { return n_details_; }
+
+  /// Quantization of a compressed file
+  const VSplitQuantization& quantization() const
+  { return decoder_.quantization(); }
+
+  /// Reads the next base vertex.
+  bool read_base_vertex(Vec3f& _point, VHierarchyNodeParams& _params);
+
+  /// Reads the vertex indices of the next base face.
+  bool read_base_face(unsigned int _fvi[3]);
+
+  /// Reads (and decodes) the next vertex split.
+  bool read_vsplit(VSplitRecord& _record);
+
+private:
+
+  std::ifstream   ifs_;
+  bool            compressed_;
+  bool            swap_;
+
+  unsigned int    n_base_vertices_;
+  unsigned int    n_base_faces_;
+  unsigned int    n_details_;
+  unsigned int    n_read_base_vertices_;
+  unsigned int    n_read_details_;
+
+  VSplitDecoder   decoder_;
+};
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
+#endif // OPENMESH_VDPROGMESH_VHIERARCHYREADER_HH defined
+//=============================================================================
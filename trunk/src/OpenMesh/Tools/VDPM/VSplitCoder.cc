@@ -0,0 +1,808 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASSES VSplitEncoder, VSplitDecoder - IMPLEMENTATION
+//
+//=============================================================================
+
+
+//== INCLUDES =================================================================
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Tools/VDPM/VSplitCoder.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyReader.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== IMPLEMENTATION ==========================================================
+
+
+// adaptive binary range coder with 11 bit probabilities (as in LZMA)
+static const unsigned int   ProbBits     = 11;
+static const unsigned int   ProbInit     = 1 << (ProbBits - 1);
+static const unsigned int   ProbMoveBits = 5;
+static const unsigned int   RangeTop     = 1 << 24;
+static const int            MaxQuantized = 1 << 30;
+
+// radius and error bounds are quantized in 1/16 octaves
+static const float          LogSteps     = 16.0f;
+
+
+static int clamp(float _f, int _max)
+{
+  if (!(_f > 0.0f))
+    return 0;
+  return _f >= (float) _max ? _max : (int) _f;
+}
+
+
+static float sign(float _f)
+{
+  return _f < 0.0f ? -1.0f : 1.0f;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+VSplitCoder::IntModel::
+IntModel()
+{
+  std::fill(length, length+64, (unsigned short) ProbInit);
+  std::fill(mantissa, mantissa+33, (unsigned short) ProbInit);
+}
+
+
+VSplitCoder::
+VSplitCoder()
+  : position_scale_(1.0f),
+    unit_scale_(1.0f),
+    tree_id_bits_(0),
+    last_tree_id_(0)
+{
+}
+
+
+void
+VSplitCoder::
+reset(unsigned int _n_roots, const VSplitQuantization& _quantization)
+{
+  quantization_   = _quantization;
+  position_scale_ = float((1u << quantization_.position_bits) - 1) /
+                    (quantization_.bb_size > 0.0f ? quantization_.bb_size : 1.0f);
+  unit_scale_     = float((1u << quantization_.normal_bits) - 1);
+
+  // same as VHierarchy::set_num_roots()
+  tree_id_bits_ = 0;
+  while (_n_roots > (1u << tree_id_bits_))
+    ++tree_id_bits_;
+
+  nodes_.clear();
+  last_tree_id_ = 0;
+
+  for (int i=0; i<NumFields; ++i)
+    models_[i] = IntModel();
+}
+
+
+void
+VSplitCoder::
+add_root(unsigned int                _tree_id,
+         const Vec3f&                _point,
+         const VHierarchyNodeParams& _params)
+{
+  quantize(_point, _params, nodes_[make_index(_tree_id, 1)]);
+}
+
+
+VSplitQuantization
+VSplitCoder::
+quantization(const Vec3f&  _bb_min,
+             const Vec3f&  _bb_max,
+             unsigned int  _position_bits,
+             unsigned int  _normal_bits)
+{
+  VSplitQuantization q;
+  Vec3f              d = _bb_max - _bb_min;
+
+  q.bb_min        = _bb_min;
+  q.bb_size       = std::max(d[0], std::max(d[1], d[2]));
+  q.position_bits = std::min(_position_bits, 30u);
+  q.normal_bits   = std::min(_normal_bits, 15u);
+
+  return q;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+void
+VSplitCoder::
+quantize(const Vec3f& _point, const VHierarchyNodeParams& _params,
+         QNode& _q) const
+{
+  int max_position = (1 << quantization_.position_bits) - 1;
+  int max_unit     = (1 << quantization_.normal_bits) - 1;
+
+  for (int i=0; i<3; ++i)
+    _q.point[i] = clamp((_point[i] - quantization_.bb_min[i]) * position_scale_
+                        + 0.5f, max_position);
+
+  // octahedral mapping of the normal
+  const Vec3f& n  = _params.normal;
+  float        l1 = fabs(n[0]) + fabs(n[1]) + fabs(n[2]);
+  float        u  = l1 > 0.0f ? n[0] / l1 : 0.0f;
+  float        v  = l1 > 0.0f ? n[1] / l1 : 0.0f;
+
+  if (n[2] < 0.0f)
+  {
+    float uu = (1.0f - fabs(v)) * sign(u);
+    v        = (1.0f - fabs(u)) * sign(v);
+    u        = uu;
+  }
+
+  _q.normal[0] = clamp((u * 0.5f + 0.5f) * unit_scale_ + 0.5f, max_unit);
+  _q.normal[1] = clamp((v * 0.5f + 0.5f) * unit_scale_ + 0.5f, max_unit);
+
+  // conservative: round up
+  _q.radius     = quantize_log(_params.radius);
+  _q.sin_square = clamp(ceil(_params.sin_square * unit_scale_), max_unit);
+  _q.mue        = quantize_log(sqrt(std::max(_params.mue_square, 0.0f)));
+  _q.sigma      = quantize_log(sqrt(std::max(_params.sigma_square, 0.0f)));
+}
+
+
+int
+VSplitCoder::
+quantize_log(float _f) const
+{
+  // 0 is reserved for 0, everything below one grid cell is rounded up to it
+  float f = _f * position_scale_;
+  if (!(f > 0.0f))
+    return 0;
+
+  return 1 + clamp(ceil(LogSteps * log(f) / log(2.0f) + 1e-3f), MaxQuantized);
+}
+
+
+float
+VSplitCoder::
+dequantize_log(int _q) const
+{
+  return _q == 0 ? 0.0f : pow(2.0f, (_q-1) / LogSteps) / position_scale_;
+}
+
+
+void
+VSplitCoder::
+dequantize(const QNode& _q, VHierarchyNodeParams& _params) const
+{
+  float u = _q.normal[0] / unit_scale_ * 2.0f - 1.0f;
+  float v = _q.normal[1] / unit_scale_ * 2.0f - 1.0f;
+  float w = 1.0f - fabs(u) - fabs(v);
+
+  if (w < 0.0f)
+  {
+    float uu = (1.0f - fabs(v)) * sign(u);
+    v        = (1.0f - fabs(u)) * sign(v);
+    u        = uu;
+  }
+
+  _params.normal = Vec3f(u, v, w);
+  _params.normal.normalize();
+
+  float mue   = dequantize_log(_q.mue);
+  float sigma = dequantize_log(_q.sigma);
+
+  _params.radius       = dequantize_log(_q.radius);
+  _params.sin_square   = _q.sin_square / unit_scale_;
+  _params.mue_square   = mue * mue;
+  _params.sigma_square = sigma * sigma;
+}
+
+
+Vec3f
+VSplitCoder::
+dequantize_point(const int _q[3]) const
+{
+  return Vec3f(quantization_.bb_min[0] + _q[0] / position_scale_,
+               quantization_.bb_min[1] + _q[1] / position_scale_,
+               quantization_.bb_min[2] + _q[2] / position_scale_);
+}
+
+
+void
+VSplitCoder::
+split_index(unsigned int _index, unsigned int& _tree_id,
+            unsigned int& _node_id) const
+{
+  if (tree_id_bits_ == 0)
+  {
+    _tree_id = 0;
+    _node_id = _index;
+  }
+  else
+  {
+    _tree_id = _index >> (32 - tree_id_bits_);
+    _node_id = _index & (0xFFFFFFFFu >> tree_id_bits_);
+  }
+}
+
+
+unsigned int
+VSplitCoder::
+bit_length(unsigned int _i)
+{
+  unsigned int n = 0;
+  while (n < 32 && (_i >> n) != 0)
+    ++n;
+  return n;
+}
+
+
+unsigned int
+VSplitCoder::
+align(unsigned int _node_id, int _depth)
+{
+  // node id of the ancestor (or first descendant) _depth levels below
+  if (_depth <= -32 || _depth >= 32)
+    return 0;
+  return _depth < 0 ? _node_id >> -_depth : _node_id << _depth;
+}
+
+
+unsigned int
+VSplitCoder::
+make_index(unsigned int _tree_id, unsigned int _node_id) const
+{
+  return tree_id_bits_ == 0 ? _node_id : (_tree_id << (32 - tree_id_bits_)) | _node_id;
+}
+
+
+//== VSplitEncoder ============================================================
+
+
+VSplitEncoder::
+VSplitEncoder()
+  : os_(NULL),
+    low_(0),
+    carry_(0),
+    range_(0xFFFFFFFFu),
+    cache_(0),
+    cache_size_(1)
+{
+}
+
+
+void
+VSplitEncoder::
+begin(std::ostream& _os)
+{
+  os_         = &_os;
+  low_        = 0;
+  carry_      = 0;
+  range_      = 0xFFFFFFFFu;
+  cache_      = 0;
+  cache_size_ = 1;
+}
+
+
+void
+VSplitEncoder::
+end()
+{
+  for (int i=0; i<5; ++i)
+    shift_low();
+  os_ = NULL;
+}
+
+
+bool
+VSplitEncoder::
+encode(const VSplitRecord& _record)
+{
+  unsigned int tree_id, node_id, cut_tree_id, cut_node_id;
+  split_index(_record.node_index, tree_id, node_id);
+
+  NodeMap::iterator n_it = nodes_.find(_record.node_index);
+  if (n_it == nodes_.end())
+    return false;
+
+  const QNode parent = n_it->second;
+
+  // node index relative to the previous vertex split
+  encode_int (models_[TreeId], (int)(tree_id - last_tree_id_));
+  encode_uint(models_[NodeId], node_id);
+  last_tree_id_ = tree_id;
+
+  // fundamental cut neighbors relative to the split node: mostly in the
+  // same tree, sharing a path from the root with it
+  const unsigned int cut_index[2] = { _record.fund_lcut_index,
+                                      _record.fund_rcut_index };
+  for (int c=0; c<2; ++c)
+  {
+    split_index(cut_index[c], cut_tree_id, cut_node_id);
+
+    int depth = (int) bit_length(cut_node_id) - (int) bit_length(node_id);
+    encode_int (models_[CutTreeId],  (int)(cut_tree_id - tree_id));
+    encode_int (models_[CutDepth],   depth);
+    encode_uint(models_[CutNodeId],  cut_node_id ^ align(node_id, depth));
+  }
+
+  // children predicted from the parent, rchild keeps the parent's position
+  QNode children[2];
+  quantize(_record.point, _record.lchild, children[0]);
+  quantize(_record.point, _record.rchild, children[1]);
+  for (int i=0; i<3; ++i)
+    children[1].point[i] = parent.point[i];
+
+  for (int i=0; i<3; ++i)
+    encode_int(models_[Point], children[0].point[i] - parent.point[i]);
+
+  for (int c=0; c<2; ++c)
+  {
+    encode_int(models_[Normal],    children[c].normal[0]  - parent.normal[0]);
+    encode_int(models_[Normal],    children[c].normal[1]  - parent.normal[1]);
+    encode_int(models_[Radius],    children[c].radius     - parent.radius);
+    encode_int(models_[SinSquare], children[c].sin_square - parent.sin_square);
+    encode_int(models_[Mue],       children[c].mue        - parent.mue);
+    encode_int(models_[Sigma],     children[c].sigma      - parent.sigma);
+  }
+
+  nodes_[make_index(tree_id, 2*node_id)]   = children[0];
+  nodes_[make_index(tree_id, 2*node_id+1)] = children[1];
+
+  return true;
+}
+
+
+void
+VSplitEncoder::
+encode_bit(unsigned short& _prob, unsigned int _bit)
+{
+  unsigned int bound = (range_ >> ProbBits) * _prob;
+
+  if (_bit == 0)
+  {
+    range_  = bound;
+    _prob  += ((1u << ProbBits) - _prob) >> ProbMoveBits;
+  }
+  else
+  {
+    unsigned int low = low_;
+    low_   += bound;
+    carry_ |= low_ < low;
+    range_ -= bound;
+    _prob  -= _prob >> ProbMoveBits;
+  }
+
+  while (range_ < RangeTop)
+  {
+    range_ <<= 8;
+    shift_low();
+  }
+}
+
+
+void
+VSplitEncoder::
+encode_direct(unsigned int _value, unsigned int _n_bits)
+{
+  while (_n_bits-- > 0)
+  {
+    range_ >>= 1;
+    if ((_value >> _n_bits) & 1)
+    {
+      unsigned int low = low_;
+      low_   += range_;
+      carry_ |= low_ < low;
+    }
+
+    while (range_ < RangeTop)
+    {
+      range_ <<= 8;
+      shift_low();
+    }
+  }
+}
+
+
+void
+VSplitEncoder::
+encode_uint(IntModel& _model, unsigned int _value)
+{
+  // bit length (0..32) with an adaptive bit tree, then the mantissa
+  unsigned int n_bits = bit_length(_value);
+
+  unsigned int node = 1;
+  for (int b=5; b>=0; --b)
+  {
+    unsigned int bit = (n_bits >> b) & 1;
+    encode_bit(_model.length[node], bit);
+    node = 2*node + bit;
+  }
+
+  if (n_bits >= 2)
+    encode_bit(_model.mantissa[n_bits], (_value >> (n_bits-2)) & 1);
+  if (n_bits >= 3)
+    encode_direct(_value, n_bits-2);
+}
+
+
+void
+VSplitEncoder::
+shift_low()
+{
+  if (low_ < 0xFF000000u || carry_)
+  {
+    unsigned char c = cache_;
+    do
+    {
+      os_->put((char)(unsigned char)(c + carry_));
+      c = 0xFF;
+    }
+    while (--cache_size_ != 0);
+
+    cache_ = (unsigned char)(low_ >> 24);
+  }
+
+  ++cache_size_;
+  low_   = (low_ & 0x00FFFFFFu) << 8;
+  carry_ = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+bool
+VSplitEncoder::
+compress(const std::string& _spm_filename,
+         const std::string& _coded_filename,
+         unsigned int       _position_bits,
+         unsigned int       _normal_bits)
+{
+  unsigned int  i, fvi[3];
+
+  VHierarchyReader reader;
+  if (!reader.open(_spm_filename))
+    return false;
+
+  const unsigned int n_base_vertices = reader.n_base_vertices();
+  const unsigned int n_base_faces    = reader.n_base_faces();
+  const unsigned int n_details       = reader.n_details();
+
+  std::vector<Vec3f>                 base_points(n_base_vertices);
+  std::vector<VHierarchyNodeParams>  base_params(n_base_vertices);
+  std::vector<unsigned int>          base_faces(3*n_base_faces);
+  std::vector<VSplitRecord>          records(n_details);
+
+  for (i=0; i<n_base_vertices; ++i)
+    if (!reader.read_base_vertex(base_points[i], base_params[i]))
+      return false;
+
+  for (i=0; i<n_base_faces; ++i)
+  {
+    if (!reader.read_base_face(fvi))
+      return false;
+    std::copy(fvi, fvi+3, &base_faces[3*i]);
+  }
+
+  for (i=0; i<n_details; ++i)
+    if (!reader.read_vsplit(records[i]))
+      return false;
+
+  reader.close();
+
+  // bounding box of all vertices
+  Vec3f bb_min( 1e30f,  1e30f,  1e30f);
+  Vec3f bb_max(-1e30f, -1e30f, -1e30f);
+
+  for (i=0; i<n_base_vertices; ++i)
+  {
+    bb_min.minimize(base_points[i]);
+    bb_max.maximize(base_points[i]);
+  }
+  for (i=0; i<n_details; ++i)
+  {
+    bb_min.minimize(records[i].point);
+    bb_max.maximize(records[i].point);
+  }
+  if (n_base_vertices == 0)
+    bb_min = bb_max = Vec3f(0.0f, 0.0f, 0.0f);
+
+  VSplitQuantization q = quantization(bb_min, bb_max, _position_bits, _normal_bits);
+
+  std::ofstream ofs(_coded_filename.c_str(), std::ios::binary);
+  if (!ofs)
+    return false;
+
+  bool swap = Endian::local() != Endian::LSB;
+
+  ofs.write("VDPMCoded", 9);
+  IO::store(ofs, 1u, swap);
+  IO::store(ofs, n_base_vertices, swap);
+  IO::store(ofs, n_base_faces, swap);
+  IO::store(ofs, n_details, swap);
+  IO::store(ofs, q.bb_min, swap);
+  IO::store(ofs, q.bb_size, swap);
+  IO::store(ofs, q.position_bits, swap);
+  IO::store(ofs, q.normal_bits, swap);
+
+  VSplitEncoder encoder;
+  encoder.reset(n_base_vertices, q);
+
+  for (i=0; i<n_base_vertices; ++i)
+  {
+    const VHierarchyNodeParams& params = base_params[i];
+
+    IO::store(ofs, base_points[i], swap);
+    IO::store(ofs, params.radius, swap);
+    IO::store(ofs, params.normal, swap);
+    IO::store(ofs, params.sin_square, swap);
+    IO::store(ofs, params.mue_square, swap);
+    IO::store(ofs, params.sigma_square, swap);
+
+    encoder.add_root(i, base_points[i], params);
+  }
+
+  for (i=0; i<3*n_base_faces; ++i)
+    IO::store(ofs, base_faces[i], swap);
+
+  encoder.begin(ofs);
+  for (i=0; i<n_details; ++i)
+    if (!encoder.encode(records[i]))
+      return false;
+  encoder.end();
+
+  return ofs.good();
+}
+
+
+//== VSplitDecoder ============================================================
+
+
+VSplitDecoder::
+VSplitDecoder()
+  : is_(NULL),
+    code_(0),
+    range_(0xFFFFFFFFu),
+    error_(false)
+{
+}
+
+
+void
+VSplitDecoder::
+begin(std::istream& _is)
+{
+  is_    = &_is;
+  code_  = 0;
+  range_ = 0xFFFFFFFFu;
+  error_ = false;
+
+  for (int i=0; i<5; ++i)
+  {
+    int c = is_->get();
+    if (c == EOF)
+      error_ = true;
+    code_ = (code_ << 8) | (unsigned int)(c & 0xFF);
+  }
+}
+
+
+void
+VSplitDecoder::
+end()
+{
+  is_ = NULL;
+}
+
+
+bool
+VSplitDecoder::
+decode(VSplitRecord& _record)
+{
+  if (error_ || is_ == NULL)
+    return false;
+
+  unsigned int tree_id, node_id, cut_tree_id, cut_node_id;
+
+  tree_id       = last_tree_id_ + decode_int(models_[TreeId]);
+  node_id       = decode_uint(models_[NodeId]);
+  last_tree_id_ = tree_id;
+
+  unsigned int* cut_index[2] = { &_record.fund_lcut_index,
+                                 &_record.fund_rcut_index };
+  for (int c=0; c<2; ++c)
+  {
+    cut_tree_id  = tree_id + decode_int(models_[CutTreeId]);
+    int depth    = decode_int(models_[CutDepth]);
+    cut_node_id  = decode_uint(models_[CutNodeId]) ^ align(node_id, depth);
+    *cut_index[c] = make_index(cut_tree_id, cut_node_id);
+  }
+
+  _record.node_index = make_index(tree_id, node_id);
+
+  NodeMap::iterator n_it = nodes_.find(_record.node_index);
+  if (error_ || n_it == nodes_.end())
+    return false;
+
+  const QNode parent = n_it->second;
+
+  QNode children[2];
+
+  for (int i=0; i<3; ++i)
+  {
+    children[0].point[i] = parent.point[i] + decode_int(models_[Point]);
+    children[1].point[i] = parent.point[i];
+  }
+
+  for (int c=0; c<2; ++c)
+  {
+    children[c].normal[0]  = parent.normal[0]  + decode_int(models_[Normal]);
+    children[c].normal[1]  = parent.normal[1]  + decode_int(models_[Normal]);
+    children[c].radius     = parent.radius     + decode_int(models_[Radius]);
+    children[c].sin_square = parent.sin_square + decode_int(models_[SinSquare]);
+    children[c].mue        = parent.mue        + decode_int(models_[Mue]);
+    children[c].sigma      = parent.sigma      + decode_int(models_[Sigma]);
+  }
+
+  _record.point = dequantize_point(children[0].point);
+  dequantize(children[0], _record.lchild);
+  dequantize(children[1], _record.rchild);
+
+  nodes_[make_index(tree_id, 2*node_id)]   = children[0];
+  nodes_[make_index(tree_id, 2*node_id+1)] = children[1];
+
+  return !error_;
+}
+
+
+unsigned int
+VSplitDecoder::
+decode_bit(unsigned short& _prob)
+{
+  unsigned int bound = (range_ >> ProbBits) * _prob;
+  unsigned int bit;
+
+  if (code_ < bound)
+  {
+    range_  = bound;
+    _prob  += ((1u << ProbBits) - _prob) >> ProbMoveBits;
+    bit     = 0;
+  }
+  else
+  {
+    code_  -= bound;
+    range_ -= bound;
+    _prob  -= _prob >> ProbMoveBits;
+    bit     = 1;
+  }
+
+  normalize();
+  return bit;
+}
+
+
+unsigned int
+VSplitDecoder::
+decode_direct(unsigned int _n_bits)
+{
+  unsigned int value = 0;
+
+  while (_n_bits-- > 0)
+  {
+    range_ >>= 1;
+    unsigned int bit = code_ >= range_ ? 1 : 0;
+    if (bit)
+      code_ -= range_;
+    value = (value << 1) | bit;
+
+    normalize();
+  }
+
+  return value;
+}
+
+
+unsigned int
+VSplitDecoder::
+decode_uint(IntModel& _model)
+{
+  unsigned int node = 1;
+  for (int b=5; b>=0; --b)
+    node = 2*node + decode_bit(_model.length[node]);
+
+  unsigned int n_bits = node - 64;
+  if (n_bits == 0)
+    return 0;
+  if (n_bits > 32)
+  {
+    error_ = true;
+    return 0;
+  }
+
+  unsigned int value = 1;
+  if (n_bits >= 2)
+    value = (value << 1) | decode_bit(_model.mantissa[n_bits]);
+  if (n_bits >= 3)
+    value = (value << (n_bits-2)) | decode_direct(n_bits-2);
+
+  return value;
+}
+
+
+void
+VSplitDecoder::
+normalize()
+{
+  while (range_ < RangeTop)
+  {
+    int c = is_->get();
+    if (c == EOF)
+    {
+      error_ = true;
+      c      = 0;
+    }
+
+    range_ <<= 8;
+    code_    = (code_ << 8) | (unsigned int)(c & 0xFF);
+  }
+}
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
@@ -0,0 +1,306 @@
+/*===========================================================================*\
+ *                                                                           *
+ *                               OpenMesh                                    *
+ *      Copyright (C) 2001-2015 by Computer Graphics Group, RWTH Aachen      *
+ *                           www.openmesh.org                                *
+ *                                                                           *
+ *---------------------------------------------------------------------------* 
+ *  This file is part of OpenMesh.                                           *
+ *                                                                           *
+ *  OpenMesh is free software: you can redistribute it and/or modify         * 
+ *  it under the terms of the GNU Lesser General Public License as           *
+ *  published by the Free Software Foundation, either version 3 of           *
+ *  the License, or (at your option) any later version with the              *
+ *  following exceptions:                                                    *
+ *                                                                           *
+ *  If other files instantiate templates or use macros                       *
+ *  or inline functions from this file, or you compile this file and         *
+ *  link it with other files to produce an executable, this file does        *
+ *  not by itself cause the resulting executable to be covered by the        *
+ *  GNU Lesser General Public License. This exception does not however       *
+ *  invalidate any other reasons why the executable file might be            *
+ *  covered by the GNU Lesser General Public License.                        *
+ *                                                                           *
+ *  OpenMesh is distributed in the hope that it will be useful,              *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of           *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            *
+ *  GNU Lesser General Public License for more details.                      *
+ *                                                                           *
+ *  You should have received a copy of the GNU LesserGeneral Public          *
+ *  License along with OpenMesh.  If not,                                    *
+ *  see <http://www.gnu.org/licenses/>.                                      *
+ *                                                                           *
+\*===========================================================================*/ 
+
+/*===========================================================================*\
+ *                                                                           *             
+ *   $Revision$                                                         *
+ *   $Date$                   *
+ *                                                                           *
+\*===========================================================================*/
+//=============================================================================
+//
+//  CLASSES VSplitEncoder, VSplitDecoder
+//
+//=============================================================================
+
+#ifndef OPENMESH_VDPROGMESH_VSPLITCODER_HH
+#define OPENMESH_VDPROGMESH_VSPLITCODER_HH
+
+
+//== INCLUDES =================================================================
+
+#include <map>
+#include <string>
+#include <iosfwd>
+#include <OpenMesh/Core/System/config.h>
+#include <OpenMesh/Core/Geometry/VectorT.hh>
+#include <OpenMesh/Tools/VDPM/VSplitRecord.hh>
+
+
+//== NAMESPACES ===============================================================
+
+namespace OpenMesh {
+namespace VDPM {
+
+//== CLASS DEFINITION =========================================================
+
+
+/** Quantization of a compressed vertex hierarchy. Positions are
+    quantized on a grid of 2^position_bits cells along the largest side
+    of the bounding box, radii and the error bounds mue and sigma in
+    steps of 1/16 octave down to one grid cell. Normals are mapped to an
+    octahedron and quantized with normal_bits per coordinate, as is
+    sin^2 of the normal cone angle.
+*/
+struct VSplitQuantization
+{
+  VSplitQuantization()
+    : bb_min(0.0f, 0.0f, 0.0f), bb_size(1.0f),
+      position_bits(16), normal_bits(10)
+  {}
+
+  Vec3f         bb_min;
+  float         bb_size;
+  unsigned int  position_bits;
+  unsigned int  normal_bits;
+};
+
+
+/** Common state of VSplitEncoder and VSplitDecoder.
+
+    Each vertex split is predicted from the node it splits: the position
+    of the new vertex from the position of the node, the parameters of
+    both children from those of the parent. Only the differences of the
+    quantized values are coded, with an adaptive binary range coder.
+    Encoder and decoder hence keep the same table of quantized nodes,
+    which is started by add_root() for each base vertex and extended by
+    every coded vertex split.
+
+    The vertex splits may come in any order in which every node is split
+    after its parent, e.g. in the order of a .spm file or in the order a
+    StreamingSession emits them. Quantized values are rounded up for the
+    radius, the normal cone and the error bounds, so refinement with the
+    decoded hierarchy is never coarser than with the original one.
+*/
+class OPENMESHDLLEXPORT VSplitCoder
+{
+public:
+
+  VSplitCoder();
+
+  /// Clears the node table and the adaptive models.
+  void reset(unsigned int              _n_roots,
+             const VSplitQuantization& _quantization);
+
+  /** Adds the root node _tree_id. Encoder and decoder have to be given
+      the same (unquantized) values.
+  */
+  void add_root(unsigned int                _tree_id,
+                const Vec3f&                _point,
+                const VHierarchyNodeParams& _params);
+
+  const VSplitQuantization& quantization() const { return quantization_; }
+
+  /// Quantization fitting the bounding box _bb_min, _bb_max
+  static VSplitQuantization quantization(const Vec3f&  _bb_min,
+                                         const Vec3f&  _bb_max,
+                                         unsigned int  _position_bits = 16,
+                                         unsigned int  _normal_bits = 10);
+
+protected:
+
+  /// Quantized position and refinement parameters of a node
+  struct QNode
+  {
+    int point[3];
+    int normal[2];
+    int radius;
+    int sin_square;
+    int mue;
+    int sigma;
+  };
+
+  /// Adaptive model of an integer: bit length and leading mantissa bit
+  struct IntModel
+  {
+    IntModel();
+    unsigned short length[64];
+    unsigned short mantissa[33];
+  };
+
+  enum Field
+  {
+    TreeId, NodeId, CutTreeId, CutDepth, CutNodeId,
+    Point, Normal, Radius, SinSquare, Mue, Sigma,
+    NumFields
+  };
+
+  void quantize(const Vec3f& _point, const VHierarchyNodeParams& _params,
+                QNode& _q) const;
+  void dequantize(const QNode& _q, VHierarchyNodeParams& _params) const;
+  Vec3f dequantize_point(const int _q[3]) const;
+  int   quantize_log(float _f) const;
+  float dequantize_log(int _q) const;
+
+  void split_index(unsigned int _index, unsigned int& _tree_id,
+                   unsigned int& _node_id) const;
+  unsigned int make_index(unsigned int _tree_id, unsigned int _node_id) const;
+
+  static unsigned int bit_length(unsigned int _i);
+  static unsigned int align(unsigned int _node_id, int _depth);
+
+  // shifts in unsigned, negative ints must not be shifted
+  static unsigned int zigzag(int _i)
+  { return ((unsigned int)_i << 1) ^ (_i < 0 ? ~0u : 0u); }
+
+  static int unzigzag(unsigned int _u)
+  { return (int)(_u >> 1) ^ -(int)(_u & 1); }
+
+protected:
+
+  typedef std::map<unsigned int, QNode>  NodeMap;
+
+  VSplitQuantization  quantization_;
+  float               position_scale_;
+  float               unit_scale_;
+  unsigned int        tree_id_bits_;
+  NodeMap             nodes_;
+  unsigned int        last_tree_id_;
+  IntModel            models_[NumFields];
+};
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** Compresses vertex split records, see VSplitCoder.
+
+    \code
+    encoder.reset(n_base_vertices, quantization);
+    for (i=0; i<n_base_vertices; ++i)
+      encoder.add_root(i, base_point[i], base_params[i]);
+
+    encoder.begin(os);
+    for (i=0; i<n_details; ++i)
+      encoder.encode(record[i]);
+    encoder.end();
+    \endcode
+
+    begin() and end() may be called repeatedly, e.g. per batch of
+    streamed vertex splits. The adaptive models are kept between the
+    calls, every end() flushes at most five bytes.
+*/
+class OPENMESHDLLEXPORT VSplitEncoder : public VSplitCoder
+{
+public:
+
+  VSplitEncoder();
+
+  void begin(std::ostream& _os);
+
+  /** Codes _record. Its node has to be in the table, i.e. a root or a
+      child of a coded vertex split.
+      \return false if the node is unknown
+  */
+  bool encode(const VSplitRecord& _record);
+
+  void end();
+
+  /** Compresses the .spm file _spm_filename into _coded_filename (see
+      VHierarchyReader for the format).
+      \return false if the input could not be read or the output written.
+  */
+  static bool compress(const std::string& _spm_filename,
+                       const std::string& _coded_filename,
+                       unsigned int       _position_bits = 16,
+                       unsigned int       _normal_bits = 10);
+
+private:
+
+  void encode_bit(unsigned short& _prob, unsigned int _bit);
+  void encode_direct(unsigned int _value, unsigned int _n_bits);
+  void encode_uint(IntModel& _model, unsigned int _value);
+  void encode_int(IntModel& _model, int _value)
+  { encode_uint(_model, zigzag(_value)); }
+  void shift_low();
+
+private:
+
+  std::ostream*   os_;
+  unsigned int    low_;
+  unsigned int    carry_;
+  unsigned int    range_;
+  unsigned char   cache_;
+  size_t          cache_size_;
+};
+
+
+//== CLASS DEFINITION =========================================================
+
+
+/** Decompresses vertex split records written by VSplitEncoder, one at a
+    time. The decoder has to be reset() and given the roots exactly as
+    the encoder, and begin() and end() have to be called for the same
+    groups of records.
+*/
+class OPENMESHDLLEXPORT VSplitDecoder : public VSplitCoder
+{
+public:
+
+  VSplitDecoder();
+
+  void begin(std::istream& _is);
+
+  /** Decodes the next record. The position and parameters are the
+      dequantized values.
+      \return false if the stream ended or is corrupt
+  */
+  bool decode(VSplitRecord& _record);
+
+  void end();
+
+private:
+
+  unsigned int decode_bit(unsigned short& _prob);
+  unsigned int decode_direct(unsigned int _n_bits);
+  unsigned int decode_uint(IntModel& _model);
+  int decode_int(IntModel& _model)
+  { return unzigzag(decode_uint(_model)); }
+  void normalize();
+
+private:
+
+  std::istream*   is_;
+  unsigned int    code_;
+  unsigned int    range_;
+  bool            error_;
+};
+
+
+//=============================================================================
+} // namespace VDPM
+} // namespace OpenMesh
+//=============================================================================
+#endif // OPENMESH_VDPROGMESH_VSPLITCODER_HH defined
+//=============================================================================
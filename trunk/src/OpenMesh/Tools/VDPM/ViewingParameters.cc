@@ -67,6 +67,27 @@ ViewingParameters()
   tolerance_square_ = 0.001f;
 }
 
+void
+ViewingParameters::
+set_look_at(const Vec3f& _eye, const Vec3f& _center, const Vec3f& _up)
+{
+  Vec3f f = (_center - _eye).normalize();
+  Vec3f s = cross(f, _up).normalize();
+  Vec3f u = cross(s, f);
+
+  for (int i=0; i<3; ++i)
+  {
+    modelview_matrix_[4*i  ] =  s[i];
+    modelview_matrix_[4*i+1] =  u[i];
+    modelview_matrix_[4*i+2] = -f[i];
+    modelview_matrix_[4*i+3] =  0.0;
+  }
+  modelview_matrix_[12] = -dot(s, _eye);
+  modelview_matrix_[13] = -dot(u, _eye);
+  modelview_matrix_[14] =  dot(f, _eye);
+  modelview_matrix_[15] =  1.0;
+}
+
 void
 ViewingParameters::
 update_viewing_configurations()
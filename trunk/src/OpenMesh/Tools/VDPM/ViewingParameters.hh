@@ -126,6 +126,11 @@ public:
       modelview_matrix_[i] = _modelview_matrix[i];   
   }
 
+  /** Sets the modelview matrix of a camera at _eye looking at _center
+      (as gluLookAt() does), for use without an OpenGL context.
+  */
+  void set_look_at(const Vec3f& _eye, const Vec3f& _center, const Vec3f& _up);
+
   void update_viewing_configurations();
 
   void PrintOut();
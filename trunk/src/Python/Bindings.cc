@@ -5,6 +5,10 @@
 #include "Python/Circulator.hh"
 #include "Python/PropertyManager.hh"
 #include "Python/InputOutput.hh"
+#ifdef OPENMESH_PYTHON_NUMPY
+#include "Python/NumPy.hh"
+#endif
+#include "Python/Tools.hh"
 
 namespace OpenMesh {
 namespace Python {
@@ -19,6 +23,23 @@ void expose_items() {
 	class_<ArrayItems::Face>("Face");
 }
 
+/**
+ * Expose the vertex, halfedge, edge and face property handles of a numeric
+ * type to %Python.
+ *
+ * @tparam T The value type of the properties.
+ *
+ * @param _suffix The suffix of the handle names (e.g. "Float" for
+ * VPropHandleFloat).
+ */
+template <class T>
+void expose_typed_prop_handles(const std::string& _suffix) {
+	class_<VPropHandleT<T>, bases<BaseHandle> >(("VPropHandle" + _suffix).c_str(), init<optional<int> >());
+	class_<HPropHandleT<T>, bases<BaseHandle> >(("HPropHandle" + _suffix).c_str(), init<optional<int> >());
+	class_<EPropHandleT<T>, bases<BaseHandle> >(("EPropHandle" + _suffix).c_str(), init<optional<int> >());
+	class_<FPropHandleT<T>, bases<BaseHandle> >(("FPropHandle" + _suffix).c_str(), init<optional<int> >());
+}
+
 /**
  * Expose item and property handles to %Python.
  */
@@ -50,6 +71,12 @@ void expose_handles() {
 		.def(init<const BasePropHandleT<object>&>());
 	class_<MPropHandleT<object>, bases<BasePropHandleT<object> > >("MPropHandle", init<optional<int> >())
 		.def(init<const BasePropHandleT<object>&>());
+
+	expose_typed_prop_handles<int   >("Int");
+	expose_typed_prop_handles<float >("Float");
+	expose_typed_prop_handles<double>("Double");
+	expose_typed_prop_handles<Vec3f >("Vec3f");
+	expose_typed_prop_handles<Vec3d >("Vec3d");
 }
 
 
@@ -99,6 +126,10 @@ void expose_status_bits_and_info() {
 }
 
 BOOST_PYTHON_MODULE(openmesh) {
+#ifdef OPENMESH_PYTHON_NUMPY
+	import_numpy();
+#endif
+
 	expose_items();
 	expose_handles();
 	expose_status_bits_and_info();
@@ -142,6 +173,7 @@ BOOST_PYTHON_MODULE(openmesh) {
 	expose_property_manager<FPropHandleT<object>, FaceHandle, FaceIterWrapper>("FPropertyManager");
 
 	expose_io();
+	expose_tools();
 }
 
 } // namespace Python
@@ -28,6 +28,33 @@ namespace Python {
  */
 #define OPENMESH_PYTHON_DEFAULT_POLICY return_value_policy<copy_const_reference>()
 
+/**
+ * Releases the global interpreter lock for the lifetime of an instance.
+ *
+ * No %Python objects may be accessed while the lock is released.
+ */
+class ScopedGILRelease {
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param _release Release the lock? If false, the lock is kept.
+	 */
+	explicit ScopedGILRelease(bool _release = true) : state_(_release ? PyEval_SaveThread() : NULL) {}
+
+	~ScopedGILRelease() {
+		if (state_ != NULL) {
+			PyEval_RestoreThread(state_);
+		}
+	}
+
+private:
+	ScopedGILRelease(const ScopedGILRelease&);
+	ScopedGILRelease& operator=(const ScopedGILRelease&);
+
+	PyThreadState* state_;
+};
+
 struct MeshTraits : public OpenMesh::DefaultTraits {
 	/** Use double precision points */
 	typedef OpenMesh::Vec3d Point;
@@ -42,6 +69,40 @@ struct MeshTraits : public OpenMesh::DefaultTraits {
 typedef OpenMesh::TriMesh_ArrayKernelT<MeshTraits> TriMesh;
 typedef OpenMesh::PolyMesh_ArrayKernelT<MeshTraits> PolyMesh;
 
+/**
+ * Check whether a range of properties contains a property that stores %Python
+ * objects.
+ */
+template <class Iterator>
+bool has_object_properties(Iterator _begin, Iterator _end) {
+	for (; _begin != _end; ++_begin) {
+		if (dynamic_cast<const PropertyT<object>*>(*_begin) != NULL) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Check whether a mesh has properties that store %Python objects.
+ *
+ * Adding or removing items of such a mesh creates or destroys %Python
+ * objects, so it must not be modified without holding the global
+ * interpreter lock.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _mesh The mesh instance that is to be checked.
+ */
+template <class Mesh>
+bool has_object_properties(const Mesh& _mesh) {
+	return has_object_properties(_mesh.vprops_begin(), _mesh.vprops_end())
+		|| has_object_properties(_mesh.hprops_begin(), _mesh.hprops_end())
+		|| has_object_properties(_mesh.eprops_begin(), _mesh.eprops_end())
+		|| has_object_properties(_mesh.fprops_begin(), _mesh.fprops_end())
+		|| has_object_properties(_mesh.mprops_begin(), _mesh.mprops_end());
+}
+
 } // namespace OpenMesh
 } // namespace Python
 
@@ -4,6 +4,9 @@
 #include "Python/Bindings.hh"
 #include "Python/Iterator.hh"
 #include "Python/Circulator.hh"
+#ifdef OPENMESH_PYTHON_NUMPY
+#include "Python/NumPy.hh"
+#endif
 
 #include <boost/python/stl_iterator.hpp>
 
@@ -84,6 +87,23 @@ void set_property(Mesh& _self, PropHandle _ph, const object& _value) {
 	_self.property(_ph) = _value;
 }
 
+/**
+ * Set the value of a typed property of an item.
+ *
+ * @tparam Mesh A mesh type.
+ * @tparam PropHandle A typed property handle type (e.g. VPropHandleT<float>).
+ * @tparam IndexHandle The appropriate handle type.
+ *
+ * @param _self The mesh instance that is to be used.
+ * @param _ph The property that is to be set.
+ * @param _h The handle of the item whose property is to be set.
+ * @param _value The value to be set.
+ */
+template <class Mesh, class PropHandle, class IndexHandle>
+void set_typed_property(Mesh& _self, PropHandle _ph, IndexHandle _h, const typename PropHandle::Value& _value) {
+	_self.property(_ph, _h) = _value;
+}
+
 /**
  * Thin wrapper for assign_connectivity.
  *
@@ -292,6 +312,106 @@ void expose_type_specific_functions(class_<TriMesh>& _class) {
 }
 
 
+/**
+ * Expose the functions for vertex, halfedge, edge and face properties of a
+ * numeric type to %Python.
+ *
+ * Unlike properties that store %Python objects, the values of these
+ * properties can also be accessed as NumPy arrays if the bindings are built
+ * with NumPy support (OPENMESH_PYTHON_NUMPY).
+ *
+ * @tparam Mesh A mesh type.
+ * @tparam T The value type of the properties (e.g. float or Vec3d).
+ *
+ * @param _class The boost::python::class instance for which the member
+ * functions are to be defined.
+ */
+template <class Mesh, class T>
+void expose_typed_property_functions(class_<Mesh>& _class) {
+	// Property management - add property
+	void (Mesh::*add_property_vph)(VPropHandleT<T>&, const std::string&) = &Mesh::add_property;
+	void (Mesh::*add_property_eph)(EPropHandleT<T>&, const std::string&) = &Mesh::add_property;
+	void (Mesh::*add_property_hph)(HPropHandleT<T>&, const std::string&) = &Mesh::add_property;
+	void (Mesh::*add_property_fph)(FPropHandleT<T>&, const std::string&) = &Mesh::add_property;
+
+	// Property management - remove property
+	void (Mesh::*remove_property_vph)(VPropHandleT<T>&) = &Mesh::remove_property;
+	void (Mesh::*remove_property_eph)(EPropHandleT<T>&) = &Mesh::remove_property;
+	void (Mesh::*remove_property_hph)(HPropHandleT<T>&) = &Mesh::remove_property;
+	void (Mesh::*remove_property_fph)(FPropHandleT<T>&) = &Mesh::remove_property;
+
+	// Property management - get property by name
+	bool (Mesh::*get_property_handle_vph)(VPropHandleT<T>&, const std::string&) const = &Mesh::get_property_handle;
+	bool (Mesh::*get_property_handle_eph)(EPropHandleT<T>&, const std::string&) const = &Mesh::get_property_handle;
+	bool (Mesh::*get_property_handle_hph)(HPropHandleT<T>&, const std::string&) const = &Mesh::get_property_handle;
+	bool (Mesh::*get_property_handle_fph)(FPropHandleT<T>&, const std::string&) const = &Mesh::get_property_handle;
+
+	// Property management - get property value for an item
+	const T& (Mesh::*property_vertex  )(VPropHandleT<T>, VertexHandle  ) const = &Mesh::property;
+	const T& (Mesh::*property_edge    )(EPropHandleT<T>, EdgeHandle    ) const = &Mesh::property;
+	const T& (Mesh::*property_halfedge)(HPropHandleT<T>, HalfedgeHandle) const = &Mesh::property;
+	const T& (Mesh::*property_face    )(FPropHandleT<T>, FaceHandle    ) const = &Mesh::property;
+
+	// Property management - set property value for an item
+	void (*set_property_vertex  )(Mesh&, VPropHandleT<T>, VertexHandle,   const T&) = &set_typed_property;
+	void (*set_property_edge    )(Mesh&, EPropHandleT<T>, EdgeHandle,     const T&) = &set_typed_property;
+	void (*set_property_halfedge)(Mesh&, HPropHandleT<T>, HalfedgeHandle, const T&) = &set_typed_property;
+	void (*set_property_face    )(Mesh&, FPropHandleT<T>, FaceHandle,     const T&) = &set_typed_property;
+
+	_class
+		.def("add_property", add_property_vph, add_property_overloads())
+		.def("add_property", add_property_eph, add_property_overloads())
+		.def("add_property", add_property_hph, add_property_overloads())
+		.def("add_property", add_property_fph, add_property_overloads())
+
+		.def("remove_property", remove_property_vph)
+		.def("remove_property", remove_property_eph)
+		.def("remove_property", remove_property_hph)
+		.def("remove_property", remove_property_fph)
+
+		.def("get_property_handle", get_property_handle_vph)
+		.def("get_property_handle", get_property_handle_eph)
+		.def("get_property_handle", get_property_handle_hph)
+		.def("get_property_handle", get_property_handle_fph)
+
+		.def("property", property_vertex, OPENMESH_PYTHON_DEFAULT_POLICY)
+		.def("property", property_edge, OPENMESH_PYTHON_DEFAULT_POLICY)
+		.def("property", property_halfedge, OPENMESH_PYTHON_DEFAULT_POLICY)
+		.def("property", property_face, OPENMESH_PYTHON_DEFAULT_POLICY)
+
+		.def("set_property", set_property_vertex)
+		.def("set_property", set_property_edge)
+		.def("set_property", set_property_halfedge)
+		.def("set_property", set_property_face)
+		;
+
+#ifdef OPENMESH_PYTHON_NUMPY
+	// Property management - get property values of all items
+	object (*property_array_vertex  )(object, VPropHandleT<T>) = &custom_property_array<Mesh, VPropHandleT<T> >;
+	object (*property_array_edge    )(object, EPropHandleT<T>) = &custom_property_array<Mesh, EPropHandleT<T> >;
+	object (*property_array_halfedge)(object, HPropHandleT<T>) = &custom_property_array<Mesh, HPropHandleT<T> >;
+	object (*property_array_face    )(object, FPropHandleT<T>) = &custom_property_array<Mesh, FPropHandleT<T> >;
+
+	// Property management - set property values of all items
+	void (*set_property_array_vertex  )(object, VPropHandleT<T>, object) = &set_custom_property_array<Mesh, VPropHandleT<T> >;
+	void (*set_property_array_edge    )(object, EPropHandleT<T>, object) = &set_custom_property_array<Mesh, EPropHandleT<T> >;
+	void (*set_property_array_halfedge)(object, HPropHandleT<T>, object) = &set_custom_property_array<Mesh, HPropHandleT<T> >;
+	void (*set_property_array_face    )(object, FPropHandleT<T>, object) = &set_custom_property_array<Mesh, FPropHandleT<T> >;
+
+	_class
+		.def("property_array", property_array_vertex)
+		.def("property_array", property_array_edge)
+		.def("property_array", property_array_halfedge)
+		.def("property_array", property_array_face)
+
+		.def("set_property_array", set_property_array_vertex)
+		.def("set_property_array", set_property_array_edge)
+		.def("set_property_array", set_property_array_halfedge)
+		.def("set_property_array", set_property_array_face)
+		;
+#endif
+}
+
 /**
  * Expose a mesh type to %Python.
  *
@@ -891,6 +1011,15 @@ void expose_mesh(const char *_name) {
 		;
 
 	expose_type_specific_functions(class_mesh);
+#ifdef OPENMESH_PYTHON_NUMPY
+	expose_numpy_functions(class_mesh);
+#endif
+
+	expose_typed_property_functions<Mesh, int   >(class_mesh);
+	expose_typed_property_functions<Mesh, float >(class_mesh);
+	expose_typed_property_functions<Mesh, double>(class_mesh);
+	expose_typed_property_functions<Mesh, Vec3f >(class_mesh);
+	expose_typed_property_functions<Mesh, Vec3d >(class_mesh);
 
 	//======================================================================
 	//  Nested Types
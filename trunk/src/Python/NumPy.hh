@@ -0,0 +1,429 @@
+/** @file */
+
+#ifndef OPENMESH_PYTHON_NUMPY_HH
+#define OPENMESH_PYTHON_NUMPY_HH
+
+#include "Python/Bindings.hh"
+
+#include <boost/python/make_constructor.hpp>
+
+#include <OpenMesh/Core/Utils/vector_traits.hh>
+
+#include <algorithm>
+
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+namespace OpenMesh {
+namespace Python {
+
+/**
+ * Initialize the NumPy C API. Must be called once when the module is loaded
+ * before any of the functions in this file is used.
+ */
+inline void import_numpy() {
+	if (_import_array() < 0) {
+		throw_error_already_set();
+	}
+}
+
+/**
+ * Maps a scalar type to the corresponding NumPy type number.
+ */
+template <class Scalar> struct NumPyType;
+template <> struct NumPyType<float>  { enum { value = NPY_FLOAT  }; };
+template <> struct NumPyType<double> { enum { value = NPY_DOUBLE }; };
+template <> struct NumPyType<int>    { enum { value = NPY_INT    }; };
+
+/**
+ * Describes the NumPy array layout of a property value type. Vector types are
+ * stored as rows of a two-dimensional array, scalar types as elements of a
+ * one-dimensional array.
+ */
+template <class T>
+struct ArrayTraits {
+	typedef typename vector_traits<T>::value_type Scalar;
+	enum { ndim = 2, cols = vector_traits<T>::size_ };
+};
+
+template <> struct ArrayTraits<float>  { typedef float  Scalar; enum { ndim = 1, cols = 1 }; };
+template <> struct ArrayTraits<double> { typedef double Scalar; enum { ndim = 1, cols = 1 }; };
+template <> struct ArrayTraits<int>    { typedef int    Scalar; enum { ndim = 1, cols = 1 }; };
+
+/**
+ * Create a NumPy array that views the given property storage.
+ *
+ * The array does not own its data but keeps @p _owner alive. The view becomes
+ * invalid as soon as the number of items of the property changes, i.e. when
+ * items are added or garbage collection is performed.
+ *
+ * @tparam T A scalar or vector type (e.g. float or Vec3d).
+ *
+ * @param _owner The %Python object that owns the storage (i.e. the mesh).
+ * @param _data The property storage.
+ */
+template <class T>
+object array_view(object _owner, std::vector<T>& _data) {
+	typedef typename ArrayTraits<T>::Scalar Scalar;
+
+	const int ndim = ArrayTraits<T>::ndim;
+	npy_intp dims[2] = { npy_intp(_data.size()), npy_intp(ArrayTraits<T>::cols) };
+
+	PyObject* array;
+	if (_data.empty()) {
+		array = PyArray_SimpleNew(ndim, dims, NumPyType<Scalar>::value);
+	}
+	else {
+		array = PyArray_SimpleNewFromData(ndim, dims, NumPyType<Scalar>::value, reinterpret_cast<Scalar*>(&_data[0]));
+	}
+	if (array == NULL) {
+		throw_error_already_set();
+	}
+
+	Py_INCREF(_owner.ptr());
+	if (PyArray_SetBaseObject((PyArrayObject*)array, _owner.ptr()) < 0) {
+		Py_DECREF(array);
+		throw_error_already_set();
+	}
+
+	return object(handle<>(array));
+}
+
+/**
+ * Create a NumPy array that views a standard property of a mesh.
+ *
+ * Raises a %Python RuntimeError if the property has not been requested.
+ *
+ * @tparam Mesh A mesh type.
+ * @tparam PropHandle The handle type of the standard property.
+ * @tparam pph The member function of the attribute kernel that returns the
+ * property handle.
+ *
+ * @param _self The mesh instance that is to be used.
+ */
+template <class Mesh, class PropHandle, PropHandle (Mesh::AttribKernel::*pph)() const>
+object standard_property_array(object _self) {
+	Mesh& mesh = extract<Mesh&>(_self);
+	PropHandle ph = (mesh.*pph)();
+	if (!ph.is_valid()) {
+		PyErr_SetString(PyExc_RuntimeError, "The property has not been requested.");
+		throw_error_already_set();
+	}
+	return array_view(_self, mesh.property(ph).data_vector());
+}
+
+/**
+ * Create a NumPy array that views a custom property of a mesh.
+ *
+ * Raises a %Python RuntimeError if the property handle is invalid.
+ *
+ * @tparam Mesh A mesh type.
+ * @tparam PropHandle A typed property handle type (e.g. VPropHandleT<float>).
+ *
+ * @param _self The mesh instance that is to be used.
+ * @param _ph The property that is to be viewed.
+ */
+template <class Mesh, class PropHandle>
+object custom_property_array(object _self, PropHandle _ph) {
+	Mesh& mesh = extract<Mesh&>(_self);
+	if (!_ph.is_valid()) {
+		PyErr_SetString(PyExc_RuntimeError, "Invalid property handle.");
+		throw_error_already_set();
+	}
+	return array_view(_self, mesh.property(_ph).data_vector());
+}
+
+/**
+ * Set the values of a custom property of all items from an array.
+ *
+ * The array is broadcast to the shape of custom_property_array(), e.g. a
+ * single value sets the property of all items.
+ *
+ * @tparam Mesh A mesh type.
+ * @tparam PropHandle A typed property handle type (e.g. VPropHandleT<float>).
+ *
+ * @param _self The mesh instance that is to be used.
+ * @param _ph The property that is to be set.
+ * @param _values The new values.
+ */
+template <class Mesh, class PropHandle>
+void set_custom_property_array(object _self, PropHandle _ph, object _values) {
+	object view = custom_property_array<Mesh, PropHandle>(_self, _ph);
+
+	PyObject* values = PyArray_FROMANY(_values.ptr(), PyArray_TYPE((PyArrayObject*)view.ptr()), 0, 2, NPY_ARRAY_FORCECAST);
+	if (values == NULL) {
+		throw_error_already_set();
+	}
+	object values_array = object(handle<>(values));
+
+	if (PyArray_CopyInto((PyArrayObject*)view.ptr(), (PyArrayObject*)values_array.ptr()) < 0) {
+		throw_error_already_set();
+	}
+}
+
+/**
+ * Create an integer NumPy array of the given shape.
+ */
+inline object new_index_array(npy_intp _rows, npy_intp _cols) {
+	npy_intp dims[2] = { _rows, _cols };
+	PyObject* array = PyArray_SimpleNew(2, dims, NPY_INT);
+	if (array == NULL) {
+		throw_error_already_set();
+	}
+	return object(handle<>(array));
+}
+
+/**
+ * Get the vertex indices of all faces as an array with one row per face.
+ *
+ * For polygon meshes the number of columns equals the largest face valence
+ * and shorter rows are padded with -1. Rows of deleted faces consist of -1.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _self The mesh instance that is to be used.
+ */
+template <class Mesh>
+object face_vertex_indices(Mesh& _self) {
+	const bool check_deleted = _self.has_face_status();
+
+	// Determine the number of columns
+	int cols = 3;
+	if (!Mesh::is_trimesh()) {
+		cols = 0;
+		for (typename Mesh::FaceIter f_it = _self.faces_begin(); f_it != _self.faces_end(); ++f_it) {
+			if (!check_deleted || !_self.status(*f_it).deleted()) {
+				cols = std::max(cols, int(_self.valence(*f_it)));
+			}
+		}
+	}
+
+	object array = new_index_array(_self.n_faces(), cols);
+	int* indices = (int*)PyArray_DATA((PyArrayObject*)array.ptr());
+	std::fill(indices, indices + _self.n_faces() * cols, -1);
+
+	for (typename Mesh::FaceIter f_it = _self.faces_begin(); f_it != _self.faces_end(); ++f_it) {
+		if (check_deleted && _self.status(*f_it).deleted()) {
+			continue;
+		}
+		int* row = indices + f_it->idx() * cols;
+		for (typename Mesh::ConstFaceVertexIter fv_it = _self.cfv_iter(*f_it); fv_it.is_valid(); ++fv_it) {
+			*row++ = fv_it->idx();
+		}
+	}
+
+	return array;
+}
+
+/**
+ * Get the indices of the two vertices of all edges as an array with one row
+ * per edge.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _self The mesh instance that is to be used.
+ */
+template <class Mesh>
+object ev_indices(Mesh& _self) {
+	object array = new_index_array(_self.n_edges(), 2);
+	int* indices = (int*)PyArray_DATA((PyArrayObject*)array.ptr());
+
+	for (size_t i = 0; i < _self.n_edges(); ++i) {
+		const HalfedgeHandle heh = _self.halfedge_handle(_self.edge_handle(i), 0);
+		indices[2 * i    ] = _self.from_vertex_handle(heh).idx();
+		indices[2 * i + 1] = _self.to_vertex_handle(heh).idx();
+	}
+
+	return array;
+}
+
+/**
+ * Raise a %Python ValueError.
+ */
+inline void raise_value_error(const char* _message) {
+	PyErr_SetString(PyExc_ValueError, _message);
+	throw_error_already_set();
+}
+
+/**
+ * Convert a %Python object (e.g. a NumPy array or a nested list) to a
+ * contiguous two-dimensional NumPy array of the given type.
+ *
+ * Empty inputs are converted to an array with zero rows. Raises a %Python
+ * ValueError if the array does not have two dimensions or if the number of
+ * columns is less than @p _min_cols or greater than @p _max_cols.
+ */
+inline object as_array(object _obj, int _type, npy_intp _min_cols, npy_intp _max_cols, const char* _message) {
+	PyObject* array = PyArray_FROMANY(_obj.ptr(), _type, 0, 2, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
+	if (array == NULL) {
+		throw_error_already_set();
+	}
+	object result = object(handle<>(array));
+
+	PyArrayObject* arr = (PyArrayObject*)array;
+	if (PyArray_SIZE(arr) == 0) {
+		npy_intp dims[2] = { 0, _min_cols };
+		array = PyArray_SimpleNew(2, dims, _type);
+		if (array == NULL) {
+			throw_error_already_set();
+		}
+		return object(handle<>(array));
+	}
+	if (PyArray_NDIM(arr) != 2 || PyArray_DIM(arr, 1) < _min_cols || PyArray_DIM(arr, 1) > _max_cols) {
+		raise_value_error(_message);
+	}
+
+	return result;
+}
+
+/**
+ * Add the vertices given by an array of shape (n, 3).
+ *
+ * The vertices are added in C++ with the global interpreter lock released
+ * unless the mesh has properties that store %Python objects.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _self The mesh instance that is to be used.
+ * @param _points The coordinates of the new vertices.
+ */
+template <class Mesh>
+void add_vertices(Mesh& _self, object _points) {
+	typedef typename Mesh::Point Point;
+
+	object array = as_array(_points, NPY_DOUBLE, 3, 3, "Points must be an array of shape (n, 3).");
+	PyArrayObject* arr = (PyArrayObject*)array.ptr();
+	const size_t rows = PyArray_DIM(arr, 0);
+	const double* points = (const double*)PyArray_DATA(arr);
+
+	ScopedGILRelease release(!has_object_properties(_self));
+
+	_self.reserve(_self.n_vertices() + rows, _self.n_edges(), _self.n_faces());
+	for (size_t i = 0; i < rows; ++i, points += 3) {
+		_self.add_vertex(Point(points[0], points[1], points[2]));
+	}
+}
+
+/**
+ * Add the faces given by an array with one row of vertex indices per face.
+ *
+ * Rows may be padded with -1 to add faces with different numbers of
+ * vertices. The faces are added in C++ with the global interpreter lock
+ * released unless the mesh has properties that store %Python objects.
+ * Raises a %Python ValueError and adds no faces if a vertex index is out of
+ * range.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _self The mesh instance that is to be used.
+ * @param _faces The vertex indices of the new faces.
+ *
+ * @return An array that contains the index of each new face. The index is -1
+ * if the face could not be added (e.g. because of a complex edge).
+ */
+template <class Mesh>
+object add_faces(Mesh& _self, object _faces) {
+	object array = as_array(_faces, NPY_INT, 3, NPY_MAX_INT, "Faces must be an array of shape (n, k) with k >= 3.");
+	PyArrayObject* arr = (PyArrayObject*)array.ptr();
+	const size_t rows = PyArray_DIM(arr, 0);
+	const size_t cols = PyArray_DIM(arr, 1);
+	const int* indices = (const int*)PyArray_DATA(arr);
+
+	npy_intp dims[1] = { npy_intp(rows) };
+	PyObject* result = PyArray_SimpleNew(1, dims, NPY_INT);
+	if (result == NULL) {
+		throw_error_already_set();
+	}
+	object face_array = object(handle<>(result));
+	int* face_indices = (int*)PyArray_DATA((PyArrayObject*)result);
+
+	bool valid = true;
+	{
+		ScopedGILRelease release(!has_object_properties(_self));
+
+		// Check all indices before modifying the mesh
+		const int n_vertices = int(_self.n_vertices());
+		for (size_t i = 0; i < rows * cols && valid; ++i) {
+			valid = indices[i] >= -1 && indices[i] < n_vertices;
+		}
+
+		if (valid) {
+			_self.reserve(_self.n_vertices(), _self.n_edges() + rows * cols / 2, _self.n_faces() + rows);
+
+			std::vector<VertexHandle> vhandles;
+			vhandles.reserve(cols);
+			for (size_t i = 0; i < rows; ++i, indices += cols) {
+				vhandles.clear();
+				for (size_t j = 0; j < cols && indices[j] >= 0; ++j) {
+					vhandles.push_back(VertexHandle(indices[j]));
+				}
+				face_indices[i] = vhandles.size() >= 3 ? _self.add_face(vhandles).idx() : -1;
+			}
+		}
+	}
+	if (!valid) {
+		raise_value_error("Vertex index out of range.");
+	}
+
+	return face_array;
+}
+
+/**
+ * Create a new mesh from an array of points and an array of faces.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _points The coordinates of the vertices, see add_vertices().
+ * @param _faces The vertex indices of the faces, see add_faces().
+ */
+template <class Mesh>
+Mesh* create_mesh(object _points, object _faces) {
+	Mesh* mesh = new Mesh();
+	try {
+		add_vertices(*mesh, _points);
+		add_faces(*mesh, _faces);
+	}
+	catch (...) {
+		delete mesh;
+		throw;
+	}
+	return mesh;
+}
+
+/**
+ * Expose the NumPy functions of a mesh type to %Python.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _class The boost::python::class instance for which the member
+ * functions are to be defined.
+ */
+template <class Mesh>
+void expose_numpy_functions(class_<Mesh>& _class) {
+	_class
+		.def("points", &standard_property_array<Mesh, typename Mesh::PointsPropertyHandle, &Mesh::points_pph>)
+		.def("vertex_normals", &standard_property_array<Mesh, typename Mesh::VertexNormalsPropertyHandle, &Mesh::vertex_normals_pph>)
+		.def("vertex_colors", &standard_property_array<Mesh, typename Mesh::VertexColorsPropertyHandle, &Mesh::vertex_colors_pph>)
+		.def("vertex_texcoords2D", &standard_property_array<Mesh, typename Mesh::VertexTexCoords2DPropertyHandle, &Mesh::vertex_texcoords2D_pph>)
+		.def("vertex_texcoords3D", &standard_property_array<Mesh, typename Mesh::VertexTexCoords3DPropertyHandle, &Mesh::vertex_texcoords3D_pph>)
+		.def("halfedge_normals", &standard_property_array<Mesh, typename Mesh::HalfedgeNormalsPropertyHandle, &Mesh::halfedge_normals_pph>)
+		.def("halfedge_colors", &standard_property_array<Mesh, typename Mesh::HalfedgeColorsPropertyHandle, &Mesh::halfedge_colors_pph>)
+		.def("halfedge_texcoords2D", &standard_property_array<Mesh, typename Mesh::HalfedgeTexCoords2DPropertyHandle, &Mesh::halfedge_texcoords2D_pph>)
+		.def("halfedge_texcoords3D", &standard_property_array<Mesh, typename Mesh::HalfedgeTexCoords3DPropertyHandle, &Mesh::halfedge_texcoords3D_pph>)
+		.def("edge_colors", &standard_property_array<Mesh, typename Mesh::EdgeColorsPropertyHandle, &Mesh::edge_colors_pph>)
+		.def("face_normals", &standard_property_array<Mesh, typename Mesh::FaceNormalsPropertyHandle, &Mesh::face_normals_pph>)
+		.def("face_colors", &standard_property_array<Mesh, typename Mesh::FaceColorsPropertyHandle, &Mesh::face_colors_pph>)
+
+		.def("face_vertex_indices", &face_vertex_indices<Mesh>)
+		.def("ev_indices", &ev_indices<Mesh>)
+
+		.def("__init__", make_constructor(&create_mesh<Mesh>))
+		.def("add_vertices", &add_vertices<Mesh>)
+		.def("add_faces", &add_faces<Mesh>)
+		;
+}
+
+} // namespace OpenMesh
+} // namespace Python
+
+#endif
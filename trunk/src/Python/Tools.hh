@@ -0,0 +1,266 @@
+/** @file */
+
+#ifndef OPENMESH_PYTHON_TOOLS_HH
+#define OPENMESH_PYTHON_TOOLS_HH
+
+#include "Python/Bindings.hh"
+
+#include <OpenMesh/Tools/Decimater/DecimaterT.hh>
+#include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
+#include <OpenMesh/Tools/Smoother/JacobiLaplaceSmootherT.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/LoopT.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/Sqrt3T.hh>
+#include <OpenMesh/Tools/Subdivider/Uniform/CatmullClarkT.hh>
+#include <OpenMesh/Tools/Utils/Timer.hh>
+
+namespace OpenMesh {
+namespace Python {
+
+/**
+ * Statistics that are returned by decimate().
+ */
+struct DecimationStats {
+	/** Number of performed collapses */
+	size_t n_collapses;
+
+	/** Number of vertices after the decimation */
+	size_t n_vertices;
+
+	/** Number of faces after the decimation */
+	size_t n_faces;
+
+	/** Time spent in seconds */
+	double time;
+};
+
+/**
+ * Statistics that are returned by smooth().
+ */
+struct SmoothingStats {
+	/** Number of performed iterations */
+	unsigned int n_iterations;
+
+	/** Time spent in seconds */
+	double time;
+};
+
+/**
+ * Statistics that are returned by subdivide().
+ */
+struct SubdivisionStats {
+	/** Number of vertices after the subdivision */
+	size_t n_vertices;
+
+	/** Number of faces after the subdivision */
+	size_t n_faces;
+
+	/** Time spent in seconds */
+	double time;
+};
+
+/**
+ * The smoother enums are exposed once for all mesh types.
+ */
+typedef Smoother::SmootherT<TriMesh>::Component  SmoothingComponent;
+typedef Smoother::SmootherT<TriMesh>::Continuity SmoothingContinuity;
+
+/**
+ * Decimate a mesh with a quadric error metric.
+ *
+ * The decimation stops as soon as the mesh has at most @p _n_vertices
+ * vertices or @p _n_faces faces, or if no collapse with an error below
+ * @p _max_err is left. Deleted items are removed afterwards.
+ *
+ * The mesh is processed with the global interpreter lock released unless it
+ * has properties that store %Python objects.
+ *
+ * @tparam Mesh A triangle mesh type.
+ *
+ * @param _mesh The mesh that is to be decimated.
+ * @param _n_vertices The target number of vertices.
+ * @param _n_faces The target number of faces.
+ * @param _max_err The maximum quadric error, no limit if not positive.
+ */
+template <class Mesh>
+DecimationStats decimate(Mesh& _mesh, size_t _n_vertices, size_t _n_faces, double _max_err) {
+	typedef Decimater::DecimaterT<Mesh>                   DecimaterType;
+	typedef typename Decimater::ModQuadricT<Mesh>::Handle HModQuadric;
+
+	DecimationStats stats;
+	Utils::Timer timer;
+
+	{
+		ScopedGILRelease release(!has_object_properties(_mesh));
+		timer.start();
+
+		_mesh.request_vertex_status();
+		_mesh.request_edge_status();
+		_mesh.request_face_status();
+
+		{
+			DecimaterType decimater(_mesh);
+			HModQuadric hmod_quadric;
+			decimater.add(hmod_quadric);
+			if (_max_err > 0.0) {
+				decimater.module(hmod_quadric).set_max_err(_max_err, false);
+			}
+			decimater.initialize();
+			stats.n_collapses = decimater.decimate_to_faces(_n_vertices, _n_faces);
+		}
+
+		_mesh.garbage_collection();
+
+		_mesh.release_vertex_status();
+		_mesh.release_edge_status();
+		_mesh.release_face_status();
+
+		timer.stop();
+	}
+
+	stats.n_vertices = _mesh.n_vertices();
+	stats.n_faces = _mesh.n_faces();
+	stats.time = timer.seconds();
+	return stats;
+}
+
+/**
+ * Smooth a mesh with the JacobiLaplaceSmootherT.
+ *
+ * Smoothing does not add or remove items, so the mesh is always processed with
+ * the global interpreter lock released.
+ *
+ * @tparam Mesh A mesh type.
+ *
+ * @param _mesh The mesh that is to be smoothed.
+ * @param _iterations The number of smoothing iterations.
+ * @param _component The component that is to be smoothed.
+ * @param _continuity The continuity of the smoothed mesh.
+ */
+template <class Mesh>
+SmoothingStats smooth(Mesh& _mesh, unsigned int _iterations, SmoothingComponent _component, SmoothingContinuity _continuity) {
+	typedef Smoother::JacobiLaplaceSmootherT<Mesh> SmootherType;
+
+	SmoothingStats stats;
+	Utils::Timer timer;
+
+	{
+		ScopedGILRelease release;
+		timer.start();
+
+		SmootherType smoother(_mesh);
+		smoother.initialize(typename SmootherType::Component(_component), typename SmootherType::Continuity(_continuity));
+		smoother.smooth(_iterations);
+
+		timer.stop();
+	}
+
+	stats.n_iterations = _iterations;
+	stats.time = timer.seconds();
+	return stats;
+}
+
+/**
+ * Subdivide a mesh with a uniform subdivision scheme.
+ *
+ * The mesh is processed with the global interpreter lock released unless it
+ * has properties that store %Python objects.
+ *
+ * @tparam Subdivider A uniform subdivider type (e.g. LoopT).
+ *
+ * @param _mesh The mesh that is to be subdivided.
+ * @param _iterations The number of subdivision steps.
+ */
+template <class Subdivider>
+SubdivisionStats subdivide(typename Subdivider::mesh_t& _mesh, size_t _iterations) {
+	SubdivisionStats stats;
+	Utils::Timer timer;
+
+	{
+		ScopedGILRelease release(!has_object_properties(_mesh));
+		timer.start();
+
+		Subdivider subdivider;
+		subdivider(_mesh, _iterations);
+
+		timer.stop();
+	}
+
+	stats.n_vertices = _mesh.n_vertices();
+	stats.n_faces = _mesh.n_faces();
+	stats.time = timer.seconds();
+	return stats;
+}
+
+/**
+ * Expose the decimater, the smoother and the uniform subdividers to %Python.
+ */
+void expose_tools() {
+	//======================================================================
+	//  Statistics
+	//======================================================================
+
+	class_<DecimationStats>("DecimationStats", no_init)
+		.def_readonly("n_collapses", &DecimationStats::n_collapses)
+		.def_readonly("n_vertices", &DecimationStats::n_vertices)
+		.def_readonly("n_faces", &DecimationStats::n_faces)
+		.def_readonly("time", &DecimationStats::time)
+		;
+
+	class_<SmoothingStats>("SmoothingStats", no_init)
+		.def_readonly("n_iterations", &SmoothingStats::n_iterations)
+		.def_readonly("time", &SmoothingStats::time)
+		;
+
+	class_<SubdivisionStats>("SubdivisionStats", no_init)
+		.def_readonly("n_vertices", &SubdivisionStats::n_vertices)
+		.def_readonly("n_faces", &SubdivisionStats::n_faces)
+		.def_readonly("time", &SubdivisionStats::time)
+		;
+
+	//======================================================================
+	//  Decimater
+	//======================================================================
+
+	def("decimate", &decimate<TriMesh>,
+		(arg("mesh"), arg("n_vertices") = 0, arg("n_faces") = 0, arg("max_err") = 0.0));
+
+	//======================================================================
+	//  Smoother
+	//======================================================================
+
+	enum_<SmoothingComponent>("SmoothingComponent")
+		.value("Tangential", Smoother::SmootherT<TriMesh>::Tangential)
+		.value("Normal", Smoother::SmootherT<TriMesh>::Normal)
+		.value("Tangential_and_Normal", Smoother::SmootherT<TriMesh>::Tangential_and_Normal)
+		;
+
+	enum_<SmoothingContinuity>("SmoothingContinuity")
+		.value("C0", Smoother::SmootherT<TriMesh>::C0)
+		.value("C1", Smoother::SmootherT<TriMesh>::C1)
+		;
+
+	def("smooth", &smooth<TriMesh>,
+		(arg("mesh"), arg("iterations") = 1,
+		 arg("component") = Smoother::SmootherT<TriMesh>::Tangential_and_Normal,
+		 arg("continuity") = Smoother::SmootherT<TriMesh>::C0));
+	def("smooth", &smooth<PolyMesh>,
+		(arg("mesh"), arg("iterations") = 1,
+		 arg("component") = Smoother::SmootherT<TriMesh>::Tangential_and_Normal,
+		 arg("continuity") = Smoother::SmootherT<TriMesh>::C0));
+
+	//======================================================================
+	//  Subdivider
+	//======================================================================
+
+	def("subdivide_loop", &subdivide<Subdivider::Uniform::LoopT<TriMesh, double> >,
+		(arg("mesh"), arg("iterations") = 1));
+	def("subdivide_sqrt3", &subdivide<Subdivider::Uniform::Sqrt3T<TriMesh, double> >,
+		(arg("mesh"), arg("iterations") = 1));
+	def("subdivide_catmull_clark", &subdivide<Subdivider::Uniform::CatmullClarkT<PolyMesh, double> >,
+		(arg("mesh"), arg("iterations") = 1));
+}
+
+} // namespace OpenMesh
+} // namespace Python
+
+#endif
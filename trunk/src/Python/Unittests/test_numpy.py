@@ -0,0 +1,123 @@
+import unittest
+import openmesh
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+# The bindings are built without the NumPy functions if NumPy is missing
+HAS_NUMPY = numpy is not None and hasattr(openmesh.TriMesh, "points")
+
+@unittest.skipUnless(HAS_NUMPY, "openmesh is built without NumPy support")
+class NumPy(unittest.TestCase):
+
+    def setUp(self):
+        self.mesh = openmesh.TriMesh()
+
+        # Add some vertices
+        self.vhandle = []
+
+        self.vhandle.append(self.mesh.add_vertex(openmesh.Vec3d(0, 1, 0)))
+        self.vhandle.append(self.mesh.add_vertex(openmesh.Vec3d(1, 0, 0)))
+        self.vhandle.append(self.mesh.add_vertex(openmesh.Vec3d(2, 1, 0)))
+        self.vhandle.append(self.mesh.add_vertex(openmesh.Vec3d(1, 2, 0)))
+
+        # Add two faces
+        self.mesh.add_face(self.vhandle[2], self.vhandle[1], self.vhandle[0])
+        self.mesh.add_face(self.vhandle[2], self.vhandle[0], self.vhandle[3])
+
+    def test_points(self):
+        points = self.mesh.points()
+        self.assertEqual(points.shape, (4, 3))
+        self.assertEqual(points.dtype, numpy.float64)
+        self.assertEqual(points[2, 0], 2.0)
+        self.assertEqual(points[3, 1], 2.0)
+
+    def test_points_are_views(self):
+        points = self.mesh.points()
+
+        # Changes to the array are visible in the mesh
+        points[1] = [4, 5, 6]
+        self.assertEqual(self.mesh.point(self.vhandle[1])[0], 4.0)
+        self.assertEqual(self.mesh.point(self.vhandle[1])[1], 5.0)
+        self.assertEqual(self.mesh.point(self.vhandle[1])[2], 6.0)
+
+        # Changes to the mesh are visible in the array
+        self.mesh.set_point(self.vhandle[0], openmesh.Vec3d(7, 8, 9))
+        self.assertEqual(points[0, 0], 7.0)
+        self.assertEqual(points[0, 1], 8.0)
+        self.assertEqual(points[0, 2], 9.0)
+
+    def test_view_keeps_mesh_alive(self):
+        points = self.mesh.points()
+        del self.mesh
+        self.assertEqual(points[2, 0], 2.0)
+
+    def test_normals(self):
+        # Properties that have not been requested raise an error
+        self.assertRaises(RuntimeError, self.mesh.vertex_normals)
+        self.assertRaises(RuntimeError, self.mesh.face_normals)
+
+        self.mesh.request_vertex_normals()
+        self.mesh.request_face_normals()
+        self.mesh.update_normals()
+
+        vertex_normals = self.mesh.vertex_normals()
+        face_normals = self.mesh.face_normals()
+        self.assertEqual(vertex_normals.shape, (4, 3))
+        self.assertEqual(face_normals.shape, (2, 3))
+        self.assertTrue(numpy.allclose(vertex_normals, [0, 0, -1]))
+        self.assertTrue(numpy.allclose(face_normals, [0, 0, -1]))
+
+    def test_colors(self):
+        self.mesh.request_vertex_colors()
+        self.mesh.set_color(self.vhandle[3], openmesh.Vec4f(0.5, 0.25, 1, 1))
+
+        colors = self.mesh.vertex_colors()
+        self.assertEqual(colors.shape, (4, 4))
+        self.assertEqual(colors.dtype, numpy.float32)
+        self.assertTrue(numpy.allclose(colors[3], [0.5, 0.25, 1, 1]))
+
+    def test_face_vertex_indices(self):
+        indices = self.mesh.face_vertex_indices()
+        self.assertEqual(indices.shape, (2, 3))
+        self.assertEqual(indices.tolist(), [[2, 1, 0], [2, 0, 3]])
+
+        # Deleted faces are filled with -1
+        self.mesh.request_face_status()
+        self.mesh.request_edge_status()
+        self.mesh.request_vertex_status()
+        self.mesh.delete_face(self.mesh.face_handle(0), False)
+        indices = self.mesh.face_vertex_indices()
+        self.assertEqual(indices.tolist(), [[-1, -1, -1], [2, 0, 3]])
+
+    def test_face_vertex_indices_poly(self):
+        mesh = openmesh.PolyMesh()
+        vh = []
+        for i in range(5):
+            vh.append(mesh.add_vertex(openmesh.Vec3d(i, i * i, 0)))
+        mesh.add_face(vh[0], vh[1], vh[2], vh[3])
+        mesh.add_face(vh[0], vh[3], vh[4])
+
+        indices = mesh.face_vertex_indices()
+        self.assertEqual(indices.shape, (2, 4))
+        self.assertEqual(indices.tolist(), [[0, 1, 2, 3], [0, 3, 4, -1]])
+
+    def test_ev_indices(self):
+        indices = self.mesh.ev_indices()
+        self.assertEqual(indices.shape, (5, 2))
+        for eh in self.mesh.edges():
+            heh = self.mesh.halfedge_handle(eh, 0)
+            self.assertEqual(indices[eh.idx(), 0], self.mesh.from_vertex_handle(heh).idx())
+            self.assertEqual(indices[eh.idx(), 1], self.mesh.to_vertex_handle(heh).idx())
+
+    def test_empty_mesh(self):
+        mesh = openmesh.TriMesh()
+        self.assertEqual(mesh.points().shape, (0, 3))
+        self.assertEqual(mesh.face_vertex_indices().shape, (0, 3))
+        self.assertEqual(mesh.ev_indices().shape, (0, 2))
+
+
+if __name__ == '__main__':
+    suite = unittest.TestLoader().loadTestsFromTestCase(NumPy)
+    unittest.TextTestRunner(verbosity=2).run(suite)
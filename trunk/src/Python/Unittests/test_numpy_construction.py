@@ -0,0 +1,118 @@
+import unittest
+import openmesh
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+# The bindings are built without the NumPy functions if NumPy is missing
+HAS_NUMPY = numpy is not None and hasattr(openmesh.TriMesh, "points")
+
+from multiprocessing.pool import ThreadPool
+
+@unittest.skipUnless(HAS_NUMPY, "openmesh is built without NumPy support")
+class NumPyConstruction(unittest.TestCase):
+
+    def setUp(self):
+        # A square that is divided into two triangles
+        self.points = numpy.array([[0, 0, 0], [1, 0, 0], [1, 1, 0], [0, 1, 0]], dtype=float)
+        self.faces = numpy.array([[0, 1, 2], [0, 2, 3]])
+
+    def test_trimesh_constructor(self):
+        mesh = openmesh.TriMesh(self.points, self.faces)
+        self.assertEqual(mesh.n_vertices(), 4)
+        self.assertEqual(mesh.n_edges(), 5)
+        self.assertEqual(mesh.n_faces(), 2)
+        self.assertTrue(numpy.array_equal(mesh.points(), self.points))
+        self.assertEqual(mesh.face_vertex_indices().tolist(), self.faces.tolist())
+
+    def test_polymesh_constructor(self):
+        points = numpy.vstack([self.points, [[2, 0, 0]]])
+        faces = [[0, 1, 2, 3], [1, 4, 2, -1]]
+
+        mesh = openmesh.PolyMesh(points, faces)
+        self.assertEqual(mesh.n_vertices(), 5)
+        self.assertEqual(mesh.n_faces(), 2)
+        self.assertEqual(mesh.valence(mesh.face_handle(0)), 4)
+        self.assertEqual(mesh.valence(mesh.face_handle(1)), 3)
+        self.assertEqual(mesh.face_vertex_indices().tolist(), faces)
+
+    def test_add_vertices_and_faces(self):
+        mesh = openmesh.TriMesh()
+        mesh.add_vertices(self.points)
+        self.assertEqual(mesh.n_vertices(), 4)
+
+        face_indices = mesh.add_faces(self.faces)
+        self.assertEqual(face_indices.tolist(), [0, 1])
+
+        # The vertex indices of added faces refer to all vertices of the mesh
+        mesh.add_vertices([[2, 0, 0]])
+        face_indices = mesh.add_faces([[1, 4, 2]])
+        self.assertEqual(face_indices.tolist(), [2])
+        self.assertEqual(mesh.n_faces(), 3)
+
+    def test_add_faces_complex_edge(self):
+        mesh = openmesh.TriMesh(self.points, self.faces)
+
+        # The face has the same orientation as the first face
+        face_indices = mesh.add_faces([[0, 1, 3]])
+        self.assertEqual(face_indices.tolist(), [-1])
+        self.assertEqual(mesh.n_faces(), 2)
+
+    def test_invalid_input(self):
+        mesh = openmesh.TriMesh()
+        self.assertRaises(ValueError, mesh.add_vertices, [[0, 0], [1, 1]])
+
+        mesh.add_vertices(self.points)
+        self.assertRaises(ValueError, mesh.add_faces, [[0, 1]])
+        self.assertRaises(ValueError, mesh.add_faces, [[0, 1, 2], [0, 2, 4]])
+        self.assertRaises(ValueError, mesh.add_faces, [[0, 1, -2]])
+
+        # No faces are added if an index is out of range
+        self.assertEqual(mesh.n_faces(), 0)
+
+    def test_empty_input(self):
+        mesh = openmesh.TriMesh(numpy.empty((0, 3)), [])
+        self.assertEqual(mesh.n_vertices(), 0)
+        self.assertEqual(mesh.n_faces(), 0)
+
+    def test_object_properties(self):
+        mesh = openmesh.TriMesh()
+        vprop = openmesh.VPropHandle()
+        fprop = openmesh.FPropHandle()
+        mesh.add_property(vprop)
+        mesh.add_property(fprop)
+
+        # Adding items to a mesh with Python properties keeps the GIL
+        mesh.add_vertices(self.points)
+        mesh.add_faces(self.faces)
+        mesh.set_property(vprop, mesh.vertex_handle(3), "vertex")
+        mesh.set_property(fprop, mesh.face_handle(1), "face")
+        self.assertEqual(mesh.property(vprop, mesh.vertex_handle(3)), "vertex")
+        self.assertEqual(mesh.property(fprop, mesh.face_handle(1)), "face")
+        self.assertEqual(mesh.property(vprop, mesh.vertex_handle(0)), None)
+
+    def test_threads(self):
+        # Build a grid of n x n quads
+        n = 50
+        x, y = numpy.meshgrid(numpy.arange(n + 1), numpy.arange(n + 1))
+        points = numpy.column_stack([x.ravel(), y.ravel(), numpy.zeros(x.size)])
+        i, j = numpy.meshgrid(numpy.arange(n), numpy.arange(n))
+        v = (i + j * (n + 1)).ravel()
+        faces = numpy.vstack([
+            numpy.column_stack([v, v + 1, v + n + 2]),
+            numpy.column_stack([v, v + n + 2, v + n + 1])
+        ])
+
+        pool = ThreadPool(4)
+        meshes = pool.map(lambda k: openmesh.TriMesh(points, faces), range(8))
+        pool.close()
+
+        for mesh in meshes:
+            self.assertEqual(mesh.n_vertices(), (n + 1) * (n + 1))
+            self.assertEqual(mesh.n_faces(), 2 * n * n)
+
+
+if __name__ == '__main__':
+    suite = unittest.TestLoader().loadTestsFromTestCase(NumPyConstruction)
+    unittest.TextTestRunner(verbosity=2).run(suite)
@@ -0,0 +1,101 @@
+import unittest
+import openmesh
+
+from multiprocessing.pool import ThreadPool
+
+class Tools(unittest.TestCase):
+
+    def setUp(self):
+        self.mesh = openmesh.TriMesh()
+        openmesh.read_mesh(self.mesh, "cube1.off")
+
+        # The unit cube as a polygon mesh
+        points = [[0, 0, 0], [1, 0, 0], [1, 1, 0], [0, 1, 0],
+                  [0, 0, 1], [1, 0, 1], [1, 1, 1], [0, 1, 1]]
+        faces = [[0, 3, 2, 1], [4, 5, 6, 7], [0, 1, 5, 4],
+                 [1, 2, 6, 5], [2, 3, 7, 6], [3, 0, 4, 7]]
+        self.cube = openmesh.PolyMesh()
+        vhandles = [self.cube.add_vertex(openmesh.Vec3d(*p)) for p in points]
+        for face in faces:
+            self.cube.add_face([vhandles[i] for i in face])
+
+    def test_decimate(self):
+        self.assertEqual(self.mesh.n_vertices(), 7526)
+
+        stats = openmesh.decimate(self.mesh, n_vertices=1000)
+        self.assertEqual(stats.n_collapses, 6526)
+        self.assertEqual(stats.n_vertices, 1000)
+        self.assertEqual(self.mesh.n_vertices(), 1000)
+        self.assertEqual(stats.n_faces, self.mesh.n_faces())
+        self.assertTrue(stats.time >= 0.0)
+
+        # Deleted items have been removed
+        self.assertFalse(self.mesh.has_vertex_status())
+        indices = [vh.idx() for fh in self.mesh.faces() for vh in self.mesh.fv(fh)]
+        self.assertEqual(min(indices), 0)
+
+    def test_decimate_max_err(self):
+        n_faces = self.mesh.n_faces()
+
+        # Collapses of the flat regions of the cube do not cause any error
+        stats = openmesh.decimate(self.mesh, max_err=1e-10)
+        self.assertTrue(stats.n_collapses > 0)
+        self.assertEqual(stats.n_faces, self.mesh.n_faces())
+        self.assertTrue(stats.n_faces < n_faces)
+
+    def test_smooth(self):
+        points = [self.mesh.point(vh) for vh in self.mesh.vertices()]
+
+        stats = openmesh.smooth(self.mesh, 5)
+        self.assertEqual(stats.n_iterations, 5)
+        self.assertTrue(stats.time >= 0.0)
+        self.assertNotEqual([self.mesh.point(vh) for vh in self.mesh.vertices()], points)
+
+        # The requested properties have been released
+        self.assertFalse(self.mesh.has_vertex_normals())
+
+    def test_smooth_poly(self):
+        stats = openmesh.smooth(self.cube, 3, openmesh.SmoothingComponent.Tangential, openmesh.SmoothingContinuity.C1)
+        self.assertEqual(stats.n_iterations, 3)
+
+    def test_subdivide(self):
+        n_faces = self.mesh.n_faces()
+
+        stats = openmesh.subdivide_loop(self.mesh)
+        self.assertEqual(stats.n_faces, 4 * n_faces)
+        self.assertEqual(self.mesh.n_faces(), 4 * n_faces)
+
+        stats = openmesh.subdivide_sqrt3(self.mesh, 2)
+        self.assertEqual(stats.n_faces, 36 * n_faces)
+
+        stats = openmesh.subdivide_catmull_clark(self.cube, 2)
+        self.assertEqual(stats.n_faces, 96)
+        self.assertEqual(stats.n_vertices, 98)
+
+    def test_object_properties(self):
+        # Meshes with Python properties are processed with the GIL held
+        prop = openmesh.VPropHandle()
+        self.mesh.add_property(prop)
+        self.mesh.set_property(prop, self.mesh.vertex_handle(0), "vertex")
+
+        openmesh.subdivide_loop(self.mesh)
+        openmesh.decimate(self.mesh, n_vertices=1000)
+        self.assertEqual(self.mesh.n_vertices(), 1000)
+
+    def test_threads(self):
+        meshes = [openmesh.TriMesh() for i in range(4)]
+        for mesh in meshes:
+            openmesh.read_mesh(mesh, "cube1.off")
+
+        pool = ThreadPool(4)
+        stats = pool.map(lambda mesh: openmesh.decimate(mesh, n_faces=500), meshes)
+        pool.close()
+
+        for s, mesh in zip(stats, meshes):
+            self.assertEqual(s.n_faces, mesh.n_faces())
+            self.assertTrue(mesh.n_faces() <= 500)
+
+
+if __name__ == '__main__':
+    suite = unittest.TestLoader().loadTestsFromTestCase(Tools)
+    unittest.TextTestRunner(verbosity=2).run(suite)
@@ -0,0 +1,131 @@
+import unittest
+import openmesh
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+# The bindings are built without the NumPy functions if NumPy is missing
+HAS_NUMPY = numpy is not None and hasattr(openmesh.TriMesh, "points")
+
+class TypedProperty(unittest.TestCase):
+
+    def setUp(self):
+        points = [[0, 0, 0], [1, 0, 0], [1, 1, 0], [0, 1, 0]]
+        faces = [[0, 1, 2], [0, 2, 3]]
+        self.mesh = openmesh.TriMesh()
+        vhandles = [self.mesh.add_vertex(openmesh.Vec3d(*p)) for p in points]
+        for face in faces:
+            self.mesh.add_face([vhandles[i] for i in face])
+
+    def test_add_remove_property(self):
+        prop = openmesh.VPropHandleFloat()
+        self.assertFalse(prop.is_valid())
+
+        self.mesh.add_property(prop, "quality")
+        self.assertTrue(prop.is_valid())
+
+        handle = openmesh.VPropHandleFloat()
+        self.assertTrue(self.mesh.get_property_handle(handle, "quality"))
+        self.assertEqual(handle.idx(), prop.idx())
+
+        # Properties of other types are not found
+        self.assertFalse(self.mesh.get_property_handle(openmesh.VPropHandleInt(), "quality"))
+        self.assertFalse(self.mesh.get_property_handle(openmesh.VPropHandle(), "quality"))
+
+        self.mesh.remove_property(prop)
+        self.assertFalse(prop.is_valid())
+        self.assertFalse(self.mesh.get_property_handle(handle, "quality"))
+
+    def test_item_access(self):
+        vprop = openmesh.VPropHandleInt()
+        eprop = openmesh.EPropHandleDouble()
+        hprop = openmesh.HPropHandleFloat()
+        fprop = openmesh.FPropHandleVec3d()
+        self.mesh.add_property(vprop)
+        self.mesh.add_property(eprop)
+        self.mesh.add_property(hprop)
+        self.mesh.add_property(fprop)
+
+        vh = self.mesh.vertex_handle(2)
+        eh = self.mesh.edge_handle(3)
+        hh = self.mesh.halfedge_handle(1)
+        fh = self.mesh.face_handle(1)
+
+        self.mesh.set_property(vprop, vh, 42)
+        self.mesh.set_property(eprop, eh, 0.125)
+        self.mesh.set_property(hprop, hh, 1.5)
+        self.mesh.set_property(fprop, fh, openmesh.Vec3d(1, 2, 3))
+
+        self.assertEqual(self.mesh.property(vprop, vh), 42)
+        self.assertEqual(self.mesh.property(eprop, eh), 0.125)
+        self.assertEqual(self.mesh.property(hprop, hh), 1.5)
+        self.assertEqual(self.mesh.property(fprop, fh), openmesh.Vec3d(1, 2, 3))
+
+    @unittest.skipUnless(HAS_NUMPY, "openmesh is built without NumPy support")
+    def test_scalar_array(self):
+        prop = openmesh.VPropHandleFloat()
+        self.mesh.add_property(prop)
+
+        array = self.mesh.property_array(prop)
+        self.assertEqual(array.shape, (4,))
+        self.assertEqual(array.dtype, numpy.float32)
+
+        # The array is a view of the property
+        array[:] = [0.5, 1.5, 2.5, 3.5]
+        self.assertEqual(self.mesh.property(prop, self.mesh.vertex_handle(2)), 2.5)
+
+        self.mesh.set_property(prop, self.mesh.vertex_handle(0), -1.0)
+        self.assertEqual(array[0], -1.0)
+
+    @unittest.skipUnless(HAS_NUMPY, "openmesh is built without NumPy support")
+    def test_vector_array(self):
+        prop = openmesh.FPropHandleVec3d()
+        self.mesh.add_property(prop)
+
+        array = self.mesh.property_array(prop)
+        self.assertEqual(array.shape, (2, 3))
+        self.assertEqual(array.dtype, numpy.float64)
+
+        array[:] = 0
+        array += [1, 2, 3]
+        self.assertEqual(self.mesh.property(prop, self.mesh.face_handle(1)), openmesh.Vec3d(1, 2, 3))
+
+    @unittest.skipUnless(HAS_NUMPY, "openmesh is built without NumPy support")
+    def test_set_property_array(self):
+        vprop = openmesh.VPropHandleInt()
+        eprop = openmesh.EPropHandleVec3f()
+        self.mesh.add_property(vprop)
+        self.mesh.add_property(eprop)
+
+        self.mesh.set_property_array(vprop, numpy.arange(4) * 10)
+        self.assertEqual(self.mesh.property_array(vprop).tolist(), [0, 10, 20, 30])
+        self.assertEqual(self.mesh.property(vprop, self.mesh.vertex_handle(3)), 30)
+
+        # Values are broadcast to all items
+        self.mesh.set_property_array(eprop, [1, 0, 0])
+        self.assertTrue(numpy.array_equal(self.mesh.property_array(eprop), numpy.tile([1, 0, 0], (5, 1))))
+
+        # Arrays with a wrong shape are rejected
+        self.assertRaises(ValueError, self.mesh.set_property_array, vprop, [1, 2, 3])
+
+    @unittest.skipUnless(HAS_NUMPY, "openmesh is built without NumPy support")
+    def test_invalid_handle(self):
+        self.assertRaises(RuntimeError, self.mesh.property_array, openmesh.VPropHandleFloat())
+
+    @unittest.skipUnless(HAS_NUMPY, "openmesh is built without NumPy support")
+    def test_add_items(self):
+        prop = openmesh.VPropHandleDouble()
+        self.mesh.add_property(prop)
+        self.mesh.set_property_array(prop, 1.0)
+
+        # The property grows with the mesh
+        self.mesh.add_vertices([[2, 0, 0], [2, 1, 0]])
+        array = self.mesh.property_array(prop)
+        self.assertEqual(array.shape, (6,))
+        self.assertEqual(array[:4].tolist(), [1.0] * 4)
+
+
+if __name__ == '__main__':
+    suite = unittest.TestLoader().loadTestsFromTestCase(TypedProperty)
+    unittest.TextTestRunner(verbosity=2).run(suite)
@@ -3,6 +3,11 @@
 #include <Unittests/unittests_common.hh>
 #include <OpenMesh/Tools/Decimater/DecimaterT.hh>
 #include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
+#include <OpenMesh/Tools/Decimater/ModAttribQuadricT.hh>
+#include <OpenMesh/Tools/Decimater/ModHausdorffT.hh>
+#include <OpenMesh/Tools/Decimater/ModNormalDeviationT.hh>
+#include <OpenMesh/Tools/Decimater/PartitionDecimaterT.hh>
+#include <OpenMesh/Tools/Decimater/VertexClusteringT.hh>
 
 namespace {
 
@@ -103,6 +108,37 @@ TEST_F(OpenMeshDecimater, DecimateMeshToFaceFaceLimit) {
   EXPECT_EQ(9996u, mesh_.n_faces()) << "The number of faces after decimation is not correct!";
 }
 
+/*
+ * The Hausdorff module has to stop the decimation before the tolerance
+ * is exceeded.
+ */
+TEST_F(OpenMeshDecimater, DecimateMeshHausdorff) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  typedef OpenMesh::Decimater::DecimaterT< Mesh >  Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT< Mesh >::Handle HModQuadric;
+  typedef OpenMesh::Decimater::ModHausdorffT< Mesh >::Handle HModHausdorff;
+
+  Decimater decimaterDBG(mesh_);
+  HModQuadric hModQuadricDBG;
+  HModHausdorff hModHausdorffDBG;
+  decimaterDBG.add( hModQuadricDBG );
+  decimaterDBG.add( hModHausdorffDBG );
+  decimaterDBG.module( hModHausdorffDBG ).set_tolerance(0.001f);
+  decimaterDBG.initialize();
+  size_t removedVertices = 0;
+  removedVertices = decimaterDBG.decimate_to(0);
+                    decimaterDBG.mesh().garbage_collection();
+
+  EXPECT_EQ(6311u, removedVertices) << "The number of remove vertices is not correct!";
+  EXPECT_EQ(1215u, mesh_.n_vertices()) << "The number of vertices after decimation is not correct!";
+  EXPECT_EQ(3639u, mesh_.n_edges()) << "The number of edges after decimation is not correct!";
+  EXPECT_EQ(2426u, mesh_.n_faces()) << "The number of faces after decimation is not correct!";
+}
+
 TEST_F(OpenMeshDecimater, DecimateMeshExampleFromDoc) {
 
   bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
@@ -129,6 +165,198 @@ TEST_F(OpenMeshDecimater, DecimateMeshExampleFromDoc) {
   EXPECT_EQ(9996u, mesh_.n_faces()) << "The number of faces after decimation is not correct!";
 }
 
+/*
+ * Batched quadric evaluation gives the same errors as single quadrics
+ */
+TEST_F(OpenMeshDecimater, QuadricBatchEvaluation) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  OpenMesh::Geometry::QuadricBatchd batchd;
+  OpenMesh::Geometry::QuadricBatchf batchf;
+  std::vector<OpenMesh::Geometry::Quadricd> quadrics;
+
+  // a plane quadric per face, evaluated at the next face's first vertex
+  for (Mesh::FaceIter f_it = mesh_.faces_begin(); f_it != mesh_.faces_end(); ++f_it) {
+    Mesh::FaceVertexIter fv_it = mesh_.fv_iter(*f_it);
+    Mesh::Point p0 = mesh_.point(*fv_it); ++fv_it;
+    Mesh::Point p1 = mesh_.point(*fv_it); ++fv_it;
+    Mesh::Point p2 = mesh_.point(*fv_it);
+    Mesh::Normal n = (p1 - p0) % (p2 - p0);
+
+    OpenMesh::Geometry::Quadricd q(n[0], n[1], n[2], -(n | p0));
+    quadrics.push_back(q);
+  }
+
+  // the batch is reused, and its size is no multiple of the block size
+  batchd.push_back(quadrics[0], mesh_.point(mesh_.vertex_handle(0)));
+  batchd.clear();
+
+  const size_t n = 1003;
+  for (size_t k = 0; k < n; ++k) {
+    const Mesh::Point& p = mesh_.point(mesh_.vertex_handle(int((k + 1) % mesh_.n_vertices())));
+    batchd.push_back(quadrics[k], p);
+    batchf.push_back(quadrics[k], p);
+  }
+
+  EXPECT_EQ(n, batchd.size()) << "Wrong batch size";
+
+  std::vector<double> errorsd(n);
+  std::vector<float>  errorsf(n);
+  batchd.evaluate(&errorsd[0]);
+  batchf.evaluate(&errorsf[0]);
+
+  for (size_t k = 0; k < n; ++k) {
+    const double err = quadrics[k](mesh_.point(mesh_.vertex_handle(int((k + 1) % mesh_.n_vertices()))));
+    EXPECT_EQ(err, errorsd[k]) << "Wrong double error at " << k;
+    EXPECT_NEAR(err, errorsf[k], 1e-4 * (1.0 + err)) << "Wrong float error at " << k;
+  }
+}
+
+/*
+ * Optimal placement removes more vertices for the same error bound
+ */
+TEST_F(OpenMeshDecimater, DecimateMeshOptimalPlacement) {
+
+  typedef OpenMesh::Decimater::DecimaterT< Mesh >  Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT< Mesh >::Handle HModQuadric;
+
+  size_t n_vertices[2];
+
+  for (int optimal = 0; optimal < 2; ++optimal) {
+    Mesh mesh;
+    bool ok = OpenMesh::IO::read_mesh(mesh, "cube1.off");
+
+    ASSERT_TRUE(ok);
+
+    Decimater decimaterDBG(mesh);
+    HModQuadric hModQuadricDBG;
+    decimaterDBG.add( hModQuadricDBG );
+    decimaterDBG.module( hModQuadricDBG ).set_max_err( 1e-6, false );
+    decimaterDBG.module( hModQuadricDBG ).set_optimal_placement( optimal == 1 );
+    decimaterDBG.initialize();
+    decimaterDBG.decimate_to(0);
+    mesh.garbage_collection();
+
+    n_vertices[optimal] = mesh.n_vertices();
+  }
+
+  EXPECT_EQ(255u, n_vertices[0]) << "The number of vertices with endpoint placement is not correct!";
+  EXPECT_EQ(200u, n_vertices[1]) << "The number of vertices with optimal placement is not correct!";
+}
+
+/*
+ * Other modules test collapses at p1 and cannot be combined with optimal placement
+ */
+TEST_F(OpenMeshDecimater, OptimalPlacementWithOtherModules) {
+
+  typedef OpenMesh::Decimater::DecimaterT< Mesh >  Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT< Mesh >::Handle HModQuadric;
+  typedef OpenMesh::Decimater::ModNormalDeviationT< Mesh >::Handle HModNormalDeviation;
+
+  Mesh mesh;
+  bool ok = OpenMesh::IO::read_mesh(mesh, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  Decimater decimaterDBG(mesh);
+  HModQuadric hModQuadricDBG;
+  HModNormalDeviation hModNormalDeviationDBG;
+  decimaterDBG.add( hModQuadricDBG );
+  decimaterDBG.add( hModNormalDeviationDBG );
+  decimaterDBG.module( hModQuadricDBG ).set_optimal_placement( true );
+
+  EXPECT_FALSE(decimaterDBG.initialize()) << "Optimal placement should not be accepted with a binary module!";
+  EXPECT_EQ(0u, decimaterDBG.decimate_to(0)) << "An uninitialized decimater should not collapse!";
+
+  decimaterDBG.module( hModQuadricDBG ).set_optimal_placement( false );
+
+  EXPECT_TRUE(decimaterDBG.initialize()) << "Endpoint placement should be accepted with a binary module!";
+}
+
+/*
+ * The minimizer of a quadric is the common point of its planes
+ */
+TEST_F(OpenMeshDecimater, QuadricMinimizer) {
+
+  typedef OpenMesh::Geometry::Quadricd Quadric;
+
+  // planes x = 1, y = 2 and z = 3
+  Quadric q(1.0, 0.0, 0.0, -1.0);
+  q += Quadric(0.0, 1.0, 0.0, -2.0);
+
+  OpenMesh::Vec3d p(0.0, 0.0, 0.0);
+
+  // two planes meet in a line
+  EXPECT_FALSE(q.minimizer(p)) << "The minimizer of two planes should not be unique!";
+  EXPECT_EQ(0.0, p[0]) << "The point should be unchanged!";
+
+  q += Quadric(0.0, 0.0, 1.0, -3.0);
+
+  EXPECT_TRUE(q.minimizer(p)) << "The minimizer of three planes should be unique!";
+  EXPECT_NEAR(1.0, p[0], 1e-12) << "Wrong x coordinate of the minimizer!";
+  EXPECT_NEAR(2.0, p[1], 1e-12) << "Wrong y coordinate of the minimizer!";
+  EXPECT_NEAR(3.0, p[2], 1e-12) << "Wrong z coordinate of the minimizer!";
+  EXPECT_NEAR(0.0, q(p), 1e-12) << "The error at the minimizer should be zero!";
+}
+
+/*
+ */
+TEST_F(OpenMeshDecimater, DecimateMeshNormalDeviation) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  typedef OpenMesh::Decimater::DecimaterT< Mesh >  Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT< Mesh >::Handle HModQuadric;
+  typedef OpenMesh::Decimater::ModNormalDeviationT< Mesh >::Handle HModNormalDeviation;
+
+  Decimater decimaterDBG(mesh_);
+  HModQuadric hModQuadricDBG;
+  HModNormalDeviation hModNormalDeviationDBG;
+  decimaterDBG.add( hModQuadricDBG );
+  decimaterDBG.add( hModNormalDeviationDBG );
+  decimaterDBG.module( hModQuadricDBG ).unset_max_err();
+  decimaterDBG.module( hModNormalDeviationDBG ).set_normal_deviation( 10.0f );
+  decimaterDBG.initialize();
+  size_t removedVertices = 0;
+  removedVertices = decimaterDBG.decimate_to(0);
+  decimaterDBG.mesh().garbage_collection();
+
+  EXPECT_EQ(6652u, removedVertices) << "The number of remove vertices is not correct!";
+  EXPECT_EQ(874u, mesh_.n_vertices()) << "The number of vertices after decimation is not correct!";
+  EXPECT_EQ(1744u, mesh_.n_faces()) << "The number of faces after decimation is not correct!";
+}
+
+/*
+ * The angle of a merged normal cone can be computed without merging
+ */
+TEST_F(OpenMeshDecimater, NormalConeMergedAngle) {
+
+  typedef OpenMesh::NormalConeT<float> NormalCone;
+
+  NormalCone cone(OpenMesh::Vec3f(0.0f, 0.0f, 1.0f), 0.2f);
+
+  const OpenMesh::Vec3f normals[4] = {
+    OpenMesh::Vec3f(0.0f, 0.0f, 1.0f),                      // the axis
+    OpenMesh::Vec3f(0.1f, 0.0f, 1.0f).normalize(),          // inside
+    OpenMesh::Vec3f(1.0f, 1.0f, 1.0f).normalize(),          // outside
+    OpenMesh::Vec3f(0.0f, 0.0f, -1.0f)                      // opposite
+  };
+
+  for (int i = 0; i < 4; ++i) {
+    NormalCone merged = cone;
+    merged.merge(NormalCone(normals[i]));
+    EXPECT_FLOAT_EQ(merged.angle(), cone.merged_angle(normals[i])) << "Wrong angle for normal " << i;
+  }
+
+  // the cone does not grow for normals inside of it
+  EXPECT_FLOAT_EQ(0.2f, cone.merged_angle(normals[1])) << "Cone grew for an enclosed normal";
+}
+
 class UnittestObserver : public OpenMesh::Decimater::Observer
 {
     size_t notifies_;
@@ -152,6 +380,269 @@ public:
     }
 };
 
+/*
+ * Attribute quadrics keep the border between two colors on a flat grid,
+ * plane quadrics lose one of the colors
+ */
+TEST_F(OpenMeshDecimater, DecimateMeshAttribQuadric) {
+
+  typedef OpenMesh::Decimater::DecimaterT< Mesh >  Decimater;
+  typedef OpenMesh::Decimater::ModAttribQuadricT< Mesh >::Handle HModAttribQuadric;
+
+  size_t n_vertices[2];
+  size_t n_red[2];
+  size_t n_crossing[2];
+
+  for (int colors = 0; colors < 2; ++colors) {
+    Mesh mesh;
+    mesh.request_vertex_colors();
+
+    // 20x20 vertices, red for x < 10 and blue for x >= 10
+    std::vector<Mesh::VertexHandle> vhs;
+    for (int y = 0; y < 20; ++y)
+      for (int x = 0; x < 20; ++x) {
+        Mesh::VertexHandle vh = mesh.add_vertex(Mesh::Point(float(x), float(y), 0.0f));
+        mesh.set_color(vh, x < 10 ? Mesh::Color(255, 0, 0) : Mesh::Color(0, 0, 255));
+        vhs.push_back(vh);
+      }
+
+    for (int y = 0; y < 19; ++y)
+      for (int x = 0; x < 19; ++x) {
+        mesh.add_face(vhs[y*20+x], vhs[y*20+x+1], vhs[(y+1)*20+x+1]);
+        mesh.add_face(vhs[y*20+x], vhs[(y+1)*20+x+1], vhs[(y+1)*20+x]);
+      }
+
+    mesh.request_vertex_status();
+    mesh.request_edge_status();
+    mesh.request_face_status();
+
+    Decimater decimaterDBG(mesh);
+    HModAttribQuadric hModAttribQuadricDBG;
+    decimaterDBG.add( hModAttribQuadricDBG );
+    decimaterDBG.module( hModAttribQuadricDBG ).set_max_err( 1e-6, false );
+    decimaterDBG.module( hModAttribQuadricDBG ).set_color_weight( colors == 1 ? 1.0 : 0.0 );
+    decimaterDBG.initialize();
+
+    EXPECT_EQ(colors == 1 ? 6u : 3u, decimaterDBG.module( hModAttribQuadricDBG ).dimension());
+
+    decimaterDBG.decimate_to(0);
+    mesh.garbage_collection();
+
+    // edges between both colors that do not join the columns x = 9 and x = 10
+    n_crossing[colors] = 0;
+    for (Mesh::EdgeIter e_it = mesh.edges_begin(); e_it != mesh.edges_end(); ++e_it) {
+      Mesh::HalfedgeHandle heh = mesh.halfedge_handle(*e_it, 0);
+      Mesh::VertexHandle   vh0 = mesh.from_vertex_handle(heh);
+      Mesh::VertexHandle   vh1 = mesh.to_vertex_handle(heh);
+      if (mesh.color(vh0) != mesh.color(vh1) &&
+          fabs(mesh.point(vh0)[0] - mesh.point(vh1)[0]) != 1.0f)
+        ++n_crossing[colors];
+    }
+
+    n_vertices[colors] = mesh.n_vertices();
+
+    n_red[colors] = 0;
+    for (Mesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+      if (mesh.color(*v_it) == Mesh::Color(255, 0, 0))
+        ++n_red[colors];
+  }
+
+  EXPECT_EQ(3u, n_vertices[0]) << "The number of vertices with plane quadrics is not correct!";
+  EXPECT_EQ(6u, n_vertices[1]) << "The number of vertices with color quadrics is not correct!";
+  EXPECT_EQ(0u, n_red[0]) << "Plane quadrics should collapse the red half away!";
+  EXPECT_EQ(3u, n_red[1]) << "The number of red vertices with color quadrics is not correct!";
+  EXPECT_EQ(0u, n_crossing[1]) << "Color quadrics should keep the color border!";
+}
+
+/*
+ * One run with snapshots gives the same levels as separate decimations
+ */
+TEST_F(OpenMeshDecimater, DecimateMeshToLods) {
+
+  typedef OpenMesh::Decimater::DecimaterT< Mesh >  Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT< Mesh >::Handle HModQuadric;
+
+  const size_t targets[3] = { 10000, 5000, 1000 };
+
+  Mesh mesh;
+  bool ok = OpenMesh::IO::read_mesh(mesh, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  std::vector<Decimater::LevelOfDetail> lods;
+  {
+    Decimater decimaterDBG(mesh);
+    HModQuadric hModQuadricDBG;
+    decimaterDBG.add( hModQuadricDBG );
+    decimaterDBG.initialize();
+    decimaterDBG.decimate_to_lods(std::vector<size_t>(targets, targets + 3), lods);
+
+    // the last level is the decimated mesh
+    mesh.garbage_collection();
+    EXPECT_EQ(1000u, mesh.n_faces()) << "The number of faces after decimation is not correct!";
+  }
+
+  ASSERT_EQ(3u, lods.size());
+
+  for (size_t i = 0; i < 3; ++i) {
+    Mesh reference;
+    OpenMesh::IO::read_mesh(reference, "cube1.off");
+
+    Decimater decimaterDBG(reference);
+    HModQuadric hModQuadricDBG;
+    decimaterDBG.add( hModQuadricDBG );
+    decimaterDBG.initialize();
+    decimaterDBG.decimate_to_faces(0, targets[i]);
+
+    // compare the triangles by vertex handle
+    std::vector<OpenMesh::Vec3i> expected, snapshot;
+    for (Mesh::FaceIter f_it = reference.faces_begin(); f_it != reference.faces_end(); ++f_it) {
+      if (reference.status(*f_it).deleted())
+        continue;
+      Mesh::FaceVertexIter fv_it = reference.fv_iter(*f_it);
+      OpenMesh::Vec3i t;
+      t[0] = fv_it->idx(); ++fv_it;
+      t[1] = fv_it->idx(); ++fv_it;
+      t[2] = fv_it->idx();
+      expected.push_back(t);
+    }
+    for (size_t f = 0; f < lods[i].n_faces(); ++f) {
+      OpenMesh::Vec3i t;
+      for (int k = 0; k < 3; ++k) {
+        Mesh::VertexHandle vh = lods[i].vertices[lods[i].indices[3*f+k]];
+        t[k] = vh.idx();
+        EXPECT_EQ(reference.point(vh), lods[i].points[lods[i].indices[3*f+k]]);
+      }
+      snapshot.push_back(t);
+    }
+
+    EXPECT_EQ(targets[i], lods[i].n_faces()) << "The number of faces of level " << i << " is not correct!";
+    EXPECT_TRUE(expected == snapshot) << "Level " << i << " differs from a separate decimation!";
+  }
+}
+
+/*
+ * Snapshots at priority thresholds
+ */
+TEST_F(OpenMeshDecimater, DecimateMeshToPriorities) {
+
+  typedef OpenMesh::Decimater::DecimaterT< Mesh >  Decimater;
+  typedef OpenMesh::Decimater::ModQuadricT< Mesh >::Handle HModQuadric;
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  std::vector<float> priorities;
+  priorities.push_back(1e-9f);
+  priorities.push_back(1e-6f);
+  priorities.push_back(1e-3f);
+
+  Decimater decimaterDBG(mesh_);
+  HModQuadric hModQuadricDBG;
+  decimaterDBG.add( hModQuadricDBG );
+  decimaterDBG.initialize();
+
+  std::vector<Decimater::LevelOfDetail> lods;
+  decimaterDBG.decimate_to_priorities(priorities, lods);
+
+  ASSERT_EQ(3u, lods.size());
+  EXPECT_EQ(6338u, lods[0].n_faces()) << "The number of faces of level 0 is not correct!";
+  EXPECT_EQ(506u, lods[1].n_faces()) << "The number of faces of level 1 is not correct!";
+  EXPECT_EQ(36u, lods[2].n_faces()) << "The number of faces of level 2 is not correct!";
+  EXPECT_EQ(lods[2].vertices.size(), lods[2].points.size());
+
+  mesh_.garbage_collection();
+  EXPECT_EQ(lods[2].n_faces(), mesh_.n_faces()) << "The last level is not the decimated mesh!";
+
+  // a threshold is the same as a maximum quadric error
+  Mesh reference;
+  OpenMesh::IO::read_mesh(reference, "cube1.off");
+
+  Decimater decimaterRef(reference);
+  HModQuadric hModQuadricRef;
+  decimaterRef.add( hModQuadricRef );
+  decimaterRef.module( hModQuadricRef ).set_max_err( 1e-6f, false );
+  decimaterRef.initialize();
+  decimaterRef.decimate();
+  reference.garbage_collection();
+
+  EXPECT_EQ(lods[1].n_faces(), reference.n_faces()) << "Level 1 differs from decimation with maximum error!";
+}
+
+/*
+ * Decimate the chunks of a partition with locked seams
+ */
+class QuadricSetup : public OpenMesh::Decimater::PartitionDecimaterT<Mesh>::Setup {
+  public:
+    void add_modules(OpenMesh::Decimater::DecimaterT<Mesh>& _decimater) {
+      OpenMesh::Decimater::ModQuadricT<Mesh>::Handle hModQuadric;
+      _decimater.add(hModQuadric);
+      _decimater.module(hModQuadric).unset_max_err();
+    }
+};
+
+TEST_F(OpenMeshDecimater, DecimateMeshPartitioned) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  OpenMesh::Decimater::PartitionDecimaterT<Mesh> decimater(mesh_);
+  decimater.set_n_chunks(4);
+
+  QuadricSetup setup;
+  size_t removedVertices = decimater.decimate_to_faces(1000, setup);
+
+  EXPECT_GT(decimater.n_seam_vertices(), 0u) << "The chunks have no seams!";
+  EXPECT_EQ(0u, decimater.n_stitch_failures()) << "Faces were lost while stitching the chunks!";
+  EXPECT_EQ(mesh_.n_vertices() + removedVertices, 7526u) << "The number of collapses is not correct!";
+  EXPECT_EQ(1000u, mesh_.n_faces()) << "The number of faces after decimation is not correct!";
+
+  // the stitched mesh is still a closed surface of genus 0
+  EXPECT_EQ(2, int(mesh_.n_vertices()) - int(mesh_.n_edges()) + int(mesh_.n_faces())) << "The chunks were not stitched correctly!";
+  for (Mesh::EdgeIter e_it = mesh_.edges_begin(); e_it != mesh_.edges_end(); ++e_it)
+    EXPECT_FALSE(mesh_.is_boundary(*e_it)) << "The stitched mesh has a boundary!";
+}
+
+/*
+ * Simplify by vertex clustering
+ */
+TEST_F(OpenMeshDecimater, VertexClustering) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  typedef OpenMesh::Decimater::VertexClusteringT<Mesh> VertexClustering;
+
+  VertexClustering clustering(mesh_);
+  clustering.set_grid_size(8);
+
+  Mesh mean, quadric;
+
+  clustering.set_representative(VertexClustering::Mean);
+  EXPECT_EQ(588u, clustering.simplify(mean)) << "The number of faces after clustering is not correct!";
+  EXPECT_EQ(296u, clustering.n_cells()) << "The number of occupied cells is not correct!";
+  EXPECT_EQ(296u, mean.n_vertices()) << "The number of vertices after clustering is not correct!";
+  EXPECT_EQ(0u, clustering.n_dropped_faces());
+
+  // the representatives only move the vertices
+  clustering.set_representative(VertexClustering::Quadric);
+  EXPECT_EQ(588u, clustering.simplify(quadric)) << "The number of faces after clustering is not correct!";
+  EXPECT_EQ(296u, quadric.n_vertices()) << "The number of vertices after clustering is not correct!";
+
+  EXPECT_EQ(2, int(quadric.n_vertices()) - int(quadric.n_edges()) + int(quadric.n_faces())) << "The result is not a closed surface of genus 0!";
+  for (Mesh::EdgeIter e_it = quadric.edges_begin(); e_it != quadric.edges_end(); ++e_it)
+    EXPECT_FALSE(quadric.is_boundary(*e_it)) << "The result has a boundary!";
+
+  // the result is rebuilt from scratch
+  clustering.set_grid_size(4);
+  EXPECT_EQ(108u, clustering.simplify(quadric)) << "The number of faces after clustering is not correct!";
+  EXPECT_EQ(56u, quadric.n_vertices()) << "The number of vertices after clustering is not correct!";
+  EXPECT_EQ(15048u, mesh_.n_faces()) << "The input mesh was modified!";
+}
+
 TEST_F(OpenMeshDecimater, DecimateMeshStoppedByObserver) {
 
     bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
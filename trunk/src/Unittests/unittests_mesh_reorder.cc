@@ -0,0 +1,114 @@
+
+#include <gtest/gtest.h>
+#include <Unittests/unittests_common.hh>
+#include <OpenMesh/Tools/Utils/MeshReorderT.hh>
+#include <OpenMesh/Tools/Utils/MeshCheckerT.hh>
+
+namespace {
+
+class OpenMeshMeshReorder : public OpenMeshBase {
+
+    protected:
+
+        // This function is called before each test is run
+        virtual void SetUp() {
+            
+            // Do some initial stuff with the member data here...
+        }
+
+        // This function is called after all tests are through
+        virtual void TearDown() {
+
+            // Do some final stuff with the member data here...
+        }
+
+    // Member already defined in OpenMeshBase
+    //Mesh mesh_;  
+};
+
+/*
+ * ====================================================================
+ * Define tests below
+ * ====================================================================
+ */
+
+/*
+ * Reorder the mesh and check that connectivity, geometry and properties
+ * are still consistent
+ */
+void check_reordered(Mesh& _mesh, OpenMesh::MeshReorderT<Mesh>::Ordering _ordering) {
+
+  bool ok = OpenMesh::IO::read_mesh(_mesh, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  // remember the original index of every item in a property
+  OpenMesh::VPropHandleT<int> vprop;
+  OpenMesh::EPropHandleT<int> eprop;
+  OpenMesh::HPropHandleT<int> hprop;
+  OpenMesh::FPropHandleT<int> fprop;
+  _mesh.add_property(vprop);
+  _mesh.add_property(eprop);
+  _mesh.add_property(hprop);
+  _mesh.add_property(fprop);
+
+  for (Mesh::VertexIter v_it = _mesh.vertices_begin(); v_it != _mesh.vertices_end(); ++v_it)
+    _mesh.property(vprop, *v_it) = v_it->idx();
+  for (Mesh::EdgeIter e_it = _mesh.edges_begin(); e_it != _mesh.edges_end(); ++e_it)
+    _mesh.property(eprop, *e_it) = e_it->idx();
+  for (Mesh::HalfedgeIter h_it = _mesh.halfedges_begin(); h_it != _mesh.halfedges_end(); ++h_it)
+    _mesh.property(hprop, *h_it) = h_it->idx();
+  for (Mesh::FaceIter f_it = _mesh.faces_begin(); f_it != _mesh.faces_end(); ++f_it)
+    _mesh.property(fprop, *f_it) = f_it->idx();
+
+  Mesh original(_mesh);
+
+  OpenMesh::MeshReorderT<Mesh> reorder(_mesh);
+  reorder.reorder(_ordering);
+
+  EXPECT_EQ(original.n_vertices(), _mesh.n_vertices()) << "Number of vertices changed!";
+  EXPECT_EQ(original.n_edges(), _mesh.n_edges()) << "Number of edges changed!";
+  EXPECT_EQ(original.n_faces(), _mesh.n_faces()) << "Number of faces changed!";
+
+  OpenMesh::Utils::MeshCheckerT<Mesh> checker(_mesh);
+  EXPECT_TRUE(checker.check()) << "Mesh is not consistent after reordering!";
+
+  // properties moved with their items
+  size_t moved = 0;
+  for (Mesh::VertexIter v_it = _mesh.vertices_begin(); v_it != _mesh.vertices_end(); ++v_it) {
+    const int old_idx = _mesh.property(vprop, *v_it);
+    EXPECT_EQ(int(reorder.vertex_order()[v_it->idx()]), old_idx) << "Wrong vertex order!";
+    EXPECT_EQ(original.point(Mesh::VertexHandle(old_idx)), _mesh.point(*v_it)) << "Point did not move with vertex!";
+    if (old_idx != v_it->idx())
+      ++moved;
+  }
+  EXPECT_GT(moved, 0u) << "Nothing has been reordered!";
+
+  for (Mesh::EdgeIter e_it = _mesh.edges_begin(); e_it != _mesh.edges_end(); ++e_it)
+    EXPECT_EQ(int(reorder.edge_order()[e_it->idx()]), _mesh.property(eprop, *e_it)) << "Wrong edge order!";
+
+  for (Mesh::HalfedgeIter h_it = _mesh.halfedges_begin(); h_it != _mesh.halfedges_end(); ++h_it) {
+    const Mesh::HalfedgeHandle old_hh(_mesh.property(hprop, *h_it));
+    EXPECT_EQ(original.property(vprop, original.to_vertex_handle(old_hh)),
+              _mesh.property(vprop, _mesh.to_vertex_handle(*h_it))) << "Halfedge points to wrong vertex!";
+    EXPECT_EQ(original.property(hprop, original.next_halfedge_handle(old_hh)),
+              _mesh.property(hprop, _mesh.next_halfedge_handle(*h_it))) << "Wrong next halfedge!";
+  }
+
+  for (Mesh::FaceIter f_it = _mesh.faces_begin(); f_it != _mesh.faces_end(); ++f_it) {
+    const Mesh::FaceHandle old_fh(_mesh.property(fprop, *f_it));
+    EXPECT_EQ(int(reorder.face_order()[f_it->idx()]), old_fh.idx()) << "Wrong face order!";
+    EXPECT_EQ(original.property(hprop, original.halfedge_handle(old_fh)),
+              _mesh.property(hprop, _mesh.halfedge_handle(*f_it))) << "Wrong face halfedge!";
+  }
+}
+
+TEST_F(OpenMeshMeshReorder, Morton) {
+  check_reordered(mesh_, OpenMesh::MeshReorderT<Mesh>::Morton);
+}
+
+TEST_F(OpenMeshMeshReorder, ReverseCuthillMcKee) {
+  check_reordered(mesh_, OpenMesh::MeshReorderT<Mesh>::ReverseCuthillMcKee);
+}
+
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include <Unittests/unittests_common.hh>
+#include <OpenMesh/Core/IO/StoreRestore.hh>
+#include <OpenMesh/Core/Utils/Endian.hh>
+#include <OpenMesh/Tools/Decimater/ProgMesh.hh>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+class OpenMeshProgMesh : public OpenMeshBase {
+
+    protected:
+
+        // This function is called before each test is run
+        virtual void SetUp() {
+        }
+
+        // This function is called after all tests are through
+        virtual void TearDown() {
+
+            // Do some final stuff with the member data here...
+        }
+
+        // Member already defined in OpenMeshBase
+        //Mesh mesh_;
+};
+
+/*
+* ====================================================================
+* Define tests below
+* ====================================================================
+*/
+
+struct VSplit
+{
+    Mesh::VertexHandle v0, v1, vl, vr;
+};
+
+/*
+ * Reads the base mesh of a .pm file into _mesh. The vertices of all vertex
+ * splits are added as well, the splits are returned in _splits.
+ */
+bool read_pm(const std::string& _filename, Mesh& _mesh, std::vector<VSplit>& _splits)
+{
+    std::ifstream ifs(_filename.c_str(), std::ios::binary);
+    char          c[9];
+
+    ifs.read(c, 8); c[8] = '\0';
+    if (!ifs || std::string(c) != "ProgMesh")
+        return false;
+
+    const bool   swap = OpenMesh::Endian::local() != OpenMesh::Endian::LSB;
+    unsigned int n_base_vertices, n_base_faces, n_details, i0, i1, i2;
+    Mesh::Point  p;
+
+    OpenMesh::IO::restore(ifs, n_base_vertices, swap);
+    OpenMesh::IO::restore(ifs, n_base_faces, swap);
+    OpenMesh::IO::restore(ifs, n_details, swap);
+
+    _mesh.clear();
+    for (unsigned int i = 0; i < n_base_vertices; ++i)
+    {
+        OpenMesh::IO::restore(ifs, p, swap);
+        _mesh.add_vertex(p);
+    }
+
+    for (unsigned int i = 0; i < n_base_faces; ++i)
+    {
+        OpenMesh::IO::restore(ifs, i0, swap);
+        OpenMesh::IO::restore(ifs, i1, swap);
+        OpenMesh::IO::restore(ifs, i2, swap);
+        _mesh.add_face(_mesh.vertex_handle(i0), _mesh.vertex_handle(i1), _mesh.vertex_handle(i2));
+    }
+
+    _splits.resize(n_details);
+    for (unsigned int i = 0; i < n_details; ++i)
+    {
+        OpenMesh::IO::restore(ifs, p, swap);
+        OpenMesh::IO::restore(ifs, i0, swap);
+        OpenMesh::IO::restore(ifs, i1, swap);
+        OpenMesh::IO::restore(ifs, i2, swap);
+
+        _splits[i].v0 = _mesh.add_vertex(p);
+        _splits[i].v1 = Mesh::VertexHandle(i0);
+        _splits[i].vl = Mesh::VertexHandle(i1);
+        _splits[i].vr = Mesh::VertexHandle(i2);
+    }
+
+    return ifs.good();
+}
+
+/*
+ * Faces of an index buffer as sorted triangles, each starting at its
+ * smallest vertex index
+ */
+std::vector<OpenMesh::Vec3ui> sorted_triangles(const unsigned int* _indices, size_t _n_faces)
+{
+    std::vector<OpenMesh::Vec3ui> triangles;
+    for (size_t i = 0; i < _n_faces; ++i)
+    {
+        const unsigned int* fv = _indices + 3 * i;
+        size_t k = (fv[1] < fv[0] && fv[1] < fv[2]) ? 1 : (fv[2] < fv[0] && fv[2] < fv[1]) ? 2 : 0;
+        triangles.push_back(OpenMesh::Vec3ui(fv[k], fv[(k+1)%3], fv[(k+2)%3]));
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+std::vector<OpenMesh::Vec3ui> sorted_triangles(const Mesh& _mesh)
+{
+    std::vector<unsigned int> indices;
+    for (Mesh::ConstFaceIter f_it = _mesh.faces_begin(); f_it != _mesh.faces_end(); ++f_it)
+        for (Mesh::ConstFaceVertexIter fv_it = _mesh.cfv_iter(*f_it); fv_it.is_valid(); ++fv_it)
+            indices.push_back(fv_it->idx());
+    return sorted_triangles(indices.empty() ? 0 : &indices[0], indices.size() / 3);
+}
+
+/*
+ * The index buffers of a ProgMesh match the mesh refined with vertex splits
+ */
+TEST_F(OpenMeshProgMesh, Playback)
+{
+    OpenMesh::Decimater::ProgMesh pm;
+    ASSERT_TRUE(pm.read("cube1.pm")) << "Could not read PM file.";
+
+    EXPECT_EQ(4u, pm.n_base_vertices()) << "Base vertices differ";
+    EXPECT_EQ(4u, pm.n_base_faces()) << "Base faces differ";
+    EXPECT_EQ(7522u, pm.n_details()) << "Details differ";
+    EXPECT_EQ(7526u, pm.n_max_vertices()) << "Vertices differ";
+    EXPECT_EQ(15048u, pm.n_max_faces()) << "Faces differ";
+    EXPECT_EQ(0u, pm.lod()) << "Does not start at the base mesh";
+    EXPECT_EQ(4u, pm.n_faces());
+
+    std::vector<VSplit> splits;
+    ASSERT_TRUE(read_pm("cube1.pm", mesh_, splits));
+
+    // refine the mesh to three levels, switch the ProgMesh back and forth
+    const unsigned int lods[3] = { 1000, 3000, 7522 };
+    unsigned int lod = 0;
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (; lod < lods[i]; ++lod)
+        {
+            const VSplit& vs = splits[lod];
+            mesh_.vertex_split(vs.v0, vs.v1, vs.vl, vs.vr);
+        }
+
+        pm.set_lod(0);
+        pm.set_lod(pm.n_details());
+        pm.set_lod(lod);
+
+        EXPECT_EQ(lod, pm.lod());
+        EXPECT_EQ(4u + lod, pm.n_vertices()) << "Vertices differ at level " << lod;
+        EXPECT_EQ(mesh_.n_faces(), pm.n_faces()) << "Faces differ at level " << lod;
+        EXPECT_TRUE(sorted_triangles(mesh_) == sorted_triangles(pm.indices(), pm.n_faces())) << "Triangles differ at level " << lod;
+    }
+
+    // index buffer of another level without switching
+    pm.set_lod(3000);
+    std::vector<unsigned int> indices;
+    pm.index_buffer(pm.n_faces(2000), indices);
+    EXPECT_EQ(3000u, pm.lod());
+
+    pm.set_n_faces(pm.n_faces(2000));
+    EXPECT_EQ(2000u, pm.lod());
+    EXPECT_TRUE(indices == std::vector<unsigned int>(pm.indices(), pm.indices() + 3 * pm.n_faces())) << "Index buffers differ";
+
+    pm.index_buffer(pm.n_faces(5000), indices);
+    pm.set_lod(5000);
+    EXPECT_TRUE(indices == std::vector<unsigned int>(pm.indices(), pm.indices() + 3 * pm.n_faces())) << "Refined index buffers differ";
+
+    // the finest level with at most the requested number of faces
+    pm.set_n_faces(1001);
+    EXPECT_GE(1001u, pm.n_faces());
+    EXPECT_LT(1001u, pm.n_faces(pm.lod() + 1));
+
+    pm.set_n_faces(0);
+    EXPECT_EQ(0u, pm.lod());
+}
+
+/*
+ * Truncated files and headers with counts larger than the file are rejected
+ */
+TEST_F(OpenMeshProgMesh, Truncated)
+{
+    std::ifstream in("cube1.pm", std::ios::binary);
+    ASSERT_TRUE(in.good());
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    OpenMesh::Decimater::ProgMesh pm;
+
+    // the vertex splits end in the middle
+    {
+        std::ofstream out("progmesh_test_file.pm", std::ios::binary);
+        out.write(data.data(), data.size() / 2);
+    }
+    EXPECT_FALSE(pm.read("progmesh_test_file.pm")) << "Truncated file was read";
+    EXPECT_EQ(0u, pm.n_details());
+
+    // a header only, with huge counts
+    const bool swap = OpenMesh::Endian::local() != OpenMesh::Endian::LSB;
+    const unsigned int counts[][3] = { { 4u, 4u, 0xFFFFFFF0u }, { 0x7FFFFFFFu, 4u, 1u }, { 0xFFFFFFFFu, 0u, 1u } };
+    for (int i = 0; i < 3; ++i)
+    {
+        {
+            std::ofstream out("progmesh_test_file.pm", std::ios::binary);
+            out.write("ProgMesh", 8);
+            for (int j = 0; j < 3; ++j)
+                OpenMesh::IO::store(out, counts[i][j], swap);
+        }
+        EXPECT_FALSE(pm.read("progmesh_test_file.pm")) << "Header " << i << " was accepted";
+    }
+
+    remove("progmesh_test_file.pm");
+
+    // the complete file still works
+    EXPECT_TRUE(pm.read("cube1.pm"));
+    EXPECT_EQ(7522u, pm.n_details());
+}
+
+}
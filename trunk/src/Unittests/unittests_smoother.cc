@@ -0,0 +1,222 @@
+
+#include <gtest/gtest.h>
+#include <Unittests/unittests_common.hh>
+#include <OpenMesh/Tools/Smoother/JacobiLaplaceSmootherT.hh>
+#include <OpenMesh/Tools/Smoother/SparseLaplaceSmootherT.hh>
+
+namespace {
+
+class SmootherObserver : public OpenMesh::Smoother::Observer
+{
+public:
+  SmootherObserver(unsigned int _max_iterations) :
+    max_iterations_(_max_iterations), iterations_(0), notifications_(0), seconds_(0.0)
+  {}
+
+  void notify(unsigned int _iteration, Stage _stage, double _seconds)
+  {
+    if (_stage == MovePoints)
+      iterations_ = _iteration + 1;
+    ++notifications_;
+    seconds_ += _seconds;
+  }
+
+  bool abort() const
+  {
+    return iterations_ >= max_iterations_;
+  }
+
+  unsigned int max_iterations_;
+  unsigned int iterations_;
+  unsigned int notifications_;
+  double       seconds_;
+};
+
+class OpenMeshSmoother : public OpenMeshBase {
+
+    protected:
+
+        // This function is called before each test is run
+        virtual void SetUp() {
+            
+            // Do some initial stuff with the member data here...
+        }
+
+        // This function is called after all tests are through
+        virtual void TearDown() {
+
+            // Do some final stuff with the member data here...
+        }
+
+    // Member already defined in OpenMeshBase
+    //Mesh mesh_;  
+};
+
+/*
+ * ====================================================================
+ * Define tests below
+ * ====================================================================
+ */
+
+/*
+ * Explicit steps on the sparse matrix have to give the same result as the
+ * Jacobi smoother
+ */
+TEST_F(OpenMeshSmoother, SparseExplicitMatchesJacobi) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  Mesh reference(mesh_);
+
+  typedef OpenMesh::Smoother::JacobiLaplaceSmootherT< Mesh > JacobiSmoother;
+  typedef OpenMesh::Smoother::SparseLaplaceSmootherT< Mesh > SparseSmoother;
+
+  {
+    JacobiSmoother smoother(reference);
+    smoother.initialize(JacobiSmoother::Tangential_and_Normal, JacobiSmoother::C0);
+    smoother.smooth(5);
+  }
+
+  SparseSmoother smoother(mesh_);
+  smoother.initialize(SparseSmoother::Tangential_and_Normal, SparseSmoother::C0);
+  smoother.smooth(5);
+
+  EXPECT_EQ(mesh_.n_vertices(), smoother.n_rows()) << "Wrong number of active vertices!";
+
+  for (Mesh::VertexIter v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it)
+    EXPECT_LT((mesh_.point(*v_it) - reference.point(*v_it)).norm(), 1e-5f) << "Positions differ at vertex " << v_it->idx();
+}
+
+/*
+ * C1 smoothing of a selection
+ */
+TEST_F(OpenMeshSmoother, SparseExplicitC1MatchesJacobi) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  mesh_.request_vertex_status();
+  for (unsigned int i = 0; i < mesh_.n_vertices(); i += 3)
+    mesh_.status(Mesh::VertexHandle(i)).set_selected(true);
+
+  Mesh reference(mesh_);
+
+  typedef OpenMesh::Smoother::JacobiLaplaceSmootherT< Mesh > JacobiSmoother;
+  typedef OpenMesh::Smoother::SparseLaplaceSmootherT< Mesh > SparseSmoother;
+
+  {
+    JacobiSmoother smoother(reference);
+    smoother.initialize(JacobiSmoother::Tangential, JacobiSmoother::C1);
+    smoother.smooth(3);
+  }
+
+  SparseSmoother smoother(mesh_);
+  smoother.initialize(SparseSmoother::Tangential, SparseSmoother::C1);
+  smoother.smooth(3);
+
+  for (Mesh::VertexIter v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it)
+    EXPECT_LT((mesh_.point(*v_it) - reference.point(*v_it)).norm(), 1e-5f) << "Positions differ at vertex " << v_it->idx();
+}
+
+/*
+ * Implicit fairing keeps not selected vertices fixed and moves the others
+ */
+TEST_F(OpenMeshSmoother, SparseImplicitKeepsInactiveVertices) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  mesh_.request_vertex_status();
+  for (unsigned int i = 0; i < mesh_.n_vertices() / 2; ++i)
+    mesh_.status(Mesh::VertexHandle(i)).set_selected(true);
+
+  Mesh reference(mesh_);
+
+  typedef OpenMesh::Smoother::SparseLaplaceSmootherT< Mesh > SparseSmoother;
+
+  SparseSmoother smoother(mesh_);
+  smoother.set_solver(SparseSmoother::Implicit, 2.0f);
+  smoother.initialize(SparseSmoother::Tangential_and_Normal, SparseSmoother::C0);
+  smoother.smooth(2);
+
+  EXPECT_EQ(mesh_.n_vertices() / 2, smoother.n_rows()) << "Wrong number of active vertices!";
+  EXPECT_GT(smoother.cg_iterations(), 0u) << "Solver did not iterate!";
+
+  size_t moved = 0;
+  for (Mesh::VertexIter v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it) {
+    const float d = (mesh_.point(*v_it) - reference.point(*v_it)).norm();
+    if (mesh_.status(*v_it).selected()) {
+      if (d > 0.0f)
+        ++moved;
+    } else {
+      EXPECT_EQ(0.0f, d) << "Inactive vertex moved " << v_it->idx();
+    }
+  }
+
+  EXPECT_GT(moved, 0u) << "No vertex has been moved!";
+}
+
+/*
+ * Observer gets notified for each stage and can abort the smoother
+ */
+TEST_F(OpenMeshSmoother, SmootherObserver) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  typedef OpenMesh::Smoother::JacobiLaplaceSmootherT< Mesh > JacobiSmoother;
+
+  JacobiSmoother smoother(mesh_);
+  SmootherObserver observer(3);
+  smoother.set_observer(&observer);
+  smoother.initialize(JacobiSmoother::Tangential, JacobiSmoother::C0);
+  smoother.smooth(10);
+
+  // compute_new_positions, project_to_tangent_plane and move_points
+  EXPECT_EQ(3u, observer.iterations_)    << "Smoother has not been aborted!";
+  EXPECT_EQ(9u, observer.notifications_) << "Wrong number of notifications!";
+  EXPECT_GE(observer.seconds_, 0.0)      << "Negative timing!";
+}
+
+
+/*
+ * Deleted vertices are skipped until the garbage collection
+ */
+TEST_F(OpenMeshSmoother, SmoothMeshWithDeletedVertices) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+
+  ASSERT_TRUE(ok);
+
+  mesh_.request_vertex_status();
+  mesh_.request_edge_status();
+  mesh_.request_face_status();
+
+  typedef OpenMesh::Smoother::JacobiLaplaceSmootherT< Mesh > JacobiSmoother;
+
+  for (int c1 = 0; c1 < 2; ++c1) {
+    Mesh mesh(mesh_);
+    JacobiSmoother::Continuity continuity = c1 ? JacobiSmoother::C1 : JacobiSmoother::C0;
+
+    // a vertex deleted with its faces and one that is only flagged as deleted
+    const Mesh::VertexHandle vh[2] = { mesh.vertex_handle(100), mesh.vertex_handle(200) };
+    const Mesh::Point p[2] = { mesh.point(vh[0]), mesh.point(vh[1]) };
+
+    mesh.delete_vertex(vh[0]);
+    mesh.status(vh[1]).set_deleted(true);
+
+    JacobiSmoother smoother(mesh);
+    smoother.initialize(JacobiSmoother::Tangential_and_Normal, continuity);
+    smoother.smooth(3);
+
+    EXPECT_EQ(p[0], mesh.point(vh[0])) << "Vertex deleted with its faces has been moved, continuity " << continuity;
+    EXPECT_EQ(p[1], mesh.point(vh[1])) << "Vertex flagged as deleted has been moved, continuity " << continuity;
+  }
+}
+
+}
@@ -607,4 +607,51 @@ TEST_F(OpenMeshCollapse, LargeCollapseHalfEdge) {
 
 }
 
+/*
+ * Test is_collapse_ok on a vertex whose valence exceeds the small on-stack
+ * one-ring buffer. The test must not touch the status bits of the mesh.
+ */
+TEST_F(OpenMeshCollapse, IsCollapseOkHighValence) {
+
+  mesh_.clear();
+
+  const int n_ring = 40;
+
+  // Closed fan of n_ring triangles around a center vertex
+  Mesh::VertexHandle vh_center = mesh_.add_vertex(Mesh::Point(0, 0, 0));
+
+  std::vector<Mesh::VertexHandle> ring;
+  for (int i = 0; i < n_ring; ++i) {
+    const double angle = 2.0 * M_PI * i / n_ring;
+    ring.push_back(mesh_.add_vertex(Mesh::Point(cos(angle), sin(angle), 0)));
+  }
+
+  for (int i = 0; i < n_ring; ++i)
+    mesh_.add_face(vh_center, ring[i], ring[(i+1) % n_ring]);
+
+  // Bridge that makes ring[n_ring/2] a neighbor of ring[0]
+  Mesh::VertexHandle vh_bridge = mesh_.add_vertex(Mesh::Point(0, 2, 0));
+  mesh_.add_face(ring[n_ring/2], ring[0], vh_bridge);
+
+  mesh_.request_vertex_status();
+  mesh_.request_edge_status();
+  mesh_.request_face_status();
+
+  // Tag every second vertex, is_collapse_ok must not change the bits
+  for (Mesh::VertexIter v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it)
+    mesh_.status(*v_it).set_tagged(v_it->idx() % 2 == 0);
+
+  const Mesh& const_mesh = mesh_;
+
+  // ring[5] and the center only share ring[4] and ring[6]
+  EXPECT_TRUE( const_mesh.is_collapse_ok(mesh_.find_halfedge(ring[5], vh_center)) ) << "Collapse into high valence vertex should be ok";
+
+  // ring[0] and the center additionally share ring[n_ring/2]
+  EXPECT_FALSE( const_mesh.is_collapse_ok(mesh_.find_halfedge(ring[0], vh_center)) ) << "Collapse with third common neighbor should not be ok";
+  EXPECT_FALSE( const_mesh.is_collapse_ok(mesh_.find_halfedge(vh_center, ring[0])) ) << "Collapse with third common neighbor should not be ok";
+
+  for (Mesh::VertexIter v_it = mesh_.vertices_begin(); v_it != mesh_.vertices_end(); ++v_it)
+    EXPECT_EQ( v_it->idx() % 2 == 0, mesh_.status(*v_it).tagged() ) << "Tagged bit of vertex " << v_it->idx() << " changed";
+}
+
 }
@@ -8,6 +8,16 @@
 #include <OpenMesh/Tools/VDPM/VHierarchy.hh>
 #include <OpenMesh/Tools/VDPM/VHierarchyNode.hh>
 #include <OpenMesh/Tools/VDPM/VHierarchyNodeIndex.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyPager.hh>
+#include <OpenMesh/Tools/VDPM/MeshTraits.hh>
+#include <OpenMesh/Tools/VDPM/AdaptiveRefinerT.hh>
+#include <OpenMesh/Tools/VDPM/StreamingSession.hh>
+#include <OpenMesh/Tools/VDPM/VSplitCoder.hh>
+#include <OpenMesh/Tools/VDPM/VHierarchyReader.hh>
+#include <set>
+#include <fstream>
+#include <algorithm>
+#include <sstream>
 
 namespace {
 
@@ -268,8 +278,667 @@ TEST_F(OpenMeshVDPM, WriteReadPM)
     remove(filename.c_str());
 }
 
+/*
+ * Writes a small synthetic .spm file with 4 trees and 7 vertex splits
+ */
+void write_test_spm(const std::string& _filename,
+                    std::vector<OpenMesh::VDPM::VSplitRecord>& _records)
+{
+    const bool swap = OpenMesh::Endian::local() != OpenMesh::Endian::LSB;
+    const unsigned int n_base_vertices = 4, n_base_faces = 2;
+
+    // tree id, node id of the split nodes
+    const unsigned int splits[7][2] = { {0,1}, {0,2}, {0,3}, {0,5}, {1,1}, {3,1}, {3,2} };
+
+    OpenMesh::VDPM::VHierarchy vhierarchy;
+    vhierarchy.set_num_roots(n_base_vertices);
+
+    _records.clear();
+    for (unsigned int i = 0; i < 7; ++i)
+    {
+        OpenMesh::VDPM::VSplitRecord r;
+        r.point            = OpenMesh::Vec3f(float(splits[i][0]), 0.1f * float(i), 0.0f);
+        r.node_index       = vhierarchy.generate_node_index(splits[i][0], splits[i][1]).value();
+        r.fund_lcut_index  = i;
+        r.fund_rcut_index  = 100 + i;
+        r.lchild.radius    = 1.0f + float(i);
+        r.lchild.normal    = OpenMesh::Vec3f(0.0f, 0.0f, 1.0f);
+        r.lchild.sin_square = r.lchild.mue_square = r.lchild.sigma_square = 0.5f;
+        r.rchild           = r.lchild;
+        r.rchild.radius    = 2.0f + float(i);
+        _records.push_back(r);
+    }
+
+    std::ofstream ofs(_filename.c_str(), std::ios::binary);
+    ofs << "VDProgMesh";
+    OpenMesh::IO::store(ofs, n_base_vertices, swap);
+    OpenMesh::IO::store(ofs, n_base_faces, swap);
+    OpenMesh::IO::store(ofs, (unsigned int)_records.size(), swap);
+
+    for (unsigned int i = 0; i < n_base_vertices; ++i)
+    {
+        OpenMesh::IO::store(ofs, OpenMesh::Vec3f(float(i), 0.0f, 0.0f), swap);
+        OpenMesh::IO::store(ofs, 10.0f + float(i), swap);
+        OpenMesh::IO::store(ofs, OpenMesh::Vec3f(0.0f, 0.0f, 1.0f), swap);
+        OpenMesh::IO::store(ofs, 0.5f, swap);
+        OpenMesh::IO::store(ofs, 0.5f, swap);
+        OpenMesh::IO::store(ofs, 0.5f, swap);
+    }
+
+    const unsigned int faces[6] = { 0, 1, 2, 0, 2, 3 };
+    for (unsigned int i = 0; i < 6; ++i)
+        OpenMesh::IO::store(ofs, faces[i], swap);
+
+    for (size_t i = 0; i < _records.size(); ++i)
+    {
+        const OpenMesh::VDPM::VSplitRecord& r = _records[i];
+        OpenMesh::IO::store(ofs, r.point, swap);
+        OpenMesh::IO::store(ofs, r.node_index, swap);
+        OpenMesh::IO::store(ofs, r.fund_lcut_index, swap);
+        OpenMesh::IO::store(ofs, r.fund_rcut_index, swap);
+        OpenMesh::IO::store(ofs, r.lchild.radius, swap);
+        OpenMesh::IO::store(ofs, r.lchild.normal, swap);
+        OpenMesh::IO::store(ofs, r.lchild.sin_square, swap);
+        OpenMesh::IO::store(ofs, r.lchild.mue_square, swap);
+        OpenMesh::IO::store(ofs, r.lchild.sigma_square, swap);
+        OpenMesh::IO::store(ofs, r.rchild.radius, swap);
+        OpenMesh::IO::store(ofs, r.rchild.normal, swap);
+        OpenMesh::IO::store(ofs, r.rchild.sin_square, swap);
+        OpenMesh::IO::store(ofs, r.rchild.mue_square, swap);
+        OpenMesh::IO::store(ofs, r.rchild.sigma_square, swap);
+    }
+}
+
+/*
+ * Converts a .spm file into a paged hierarchy and looks up all vertex
+ * splits through a small LRU cache
+ */
+TEST_F(OpenMeshVDPM, PagedHierarchy)
+{
+    std::vector<OpenMesh::VDPM::VSplitRecord> records;
+    write_test_spm("vdpm_test_file.spm", records);
+
+    ASSERT_TRUE(OpenMesh::VDPM::VHierarchyPager::convert("vdpm_test_file.spm", "vdpm_test_file.pspm", 2));
+
+    OpenMesh::VDPM::VHierarchyPager pager;
+    ASSERT_TRUE(pager.open("vdpm_test_file.pspm"));
+
+    EXPECT_EQ(4u, pager.n_base_vertices()) << "Base vertices differ";
+    EXPECT_EQ(2u, pager.n_base_faces()) << "Base faces differ";
+    EXPECT_EQ(7u, pager.n_details()) << "Details differ";
+    EXPECT_EQ(4u, pager.n_blocks()) << "Blocks differ";
+    EXPECT_EQ(2u, pager.base_face(1)[1]) << "Base face differs";
+
+    pager.set_cache_size(2);
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        OpenMesh::VDPM::VSplitRecord r;
+        ASSERT_TRUE(pager.vsplit(OpenMesh::VDPM::VHierarchyNodeIndex(records[i].node_index), r)) << "Missing split " << i;
+        EXPECT_EQ(records[i].node_index, r.node_index);
+        EXPECT_EQ(records[i].fund_lcut_index, r.fund_lcut_index);
+        EXPECT_EQ(records[i].fund_rcut_index, r.fund_rcut_index);
+        EXPECT_EQ(records[i].lchild.radius, r.lchild.radius);
+        EXPECT_EQ(records[i].rchild.radius, r.rchild.radius);
+        EXPECT_EQ(records[i].point, r.point);
+        EXPECT_LE(pager.n_cached_blocks(), 2u) << "Cache exceeds its size";
+    }
+
+    // leaves of the hierarchy have no vertex split
+    OpenMesh::VDPM::VHierarchy vhierarchy;
+    pager.init_hierarchy(vhierarchy);
+
+    OpenMesh::VDPM::VSplitRecord r;
+    EXPECT_FALSE(pager.vsplit(vhierarchy.generate_node_index(0, 4), r));
+    EXPECT_FALSE(pager.vsplit(vhierarchy.generate_node_index(2, 1), r));
+
+    // repeated lookups are served from the cache
+    pager.reset_statistics();
+    pager.vsplit(vhierarchy.generate_node_index(3, 2), r);
+    pager.vsplit(vhierarchy.generate_node_index(3, 2), r);
+    EXPECT_LE(pager.n_loads(), 1u);
+    EXPECT_GE(pager.n_hits(), 1u);
+
+    // lazily build the hierarchy
+    EXPECT_EQ(4u, vhierarchy.num_nodes());
+    EXPECT_FLOAT_EQ(12.0f, vhierarchy.node(vhierarchy.root_handle(2)).radius());
+
+    OpenMesh::Vec3f p;
+    EXPECT_TRUE(pager.make_children(vhierarchy, vhierarchy.root_handle(0), p));
+    EXPECT_EQ(records[0].point, p);
+    EXPECT_EQ(6u, vhierarchy.num_nodes());
+
+    OpenMesh::VDPM::VHierarchyNodeHandle lchild = vhierarchy.lchild_handle(vhierarchy.root_handle(0));
+    EXPECT_FLOAT_EQ(records[0].lchild.radius, vhierarchy.node(lchild).radius());
+    EXPECT_EQ(100u, vhierarchy.fund_rcut_index(vhierarchy.root_handle(0)).value());
+    EXPECT_FALSE(pager.make_children(vhierarchy, vhierarchy.root_handle(2), p));
+
+    pager.close();
+
+    // a truncated file opens, but the records of its last block are
+    // missing and must not be cached
+    {
+        std::ifstream in("vdpm_test_file.pspm", std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out("vdpm_test_file.pspm", std::ios::binary | std::ios::trunc);
+        out.write(data.data(), data.size() - 8);
+    }
+    ASSERT_TRUE(pager.open("vdpm_test_file.pspm"));
+    const OpenMesh::VDPM::VHierarchyNodeIndex last(records.back().node_index);
+    EXPECT_FALSE(pager.vsplit(last, r)) << "Truncated record was read";
+    EXPECT_FALSE(pager.vsplit(last, r)) << "Truncated record was cached";
+    EXPECT_EQ(0u, pager.n_cached_blocks());
+    EXPECT_TRUE(pager.vsplit(OpenMesh::VDPM::VHierarchyNodeIndex(records[0].node_index), r));
+
+    pager.close();
+    remove("vdpm_test_file.spm");
+    remove("vdpm_test_file.pspm");
+}
+
+/*
+ * Headers with counts larger than the file and indices out of range are
+ * rejected by the conversion and by the pager
+ */
+TEST_F(OpenMeshVDPM, PagedHierarchyCorrupt)
+{
+    std::vector<OpenMesh::VDPM::VSplitRecord> records;
+    write_test_spm("vdpm_test_file.spm", records);
+
+    std::string data;
+    {
+        std::ifstream in("vdpm_test_file.spm", std::ios::binary);
+        data.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    const bool swap = OpenMesh::Endian::local() != OpenMesh::Endian::LSB;
+
+    // a .spm header only, with huge counts
+    const unsigned int counts[][3] = { { 4u, 2u, 0xFFFFFFF0u }, { 0x7FFFFFFFu, 2u, 7u }, { 4u, 0xFFFFFFFFu, 0u } };
+    for (int i = 0; i < 3; ++i)
+    {
+        {
+            std::ofstream out("vdpm_test_file.spm", std::ios::binary);
+            out.write("VDProgMesh", 10);
+            for (int j = 0; j < 3; ++j)
+                OpenMesh::IO::store(out, counts[i][j], swap);
+        }
+        EXPECT_FALSE(OpenMesh::VDPM::VHierarchyPager::convert("vdpm_test_file.spm", "vdpm_test_file.pspm", 2))
+            << "Header " << i << " was accepted";
+    }
 
+    // a base face refers to a vertex that does not exist
+    {
+        std::string corrupt(data);
+        const size_t first_face = 10 + 3*4 + 4 * (3*4 + 4 + 3*4 + 3*4);
+        corrupt[first_face + 3] = char(0x7F);
+        std::ofstream out("vdpm_test_file.spm", std::ios::binary);
+        out.write(corrupt.data(), corrupt.size());
+    }
+    EXPECT_FALSE(OpenMesh::VDPM::VHierarchyPager::convert("vdpm_test_file.spm", "vdpm_test_file.pspm", 2))
+        << "Base face out of range was accepted";
+
+    // a paged header only, with huge counts
+    const unsigned int paged_counts[][5] = { { 0x7FFFFFFFu, 2u, 7u, 2u, 4u },
+                                             { 4u, 0xFFFFFFFFu, 7u, 2u, 4u },
+                                             { 4u, 2u, 0xFFFFFFF0u, 1u, 0xFFFFFFF0u },
+                                             { 4u, 2u, 7u, 0u, 4u },
+                                             { 4u, 2u, 7u, 2u, 5u } };
+    OpenMesh::VDPM::VHierarchyPager pager;
+    for (int i = 0; i < 5; ++i)
+    {
+        {
+            std::ofstream out("vdpm_test_file.pspm", std::ios::binary);
+            out.write("VDPMPaged", 9);
+            OpenMesh::IO::store(out, 1u, swap);
+            for (int j = 0; j < 5; ++j)
+                OpenMesh::IO::store(out, paged_counts[i][j], swap);
+        }
+        EXPECT_FALSE(pager.open("vdpm_test_file.pspm")) << "Paged header " << i << " was accepted";
+        EXPECT_FALSE(pager.is_open());
+    }
 
+    // the intact file still converts and opens
+    {
+        std::ofstream out("vdpm_test_file.spm", std::ios::binary);
+        out.write(data.data(), data.size());
+    }
+    ASSERT_TRUE(OpenMesh::VDPM::VHierarchyPager::convert("vdpm_test_file.spm", "vdpm_test_file.pspm", 2));
+    EXPECT_TRUE(pager.open("vdpm_test_file.pspm"));
 
+    pager.close();
+    remove("vdpm_test_file.spm");
+    remove("vdpm_test_file.pspm");
+}
+
+/*
+ * Refines a view-dependent progressive mesh for a near and a far camera
+ */
+TEST_F(OpenMeshVDPM, AdaptiveRefinement)
+{
+    typedef OpenMesh::TriMesh_ArrayKernelT<OpenMesh::VDPM::MeshTraits> RefinerMesh;
+
+    RefinerMesh                                  mesh;
+    OpenMesh::VDPM::VHierarchy                   vhierarchy;
+    OpenMesh::VDPM::VFront                       vfront;
+    OpenMesh::VDPM::ViewingParameters            viewing_parameters;
+    OpenMesh::VDPM::AdaptiveRefinerT<RefinerMesh> refiner(mesh, vhierarchy, vfront);
+
+    ASSERT_TRUE(refiner.open("cube1_600.spm"));
+
+    EXPECT_EQ(4u, refiner.n_base_vertices()) << "Base vertices differ";
+    EXPECT_EQ(596u, refiner.n_details()) << "Details differ";
+    EXPECT_EQ(4u, mesh.n_faces()) << "Base mesh faces differ";
+    EXPECT_EQ(4, vfront.size()) << "Front should hold the roots";
+
+    RefinerMesh::Point bb_min = mesh.point(*mesh.vertices_begin()), bb_max = bb_min;
+    for (RefinerMesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    {
+        bb_min.minimize(mesh.point(*v_it));
+        bb_max.maximize(mesh.point(*v_it));
+    }
+    OpenMesh::Vec3f center = 0.5f * (bb_min + bb_max);
+    float radius = 0.5f * (bb_max - bb_min).norm();
+
+    // near camera
+    OpenMesh::Vec3f eye = center + OpenMesh::Vec3f(0.0f, 0.0f, 2.0f * radius);
+    viewing_parameters.set_look_at(eye, center, OpenMesh::Vec3f(0.0f, 1.0f, 0.0f));
+    viewing_parameters.update_viewing_configurations();
+    viewing_parameters.set_tolerance_square(0.00001f);
+
+    EXPECT_NEAR(eye[2], viewing_parameters.eye_pos()[2], 1e-4) << "Eye position differs";
+
+    EXPECT_TRUE(refiner.refine(viewing_parameters)) << "Pass should not be interrupted without budget";
+    EXPECT_GT(refiner.n_vsplits(), 0u);
+    EXPECT_EQ(0u, refiner.n_ecols());
+
+    size_t near_faces = mesh.n_faces();
+    EXPECT_GT(near_faces, 100u) << "Mesh was not refined";
+    ASSERT_GT(vfront.size(), 64) << "Front too small for the budget test";
+
+    // a tiny budget interrupts the pass, following calls continue it
+    OpenMesh::Vec3f far_eye = center + OpenMesh::Vec3f(0.0f, 0.0f, 50.0f * radius);
+    viewing_parameters.set_look_at(far_eye, center, OpenMesh::Vec3f(0.0f, 1.0f, 0.0f));
+    viewing_parameters.update_viewing_configurations();
+
+    refiner.set_time_budget(1e-9);
+    EXPECT_FALSE(refiner.refine(viewing_parameters)) << "Pass should be interrupted by the budget";
+    EXPECT_GT(mesh.n_faces(), 4u);
+
+    refiner.set_time_budget(0.0);
+    EXPECT_TRUE(refiner.refine(viewing_parameters));
+    for (int i = 0; i < 10 && refiner.n_ecols() > 0; ++i)
+        refiner.refine(viewing_parameters);
+
+    EXPECT_LT(mesh.n_faces(), near_faces) << "Far camera should coarsen the mesh";
+}
+
+/*
+ * Refines a paged hierarchy out of core and compares it with the
+ * refinement of the same hierarchy held in memory
+ */
+TEST_F(OpenMeshVDPM, AdaptiveRefinementPaged)
+{
+    typedef OpenMesh::TriMesh_ArrayKernelT<OpenMesh::VDPM::MeshTraits> RefinerMesh;
+
+    ASSERT_TRUE(OpenMesh::VDPM::VHierarchyPager::convert("cube1_600.spm", "vdpm_test_file.pspm", 16));
+
+    RefinerMesh                                  mesh, paged_mesh;
+    OpenMesh::VDPM::VHierarchy                   vhierarchy, paged_vhierarchy;
+    OpenMesh::VDPM::VFront                       vfront, paged_vfront;
+    OpenMesh::VDPM::ViewingParameters            viewing_parameters;
+    OpenMesh::VDPM::AdaptiveRefinerT<RefinerMesh> refiner(mesh, vhierarchy, vfront);
+    OpenMesh::VDPM::AdaptiveRefinerT<RefinerMesh> paged_refiner(paged_mesh, paged_vhierarchy, paged_vfront);
+
+    ASSERT_TRUE(refiner.open("cube1_600.spm"));
+    EXPECT_FALSE(refiner.is_paged());
+
+    ASSERT_TRUE(paged_refiner.open("vdpm_test_file.pspm"));
+    EXPECT_TRUE(paged_refiner.is_paged());
+    paged_refiner.pager().set_cache_size(4);
+
+    EXPECT_EQ(refiner.n_base_vertices(), paged_refiner.n_base_vertices()) << "Base vertices differ";
+    EXPECT_EQ(refiner.n_details(), paged_refiner.n_details()) << "Details differ";
+    EXPECT_EQ(mesh.n_faces(), paged_mesh.n_faces()) << "Base mesh faces differ";
+    EXPECT_EQ(4u, paged_mesh.n_vertices()) << "Only the base mesh should be loaded";
+
+    RefinerMesh::Point bb_min = mesh.point(*mesh.vertices_begin()), bb_max = bb_min;
+    for (RefinerMesh::VertexIter v_it = mesh.vertices_begin(); v_it != mesh.vertices_end(); ++v_it)
+    {
+        bb_min.minimize(mesh.point(*v_it));
+        bb_max.maximize(mesh.point(*v_it));
+    }
+    OpenMesh::Vec3f center = 0.5f * (bb_min + bb_max);
+    float radius = 0.5f * (bb_max - bb_min).norm();
+
+    OpenMesh::Vec3f eye = center + OpenMesh::Vec3f(0.0f, 0.0f, 2.0f * radius);
+    viewing_parameters.set_look_at(eye, center, OpenMesh::Vec3f(0.0f, 1.0f, 0.0f));
+    viewing_parameters.update_viewing_configurations();
+    viewing_parameters.set_tolerance_square(0.00001f);
+
+    // the paged refiner needs a few passes to reach the same front
+    for (int i = 0; i < 10; ++i)
+    {
+        refiner.refine(viewing_parameters);
+        paged_refiner.refine(viewing_parameters);
+    }
+
+    EXPECT_GT(paged_mesh.n_faces(), 100u) << "Paged mesh was not refined";
+    EXPECT_EQ(mesh.n_faces(), paged_mesh.n_faces()) << "Refined meshes differ";
+    EXPECT_EQ(vfront.size(), paged_vfront.size()) << "Fronts differ";
+    EXPECT_LT(paged_mesh.n_vertices(), mesh.n_vertices()) << "Paged refiner should only load the needed vertices";
+    EXPECT_GT(paged_refiner.pager().n_loads(), 0u) << "No block was paged in";
+
+    remove("vdpm_test_file.pspm");
+}
+
+/*
+ * Streams the vertex splits for a view in small batches and checks that
+ * every split refers to a node the client has at that time
+ */
+TEST_F(OpenMeshVDPM, StreamingSession)
+{
+    OpenMesh::VDPM::StreamingModel model;
+    ASSERT_TRUE(model.open("cube1_600.spm"));
+
+    EXPECT_EQ(4u, model.n_base_vertices());
+    EXPECT_EQ(596u, model.n_details());
+    EXPECT_EQ(3u * 4u + 4u * 40u + 4u * 12u, model.base_mesh_payload().size()) << "Base mesh payload size differs";
+
+    // camera close to the model
+    OpenMesh::Vec3f bb_min = model.point(model.vhierarchy().root_handle(0)), bb_max = bb_min;
+    for (unsigned int i = 0; i < model.n_base_vertices(); ++i)
+    {
+        bb_min.minimize(model.point(model.vhierarchy().root_handle(i)));
+        bb_max.maximize(model.point(model.vhierarchy().root_handle(i)));
+    }
+    OpenMesh::Vec3f center = 0.5f * (bb_min + bb_max);
+    float radius = 0.5f * (bb_max - bb_min).norm();
+
+    OpenMesh::VDPM::ViewingParameters viewing_parameters;
+    viewing_parameters.set_look_at(center + OpenMesh::Vec3f(0.0f, 0.0f, 2.0f * radius), center, OpenMesh::Vec3f(0.0f, 1.0f, 0.0f));
+    viewing_parameters.update_viewing_configurations();
+    viewing_parameters.set_tolerance_square(0.00001f);
+
+    OpenMesh::VDPM::StreamingSession session(model);
+    session.set_viewing_parameters(viewing_parameters);
+    EXPECT_FALSE(session.complete());
+
+    // nodes the client has, initially the roots
+    std::set<unsigned int> active;
+    for (unsigned int i = 0; i < model.n_base_vertices(); ++i)
+        active.insert(model.vhierarchy().generate_node_index(i, 1).value());
+
+    const unsigned char bits = model.vhierarchy().tree_id_bits();
+    const bool swap = OpenMesh::Endian::local() != OpenMesh::Endian::LSB;
+    size_t n_batches = 0, n_total = 0;
+
+    while (!session.complete() && n_batches < 1000)
+    {
+        std::ostringstream batch;
+        size_t n = session.next_batch(10 * OpenMesh::VDPM::StreamingModel::VSplitSize, batch);
+        ++n_batches;
+        n_total += n;
+
+        ASSERT_EQ(n * OpenMesh::VDPM::StreamingModel::VSplitSize, batch.str().size()) << "Wrong batch size";
+
+        std::istringstream is(batch.str());
+        for (size_t i = 0; i < n; ++i)
+        {
+            OpenMesh::Vec3f p;
+            unsigned int node_index, fund_lcut, fund_rcut;
+            char params[56];
+            OpenMesh::IO::restore(is, p, swap);
+            OpenMesh::IO::restore(is, node_index, swap);
+            OpenMesh::IO::restore(is, fund_lcut, swap);
+            OpenMesh::IO::restore(is, fund_rcut, swap);
+            is.read(params, sizeof(params));
+
+            ASSERT_EQ(1u, active.count(node_index)) << "Split of a node the client does not have";
+            active.erase(node_index);
+
+            OpenMesh::VDPM::VHierarchyNodeIndex index(node_index);
+            unsigned int tree = index.tree_id(bits), node = index.node_id(bits);
+            active.insert(model.vhierarchy().generate_node_index(tree, 2 * node).value());
+            active.insert(model.vhierarchy().generate_node_index(tree, 2 * node + 1).value());
+        }
+    }
+
+    EXPECT_TRUE(session.complete()) << "View was not fully refined";
+    EXPECT_GT(n_batches, 1u) << "Batches should be limited in size";
+    EXPECT_GT(n_total, 100u) << "Too few vertex splits for a close view";
+    EXPECT_EQ(n_total, session.n_vsplits());
+
+    // nothing more to send for the same view
+    std::ostringstream empty;
+    session.set_viewing_parameters(viewing_parameters);
+    EXPECT_EQ(0u, session.next_batch(1000, empty));
+
+    // a second session on the same model starts from the base mesh
+    OpenMesh::VDPM::StreamingSession other(model);
+    other.set_viewing_parameters(viewing_parameters);
+    std::ostringstream all;
+    EXPECT_EQ(n_total, other.next_batch(size_t(-1), all));
+}
+
+/*
+ * Applies uncompressed vertex splits to the nodes a client has, returns
+ * the number of splits of nodes the client does not have
+ */
+size_t apply_vsplits(OpenMesh::VDPM::StreamingModel& _model, const std::string& _batch, size_t _n,
+                     std::set<unsigned int>& _active)
+{
+    const unsigned char bits = _model.vhierarchy().tree_id_bits();
+    const bool swap = OpenMesh::Endian::local() != OpenMesh::Endian::LSB;
+    size_t n_unknown = 0;
+
+    std::istringstream is(_batch);
+    for (size_t i = 0; i < _n; ++i)
+    {
+        OpenMesh::Vec3f p;
+        unsigned int node_index, fund_lcut, fund_rcut;
+        char params[56];
+        OpenMesh::IO::restore(is, p, swap);
+        OpenMesh::IO::restore(is, node_index, swap);
+        OpenMesh::IO::restore(is, fund_lcut, swap);
+        OpenMesh::IO::restore(is, fund_rcut, swap);
+        is.read(params, sizeof(params));
+
+        if (_active.erase(node_index) == 0)
+            ++n_unknown;
+
+        OpenMesh::VDPM::VHierarchyNodeIndex index(node_index);
+        unsigned int tree = index.tree_id(bits), node = index.node_id(bits);
+        _active.insert(_model.vhierarchy().generate_node_index(tree, 2 * node).value());
+        _active.insert(_model.vhierarchy().generate_node_index(tree, 2 * node + 1).value());
+    }
+    return n_unknown;
+}
+
+/*
+ * The client re-requests the base mesh while a batch is built. The
+ * server has to drop that batch and reset the session, otherwise the
+ * client gets vertex splits of nodes its new base mesh does not have.
+ */
+TEST_F(OpenMeshVDPM, StreamingSessionBaseMeshDuringBatch)
+{
+    OpenMesh::VDPM::StreamingModel model;
+    ASSERT_TRUE(model.open("cube1_600.spm"));
+
+    OpenMesh::VDPM::ViewingParameters viewing_parameters;
+    viewing_parameters.set_look_at(OpenMesh::Vec3f(0.0f, 0.0f, 3.0f), OpenMesh::Vec3f(0.0f, 0.0f, 0.0f), OpenMesh::Vec3f(0.0f, 1.0f, 0.0f));
+    viewing_parameters.update_viewing_configurations();
+    viewing_parameters.set_tolerance_square(0.00001f);
+
+    std::set<unsigned int> roots, active;
+    for (unsigned int i = 0; i < model.n_base_vertices(); ++i)
+        roots.insert(model.vhierarchy().generate_node_index(i, 1).value());
+    active = roots;
+
+    OpenMesh::VDPM::StreamingSession session(model);
+    session.set_viewing_parameters(viewing_parameters);
+
+    // generation of the client, bumped by every base mesh request
+    unsigned int generation = 0;
+
+    // the first batch is delivered
+    std::ostringstream first;
+    size_t n = session.next_batch(20 * OpenMesh::VDPM::StreamingModel::VSplitSize, first);
+    ASSERT_GT(n, 0u);
+    EXPECT_EQ(0u, apply_vsplits(model, first.str(), n, active));
+
+    // the worker builds the second batch, meanwhile the base mesh request
+    // resets the client
+    unsigned int snapshot = generation;
+    std::ostringstream stale;
+    size_t n_stale = session.next_batch(20 * OpenMesh::VDPM::StreamingModel::VSplitSize, stale);
+    ASSERT_GT(n_stale, 0u);
+
+    active = roots;
+    ++generation;
+
+    // the stale batch refines the old front and does not fit the base mesh
+    std::set<unsigned int> wrong(roots);
+    EXPECT_GT(apply_vsplits(model, stale.str(), n_stale, wrong), 0u) << "Stale batch should not fit the new base mesh";
+    EXPECT_NE(snapshot, generation) << "The stale batch has to be detected";
+
+    // it is dropped, and the session is reset with the next view
+    session.reset();
+    session.set_viewing_parameters(viewing_parameters);
+
+    size_t n_total = 0;
+    while (!session.complete())
+    {
+        std::ostringstream batch;
+        size_t m = session.next_batch(20 * OpenMesh::VDPM::StreamingModel::VSplitSize, batch);
+        ASSERT_EQ(0u, apply_vsplits(model, batch.str(), m, active)) << "Split of a node the client does not have";
+        n_total += m;
+    }
+    EXPECT_EQ(n_total, session.n_vsplits());
+}
+
+/*
+ * Compresses a .spm file and compares the decoded vertex splits with the
+ * original ones
+ */
+TEST_F(OpenMeshVDPM, CompressedHierarchy)
+{
+    ASSERT_TRUE(OpenMesh::VDPM::VSplitEncoder::compress("cube1_600.spm", "vdpm_test_file.cspm"));
+
+    OpenMesh::VDPM::VHierarchyReader original, coded;
+    ASSERT_TRUE(original.open("cube1_600.spm"));
+    ASSERT_TRUE(coded.open("vdpm_test_file.cspm"));
+    EXPECT_FALSE(original.is_compressed());
+    EXPECT_TRUE(coded.is_compressed());
+    ASSERT_EQ(original.n_details(), coded.n_details());
+
+    OpenMesh::Vec3f p, q;
+    OpenMesh::VDPM::VHierarchyNodeParams a, b;
+    unsigned int fa[3], fb[3];
+
+    for (unsigned int i = 0; i < original.n_base_vertices(); ++i)
+    {
+        ASSERT_TRUE(original.read_base_vertex(p, a));
+        ASSERT_TRUE(coded.read_base_vertex(q, b));
+        EXPECT_EQ(p, q) << "Base vertices are stored unchanged";
+    }
+    for (unsigned int i = 0; i < original.n_base_faces(); ++i)
+    {
+        ASSERT_TRUE(original.read_base_face(fa));
+        ASSERT_TRUE(coded.read_base_face(fb));
+        EXPECT_EQ(fa[0], fb[0]);
+    }
+
+    const float eps = 2.0f * coded.quantization().bb_size / (1 << coded.quantization().position_bits);
+
+    for (unsigned int i = 0; i < original.n_details(); ++i)
+    {
+        OpenMesh::VDPM::VSplitRecord r, s;
+        ASSERT_TRUE(original.read_vsplit(r));
+        ASSERT_TRUE(coded.read_vsplit(s)) << "Decoding failed at vertex split " << i;
+
+        EXPECT_EQ(r.node_index, s.node_index);
+        EXPECT_EQ(r.fund_lcut_index, s.fund_lcut_index);
+        EXPECT_EQ(r.fund_rcut_index, s.fund_rcut_index);
+        EXPECT_LT((r.point - s.point).norm(), eps);
+        EXPECT_LT((r.lchild.normal - s.lchild.normal).norm(), 0.01f);
+
+        // bounds are never underestimated
+        EXPECT_GE(s.lchild.radius, r.lchild.radius);
+        EXPECT_GE(s.rchild.mue_square, r.rchild.mue_square);
+        EXPECT_GE(s.rchild.sigma_square, r.rchild.sigma_square);
+        EXPECT_GE(s.lchild.sin_square, std::min(r.lchild.sin_square, 1.0f));
+    }
+
+    original.close();
+    coded.close();
+
+    std::ifstream a_size("cube1_600.spm", std::ios::binary | std::ios::ate);
+    std::ifstream b_size("vdpm_test_file.cspm", std::ios::binary | std::ios::ate);
+    EXPECT_LT(3 * b_size.tellg(), a_size.tellg()) << "File should be several times smaller";
+
+    remove("vdpm_test_file.cspm");
+}
+
+/*
+ * Streams compressed vertex splits and decodes them on the client side
+ */
+TEST_F(OpenMeshVDPM, CompressedStreaming)
+{
+    OpenMesh::VDPM::StreamingModel model;
+    ASSERT_TRUE(model.open("cube1_600.spm"));
+
+    OpenMesh::VDPM::ViewingParameters viewing_parameters;
+    viewing_parameters.set_look_at(OpenMesh::Vec3f(0.0f, 0.0f, 3.0f), OpenMesh::Vec3f(0.0f, 0.0f, 0.0f), OpenMesh::Vec3f(0.0f, 1.0f, 0.0f));
+    viewing_parameters.update_viewing_configurations();
+    viewing_parameters.set_tolerance_square(0.00001f);
+
+    OpenMesh::VDPM::StreamingSession plain(model), compressed(model);
+    compressed.set_compressed(true);
+    plain.set_viewing_parameters(viewing_parameters);
+    compressed.set_viewing_parameters(viewing_parameters);
+
+    // client side decoder, set up from the base mesh
+    OpenMesh::VDPM::VSplitDecoder decoder;
+    decoder.reset(model.n_base_vertices(), model.quantization());
+    for (unsigned int i = 0; i < model.n_base_vertices(); ++i)
+    {
+        OpenMesh::VDPM::VHierarchyNodeHandle root = model.vhierarchy().root_handle(i);
+        OpenMesh::VDPM::VHierarchyNodeParams params;
+        model.params(root, params);
+        decoder.add_root(i, model.point(root), params);
+    }
+
+    size_t n_plain = 0, n_coded = 0, bytes_plain = 0, bytes_coded = 0;
+
+    while (!compressed.complete())
+    {
+        std::ostringstream plain_batch, coded_batch;
+        size_t n = plain.next_batch(1000, plain_batch);
+        size_t m = compressed.next_batch(1000, coded_batch);
+        n_plain += n;
+        n_coded += m;
+        bytes_plain += plain_batch.str().size();
+        bytes_coded += coded_batch.str().size();
+
+        std::istringstream is(coded_batch.str());
+        decoder.begin(is);
+        for (size_t i = 0; i < m; ++i)
+        {
+            OpenMesh::VDPM::VSplitRecord record;
+            ASSERT_TRUE(decoder.decode(record)) << "Decoding failed";
+        }
+        decoder.end();
+        EXPECT_EQ(is.tellg(), std::streampos(coded_batch.str().size())) << "Batch not fully consumed";
+    }
+
+    // drain the uncompressed session
+    std::ostringstream rest;
+    n_plain += plain.next_batch(size_t(-1), rest);
+    bytes_plain += rest.str().size();
+
+    EXPECT_GT(n_coded, 100u);
+    EXPECT_EQ(n_plain, n_coded) << "Compression should not change the vertex splits sent";
+    EXPECT_LT(3 * bytes_coded, bytes_plain) << "Compressed stream should be several times smaller";
+}
 
 }
@@ -0,0 +1,115 @@
+
+#include <gtest/gtest.h>
+#include <Unittests/unittests_common.hh>
+#include <OpenMesh/Tools/Utils/VertexCacheOptimizerT.hh>
+#include <algorithm>
+
+namespace {
+
+class OpenMeshVertexCacheOptimizer : public OpenMeshBase {
+
+    protected:
+
+        // This function is called before each test is run
+        virtual void SetUp() {
+            
+            // Do some initial stuff with the member data here...
+        }
+
+        // This function is called after all tests are through
+        virtual void TearDown() {
+
+            // Do some final stuff with the member data here...
+        }
+
+    // Member already defined in OpenMeshBase
+    //Mesh mesh_;  
+};
+
+/*
+ * ====================================================================
+ * Define tests below
+ * ====================================================================
+ */
+
+/*
+ * Check that the optimized index buffer contains every triangle exactly once
+ * and has a lower cache miss ratio than the original face order
+ */
+TEST_F(OpenMeshVertexCacheOptimizer, Optimize) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+    
+  ASSERT_TRUE(ok);
+
+  OpenMesh::VertexCacheOptimizerT<Mesh> optimizer(mesh_, 16);
+
+  size_t triangles = optimizer.optimize();
+
+  EXPECT_EQ(mesh_.n_faces(), triangles) << "The number of triangles is not correct!";
+  EXPECT_TRUE(optimizer.is_valid()) << "Index buffer not computed!";
+  EXPECT_EQ(mesh_.n_vertices(), optimizer.vertex_order().size()) << "Wrong number of vertices!";
+
+  // every original triangle has to be in the buffer, in the same orientation
+  std::vector< std::vector<unsigned int> > original, optimized;
+  for (Mesh::FaceIter f_it = mesh_.faces_begin(); f_it != mesh_.faces_end(); ++f_it) {
+    std::vector<unsigned int> tri;
+    for (Mesh::FaceVertexIter fv_it = mesh_.fv_iter(*f_it); fv_it.is_valid(); ++fv_it)
+      tri.push_back(fv_it->idx());
+    std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+    original.push_back(tri);
+  }
+
+  const std::vector<unsigned int>& indices = optimizer.indices();
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    std::vector<unsigned int> tri;
+    for (size_t j = 0; j < 3; ++j)
+      tri.push_back(optimizer.vertex_order()[indices[i+j]]);
+    std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+    optimized.push_back(tri);
+  }
+
+  std::sort(original.begin(), original.end());
+  std::sort(optimized.begin(), optimized.end());
+  EXPECT_TRUE(original == optimized) << "Triangles have been changed!";
+
+  EXPECT_LT(optimizer.acmr(), optimizer.acmr_original()) << "Cache miss ratio has not been improved!";
+  EXPECT_LT(optimizer.acmr(), 0.8) << "Cache miss ratio too high!";
+}
+
+/*
+ * Partitioned optimization
+ */
+TEST_F(OpenMeshVertexCacheOptimizer, OptimizePartitions) {
+
+  bool ok = OpenMesh::IO::read_mesh(mesh_, "cube1.off");
+    
+  ASSERT_TRUE(ok);
+
+  OpenMesh::VertexCacheOptimizerT<Mesh> optimizer(mesh_, 16);
+
+  size_t triangles = optimizer.optimize(4);
+
+  EXPECT_EQ(mesh_.n_faces(), triangles) << "The number of triangles is not correct!";
+  EXPECT_EQ(mesh_.n_vertices(), optimizer.vertex_order().size()) << "Wrong number of vertices!";
+  EXPECT_LT(optimizer.acmr(), 0.9) << "Cache miss ratio too high!";
+}
+
+/*
+ * Cache miss ratio of a simple triangle list
+ */
+TEST_F(OpenMeshVertexCacheOptimizer, ACMR) {
+
+  std::vector<unsigned int> indices;
+
+  // two triangles sharing an edge
+  indices.push_back(0); indices.push_back(1); indices.push_back(2);
+  indices.push_back(2); indices.push_back(1); indices.push_back(3);
+
+  EXPECT_DOUBLE_EQ(2.0, OpenMesh::VertexCacheOptimizerT<Mesh>::compute_acmr(indices, 16));
+
+  // cache of size 1: vertex 1 is reloaded
+  EXPECT_DOUBLE_EQ(2.5, OpenMesh::VertexCacheOptimizerT<Mesh>::compute_acmr(indices, 1));
+}
+
+}